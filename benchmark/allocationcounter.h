@@ -0,0 +1,24 @@
+#ifndef ALLOCATIONCOUNTER_H
+#define ALLOCATIONCOUNTER_H
+
+#include <QtGlobal>
+
+/**
+ * @brief Compteur global des allocations dynamiques (operator new)
+ *
+ * Le comptage remplace operator new/delete pour tout le processus ; il n'est
+ * donc compilé que si LOGISTICS_COUNT_ALLOCATIONS est défini (build dédié au
+ * banc d'essai). Sinon isAvailable() renvoie false et allocations() vaut 0.
+ */
+class AllocationCounter
+{
+public:
+    static bool isAvailable();
+
+    /**
+     * @brief Nombre cumulé d'appels à operator new depuis le démarrage
+     */
+    static quint64 allocations();
+};
+
+#endif // ALLOCATIONCOUNTER_H
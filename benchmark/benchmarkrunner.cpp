@@ -0,0 +1,587 @@
+#include "benchmarkrunner.h"
+#include "database/databasemanager.h"
+#include "database/queryprofiler.h"
+#include "models/client.h"
+#include "models/commande.h"
+#include "controllers/commandecontroller.h"
+#include "utils/emailmanager.h"
+#include "utils/labelprinter.h"
+#include "utils/printmanager.h"
+#include "utils/validator.h"
+#include "utils/percentile.h"
+#include <QSqlQuery>
+#include <QElapsedTimer>
+#include <QDateTime>
+#include <QDate>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMap>
+#include <QHash>
+#include <QPair>
+#include <QDebug>
+#include <algorithm>
+#include <iostream>
+
+namespace {
+
+int intOption(const QStringList& arguments, const QString& name, int defaultValue)
+{
+    const int index = arguments.indexOf(name);
+    if (index < 0 || index + 1 >= arguments.size()) {
+        return defaultValue;
+    }
+    bool ok = false;
+    const int value = arguments.at(index + 1).toInt(&ok);
+    return ok ? value : defaultValue;
+}
+
+QString stringOption(const QStringList& arguments, const QString& name, const QString& defaultValue)
+{
+    const int index = arguments.indexOf(name);
+    return index >= 0 && index + 1 < arguments.size() ? arguments.at(index + 1) : defaultValue;
+}
+
+const QString BENCH_MARKER = "benchmark";
+
+} // namespace
+
+BenchmarkRunner::Config BenchmarkRunner::configFromArguments(const QStringList& arguments)
+{
+    Config config;
+    config.databasePath = stringOption(arguments, "--bench-db", config.databasePath);
+    config.outputPath = stringOption(arguments, "--bench-output", config.outputPath);
+    config.dataset.clients = intOption(arguments, "--bench-clients", config.dataset.clients);
+    config.dataset.commandes = intOption(arguments, "--bench-orders", config.dataset.commandes);
+    config.dataset.seed = static_cast<quint32>(intOption(arguments, "--bench-seed", config.dataset.seed));
+    config.iterations = qMax(1, intOption(arguments, "--bench-iterations", config.iterations));
+    config.writeOperations = qMax(1, intOption(arguments, "--bench-writes", config.writeOperations));
+    config.fullScanLimit = intOption(arguments, "--bench-full-scan", config.fullScanLimit);
+    config.regenerate = arguments.contains("--bench-regenerate");
+    return config;
+}
+
+BenchmarkRunner::BenchmarkRunner(const Config& config)
+    : m_config(config)
+{
+}
+
+int BenchmarkRunner::run()
+{
+    if (!prepareDataset()) {
+        return -1;
+    }
+
+    m_results.clear();
+    QueryProfiler::instance().reset();
+
+    runReadBenchmarks();
+    runSortBenchmarks();
+    runStatisticsBenchmarks();
+    runWriteBenchmarks();
+    runEmailBenchmarks();
+    runLabelBenchmarks();
+    runReportBenchmarks();
+    runValidationBenchmarks();
+
+    printSummary();
+    std::cout << QueryProfiler::instance().report(15).toStdString() << std::endl;
+
+    return writeJson(m_config.outputPath) ? 0 : -1;
+}
+
+bool BenchmarkRunner::prepareDataset()
+{
+    DatabaseManager& db = DatabaseManager::instance();
+
+    if (db.database().driverName() != "QSQLITE") {
+        qCritical() << "Le banc d'essai nécessite une base SQLite dédiée";
+        return false;
+    }
+
+    if (!m_config.regenerate && DataGenerator::matches(db, m_config.dataset)) {
+        qInfo() << "Jeu de données existant réutilisé:" << m_config.databasePath;
+        return true;
+    }
+
+    if (!DataGenerator::generate(db, m_config.dataset)) {
+        qCritical() << "Impossible de générer le jeu de données:" << DataGenerator::lastError();
+        return false;
+    }
+    return true;
+}
+
+void BenchmarkRunner::measure(const QString& name, const std::function<qint64()>& body,
+                              const std::function<void()>& setup)
+{
+    QList<double> samples;
+    qint64 items = 0;
+
+    for (int i = 0; i < m_config.warmup + m_config.iterations; ++i) {
+        if (setup) {
+            setup();
+        }
+
+        QElapsedTimer timer;
+        timer.start();
+        items = body();
+        const double elapsedMs = timer.nsecsElapsed() / 1.0e6;
+
+        if (i >= m_config.warmup) {
+            samples.append(elapsedMs);
+        }
+    }
+
+    Result result;
+    result.name = name;
+    result.iterations = samples.size();
+    result.items = items;
+    result.minMs = *std::min_element(samples.begin(), samples.end());
+    result.maxMs = *std::max_element(samples.begin(), samples.end());
+    result.medianMs = percentileOf(samples, 50);
+    result.p95Ms = percentileOf(samples, 95);
+
+    double total = 0.0;
+    for (double sample : samples) {
+        total += sample;
+    }
+    result.meanMs = total / samples.size();
+    result.itemsPerSecond = result.medianMs > 0.0 ? items * 1000.0 / result.medianMs : 0.0;
+
+    m_results.append(result);
+    qInfo().noquote() << QString("%1: médiane %2 ms (%3 éléments)")
+                             .arg(name).arg(result.medianMs, 0, 'f', 2).arg(items);
+}
+
+void BenchmarkRunner::skip(const QString& name)
+{
+    Result result;
+    result.name = name;
+    result.skipped = true;
+    m_results.append(result);
+    qInfo().noquote() << name << ": ignoré (au-delà de --bench-full-scan)";
+}
+
+void BenchmarkRunner::runReadBenchmarks()
+{
+    const bool fullScan = m_config.dataset.commandes <= m_config.fullScanLimit;
+    const QDate today = QDate::currentDate();
+    const int sampleClient = qMax(1, m_config.dataset.clients / 10);
+
+    measure("client.findAll", [] {
+        QList<Client*> clients = Client::findAll();
+        const qint64 count = clients.size();
+        qDeleteAll(clients);
+        return count;
+    });
+
+    measure("client.search.nom", [] {
+        QList<Client*> clients = Client::search("Mar");
+        const qint64 count = clients.size();
+        qDeleteAll(clients);
+        return count;
+    });
+
+    measure("client.search.ville_statut", [] {
+        QList<Client*> clients = Client::search("", "", "Lyon", Client::ACTIF);
+        const qint64 count = clients.size();
+        qDeleteAll(clients);
+        return count;
+    });
+
+    if (fullScan) {
+        measure("commande.findAll", [] {
+            QList<Commande*> commandes = Commande::findAll();
+            const qint64 count = commandes.size();
+            qDeleteAll(commandes);
+            return count;
+        });
+    } else {
+        skip("commande.findAll");
+    }
+
+    measure("commande.search.numero", [] {
+        QList<Commande*> commandes = Commande::search("CMD00012");
+        const qint64 count = commandes.size();
+        qDeleteAll(commandes);
+        return count;
+    });
+
+    measure("commande.search.client", [sampleClient] {
+        QList<Commande*> commandes = Commande::search("", sampleClient);
+        const qint64 count = commandes.size();
+        qDeleteAll(commandes);
+        return count;
+    });
+
+    measure("commande.search.statut", [] {
+        QList<Commande*> commandes = Commande::search("", 0, Commande::EN_TRANSIT);
+        const qint64 count = commandes.size();
+        qDeleteAll(commandes);
+        return count;
+    });
+
+    measure("commande.search.statut_priorite", [] {
+        QList<Commande*> commandes = Commande::search("", 0, Commande::EN_ATTENTE, Commande::URGENTE);
+        const qint64 count = commandes.size();
+        qDeleteAll(commandes);
+        return count;
+    });
+
+    measure("commande.search.periode_30j", [today] {
+        QList<Commande*> commandes = Commande::search("", 0, -1, -1, today.addDays(-30), today);
+        const qint64 count = commandes.size();
+        qDeleteAll(commandes);
+        return count;
+    });
+}
+
+void BenchmarkRunner::runSortBenchmarks()
+{
+    const QDate today = QDate::currentDate();
+
+    // Les listes sont chargées une fois ; seul le tri est mesuré, sur l'ordre d'origine
+    const QList<Client*> clients = Client::search("", "", "Paris");
+    QList<Client*> clientsTries;
+    for (const QString& critere : {QString("nom"), QString("ville"), QString("date_creation")}) {
+        measure("client.sort." + critere, [&clientsTries, critere] {
+            Client::sort(clientsTries, critere, true);
+            return static_cast<qint64>(clientsTries.size());
+        }, [&clientsTries, &clients] {
+            clientsTries = clients;
+        });
+    }
+    qDeleteAll(clients);
+
+    const QList<Commande*> commandes = Commande::search("", 0, -1, -1, today.addDays(-180), today);
+    QList<Commande*> commandesTriees;
+    for (const QString& critere : {QString("numero"), QString("date_commande"), QString("statut"),
+                                   QString("priorite"), QString("prix")}) {
+        measure("commande.sort." + critere, [&commandesTriees, critere] {
+            Commande::sort(commandesTriees, critere, false);
+            return static_cast<qint64>(commandesTriees.size());
+        }, [&commandesTriees, &commandes] {
+            commandesTriees = commandes;
+        });
+    }
+    qDeleteAll(commandes);
+}
+
+void BenchmarkRunner::runStatisticsBenchmarks()
+{
+    // Agrégats SQL utilisables par le tableau de bord
+    measure("statistics.sql_aggregates", [] {
+        qint64 total = Commande::count() + Client::count();
+        for (int statut = Commande::EN_ATTENTE; statut <= Commande::ANNULEE; ++statut) {
+            total += Commande::countByStatut(static_cast<Commande::Statut>(statut));
+        }
+        for (int priorite = Commande::BASSE; priorite <= Commande::URGENTE; ++priorite) {
+            total += Commande::countByPriorite(static_cast<Commande::Priorite>(priorite));
+        }
+        Commande::totalChiffreAffaires();
+        Commande::moyennePrixCommandes();
+        return total;
+    });
+
+    if (m_config.dataset.commandes > m_config.fullScanLimit) {
+        skip("statistics.view_aggregations");
+        return;
+    }
+
+    // Reproduit StatisticsView::refreshData : chargement complet puis agrégation en mémoire
+    measure("statistics.view_aggregations", [] {
+        QList<Client*> clients = Client::findAll();
+        QList<Commande*> commandes = Commande::findAll();
+
+        double chiffreAffaires = 0.0;
+        QMap<Commande::Statut, int> statusCounts;
+        QMap<Commande::Priorite, int> priorityCounts;
+        QMap<QString, int> monthlyCounts;
+        QMap<int, QPair<int, double>> clientStats;
+
+        for (Commande* commande : commandes) {
+            chiffreAffaires += commande->prixTotal();
+            statusCounts[commande->statut()]++;
+            priorityCounts[commande->priorite()]++;
+            monthlyCounts[commande->dateCommande().toString("yyyy-MM")]++;
+
+            QPair<int, double>& stats = clientStats[commande->idClient()];
+            stats.first++;
+            stats.second += commande->prixTotal();
+        }
+
+        const qint64 count = clients.size() + commandes.size();
+        qDeleteAll(commandes);
+        qDeleteAll(clients);
+        return count;
+    });
+}
+
+void BenchmarkRunner::runWriteBenchmarks()
+{
+    DatabaseManager& db = DatabaseManager::instance();
+    const int operations = m_config.writeOperations;
+    const int clientCount = m_config.dataset.clients;
+    int sequence = 0;
+
+    // Insertions unitaires par Client::save() (une transaction implicite chacune)
+    measure("client.save", [operations, &sequence] {
+        for (int i = 0; i < operations; ++i) {
+            const int n = ++sequence;
+            Client client(-1, "Benchmark", "Client", QString("bench.%1@example.com").arg(n),
+                          "0600000000", "1 Rue du Banc", "Paris", "75001",
+                          QDate::currentDate(), Client::ACTIF);
+            client.save();
+        }
+        return static_cast<qint64>(operations);
+    });
+
+    measure("commande.save", [operations, clientCount] {
+        const QDate today = QDate::currentDate();
+        for (int i = 0; i < operations; ++i) {
+            Commande commande(-1, 1 + i % clientCount, QString(), today, today.addDays(3), QDate(),
+                              "1 Rue du Banc", "Paris", "75001", Commande::EN_ATTENTE, Commande::NORMALE,
+                              2.5, 0.2, 19.9, BENCH_MARKER);
+            commande.save();
+        }
+        return static_cast<qint64>(operations);
+    });
+
+    // Changements de statut par le contrôleur (lecture + mise à jour + signaux)
+    QList<int> commandeIds;
+    QSqlQuery idsQuery = db.prepareQuery(
+        "SELECT ID_COMMANDE FROM COMMANDES WHERE STATUT = 'CONFIRMEE' ORDER BY ID_COMMANDE");
+    if (db.executeQuery(idsQuery)) {
+        while (idsQuery.next() && commandeIds.size() < operations) {
+            commandeIds.append(idsQuery.value(0).toInt());
+        }
+    }
+
+    // Remet les commandes dans leur état initial (non mesuré)
+    auto resetStatuts = [&db, &commandeIds] {
+        QSqlQuery reset = db.prepareQuery(
+            "UPDATE COMMANDES SET STATUT = 'CONFIRMEE' WHERE ID_COMMANDE = ?");
+        db.beginTransaction();
+        for (int id : commandeIds) {
+            db.executeQuery(reset, {id});
+        }
+        db.commitTransaction();
+    };
+
+    CommandeController controller;
+    measure("commande.changeStatut", [&controller, &commandeIds] {
+        for (int id : commandeIds) {
+            controller.changeStatutCommande(id, Commande::EN_PREPARATION);
+        }
+        return static_cast<qint64>(commandeIds.size());
+    }, resetStatuts);
+
+    // Nettoyage : le jeu de données reste identique pour la prochaine exécution
+    resetStatuts();
+    QSqlQuery cleanup(db.database());
+    cleanup.exec("DELETE FROM COMMANDES WHERE COMMENTAIRES = '" + BENCH_MARKER + "'");
+    cleanup.exec("DELETE FROM CLIENTS WHERE EMAIL LIKE 'bench.%@example.com'");
+}
+
+void BenchmarkRunner::runEmailBenchmarks()
+{
+    // Campagne de rappels : commandes des 30 derniers jours et leurs clients, chargés hors mesure
+    const QDate today = QDate::currentDate();
+    const QList<Commande*> commandes = Commande::search("", 0, -1, -1, today.addDays(-30), today);
+    QHash<int, Client*> clients;
+    QList<QPair<const Commande*, const Client*>> destinataires;
+    for (const Commande* commande : commandes) {
+        Client*& client = clients[commande->idClient()];
+        if (!client) {
+            client = Client::findById(commande->idClient());
+        }
+        if (client) {
+            destinataires.append({commande, client});
+        }
+    }
+
+    // Débit de rendu des gabarits (messages par seconde = items/s)
+    EmailManager emails;
+    const QList<QPair<QString, EmailManager::EmailType>> types = {
+        {"email.render.rappel", EmailManager::RAPPEL_LIVRAISON},
+        {"email.render.confirmation", EmailManager::CONFIRMATION_COMMANDE},
+        {"email.render.statut", EmailManager::MISE_A_JOUR_STATUT}
+    };
+    for (const auto& type : types) {
+        measure(type.first, [&emails, &destinataires, &type] {
+            qint64 bytes = 0;
+            for (const auto& destinataire : destinataires) {
+                bytes += emails.renderHtml(type.second, destinataire.first, destinataire.second, "En attente").size();
+            }
+            return bytes > 0 ? static_cast<qint64>(destinataires.size()) : 0;
+        });
+    }
+
+    qDeleteAll(clients);
+    qDeleteAll(commandes);
+}
+
+void BenchmarkRunner::runLabelBenchmarks()
+{
+    // Étiquettes des commandes des 30 derniers jours, chargées hors mesure
+    const QDate today = QDate::currentDate();
+    DatabaseManager& db = DatabaseManager::instance();
+    QSqlQuery query = db.prepareQuery("SELECT ID_COMMANDE FROM COMMANDES WHERE DATE_COMMANDE >= ? AND DATE_COMMANDE < ?");
+    QList<int> ids;
+    if (db.executeQuery(query, {today.addDays(-30), today.addDays(1)})) {
+        while (query.next()) {
+            ids.append(query.value(0).toInt());
+        }
+    }
+    QList<LabelEngine::Label> labels;
+    LabelPrinter::loadLabels(ids, labels);
+
+    // Débit de génération des flux d'impression (étiquettes par seconde = items/s)
+    const QList<QPair<QString, LabelEngine::Language>> languages = {
+        {"label.render.zpl", LabelEngine::ZPL},
+        {"label.render.escpos", LabelEngine::ESC_POS}
+    };
+    for (const auto& language : languages) {
+        const LabelEngine engine(language.second, "Société Logistique Tunisienne",
+                                 "123 Avenue Habib Bourguiba, 1000 Tunis, Tunisie");
+        QByteArray buffer;
+        measure(language.first, [&engine, &labels, &buffer] {
+            qint64 bytes = 0;
+            for (const LabelEngine::Label& label : labels) {
+                buffer.clear();
+                engine.renderTo(buffer, label);
+                bytes += buffer.size();
+            }
+            return bytes > 0 ? static_cast<qint64>(labels.size()) : 0;
+        });
+    }
+}
+
+void BenchmarkRunner::runReportBenchmarks()
+{
+    // Rapports lus par tranches et dessinés en PDF (lignes par seconde = items/s)
+    QTemporaryDir directory;
+    if (!directory.isValid()) {
+        skip("report.commandes.pdf");
+        skip("report.clients.pdf");
+        return;
+    }
+
+    PrintManager printManager;
+    const QString commandesPdf = directory.filePath("rapport-commandes.pdf");
+    measure("report.commandes.pdf", [&printManager, &commandesPdf] {
+        return printManager.saveRapportCommandesPdf(commandesPdf)
+                   ? static_cast<qint64>(printManager.lastReportRows()) : 0;
+    });
+
+    const QString clientsPdf = directory.filePath("liste-clients.pdf");
+    measure("report.clients.pdf", [&printManager, &clientsPdf] {
+        return printManager.saveListeClientsPdf(clientsPdf)
+                   ? static_cast<qint64>(printManager.lastReportRows()) : 0;
+    });
+}
+
+void BenchmarkRunner::runValidationBenchmarks()
+{
+    // Lignes d'import simulées à partir des clients de la base, chargées hors mesure
+    DatabaseManager& db = DatabaseManager::instance();
+    QSqlQuery query = db.prepareQuery("SELECT NOM, PRENOM, EMAIL, TELEPHONE, ADRESSE, VILLE, CODE_POSTAL FROM CLIENTS");
+    QList<Validator::ClientRecord> records;
+    if (db.executeQuery(query)) {
+        while (query.next()) {
+            records.append({query.value(0).toString(), query.value(1).toString(), query.value(2).toString(),
+                            query.value(3).toString(), query.value(4).toString(), query.value(5).toString(),
+                            query.value(6).toString()});
+        }
+    }
+
+    // Débit en lignes par seconde (items/s)
+    measure("validator.clients.bulk", [&records] {
+        const Validator::BulkResult result = Validator::validateClients(records);
+        return result.errors.size() == records.size() ? static_cast<qint64>(records.size()) : 0;
+    });
+
+    // Référence : validation ligne à ligne avec messages d'erreur
+    measure("validator.clients.messages", [&records] {
+        qint64 rows = 0;
+        for (const Validator::ClientRecord& record : records) {
+            Validator::validateClient(record.nom, record.prenom, record.email, record.telephone,
+                                      record.adresse, record.ville, record.codePostal);
+            ++rows;
+        }
+        return rows;
+    });
+}
+
+void BenchmarkRunner::printSummary() const
+{
+    std::cout << QString("%1 %2 %3 %4 %5 %6")
+                     .arg("Mesure", -36).arg("médiane ms", 12).arg("p95 ms", 10)
+                     .arg("min ms", 10).arg("éléments", 10).arg("élts/s", 12)
+                     .toStdString() << std::endl;
+
+    for (const Result& result : m_results) {
+        if (result.skipped) {
+            std::cout << QString("%1 %2").arg(result.name, -36).arg("ignoré", 12).toStdString() << std::endl;
+            continue;
+        }
+        std::cout << QString("%1 %2 %3 %4 %5 %6")
+                         .arg(result.name, -36)
+                         .arg(result.medianMs, 12, 'f', 2)
+                         .arg(result.p95Ms, 10, 'f', 2)
+                         .arg(result.minMs, 10, 'f', 2)
+                         .arg(result.items, 10)
+                         .arg(result.itemsPerSecond, 12, 'f', 0)
+                         .toStdString() << std::endl;
+    }
+}
+
+bool BenchmarkRunner::writeJson(const QString& filePath) const
+{
+    QJsonObject dataset;
+    dataset["clients"] = m_config.dataset.clients;
+    dataset["commandes"] = m_config.dataset.commandes;
+    dataset["seed"] = static_cast<qint64>(m_config.dataset.seed);
+
+    QJsonArray results;
+    for (const Result& result : m_results) {
+        QJsonObject entry;
+        entry["name"] = result.name;
+        entry["skipped"] = result.skipped;
+        if (!result.skipped) {
+            entry["iterations"] = result.iterations;
+            entry["items"] = result.items;
+            entry["minMs"] = result.minMs;
+            entry["medianMs"] = result.medianMs;
+            entry["p95Ms"] = result.p95Ms;
+            entry["maxMs"] = result.maxMs;
+            entry["meanMs"] = result.meanMs;
+            entry["itemsPerSecond"] = result.itemsPerSecond;
+        }
+        results.append(entry);
+    }
+
+    QJsonObject root;
+    root["schemaVersion"] = 1;
+    root["timestamp"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    root["commit"] = qEnvironmentVariable("GIT_COMMIT");
+    root["qtVersion"] = QString(qVersion());
+    root["driver"] = DatabaseManager::instance().database().driverName();
+    root["database"] = QFileInfo(m_config.databasePath).absoluteFilePath();
+    root["dataset"] = dataset;
+    root["warmup"] = m_config.warmup;
+    root["writeOperations"] = m_config.writeOperations;
+    root["results"] = results;
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qCritical() << "Impossible d'écrire les résultats:" << filePath << file.errorString();
+        return false;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Indented));
+    qInfo() << "Résultats écrits dans" << filePath;
+    return true;
+}
@@ -0,0 +1,107 @@
+#ifndef BENCHMARKRUNNER_H
+#define BENCHMARKRUNNER_H
+
+#include "datagenerator.h"
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <functional>
+
+/**
+ * @brief Banc d'essai des couches modèle et contrôleur
+ *
+ * Exécuté par `LogisticsApp --benchmark` sur une base SQLite dédiée, générée
+ * par DataGenerator si les volumes demandés ne correspondent pas. Chaque
+ * mesure est répétée (après échauffement) et les résultats sont écrits en
+ * JSON pour comparer les performances d'un commit à l'autre.
+ *
+ * Options : --bench-db <fichier>, --bench-clients <n>, --bench-orders <n>,
+ * --bench-seed <n>, --bench-iterations <n>, --bench-writes <n>,
+ * --bench-full-scan <n>, --bench-output <fichier.json>, --bench-regenerate
+ */
+class BenchmarkRunner
+{
+public:
+    struct Config {
+        QString databasePath = "logistics-bench.db";
+        QString outputPath = "benchmark-results.json";
+        DataGenerator::Config dataset;
+        int iterations = 5;
+        int warmup = 1;
+        int writeOperations = 500;      // Insertions / changements de statut par itération
+        int fullScanLimit = 1000000;    // Au-delà, les chargements complets sont ignorés
+        bool regenerate = false;
+    };
+
+    struct Result {
+        QString name;
+        int iterations = 0;
+        qint64 items = 0;               // Éléments traités par itération
+        double minMs = 0.0;
+        double medianMs = 0.0;
+        double p95Ms = 0.0;
+        double maxMs = 0.0;
+        double meanMs = 0.0;
+        double itemsPerSecond = 0.0;
+        bool skipped = false;
+    };
+
+    /**
+     * @brief Construit la configuration à partir de la ligne de commande
+     * @param arguments Arguments de l'application
+     * @return Configuration (valeurs par défaut pour les options absentes)
+     */
+    static Config configFromArguments(const QStringList& arguments);
+
+    explicit BenchmarkRunner(const Config& config);
+
+    /**
+     * @brief Prépare le jeu de données puis exécute toutes les mesures
+     * @return Code de sortie du processus (0 si succès)
+     */
+    int run();
+
+    /**
+     * @brief Obtient les résultats de la dernière exécution
+     */
+    QList<Result> results() const { return m_results; }
+
+    /**
+     * @brief Écrit les résultats au format JSON
+     * @param filePath Fichier de sortie
+     * @return true si l'écriture a réussi
+     */
+    bool writeJson(const QString& filePath) const;
+
+    /**
+     * @brief Ajoute une mesure répétée selon la configuration
+     * @param name Identifiant stable de la mesure (ex: "client.findAll")
+     * @param body Corps mesuré, renvoie le nombre d'éléments traités
+     * @param setup Préparation non mesurée exécutée avant chaque itération
+     */
+    void measure(const QString& name, const std::function<qint64()>& body,
+                 const std::function<void()>& setup = nullptr);
+
+    /**
+     * @brief Enregistre une mesure ignorée (volume trop important)
+     */
+    void skip(const QString& name);
+
+private:
+    bool prepareDataset();
+    void runReadBenchmarks();
+    void runSortBenchmarks();
+    void runStatisticsBenchmarks();
+    void runWriteBenchmarks();
+    void runEmailBenchmarks();
+    void runLabelBenchmarks();
+    void runReportBenchmarks();
+    void runValidationBenchmarks();
+    void printSummary() const;
+
+private:
+    Config m_config;
+    QList<Result> m_results;
+};
+
+#endif // BENCHMARKRUNNER_H
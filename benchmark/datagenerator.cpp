@@ -0,0 +1,403 @@
+#include "datagenerator.h"
+#include "database/databasemanager.h"
+#include "database/queryprofiler.h"
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QDate>
+#include <QElapsedTimer>
+#include <QVariantList>
+#include <QVector>
+#include <QDebug>
+#include <iterator>
+#include <random>
+#include <vector>
+
+QString DataGenerator::m_lastError;
+
+namespace {
+
+struct City {
+    const char* name;
+    const char* codePostal;
+    int weight;
+};
+
+// Répartition concentrée sur les grandes agglomérations
+const City CITIES[] = {
+    {"Paris", "75001", 220}, {"Lyon", "69001", 95}, {"Marseille", "13001", 90},
+    {"Toulouse", "31000", 70}, {"Nice", "06000", 50}, {"Nantes", "44000", 50},
+    {"Strasbourg", "67000", 42}, {"Montpellier", "34000", 42}, {"Bordeaux", "33000", 40},
+    {"Lille", "59000", 40}, {"Rennes", "35000", 33}, {"Reims", "51100", 22},
+    {"Toulon", "83000", 20}, {"Grenoble", "38000", 20}, {"Dijon", "21000", 19},
+    {"Angers", "49000", 18}, {"Nîmes", "30000", 17}, {"Clermont-Ferrand", "63000", 17},
+    {"Le Havre", "76600", 16}, {"Tours", "37000", 16}, {"Limoges", "87000", 15},
+    {"Amiens", "80000", 15}, {"Metz", "57000", 14}, {"Besançon", "25000", 13},
+    {"Perpignan", "66000", 12}, {"Orléans", "45000", 12}, {"Caen", "14000", 12},
+    {"Rouen", "76000", 12}, {"Nancy", "54000", 11}, {"Avignon", "84000", 9}
+};
+
+const char* NOMS[] = {
+    "Martin", "Bernard", "Dubois", "Thomas", "Robert", "Richard", "Petit", "Durand",
+    "Leroy", "Moreau", "Simon", "Laurent", "Lefebvre", "Michel", "Garcia", "David",
+    "Bertrand", "Roux", "Vincent", "Fournier", "Morel", "Girard", "Andre", "Mercier",
+    "Dupont", "Lambert", "Bonnet", "Francois", "Martinez", "Legrand", "Garnier", "Faure"
+};
+
+const char* PRENOMS[] = {
+    "Jean", "Marie", "Pierre", "Sophie", "Paul", "Julie", "Nicolas", "Camille",
+    "Thomas", "Emma", "Lucas", "Léa", "Hugo", "Chloé", "Louis", "Manon",
+    "Antoine", "Sarah", "Julien", "Laura", "Maxime", "Inès", "Alexandre", "Clara"
+};
+
+const char* RUES[] = {
+    "Rue de la Paix", "Avenue Victor Hugo", "Boulevard Saint-Michel", "Rue Nationale",
+    "Place de la République", "Rue du Général de Gaulle", "Avenue Jean Jaurès",
+    "Rue Pasteur", "Rue de la Gare", "Allée des Tilleuls"
+};
+
+// Commandes récentes (moins de 30 jours) : toutes les étapes sont représentées
+const char* STATUTS[] = {"EN_ATTENTE", "CONFIRMEE", "EN_PREPARATION", "EN_TRANSIT", "LIVREE", "ANNULEE"};
+const int STATUT_WEIGHTS_RECENT[] = {14, 16, 14, 18, 33, 5};
+// Commandes anciennes : livrées ou annulées
+const int STATUT_WEIGHTS_OLD[] = {0, 0, 0, 0, 92, 8};
+
+const char* PRIORITES[] = {"BASSE", "NORMALE", "HAUTE", "URGENTE"};
+const int PRIORITE_WEIGHTS[] = {20, 55, 18, 7};
+
+const int ACTIVE_WINDOW_DAYS = 30;
+
+// À incrémenter à chaque changement des distributions ci-dessus : un jeu
+// généré par une version antérieure n'est alors plus réutilisé
+const int GENERATOR_VERSION = 1;
+
+template <typename T, size_t N>
+constexpr int countOf(const T (&)[N])
+{
+    return static_cast<int>(N);
+}
+
+template <typename T, size_t N>
+std::discrete_distribution<int> weightedDistribution(const T (&weights)[N])
+{
+    return std::discrete_distribution<int>(std::begin(weights), std::end(weights));
+}
+
+std::discrete_distribution<int> cityDistribution()
+{
+    std::vector<int> weights;
+    for (const City& city : CITIES) {
+        weights.push_back(city.weight);
+    }
+    return std::discrete_distribution<int>(weights.begin(), weights.end());
+}
+
+// Empreinte du jeu de données, enregistrée dans BENCH_DATASET après génération
+QString datasetSignature(const DataGenerator::Config& config)
+{
+    return QString("v%1;clients=%2;commandes=%3;graine=%4;historique=%5")
+        .arg(GENERATOR_VERSION).arg(config.clients).arg(config.commandes)
+        .arg(config.seed).arg(config.historyDays);
+}
+
+bool execBatch(QSqlQuery& query, const QVector<QVariantList>& columns, QString& error)
+{
+    for (const QVariantList& column : columns) {
+        query.addBindValue(column);
+    }
+    if (!query.execBatch()) {
+        error = query.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+bool DataGenerator::matches(DatabaseManager& db, const Config& config)
+{
+    // Même graine, mêmes volumes et même version du générateur...
+    if (!db.database().tables().contains("BENCH_DATASET", Qt::CaseInsensitive)) {
+        return false;
+    }
+    QSqlQuery signature = db.prepareQuery("SELECT SIGNATURE FROM BENCH_DATASET");
+    if (!db.executeQuery(signature) || !signature.next()
+        || signature.value(0).toString() != datasetSignature(config)) {
+        return false;
+    }
+
+    // ... et des tables qui n'ont pas été modifiées depuis
+    QSqlQuery query = db.prepareQuery(
+        "SELECT (SELECT COUNT(*) FROM CLIENTS), (SELECT COUNT(*) FROM COMMANDES)");
+    if (!db.executeQuery(query) || !query.next()) {
+        return false;
+    }
+    return query.value(0).toInt() == config.clients && query.value(1).toInt() == config.commandes;
+}
+
+bool DataGenerator::generate(DatabaseManager& db, const Config& config)
+{
+    if (db.database().driverName() != "QSQLITE") {
+        m_lastError = "Le générateur de données ne cible que SQLite";
+        return false;
+    }
+    if (config.clients <= 0 || config.commandes < 0) {
+        m_lastError = "Volumes de génération invalides";
+        return false;
+    }
+
+    qInfo() << "Génération de" << config.clients << "clients et" << config.commandes
+            << "commandes (graine" << config.seed << ")...";
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // Les insertions massives ne doivent pas polluer les statistiques du profileur
+    QueryProfiler& profiler = QueryProfiler::instance();
+    const bool profilerWasEnabled = profiler.isEnabled();
+    profiler.setEnabled(false);
+
+    // Mode de journal et synchronisation de la connexion (WAL en production),
+    // rétablis après le chargement
+    QSqlQuery pragma(db.database());
+    QString journalMode = "DELETE";
+    if (pragma.exec("PRAGMA journal_mode") && pragma.next()) {
+        journalMode = pragma.value(0).toString();
+    }
+    QString synchronous = "FULL";
+    if (pragma.exec("PRAGMA synchronous") && pragma.next()) {
+        synchronous = pragma.value(0).toString();
+    }
+    pragma.exec("PRAGMA synchronous = OFF");
+    pragma.exec("PRAGMA journal_mode = MEMORY");
+
+    // Empreinte effacée d'abord : une génération interrompue n'est jamais réutilisée
+    pragma.exec("CREATE TABLE IF NOT EXISTS BENCH_DATASET (SIGNATURE TEXT NOT NULL)");
+    pragma.exec("DELETE FROM BENCH_DATASET");
+
+    // Chargement sans index, reconstruits une seule fois à la fin. Les index
+    // sont ceux qu'ont créés les migrations, relus dans sqlite_master (les
+    // index implicites des contraintes UNIQUE, sans SQL, restent en place)
+    QStringList indexNames;
+    QStringList indexStatements;
+    pragma.exec("SELECT name, sql FROM sqlite_master WHERE type = 'index' AND sql IS NOT NULL"
+                " AND tbl_name IN ('CLIENTS', 'COMMANDES', 'COMMANDES_ARCHIVE')");
+    while (pragma.next()) {
+        indexNames << pragma.value(0).toString();
+        indexStatements << pragma.value(1).toString();
+    }
+    for (const QString& indexName : indexNames) {
+        pragma.exec("DROP INDEX IF EXISTS " + indexName);
+    }
+
+    QVector<quint8> clientCities;
+    bool success = clearTables(db)
+                   && generateClients(db, config, clientCities)
+                   && generateCommandes(db, config, clientCities);
+
+    for (const QString& statement : indexStatements) {
+        if (!pragma.exec(statement)) {
+            m_lastError = pragma.lastError().text();
+            success = false;
+        }
+    }
+    pragma.exec("ANALYZE");
+
+    if (success) {
+        pragma.prepare("INSERT INTO BENCH_DATASET (SIGNATURE) VALUES (?)");
+        pragma.addBindValue(datasetSignature(config));
+        if (!pragma.exec()) {
+            m_lastError = pragma.lastError().text();
+            success = false;
+        }
+    }
+
+    pragma.exec("PRAGMA journal_mode = " + journalMode);
+    pragma.exec("PRAGMA synchronous = " + synchronous);
+    profiler.setEnabled(profilerWasEnabled);
+
+    if (success) {
+        qInfo() << "Jeu de données généré en" << timer.elapsed() / 1000.0 << "s";
+    } else {
+        qCritical() << "Échec de la génération:" << m_lastError;
+    }
+    return success;
+}
+
+QString DataGenerator::lastError()
+{
+    return m_lastError;
+}
+
+bool DataGenerator::clearTables(DatabaseManager& db)
+{
+    QSqlQuery query(db.database());
+    const QStringList statements = {
+        "DELETE FROM COMMANDES_ARCHIVE",
+        "DELETE FROM COMMANDES",
+        "DELETE FROM CLIENTS",
+        "DELETE FROM sqlite_sequence WHERE name IN ('CLIENTS', 'COMMANDES', 'COMMANDES_ARCHIVE')"
+    };
+
+    for (const QString& statement : statements) {
+        if (!query.exec(statement)) {
+            m_lastError = query.lastError().text();
+            return false;
+        }
+    }
+    return true;
+}
+
+bool DataGenerator::generateClients(DatabaseManager& db, const Config& config, QVector<quint8>& clientCities)
+{
+    std::mt19937 rng(config.seed);
+    std::discrete_distribution<int> cityDist = cityDistribution();
+    std::uniform_int_distribution<int> nomDist(0, countOf(NOMS) - 1);
+    std::uniform_int_distribution<int> prenomDist(0, countOf(PRENOMS) - 1);
+    std::uniform_int_distribution<int> rueDist(0, countOf(RUES) - 1);
+    std::uniform_int_distribution<int> numeroDist(1, 250);
+    std::uniform_int_distribution<int> phoneDist(10000000, 99999999);
+    std::uniform_int_distribution<int> ageDist(0, 3 * 365);
+    std::uniform_int_distribution<int> statutDist(0, 99);
+
+    const QDate today = QDate::currentDate();
+    clientCities.resize(config.clients + 1);
+
+    QSqlQuery query = db.prepareQuery(R"(
+        INSERT INTO CLIENTS (ID_CLIENT, NOM, PRENOM, EMAIL, TELEPHONE, ADRESSE, VILLE, CODE_POSTAL, DATE_CREATION, STATUT)
+        VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?)
+    )");
+
+    for (int start = 1; start <= config.clients; start += config.batchSize) {
+        const int end = qMin(start + config.batchSize - 1, config.clients);
+        QVector<QVariantList> columns(10);
+
+        for (int id = start; id <= end; ++id) {
+            const QString nom = QString::fromUtf8(NOMS[nomDist(rng)]);
+            const QString prenom = QString::fromUtf8(PRENOMS[prenomDist(rng)]);
+            const int cityIndex = cityDist(rng);
+            const City& city = CITIES[cityIndex];
+            const int statutRoll = statutDist(rng);
+
+            clientCities[id] = static_cast<quint8>(cityIndex);
+
+            columns[0] << id;
+            columns[1] << nom;
+            columns[2] << prenom;
+            columns[3] << QString("%1.%2@example.com").arg(nom.toLower()).arg(id);
+            columns[4] << QString("0%1%2").arg(1 + id % 7).arg(phoneDist(rng));
+            columns[5] << QString("%1 %2").arg(numeroDist(rng)).arg(QString::fromUtf8(RUES[rueDist(rng)]));
+            columns[6] << QString::fromUtf8(city.name);
+            columns[7] << QString::fromLatin1(city.codePostal);
+            columns[8] << today.addDays(-ageDist(rng));
+            columns[9] << QString::fromLatin1(statutRoll < 88 ? "ACTIF" : (statutRoll < 97 ? "INACTIF" : "SUSPENDU"));
+        }
+
+        if (!db.beginTransaction()) {
+            m_lastError = db.lastError();
+            return false;
+        }
+        if (!execBatch(query, columns, m_lastError)) {
+            db.rollbackTransaction();
+            return false;
+        }
+        if (!db.commitTransaction()) {
+            m_lastError = db.lastError();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool DataGenerator::generateCommandes(DatabaseManager& db, const Config& config,
+                                      const QVector<quint8>& clientCities)
+{
+    std::mt19937 rng(config.seed + 1);
+    std::discrete_distribution<int> cityDist = cityDistribution();
+    std::discrete_distribution<int> recentStatutDist = weightedDistribution(STATUT_WEIGHTS_RECENT);
+    std::discrete_distribution<int> oldStatutDist = weightedDistribution(STATUT_WEIGHTS_OLD);
+    std::discrete_distribution<int> prioriteDist = weightedDistribution(PRIORITE_WEIGHTS);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::lognormal_distribution<double> poidsDist(1.6, 0.8);
+    std::uniform_int_distribution<int> rueDist(0, countOf(RUES) - 1);
+    std::uniform_int_distribution<int> numeroDist(1, 250);
+    std::uniform_int_distribution<int> retardDist(-1, 3);
+
+    const QDate today = QDate::currentDate();
+
+    QSqlQuery query = db.prepareQuery(R"(
+        INSERT INTO COMMANDES (ID_COMMANDE, ID_CLIENT, NUMERO_COMMANDE, DATE_COMMANDE, DATE_LIVRAISON_PREVUE,
+                               DATE_LIVRAISON_REELLE, ADRESSE_LIVRAISON, VILLE_LIVRAISON, CODE_POSTAL_LIVRAISON,
+                               STATUT, PRIORITE, POIDS_TOTAL, VOLUME_TOTAL, PRIX_TOTAL, COMMENTAIRES)
+        VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)
+    )");
+
+    for (int start = 1; start <= config.commandes; start += config.batchSize) {
+        const int end = qMin(start + config.batchSize - 1, config.commandes);
+        QVector<QVariantList> columns(15);
+
+        for (int id = start; id <= end; ++id) {
+            // Peu de clients concentrent beaucoup de commandes
+            const double clientRoll = unit(rng);
+            const int idClient = 1 + qMin(config.clients - 1, static_cast<int>(clientRoll * clientRoll * config.clients));
+
+            // Volume croissant dans le temps : plus de commandes récentes
+            const double ageRoll = unit(rng);
+            const int age = static_cast<int>(ageRoll * ageRoll * config.historyDays);
+            const QDate dateCommande = today.addDays(-age);
+
+            const int priorite = prioriteDist(rng);
+            const int statut = age < ACTIVE_WINDOW_DAYS ? recentStatutDist(rng) : oldStatutDist(rng);
+            const bool livree = qstrcmp(STATUTS[statut], "LIVREE") == 0;
+            const bool annulee = qstrcmp(STATUTS[statut], "ANNULEE") == 0;
+
+            // Délai prévu plus court pour les priorités élevées
+            const int delai = 1 + static_cast<int>(unit(rng) * (7 - 2 * priorite));
+            const QDate datePrevue = dateCommande.addDays(delai);
+            const QDate dateReelle = livree ? qMin(today, datePrevue.addDays(retardDist(rng))) : QDate();
+
+            // Livraison le plus souvent dans la ville du client
+            const int cityIndex = unit(rng) < 0.85 ? clientCities.at(idClient) : cityDist(rng);
+            const City& city = CITIES[cityIndex];
+
+            const double poids = annulee ? 0.0 : qRound(poidsDist(rng) * 100.0) / 100.0;
+            const double volume = qRound(poids * (0.03 + unit(rng) * 0.07) * 100.0) / 100.0;
+            const double prix = annulee ? 0.0 : qRound((8.0 + poids * (3.5 + priorite * 1.5)) * 100.0) / 100.0;
+
+            columns[0] << id;
+            columns[1] << idClient;
+            columns[2] << QString("CMD%1").arg(id, 6, 10, QChar('0'));
+            columns[3] << dateCommande;
+            columns[4] << datePrevue;
+            columns[5] << (dateReelle.isValid() ? QVariant(dateReelle) : QVariant());
+            columns[6] << QString("%1 %2").arg(numeroDist(rng)).arg(QString::fromUtf8(RUES[rueDist(rng)]));
+            columns[7] << QString::fromUtf8(city.name);
+            columns[8] << QString::fromLatin1(city.codePostal);
+            columns[9] << QString::fromLatin1(STATUTS[statut]);
+            columns[10] << QString::fromLatin1(PRIORITES[priorite]);
+            columns[11] << poids;
+            columns[12] << volume;
+            columns[13] << prix;
+            columns[14] << (annulee ? QVariant(QString("Commande annulée par le client")) : QVariant());
+        }
+
+        if (!db.beginTransaction()) {
+            m_lastError = db.lastError();
+            return false;
+        }
+        if (!execBatch(query, columns, m_lastError)) {
+            db.rollbackTransaction();
+            return false;
+        }
+        if (!db.commitTransaction()) {
+            m_lastError = db.lastError();
+            return false;
+        }
+
+        if (end % (config.batchSize * 100) == 0) {
+            qInfo() << "  ..." << end << "commandes";
+        }
+    }
+
+    return true;
+}
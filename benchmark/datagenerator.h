@@ -0,0 +1,62 @@
+#ifndef DATAGENERATOR_H
+#define DATAGENERATOR_H
+
+#include <QString>
+#include <QVector>
+
+class DatabaseManager;
+
+/**
+ * @brief Générateur de jeux de données synthétiques pour le banc d'essai
+ *
+ * Remplit CLIENTS et COMMANDES avec des volumes configurables et des
+ * distributions réalistes : villes concentrées sur quelques grandes
+ * agglomérations, majorité de commandes livrées, priorités surtout normales,
+ * commandes actives récentes. Le générateur est déterministe pour une graine
+ * donnée, ce qui rend les résultats comparables d'un commit à l'autre.
+ */
+class DataGenerator
+{
+public:
+    struct Config {
+        int clients = 10000;
+        int commandes = 200000;
+        quint32 seed = 42;
+        int batchSize = 5000;       // Lignes par lot (et par transaction)
+        int historyDays = 730;      // Profondeur de l'historique des commandes
+    };
+
+    /**
+     * @brief Vérifie si la base contient déjà exactement le jeu demandé
+     *
+     * Compare l'empreinte enregistrée par generate() (version du générateur,
+     * volumes, graine, profondeur d'historique) puis les volumes des tables.
+     * @param db Gestionnaire de base de données initialisé
+     * @param config Jeu attendu
+     * @return true si le jeu présent a été généré avec cette configuration
+     */
+    static bool matches(DatabaseManager& db, const Config& config);
+
+    /**
+     * @brief Vide les tables puis génère le jeu de données
+     * @param db Gestionnaire de base de données initialisé (SQLite)
+     * @param config Volumes et graine
+     * @return true si la génération a réussi
+     */
+    static bool generate(DatabaseManager& db, const Config& config);
+
+    /**
+     * @brief Obtient la dernière erreur de génération
+     */
+    static QString lastError();
+
+private:
+    static bool clearTables(DatabaseManager& db);
+    static bool generateClients(DatabaseManager& db, const Config& config, QVector<quint8>& clientCities);
+    static bool generateCommandes(DatabaseManager& db, const Config& config,
+                                  const QVector<quint8>& clientCities);
+
+    static QString m_lastError;
+};
+
+#endif // DATAGENERATOR_H
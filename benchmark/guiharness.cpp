@@ -0,0 +1,418 @@
+#include "guiharness.h"
+#include "allocationcounter.h"
+#include "mainwindow.h"
+#include "views/clientview.h"
+#include "views/commandeview.h"
+#include "views/statisticsview.h"
+#include "utils/percentile.h"
+#include <QApplication>
+#include <QAbstractEventDispatcher>
+#include <QEventLoop>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <QKeyEvent>
+#include <QLineEdit>
+#include <QComboBox>
+#include <QPushButton>
+#include <QTableWidget>
+#include <QHeaderView>
+#include <QTabWidget>
+#include <QWindow>
+#include <QDateTime>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QDebug>
+#include <algorithm>
+#include <iostream>
+
+namespace {
+
+const int HEARTBEAT_MS = 1;
+const int SETTLE_MS = 30;           // Observation des blocages après le retour au repos
+const int EXPOSE_TIMEOUT_MS = 5000;
+
+void sendKey(QWidget* target, QChar character)
+{
+    const int key = character.isLetter() ? character.toUpper().unicode() : character.unicode();
+    QKeyEvent press(QEvent::KeyPress, key, Qt::NoModifier, QString(character));
+    QKeyEvent release(QEvent::KeyRelease, key, Qt::NoModifier, QString(character));
+    QCoreApplication::sendEvent(target, &press);
+    QCoreApplication::sendEvent(target, &release);
+}
+
+} // namespace
+
+GuiHarness::Config GuiHarness::configFromArguments(const QStringList& arguments)
+{
+    Config config;
+
+    // Budgets par défaut : une frappe doit tenir dans une image à 60 Hz
+    config.budgetsMs["clients.search.keystroke"] = 16.0;
+    config.budgetsMs["tab.switch"] = 50.0;
+    config.budgetsMs["clients.sort.combo"] = 100.0;
+    config.budgetsMs["clients.sort.header"] = 100.0;
+    config.budgetsMs["commandes.sort.header"] = 100.0;
+
+    for (int i = 0; i + 1 < arguments.size(); ++i) {
+        const QString& argument = arguments.at(i);
+        if (argument == "--gui-iterations") {
+            config.iterations = qMax(1, arguments.at(i + 1).toInt());
+        } else if (argument == "--gui-output") {
+            config.outputPath = arguments.at(i + 1);
+        } else if (argument == "--gui-budget") {
+            const QStringList parts = arguments.at(i + 1).split('=');
+            if (parts.size() == 2) {
+                config.budgetsMs[parts.at(0)] = parts.at(1).toDouble();
+            }
+        }
+    }
+    return config;
+}
+
+GuiHarness::GuiHarness(const Config& config)
+    : m_config(config)
+{
+}
+
+int GuiHarness::run()
+{
+    m_results.clear();
+
+    if (!AllocationCounter::isAvailable()) {
+        qInfo() << "Comptage des allocations indisponible (compiler avec LOGISTICS_COUNT_ALLOCATIONS)";
+    }
+
+    QElapsedTimer constructionTimer;
+    constructionTimer.start();
+    const quint64 allocationsBefore = AllocationCounter::allocations();
+
+    MainWindow window;
+    window.resize(1400, 900);
+    window.show();
+
+    // Attente de la première exposition (plateforme offscreen incluse)
+    QElapsedTimer exposeTimer;
+    exposeTimer.start();
+    while (!(window.windowHandle() && window.windowHandle()->isExposed())
+           && exposeTimer.elapsed() < EXPOSE_TIMEOUT_MS) {
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+    }
+    QCoreApplication::processEvents();
+
+    Sample construction;
+    construction.wallMs = constructionTimer.nsecsElapsed() / 1.0e6;
+    construction.stallMs = construction.wallMs;
+    construction.allocations = static_cast<qint64>(AllocationCounter::allocations() - allocationsBefore);
+    record("mainwindow.construct_and_show", {construction});
+
+    runClientInteractions(window);
+    runCommandeInteractions(window);
+    runStatisticsInteractions(window);
+    runTabInteractions(window);
+
+    printSummary();
+    writeJson(m_config.outputPath);
+
+    const bool withinBudget = std::all_of(m_results.cbegin(), m_results.cend(),
+                                          [](const Result& result) { return result.withinBudget; });
+    return withinBudget ? 0 : 1;
+}
+
+GuiHarness::Sample GuiHarness::sampleInteraction(const std::function<void()>& action)
+{
+    Sample sample;
+    QEventLoop loop;
+    QElapsedTimer clock;
+    qint64 lastBeatNs = 0;
+    qint64 maxGapNs = 0;
+    quint64 allocationsBefore = 0;
+    bool started = false;
+    bool finished = false;
+
+    // Battement : un écart entre deux battements est un blocage de la boucle
+    QTimer heartbeat;
+    heartbeat.setTimerType(Qt::PreciseTimer);
+    heartbeat.setInterval(HEARTBEAT_MS);
+    QObject::connect(&heartbeat, &QTimer::timeout, &loop, [&]() {
+        const qint64 now = clock.nsecsElapsed();
+        maxGapNs = qMax(maxGapNs, now - lastBeatNs);
+        lastBeatNs = now;
+    });
+
+    // Premier passage au repos après l'action : fin de l'interaction
+    QAbstractEventDispatcher* dispatcher = QAbstractEventDispatcher::instance();
+    const QMetaObject::Connection idleConnection =
+        QObject::connect(dispatcher, &QAbstractEventDispatcher::aboutToBlock, &loop, [&]() {
+            if (started && !finished) {
+                finished = true;
+                sample.wallMs = clock.nsecsElapsed() / 1.0e6;
+                sample.allocations = static_cast<qint64>(AllocationCounter::allocations() - allocationsBefore);
+                QTimer::singleShot(SETTLE_MS, &loop, &QEventLoop::quit);
+            }
+        });
+
+    QTimer::singleShot(0, &loop, [&]() {
+        allocationsBefore = AllocationCounter::allocations();
+        clock.start();
+        lastBeatNs = 0;
+        started = true;
+        heartbeat.start();
+        action();
+    });
+
+    loop.exec();
+    QObject::disconnect(idleConnection);
+    heartbeat.stop();
+
+    sample.stallMs = qMax(0.0, maxGapNs / 1.0e6 - HEARTBEAT_MS);
+    return sample;
+}
+
+void GuiHarness::repeat(const QString& name, const std::function<void()>& action,
+                        const std::function<void()>& reset)
+{
+    QList<Sample> samples;
+    for (int i = 0; i < m_config.iterations; ++i) {
+        if (reset) {
+            reset();
+            QCoreApplication::processEvents();
+        }
+        samples.append(sampleInteraction(action));
+    }
+    record(name, samples);
+}
+
+void GuiHarness::typeText(const QString& name, QWidget* target, const QString& text)
+{
+    QLineEdit* edit = qobject_cast<QLineEdit*>(target);
+    if (!edit) {
+        qWarning() << "Champ introuvable pour" << name;
+        return;
+    }
+
+    QList<Sample> samples;
+    for (int i = 0; i < m_config.iterations; ++i) {
+        // Remise à zéro hors mesure (elle déclenche elle-même une recherche)
+        edit->clear();
+        edit->setFocus();
+        QCoreApplication::processEvents();
+
+        for (const QChar character : text) {
+            samples.append(sampleInteraction([edit, character]() {
+                sendKey(edit, character);
+            }));
+        }
+    }
+    edit->clear();
+    QCoreApplication::processEvents();
+
+    record(name, samples);
+}
+
+void GuiHarness::runClientInteractions(MainWindow& window)
+{
+    ClientView* view = window.clientView();
+    QTabWidget* tabs = window.findChild<QTabWidget*>("mainTabWidget");
+    if (!view || !tabs) {
+        qWarning() << "Vue clients introuvable";
+        return;
+    }
+    tabs->setCurrentIndex(MainWindow::TAB_CLIENTS);
+    QCoreApplication::processEvents();
+
+    repeat("clients.refresh", [view]() { view->refreshData(); });
+
+    typeText("clients.search.keystroke", view->findChild<QLineEdit*>("clientSearchNom"), "Martin");
+    typeText("clients.search.ville.keystroke", view->findChild<QLineEdit*>("clientSearchVille"), "Lyon");
+
+    if (QComboBox* sortCombo = view->findChild<QComboBox*>("clientSortCombo")) {
+        repeat("clients.sort.combo", [sortCombo]() {
+            sortCombo->setCurrentIndex((sortCombo->currentIndex() + 1) % sortCombo->count());
+        });
+    }
+
+    if (QTableWidget* table = view->findChild<QTableWidget*>("clientTable")) {
+        int column = 1;
+        repeat("clients.sort.header", [table, &column]() {
+            table->horizontalHeader()->setSortIndicator(column, Qt::AscendingOrder);
+            column = column % 5 + 1;
+        });
+    }
+}
+
+void GuiHarness::runCommandeInteractions(MainWindow& window)
+{
+    CommandeView* view = window.commandeView();
+    QTabWidget* tabs = window.findChild<QTabWidget*>("mainTabWidget");
+    if (!view || !tabs) {
+        qWarning() << "Vue commandes introuvable";
+        return;
+    }
+    tabs->setCurrentIndex(MainWindow::TAB_COMMANDES);
+    QCoreApplication::processEvents();
+
+    repeat("commandes.refresh", [view]() { view->refreshData(); });
+
+    // Recherche des commandes sur validation uniquement (pas de filtrage à la frappe)
+    QLineEdit* searchEdit = view->findChild<QLineEdit*>("commandeSearchEdit");
+
+    if (QPushButton* searchButton = view->findChild<QPushButton*>("commandeSearchButton")) {
+        repeat("commandes.search.submit", [searchButton]() {
+            searchButton->click();
+        }, [searchEdit]() {
+            if (searchEdit) {
+                searchEdit->setText("Lyon");
+            }
+        });
+        if (searchEdit) {
+            searchEdit->clear();
+            searchButton->click();
+        }
+    }
+
+    if (QComboBox* statusFilter = view->findChild<QComboBox*>("commandeStatusFilter")) {
+        repeat("commandes.filter.status", [statusFilter]() {
+            statusFilter->setCurrentIndex((statusFilter->currentIndex() + 1) % statusFilter->count());
+        });
+        statusFilter->setCurrentIndex(0);
+    }
+
+    if (QTableWidget* table = view->findChild<QTableWidget*>("commandeTable")) {
+        int column = 0;
+        repeat("commandes.sort.header", [table, &column]() {
+            table->horizontalHeader()->setSortIndicator(column, Qt::DescendingOrder);
+            column = (column + 1) % table->columnCount();
+        });
+    }
+}
+
+void GuiHarness::runStatisticsInteractions(MainWindow& window)
+{
+    QTabWidget* tabs = window.findChild<QTabWidget*>("mainTabWidget");
+    if (!tabs) {
+        qWarning() << "Vue statistiques introuvable";
+        return;
+    }
+
+    // Première activation : construction de la vue et chargement différé de ses données
+    QElapsedTimer activationTimer;
+    activationTimer.start();
+    tabs->setCurrentIndex(MainWindow::TAB_STATISTIQUES);
+    QCoreApplication::processEvents();
+    Sample activation;
+    activation.wallMs = activationTimer.nsecsElapsed() / 1.0e6;
+    activation.stallMs = activation.wallMs;
+    record("statistics.first_activation", {activation});
+
+    StatisticsView* view = window.statisticsView();
+
+    repeat("statistics.refresh", [view]() { view->refreshData(); });
+}
+
+void GuiHarness::runTabInteractions(MainWindow& window)
+{
+    QTabWidget* tabs = window.findChild<QTabWidget*>("mainTabWidget");
+    if (!tabs) {
+        return;
+    }
+
+    repeat("tab.switch", [tabs]() {
+        tabs->setCurrentIndex((tabs->currentIndex() + 1) % tabs->count());
+    });
+}
+
+void GuiHarness::record(const QString& name, const QList<Sample>& samples)
+{
+    if (samples.isEmpty()) {
+        return;
+    }
+
+    QList<double> wall;
+    QList<double> allocations;
+    Result result;
+    result.name = name;
+    result.samples = samples.size();
+
+    for (const Sample& sample : samples) {
+        wall.append(sample.wallMs);
+        allocations.append(sample.allocations);
+        result.maxStallMs = qMax(result.maxStallMs, sample.stallMs);
+    }
+
+    result.medianMs = percentileOf(wall, 50);
+    result.p95Ms = percentileOf(wall, 95);
+    result.maxMs = *std::max_element(wall.begin(), wall.end());
+    result.allocations = AllocationCounter::isAvailable()
+                             ? static_cast<qint64>(percentileOf(allocations, 50)) : -1;
+    result.budgetMs = m_config.budgetsMs.value(name, 0.0);
+    result.withinBudget = result.budgetMs <= 0.0 || result.p95Ms <= result.budgetMs;
+
+    m_results.append(result);
+}
+
+void GuiHarness::printSummary() const
+{
+    const bool countingAllocations = AllocationCounter::isAvailable();
+    if (!countingAllocations) {
+        std::cout << "Allocations : n/d (compiler avec LOGISTICS_COUNT_ALLOCATIONS)" << std::endl;
+    }
+
+    std::cout << QString("%1 %2 %3 %4 %5 %6 %7")
+                     .arg("Interaction", -34).arg("médiane ms", 11).arg("p95 ms", 9)
+                     .arg("max ms", 9).arg("blocage ms", 11).arg("allocs", 9).arg("budget", 12)
+                     .toStdString() << std::endl;
+
+    for (const Result& result : m_results) {
+        const QString budget = result.budgetMs > 0.0
+            ? QString("%1 %2").arg(result.budgetMs, 0, 'f', 0).arg(result.withinBudget ? "OK" : "DÉPASSÉ")
+            : QString("-");
+        std::cout << QString("%1 %2 %3 %4 %5 %6 %7")
+                         .arg(result.name, -34)
+                         .arg(result.medianMs, 11, 'f', 2)
+                         .arg(result.p95Ms, 9, 'f', 2)
+                         .arg(result.maxMs, 9, 'f', 2)
+                         .arg(result.maxStallMs, 11, 'f', 2)
+                         .arg(countingAllocations ? QString::number(result.allocations) : QString("n/d"), 9)
+                         .arg(budget, 12)
+                         .toStdString() << std::endl;
+    }
+}
+
+bool GuiHarness::writeJson(const QString& filePath) const
+{
+    QJsonArray results;
+    for (const Result& result : m_results) {
+        QJsonObject entry;
+        entry["name"] = result.name;
+        entry["samples"] = result.samples;
+        entry["medianMs"] = result.medianMs;
+        entry["p95Ms"] = result.p95Ms;
+        entry["maxMs"] = result.maxMs;
+        entry["maxStallMs"] = result.maxStallMs;
+        // null lorsque le comptage des allocations n'est pas compilé
+        entry["allocations"] = AllocationCounter::isAvailable() ? QJsonValue(result.allocations) : QJsonValue();
+        entry["budgetMs"] = result.budgetMs;
+        entry["withinBudget"] = result.withinBudget;
+        results.append(entry);
+    }
+
+    QJsonObject root;
+    root["schemaVersion"] = 1;
+    root["timestamp"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    root["commit"] = qEnvironmentVariable("GIT_COMMIT");
+    root["qtVersion"] = QString(qVersion());
+    root["platform"] = QGuiApplication::platformName();
+    root["iterations"] = m_config.iterations;
+    root["results"] = results;
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qCritical() << "Impossible d'écrire les résultats:" << filePath << file.errorString();
+        return false;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Indented));
+    qInfo() << "Résultats écrits dans" << filePath;
+    return true;
+}
@@ -0,0 +1,99 @@
+#ifndef GUIHARNESS_H
+#define GUIHARNESS_H
+
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QMap>
+#include <functional>
+
+class MainWindow;
+class QWidget;
+
+/**
+ * @brief Banc d'essai de l'interface, exécutable sans affichage (QPA offscreen)
+ *
+ * Lancé par `LogisticsApp --gui-benchmark`, il construit MainWindow sur la
+ * base générée du banc d'essai puis rejoue des interactions : actualisation
+ * des vues, frappe dans les champs de recherche, tris, changements d'onglet.
+ * Pour chaque interaction sont relevés le temps jusqu'au retour au repos de la
+ * boucle d'événements, le plus long blocage de cette boucle (mesuré par un
+ * battement de 1 ms) et le nombre d'allocations (voir AllocationCounter).
+ *
+ * Chaque interaction peut avoir un budget en millisecondes ; le code de
+ * sortie est non nul si un p95 dépasse son budget.
+ *
+ * Options : --gui-iterations <n>, --gui-output <fichier.json>,
+ * --gui-budget <interaction>=<ms> (répétable)
+ */
+class GuiHarness
+{
+public:
+    struct Config {
+        int iterations = 5;
+        QString outputPath = "gui-benchmark-results.json";
+        QMap<QString, double> budgetsMs;    // Interaction -> budget (p95)
+    };
+
+    struct Sample {
+        double wallMs = 0.0;
+        double stallMs = 0.0;
+        qint64 allocations = 0;
+    };
+
+    struct Result {
+        QString name;
+        int samples = 0;
+        double medianMs = 0.0;
+        double p95Ms = 0.0;
+        double maxMs = 0.0;
+        double maxStallMs = 0.0;
+        qint64 allocations = -1;            // Médiane ; -1 si non disponible
+        double budgetMs = 0.0;              // 0 : pas de budget
+        bool withinBudget = true;
+    };
+
+    /**
+     * @brief Construit la configuration (budgets par défaut inclus)
+     * @param arguments Arguments de l'application
+     */
+    static Config configFromArguments(const QStringList& arguments);
+
+    explicit GuiHarness(const Config& config);
+
+    /**
+     * @brief Construit la fenêtre principale et rejoue les interactions
+     * @return Code de sortie (0 si tous les budgets sont respectés)
+     */
+    int run();
+
+    QList<Result> results() const { return m_results; }
+
+private:
+    /**
+     * @brief Exécute une interaction depuis la boucle d'événements
+     *
+     * La mesure court du début de l'action jusqu'au premier retour au repos
+     * de la boucle (événements postés et repeints traités).
+     */
+    Sample sampleInteraction(const std::function<void()>& action);
+
+    void record(const QString& name, const QList<Sample>& samples);
+    void repeat(const QString& name, const std::function<void()>& action,
+                const std::function<void()>& reset = nullptr);
+    void typeText(const QString& name, QWidget* target, const QString& text);
+
+    void runClientInteractions(MainWindow& window);
+    void runCommandeInteractions(MainWindow& window);
+    void runStatisticsInteractions(MainWindow& window);
+    void runTabInteractions(MainWindow& window);
+
+    void printSummary() const;
+    bool writeJson(const QString& filePath) const;
+
+private:
+    Config m_config;
+    QList<Result> m_results;
+};
+
+#endif // GUIHARNESS_H
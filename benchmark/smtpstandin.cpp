@@ -0,0 +1,205 @@
+#include "smtpstandin.h"
+#include <QCoreApplication>
+#include <QTcpSocket>
+#include <QHostAddress>
+#include <QDir>
+#include <QFile>
+#include <QDebug>
+#include <iostream>
+
+SmtpStandIn::SmtpStandIn(QObject *parent)
+    : QObject(parent)
+    , m_failEvery(0)
+    , m_recipientCount(0)
+    , m_messagesReceived(0)
+    , m_recipientsRejected(0)
+{
+    connect(&m_server, &QTcpServer::newConnection, this, &SmtpStandIn::onNewConnection);
+}
+
+bool SmtpStandIn::listen(quint16 port)
+{
+    if (!m_server.listen(QHostAddress::LocalHost, port)) {
+        qWarning() << "SmtpStandIn: écoute impossible sur le port" << port << m_server.errorString();
+        return false;
+    }
+    return true;
+}
+
+quint16 SmtpStandIn::port() const
+{
+    return m_server.serverPort();
+}
+
+void SmtpStandIn::setOutputDirectory(const QString& directory)
+{
+    m_outputDirectory = directory;
+    if (!directory.isEmpty()) {
+        QDir().mkpath(directory);
+    }
+}
+
+void SmtpStandIn::setTemporaryFailureEvery(int every)
+{
+    m_failEvery = qMax(0, every);
+}
+
+int SmtpStandIn::runFromArguments(const QStringList& arguments)
+{
+    const int index = arguments.indexOf("--smtp-standin");
+    quint16 port = 2525;
+    if (index >= 0 && index + 1 < arguments.size() && !arguments.at(index + 1).startsWith("--")) {
+        port = static_cast<quint16>(arguments.at(index + 1).toUInt());
+    }
+
+    SmtpStandIn server;
+    const int dirIndex = arguments.indexOf("--smtp-standin-dir");
+    if (dirIndex >= 0 && dirIndex + 1 < arguments.size()) {
+        server.setOutputDirectory(arguments.at(dirIndex + 1));
+    }
+    const int failIndex = arguments.indexOf("--smtp-standin-fail");
+    if (failIndex >= 0 && failIndex + 1 < arguments.size()) {
+        server.setTemporaryFailureEvery(arguments.at(failIndex + 1).toInt());
+    }
+
+    if (!server.listen(port)) {
+        return -1;
+    }
+
+    std::cout << "Serveur SMTP local en écoute sur 127.0.0.1:" << server.port() << std::endl;
+    connect(&server, &SmtpStandIn::messageReceived, [&server](const QString& from, const QString& to, int size) {
+        std::cout << "#" << server.messagesReceived() << " " << from.toStdString()
+                  << " -> " << to.toStdString() << " (" << size << " octets)" << std::endl;
+    });
+    return QCoreApplication::exec();
+}
+
+void SmtpStandIn::onNewConnection()
+{
+    while (QTcpSocket* socket = m_server.nextPendingConnection()) {
+        m_sessions.insert(socket, Session());
+        connect(socket, &QTcpSocket::readyRead, this, &SmtpStandIn::onReadyRead);
+        connect(socket, &QTcpSocket::disconnected, this, &SmtpStandIn::onDisconnected);
+        reply(socket, "220 localhost ESMTP stand-in");
+    }
+}
+
+void SmtpStandIn::onReadyRead()
+{
+    QTcpSocket* socket = qobject_cast<QTcpSocket*>(sender());
+    if (!socket || !m_sessions.contains(socket)) {
+        return;
+    }
+
+    // Les commandes en rafale (PIPELINING) sont traitées ligne par ligne
+    while (socket->canReadLine()) {
+        handleLine(socket, m_sessions[socket], socket->readLine());
+    }
+}
+
+void SmtpStandIn::onDisconnected()
+{
+    QTcpSocket* socket = qobject_cast<QTcpSocket*>(sender());
+    if (socket) {
+        m_sessions.remove(socket);
+        socket->deleteLater();
+    }
+}
+
+void SmtpStandIn::handleLine(QTcpSocket* socket, Session& session, const QByteArray& rawLine)
+{
+    if (session.inData) {
+        if (rawLine == ".\r\n" || rawLine == ".\n") {
+            finishMessage(socket, session);
+        } else {
+            // Transparence des points : ".." en début de ligne devient "."
+            session.data += rawLine.startsWith("..") ? rawLine.mid(1) : rawLine;
+        }
+        return;
+    }
+
+    const QByteArray line = rawLine.trimmed();
+
+    if (session.authStep > 0) {
+        reply(socket, ++session.authStep > 2 ? "235 Authentication successful" : "334 UGFzc3dvcmQ6");
+        if (session.authStep > 2) {
+            session.authStep = 0;
+        }
+        return;
+    }
+
+    const QByteArray verb = line.section(' ', 0, 0).toUpper();
+    const QString argument = QString::fromUtf8(line.mid(verb.size())).trimmed();
+
+    if (verb == "EHLO") {
+        socket->write("250-localhost\r\n250-PIPELINING\r\n250-8BITMIME\r\n"
+                      "250-AUTH PLAIN LOGIN\r\n250 SIZE 10485760\r\n");
+    } else if (verb == "HELO") {
+        reply(socket, "250 localhost");
+    } else if (verb == "AUTH") {
+        if (argument.startsWith("LOGIN", Qt::CaseInsensitive)) {
+            session.authStep = 1;
+            reply(socket, "334 VXNlcm5hbWU6");
+        } else {
+            reply(socket, "235 Authentication successful");
+        }
+    } else if (verb == "MAIL") {
+        session.from = argument.section('<', 1).section('>', 0, 0);
+        session.recipientAccepted = false;
+        reply(socket, "250 OK");
+    } else if (verb == "RCPT") {
+        session.to = argument.section('<', 1).section('>', 0, 0);
+        ++m_recipientCount;
+        if (m_failEvery > 0 && m_recipientCount % m_failEvery == 0) {
+            ++m_recipientsRejected;
+            reply(socket, "451 4.3.0 Temporary failure (stand-in)");
+        } else {
+            session.recipientAccepted = true;
+            reply(socket, "250 OK");
+        }
+    } else if (verb == "DATA") {
+        if (!session.recipientAccepted) {
+            reply(socket, "554 No valid recipients");
+        } else {
+            session.inData = true;
+            session.data.clear();
+            reply(socket, "354 End data with <CR><LF>.<CR><LF>");
+        }
+    } else if (verb == "RSET") {
+        session = Session();
+        reply(socket, "250 OK");
+    } else if (verb == "NOOP") {
+        reply(socket, "250 OK");
+    } else if (verb == "STARTTLS") {
+        reply(socket, "454 TLS not available");
+    } else if (verb == "QUIT") {
+        reply(socket, "221 Bye");
+        socket->disconnectFromHost();
+    } else {
+        reply(socket, "502 Command not implemented");
+    }
+}
+
+void SmtpStandIn::finishMessage(QTcpSocket* socket, Session& session)
+{
+    ++m_messagesReceived;
+
+    if (!m_outputDirectory.isEmpty()) {
+        QFile file(QDir(m_outputDirectory).filePath(QString("message-%1.eml").arg(m_messagesReceived, 6, 10, QChar('0'))));
+        if (file.open(QIODevice::WriteOnly)) {
+            file.write(session.data);
+        }
+    }
+
+    emit messageReceived(session.from, session.to, session.data.size());
+
+    session.inData = false;
+    session.recipientAccepted = false;
+    session.data.clear();
+    reply(socket, "250 OK queued");
+}
+
+void SmtpStandIn::reply(QTcpSocket* socket, const QByteArray& line)
+{
+    socket->write(line + "\r\n");
+}
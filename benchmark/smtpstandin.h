@@ -0,0 +1,81 @@
+#ifndef SMTPSTANDIN_H
+#define SMTPSTANDIN_H
+
+#include <QObject>
+#include <QString>
+#include <QHash>
+#include <QTcpServer>
+
+class QTcpSocket;
+
+/**
+ * @brief Serveur SMTP local minimal pour tester la file d'envoi
+ *
+ * Lancé par `LogisticsApp --smtp-standin [port]` (port 2525 par défaut), il
+ * accepte toute session (EHLO avec PIPELINING, AUTH sans vérification), gère
+ * les commandes en rafale et compte les messages reçus. Options :
+ * --smtp-standin-dir <dossier> enregistre chaque message en .eml,
+ * --smtp-standin-fail <n> refuse temporairement (451) un destinataire sur n
+ * pour exercer les nouvelles tentatives.
+ */
+class SmtpStandIn : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit SmtpStandIn(QObject *parent = nullptr);
+
+    /**
+     * @brief Écoute sur localhost
+     * @param port Port TCP (0 : port libre choisi par le système)
+     * @return true si le serveur écoute
+     */
+    bool listen(quint16 port = 2525);
+    quint16 port() const;
+
+    void setOutputDirectory(const QString& directory);
+    void setTemporaryFailureEvery(int every);
+
+    int messagesReceived() const { return m_messagesReceived; }
+    int recipientsRejected() const { return m_recipientsRejected; }
+
+    /**
+     * @brief Mode ligne de commande : écoute jusqu'à l'arrêt du processus
+     * @param arguments Arguments de l'application
+     * @return Code de sortie
+     */
+    static int runFromArguments(const QStringList& arguments);
+
+signals:
+    void messageReceived(const QString& from, const QString& to, int size);
+
+private slots:
+    void onNewConnection();
+    void onReadyRead();
+    void onDisconnected();
+
+private:
+    struct Session {
+        QString from;
+        QString to;
+        bool recipientAccepted = false;
+        bool inData = false;
+        int authStep = 0;               // AUTH LOGIN : identifiant puis mot de passe
+        QByteArray data;
+    };
+
+    void handleLine(QTcpSocket* socket, Session& session, const QByteArray& line);
+    void finishMessage(QTcpSocket* socket, Session& session);
+    static void reply(QTcpSocket* socket, const QByteArray& line);
+
+private:
+    QTcpServer m_server;
+    QHash<QTcpSocket*, Session> m_sessions;
+    QString m_outputDirectory;
+    int m_failEvery;
+    int m_recipientCount;
+    int m_messagesReceived;
+    int m_recipientsRejected;
+};
+
+#endif // SMTPSTANDIN_H
@@ -1,6 +1,7 @@
 #include "clientcontroller.h"
 #include "models/commande.h"
 #include "utils/validator.h"
+#include "utils/tracer.h"
 #include <QDebug>
 #include <QMap>
 
@@ -20,6 +21,7 @@ Client* ClientController::createClient(const QString& nom, const QString& prenom
                                       const QString& telephone, const QString& adresse, const QString& ville,
                                       const QString& codePostal, Client::Statut statut)
 {
+    TRACE_SPAN("controller", "ClientController::createClient");
     try {
         qDebug() << "Creating client:" << nom << prenom << email;
 
@@ -94,6 +96,7 @@ Client* ClientController::createClient(const QString& nom, const QString& prenom
 
 bool ClientController::updateClient(Client* client)
 {
+    TRACE_SPAN("controller", "ClientController::updateClient");
     if (!client) {
         emit errorOccurred("Client invalide");
         return false;
@@ -131,6 +134,7 @@ bool ClientController::updateClient(Client* client)
 
 bool ClientController::deleteClient(int clientId)
 {
+    TRACE_SPAN("controller", "ClientController::deleteClient");
     if (clientId <= 0) {
         emit errorOccurred("ID de client invalide");
         return false;
@@ -180,6 +184,7 @@ Client* ClientController::getClient(int clientId)
 
 QList<Client*> ClientController::getAllClients()
 {
+    TRACE_SPAN("controller", "ClientController::getAllClients");
     if (!m_cacheValid) {
         cleanupClients(m_cachedClients);
         m_cachedClients = Client::findAll();
@@ -193,6 +198,7 @@ QList<Client*> ClientController::getAllClients()
 // Opérations de recherche et tri
 QList<Client*> ClientController::searchClients(const SearchCriteria& criteria)
 {
+    TRACE_SPAN("controller", "ClientController::searchClients");
     if (!validateSearchCriteria(criteria)) {
         emit errorOccurred("Critères de recherche invalides");
         return QList<Client*>();
@@ -213,6 +219,7 @@ void ClientController::sortClients(QList<Client*>& clients, const SortCriteria&
 QList<Client*> ClientController::searchAndSortClients(const SearchCriteria& searchCriteria, 
                                                      const SortCriteria& sortCriteria)
 {
+    TRACE_SPAN("controller", "ClientController::searchAndSortClients");
     QList<Client*> clients = searchClients(searchCriteria);
     sortClients(clients, sortCriteria);
     return clients;
@@ -346,22 +353,8 @@ int ClientController::getClientOrdersCount(int clientId)
 bool ClientController::canDeleteClient(int clientId)
 {
     // Un client peut être supprimé s'il n'a pas de commandes actives
-    QList<Commande*> commandes = Commande::findByClient(clientId);
-
-    bool canDelete = true;
-    for (Commande* commande : commandes) {
-        if (commande->statut() != Commande::LIVREE && commande->statut() != Commande::ANNULEE) {
-            canDelete = false;
-            break;
-        }
-    }
-
-    // Nettoyage de la mémoire
-    for (Commande* commande : commandes) {
-        delete commande;
-    }
-
-    return canDelete;
+    // (un échec de la requête renvoie -1 et bloque la suppression)
+    return Commande::countActivesByClient(clientId) == 0;
 }
 
 // Méthodes privées
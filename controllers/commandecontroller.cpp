@@ -4,6 +4,8 @@
 #include <QDebug>
 #include <QSqlQuery>
 #include "database/databasemanager.h"
+#include "database/queryprofiler.h"
+#include "utils/tracer.h"
 
 CommandeController::CommandeController(QObject *parent)
     : QObject(parent)
@@ -23,6 +25,7 @@ Commande* CommandeController::createCommande(int idClient, const QDate& dateLivr
                                             double poidsTotal, double volumeTotal, double prixTotal,
                                             const QString& commentaires)
 {
+    TRACE_SPAN("controller", "CommandeController::createCommande");
     // Validation des données
     QStringList errors = validateCommandeData(idClient, QDate::currentDate(), dateLivraisonPrevue,
                                              adresseLivraison, villeLivraison, codePostalLivraison,
@@ -87,6 +90,7 @@ Commande* CommandeController::createCommande(int idClient, const QDate& dateLivr
 
 bool CommandeController::updateCommande(Commande* commande)
 {
+    TRACE_SPAN("controller", "CommandeController::updateCommande");
     if (!commande) {
         emit errorOccurred("Commande invalide");
         return false;
@@ -125,6 +129,7 @@ bool CommandeController::updateCommande(Commande* commande)
 
 bool CommandeController::deleteCommande(int commandeId)
 {
+    TRACE_SPAN("controller", "CommandeController::deleteCommande");
     if (commandeId <= 0) {
         emit errorOccurred("ID de commande invalide");
         return false;
@@ -174,6 +179,7 @@ Commande* CommandeController::getCommande(int commandeId)
 
 QList<Commande*> CommandeController::getAllCommandes()
 {
+    TRACE_SPAN("controller", "CommandeController::getAllCommandes");
     if (!m_cacheValid) {
         cleanupCommandes(m_cachedCommandes);
         m_cachedCommandes = Commande::findAll();
@@ -196,6 +202,7 @@ QList<Commande*> CommandeController::getCommandesByClient(int clientId)
 // Opérations de recherche et tri
 QList<Commande*> CommandeController::searchCommandes(const SearchCriteria& criteria)
 {
+    TRACE_SPAN("controller", "CommandeController::searchCommandes");
     if (!validateSearchCriteria(criteria)) {
         emit errorOccurred("Critères de recherche invalides");
         return QList<Commande*>();
@@ -217,6 +224,7 @@ void CommandeController::sortCommandes(QList<Commande*>& commandes, const SortCr
 QList<Commande*> CommandeController::searchAndSortCommandes(const SearchCriteria& searchCriteria, 
                                                            const SortCriteria& sortCriteria)
 {
+    TRACE_SPAN("controller", "CommandeController::searchAndSortCommandes");
     QList<Commande*> commandes = searchCommandes(searchCriteria);
     sortCommandes(commandes, sortCriteria);
     return commandes;
@@ -236,6 +244,7 @@ QStringList CommandeController::validateCommandeData(int idClient, const QDate&
 // Gestion des statuts
 bool CommandeController::changeStatutCommande(int commandeId, Commande::Statut nouveauStatut)
 {
+    TRACE_SPAN("controller", "CommandeController::changeStatutCommande");
     Commande* commande = Commande::findById(commandeId);
     if (!commande) {
         emit errorOccurred("Commande non trouvée");
@@ -374,7 +383,8 @@ QMap<int, int> CommandeController::getStatistiquesParMois(int annee)
     DatabaseManager& db = DatabaseManager::instance();
     QSqlQuery query = db.prepareQuery(R"(
         SELECT EXTRACT(MONTH FROM DATE_COMMANDE) as MOIS, COUNT(*) as NOMBRE
-        FROM COMMANDES
+        FROM (SELECT DATE_COMMANDE FROM COMMANDES
+              UNION ALL SELECT DATE_COMMANDE FROM COMMANDES_ARCHIVE)
         WHERE EXTRACT(YEAR FROM DATE_COMMANDE) = ?
         GROUP BY EXTRACT(MONTH FROM DATE_COMMANDE)
         ORDER BY MOIS
@@ -386,20 +396,51 @@ QMap<int, int> CommandeController::getStatistiquesParMois(int annee)
             int nombre = query.value("NOMBRE").toInt();
             stats[mois] = nombre;
         }
+        QueryProfiler::instance().addRows(query.lastQuery(), stats.size());
     }
 
     return stats;
 }
 
+QMap<QDate, int> CommandeController::getVolumeParJour()
+{
+    QMap<QDate, int> volume;
+
+    DatabaseManager& db = DatabaseManager::instance();
+    QSqlQuery query = db.prepareQuery(R"(
+        SELECT DATE_COMMANDE, COUNT(*) as NOMBRE
+        FROM (SELECT DATE_COMMANDE FROM COMMANDES
+              UNION ALL SELECT DATE_COMMANDE FROM COMMANDES_ARCHIVE)
+        WHERE DATE_COMMANDE IS NOT NULL
+        GROUP BY DATE_COMMANDE
+    )");
+
+    if (db.executeQuery(query)) {
+        int rows = 0;
+        while (query.next()) {
+            ++rows;
+            const QDate date = query.value(0).toDate();
+            if (date.isValid()) {
+                volume[date] += query.value(1).toInt();
+            }
+        }
+        QueryProfiler::instance().addRows(query.lastQuery(), rows);
+    }
+
+    return volume;
+}
+
 // Fonctionnalités métier supplémentaires
 double CommandeController::getDelaiMoyenLivraison()
 {
     DatabaseManager& db = DatabaseManager::instance();
     QSqlQuery query = db.prepareQuery(R"(
         SELECT AVG(DATE_LIVRAISON_REELLE - DATE_COMMANDE) as DELAI_MOYEN
-        FROM COMMANDES
-        WHERE STATUT = 'LIVREE'
-          AND DATE_LIVRAISON_REELLE IS NOT NULL
+        FROM (SELECT DATE_LIVRAISON_REELLE, DATE_COMMANDE FROM COMMANDES
+              WHERE STATUT = 'LIVREE' AND DATE_LIVRAISON_REELLE IS NOT NULL
+              UNION ALL
+              SELECT DATE_LIVRAISON_REELLE, DATE_COMMANDE FROM COMMANDES_ARCHIVE
+              WHERE STATUT = 'LIVREE' AND DATE_LIVRAISON_REELLE IS NOT NULL)
     )");
 
     if (db.executeQuery(query) && query.next()) {
@@ -436,8 +477,9 @@ bool CommandeController::canModifyCommande(int commandeId)
         return false;
     }
 
-    // Une commande peut être modifiée si elle n'est pas livrée ou annulée
-    bool canModify = (commande->statut() != Commande::LIVREE &&
+    // Une commande peut être modifiée si elle n'est pas livrée, annulée ou archivée
+    bool canModify = (!commande->estArchivee() &&
+                     commande->statut() != Commande::LIVREE &&
                      commande->statut() != Commande::ANNULEE);
 
     delete commande;
@@ -451,9 +493,10 @@ bool CommandeController::canDeleteCommande(int commandeId)
         return false;
     }
 
-    // Une commande peut être supprimée si elle est en attente ou annulée
-    bool canDelete = (commande->statut() == Commande::EN_ATTENTE ||
-                     commande->statut() == Commande::ANNULEE);
+    // Une commande peut être supprimée si elle est en attente ou annulée, et non archivée
+    bool canDelete = (!commande->estArchivee() &&
+                     (commande->statut() == Commande::EN_ATTENTE ||
+                      commande->statut() == Commande::ANNULEE));
 
     delete commande;
     return canDelete;
@@ -216,6 +216,12 @@ public:
      * @return Map mois -> nombre de commandes
      */
     QMap<int, int> getStatistiquesParMois(int annee = QDate::currentDate().year());
+
+    /**
+     * @brief Nombre de commandes par jour sur tout l'historique (archive incluse)
+     * @return Map date de commande -> nombre de commandes
+     */
+    QMap<QDate, int> getVolumeParJour();
     
     // Fonctionnalités métier supplémentaires
     /**
@@ -0,0 +1,340 @@
+#include "remindercampaign.h"
+#include "database/databasemanager.h"
+#include "database/queryprofiler.h"
+#include "utils/emailmanager.h"
+#include "utils/emailoutbox.h"
+#include <QSqlQuery>
+#include <QThread>
+#include <QThreadPool>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QTimer>
+#include <QFile>
+#include <QTextStream>
+#include <QDebug>
+#include <vector>
+
+namespace {
+
+int intOption(const QStringList& arguments, const QString& name, int defaultValue)
+{
+    const int index = arguments.indexOf(name);
+    if (index < 0 || index + 1 >= arguments.size()) {
+        return defaultValue;
+    }
+    bool ok = false;
+    const int value = arguments.at(index + 1).toInt(&ok);
+    return ok ? value : defaultValue;
+}
+
+} // namespace
+
+ReminderCampaign::Config ReminderCampaign::configFromArguments(const QStringList& arguments)
+{
+    Config config;
+
+    const int index = arguments.indexOf("--reminders");
+    if (index >= 0 && index + 1 < arguments.size()) {
+        const QDate date = QDate::fromString(arguments.at(index + 1), Qt::ISODate);
+        if (date.isValid()) {
+            config.dateLivraison = date;
+        }
+    }
+
+    config.batchSize = qMax(1, intOption(arguments, "--reminders-batch", config.batchSize));
+    config.maxPerSecond = qMax(0, intOption(arguments, "--reminders-rate", config.maxPerSecond));
+    config.deliver = arguments.contains("--reminders-deliver");
+
+    const int reportIndex = arguments.indexOf("--reminders-report");
+    if (reportIndex >= 0 && reportIndex + 1 < arguments.size()) {
+        config.reportPath = arguments.at(reportIndex + 1);
+    }
+    return config;
+}
+
+ReminderCampaign::ReminderCampaign(const Config& config)
+    : m_config(config)
+{
+}
+
+bool ReminderCampaign::run()
+{
+    m_report = Report();
+    m_lastError.clear();
+
+    QElapsedTimer total;
+    total.start();
+
+    // 1. Sélection : une seule requête pour les commandes et leurs destinataires
+    QElapsedTimer step;
+    step.start();
+    QList<Row> rows;
+    if (!selectRows(rows)) {
+        qWarning() << "Campagne de rappels: sélection impossible:" << m_lastError;
+        return false;
+    }
+    m_report.selected = rows.size();
+    m_report.selectMs = step.elapsed();
+
+    // 2. Rendu parallèle : chaque tâche remplit sa tranche, sans verrou
+    step.restart();
+    std::vector<OutboxEmail> emails(rows.size());
+    std::vector<char> valid(rows.size(), 0);
+    {
+        const int threads = m_config.threads > 0 ? m_config.threads : QThread::idealThreadCount();
+        const int sliceSize = (rows.size() + threads - 1) / qMax(1, threads);
+        const Row* input = rows.constData();
+        OutboxEmail* output = emails.data();
+        char* validOutput = valid.data();
+
+        QThreadPool pool;
+        pool.setMaxThreadCount(qMax(1, threads));
+        for (int begin = 0; begin < rows.size(); begin += sliceSize) {
+            const int end = qMin(begin + sliceSize, static_cast<int>(rows.size()));
+            pool.start([input, output, validOutput, begin, end]() {
+                for (int i = begin; i < end; ++i) {
+                    const Row& row = input[i];
+                    if (!EmailManager::isValidEmail(row.email)) {
+                        continue;
+                    }
+                    OutboxEmail& email = output[i];
+                    email.to = row.email;
+                    email.subject = EmailManager::reminderSubject(row.numeroCommande);
+                    email.htmlBody = EmailManager::reminderHtml(row.numeroCommande, row.prenom,
+                                                                row.nom, row.dateLivraison);
+                    email.dedupKey = EmailManager::reminderDedupKey(row.idCommande, row.dateLivraison);
+                    validOutput[i] = 1;
+                }
+            });
+        }
+        pool.waitForDone();
+    }
+    m_report.renderMs = step.elapsed();
+
+    // 3. Mise en file par lots (une transaction par lot)
+    step.restart();
+
+    m_report.recipients.reserve(rows.size());
+    for (const Row& row : rows) {
+        Recipient recipient;
+        recipient.idCommande = row.idCommande;
+        recipient.numeroCommande = row.numeroCommande;
+        recipient.email = row.email;
+        recipient.dedupKey = EmailManager::reminderDedupKey(row.idCommande, row.dateLivraison);
+        recipient.outcome = ADRESSE_INVALIDE;
+        m_report.recipients.append(recipient);
+    }
+
+    QList<OutboxEmail> batch;
+    QList<int> batchRows;
+    batch.reserve(m_config.batchSize);
+    batchRows.reserve(m_config.batchSize);
+
+    auto flush = [&]() {
+        QList<EmailOutbox::EnqueueResult> results;
+        EmailOutbox::instance().enqueueBatch(batch, nullptr, &results);
+        for (int i = 0; i < batchRows.size(); ++i) {
+            Recipient& recipient = m_report.recipients[batchRows.at(i)];
+            switch (i < results.size() ? results.at(i) : EmailOutbox::ERREUR) {
+                case EmailOutbox::QUEUED: recipient.outcome = EN_FILE; break;
+                case EmailOutbox::DUPLICATE: recipient.outcome = DEJA_EN_FILE; break;
+                case EmailOutbox::ERREUR: recipient.outcome = ERREUR; break;
+            }
+        }
+        batch.clear();
+        batchRows.clear();
+    };
+
+    for (int i = 0; i < rows.size(); ++i) {
+        if (!valid[i]) {
+            continue;
+        }
+        batch.append(std::move(emails[i]));
+        batchRows.append(i);
+        if (batch.size() >= m_config.batchSize) {
+            flush();
+        }
+    }
+    if (!batch.isEmpty()) {
+        flush();
+    }
+    m_report.enqueueMs = step.elapsed();
+
+    for (const Recipient& recipient : m_report.recipients) {
+        switch (recipient.outcome) {
+            case EN_FILE: ++m_report.queued; break;
+            case DEJA_EN_FILE: ++m_report.duplicates; break;
+            case ADRESSE_INVALIDE: ++m_report.invalid; break;
+            case ERREUR: ++m_report.failed; break;
+            case ENVOYE:
+            case ECHEC_ENVOI: break;
+        }
+    }
+
+    m_report.totalMs = total.elapsed();
+    m_report.messagesPerSecond = m_report.totalMs > 0 ? m_report.queued * 1000.0 / m_report.totalMs : 0.0;
+
+    qInfo().noquote() << QString("Campagne de rappels du %1: %2 commandes, %3 en file, %4 déjà en file, "
+                                 "%5 adresses invalides, %6 erreurs")
+                             .arg(m_config.dateLivraison.toString(Qt::ISODate))
+                             .arg(m_report.selected).arg(m_report.queued).arg(m_report.duplicates)
+                             .arg(m_report.invalid).arg(m_report.failed);
+    qInfo().noquote() << QString("Sélection %1 ms, rendu %2 ms, mise en file %3 ms, total %4 ms (%5 messages/s)")
+                             .arg(m_report.selectMs).arg(m_report.renderMs).arg(m_report.enqueueMs)
+                             .arg(m_report.totalMs).arg(m_report.messagesPerSecond, 0, 'f', 0);
+
+    if (!m_config.reportPath.isEmpty()) {
+        writeReport(m_config.reportPath);
+    }
+
+    if (m_report.failed > 0) {
+        m_lastError = EmailOutbox::instance().lastError();
+        return false;
+    }
+    return true;
+}
+
+bool ReminderCampaign::deliver(int timeoutSec)
+{
+    EmailOutbox& outbox = EmailOutbox::instance();
+    outbox.setRateLimit(m_config.maxPerSecond);
+
+    // Messages de la campagne présents dans la file (mis en file par ce run ou un précédent)
+    QStringList keys;
+    for (const Recipient& recipient : m_report.recipients) {
+        if (recipient.outcome == EN_FILE || recipient.outcome == DEJA_EN_FILE) {
+            keys << recipient.dedupKey;
+        }
+    }
+
+    const bool wasRunning = outbox.isRunning();
+    outbox.start(1000);
+
+    // Attente active sur la boucle d'événements : la file est vidée par son thread
+    QEventLoop loop;
+    QTimer poll;
+    QElapsedTimer elapsed;
+    elapsed.start();
+    bool drained = keys.isEmpty();
+    QHash<QString, QString> statuses;
+
+    QObject::connect(&poll, &QTimer::timeout, [&]() {
+        statuses = outbox.statusByDedupKey(keys);
+        int pending = 0;
+        for (const QString& key : keys) {
+            const QString statut = statuses.value(key);
+            if (statut == "EN_ATTENTE" || statut == "EN_COURS") {
+                ++pending;
+            }
+        }
+        drained = !statuses.isEmpty() && pending == 0;
+        if (drained || elapsed.elapsed() > timeoutSec * 1000LL) {
+            loop.quit();
+        }
+    });
+    QObject::connect(&outbox, &EmailOutbox::batchProcessed, &loop, [](int sent, int retried, int failed) {
+        qInfo() << "Campagne de rappels: lot envoyé -" << sent << "envoyés," << retried
+                << "replanifiés," << failed << "en échec";
+    });
+
+    if (!drained) {
+        poll.start(1000);
+        loop.exec();
+    }
+
+    if (!wasRunning) {
+        outbox.stop();
+    }
+    m_report.deliverMs = elapsed.elapsed();
+
+    // Statut d'envoi réel de chaque destinataire de la campagne
+    m_report.sent = 0;
+    m_report.sendFailed = 0;
+    for (Recipient& recipient : m_report.recipients) {
+        if (recipient.outcome != EN_FILE && recipient.outcome != DEJA_EN_FILE) {
+            continue;
+        }
+        if (statuses.value(recipient.dedupKey) == "ENVOYE") {
+            recipient.outcome = ENVOYE;
+            ++m_report.sent;
+        } else {
+            recipient.outcome = ECHEC_ENVOI;
+            ++m_report.sendFailed;
+        }
+    }
+
+    qInfo().noquote() << QString("Campagne de rappels: %1 envoyés, %2 non envoyés en %3 ms")
+                             .arg(m_report.sent).arg(m_report.sendFailed).arg(m_report.deliverMs);
+
+    if (!m_config.reportPath.isEmpty()) {
+        writeReport(m_config.reportPath);
+    }
+
+    if (!drained) {
+        m_lastError = "Délai dépassé : des messages de la campagne restent en file";
+    } else if (m_report.sendFailed > 0) {
+        m_lastError = "Des messages de la campagne sont en échec définitif";
+    }
+    return drained && m_report.sendFailed == 0;
+}
+
+bool ReminderCampaign::selectRows(QList<Row>& rows)
+{
+    DatabaseManager& db = DatabaseManager::instance();
+
+    // Plage [date, date + 1[ : valable que la colonne contienne une date ou une date-heure
+    QSqlQuery query = db.prepareQuery(R"(
+        SELECT c.ID_COMMANDE, c.NUMERO_COMMANDE, c.DATE_LIVRAISON_PREVUE, cl.PRENOM, cl.NOM, cl.EMAIL
+        FROM COMMANDES c
+        JOIN CLIENTS cl ON cl.ID_CLIENT = c.ID_CLIENT
+        WHERE c.STATUT IN ('EN_ATTENTE', 'CONFIRMEE', 'EN_PREPARATION', 'EN_TRANSIT')
+          AND c.DATE_LIVRAISON_PREVUE >= ? AND c.DATE_LIVRAISON_PREVUE < ?
+        ORDER BY c.ID_COMMANDE
+    )");
+
+    if (!db.executeQuery(query, {m_config.dateLivraison, m_config.dateLivraison.addDays(1)})) {
+        m_lastError = db.lastError();
+        return false;
+    }
+
+    while (query.next()) {
+        rows.append({query.value(0).toInt(),
+                     query.value(1).toString(),
+                     query.value(2).toDate(),
+                     query.value(3).toString(),
+                     query.value(4).toString(),
+                     query.value(5).toString()});
+    }
+    QueryProfiler::instance().addRows(query.lastQuery(), rows.size());
+    return true;
+}
+
+bool ReminderCampaign::writeReport(const QString& filePath) const
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        qWarning() << "Campagne de rappels: impossible d'écrire" << filePath;
+        return false;
+    }
+
+    QTextStream out(&file);
+    out << "ID_COMMANDE;NUMERO_COMMANDE;EMAIL;RESULTAT\n";
+    for (const Recipient& recipient : m_report.recipients) {
+        out << recipient.idCommande << ';' << recipient.numeroCommande << ';'
+            << recipient.email << ';' << outcomeToString(recipient.outcome) << '\n';
+    }
+    return true;
+}
+
+QString ReminderCampaign::outcomeToString(Outcome outcome)
+{
+    switch (outcome) {
+        case EN_FILE: return "EN_FILE";
+        case DEJA_EN_FILE: return "DEJA_EN_FILE";
+        case ADRESSE_INVALIDE: return "ADRESSE_INVALIDE";
+        case ERREUR: return "ERREUR";
+        case ENVOYE: return "ENVOYE";
+        case ECHEC_ENVOI: return "ECHEC_ENVOI";
+    }
+    return QString();
+}
@@ -0,0 +1,129 @@
+#ifndef REMINDERCAMPAIGN_H
+#define REMINDERCAMPAIGN_H
+
+#include <QString>
+#include <QStringList>
+#include <QDate>
+#include <QList>
+
+/**
+ * @brief Campagne de rappels de livraison
+ *
+ * Sélectionne en une seule jointure COMMANDES / CLIENTS les commandes actives
+ * à livrer à une date donnée (demain par défaut), rend les emails en
+ * parallèle sur tous les cœurs puis les place par lots dans la file d'envoi
+ * (EmailOutbox). La clé de dédoublonnage (commande + date prévue) rend la
+ * campagne rejouable : une seconde exécution ne crée aucun doublon.
+ *
+ * Exécutée par `LogisticsApp --reminders [aaaa-mm-jj]` ; options :
+ * --reminders-batch <n>, --reminders-report <fichier.csv>,
+ * --reminders-deliver (envoie les messages de la campagne avant de quitter,
+ * au débit --reminders-rate <messages/s>, puis complète le rapport).
+ */
+class ReminderCampaign
+{
+public:
+    struct Config {
+        QDate dateLivraison = QDate::currentDate().addDays(1);
+        int batchSize = 2000;           // Emails par transaction de mise en file
+        int threads = 0;                // 0 : QThread::idealThreadCount()
+        int maxPerSecond = 0;           // Débit SMTP appliqué par la file, 0 : illimité
+        QString reportPath;             // Rapport CSV par destinataire (optionnel)
+        bool deliver = false;           // Vider la file d'envoi dans ce processus
+    };
+
+    enum Outcome {
+        EN_FILE,
+        DEJA_EN_FILE,
+        ADRESSE_INVALIDE,
+        ERREUR,
+        ENVOYE,                 // Après deliver() : accepté par le serveur
+        ECHEC_ENVOI             // Après deliver() : échec définitif ou délai dépassé
+    };
+
+    struct Recipient {
+        int idCommande = -1;
+        QString numeroCommande;
+        QString email;
+        QString dedupKey;
+        Outcome outcome = ERREUR;
+    };
+
+    struct Report {
+        int selected = 0;
+        int queued = 0;
+        int duplicates = 0;
+        int invalid = 0;
+        int failed = 0;
+        int sent = 0;               // Renseignés par deliver()
+        int sendFailed = 0;
+        qint64 selectMs = 0;
+        qint64 renderMs = 0;
+        qint64 enqueueMs = 0;
+        qint64 totalMs = 0;
+        qint64 deliverMs = 0;
+        double messagesPerSecond = 0.0;     // Messages mis en file par seconde
+        QList<Recipient> recipients;
+    };
+
+    /**
+     * @brief Construit la configuration à partir de la ligne de commande
+     * @param arguments Arguments de l'application
+     * @return Configuration (valeurs par défaut pour les options absentes)
+     */
+    static Config configFromArguments(const QStringList& arguments);
+
+    explicit ReminderCampaign(const Config& config);
+
+    /**
+     * @brief Exécute la campagne
+     * @return true si toutes les étapes ont réussi (les doublons ne sont pas des erreurs)
+     */
+    bool run();
+
+    /**
+     * @brief Envoie la file dans ce processus jusqu'à ce que les messages de la campagne soient soldés
+     *
+     * Seuls les messages de la campagne (clés de dédoublonnage relevées par
+     * run()) sont attendus ; le reste de la file n'intervient pas. Le statut
+     * d'envoi de chaque destinataire est ensuite reporté dans le rapport.
+     * @param timeoutSec Durée maximale d'attente
+     * @return true si tous les messages de la campagne ont été envoyés
+     */
+    bool deliver(int timeoutSec = 3600);
+
+    Report report() const { return m_report; }
+
+    /**
+     * @brief Écrit le résultat par destinataire au format CSV
+     * @param filePath Fichier de sortie
+     * @return true si l'écriture a réussi
+     */
+    bool writeReport(const QString& filePath) const;
+
+    /**
+     * @brief Libellé d'un résultat (rapport CSV)
+     */
+    static QString outcomeToString(Outcome outcome);
+
+    QString lastError() const { return m_lastError; }
+
+private:
+    struct Row {
+        int idCommande;
+        QString numeroCommande;
+        QDate dateLivraison;
+        QString prenom;
+        QString nom;
+        QString email;
+    };
+
+    bool selectRows(QList<Row>& rows);
+
+private:
+    Config m_config;
+    Report m_report;
+    QString m_lastError;
+};
+
+#endif // REMINDERCAMPAIGN_H
@@ -0,0 +1,291 @@
+#include "slaengine.h"
+#include "commandecontroller.h"
+#include "database/databasemanager.h"
+#include "database/queryprofiler.h"
+#include <QSqlQuery>
+#include <QDebug>
+#include <queue>
+#include <utility>
+
+SlaEngine* SlaEngine::m_instance = nullptr;
+
+SlaEngine& SlaEngine::instance()
+{
+    if (!m_instance) {
+        m_instance = new SlaEngine();
+    }
+    return *m_instance;
+}
+
+SlaEngine::SlaEngine(QObject *parent)
+    : QObject(parent)
+    , m_riskWindowDays(2)
+{
+}
+
+void SlaEngine::setRiskWindowDays(int days)
+{
+    if (days >= 0) {
+        m_riskWindowDays = days;
+    }
+}
+
+int SlaEngine::riskWindowDays() const
+{
+    return m_riskWindowDays;
+}
+
+void SlaEngine::attach(CommandeController* controller)
+{
+    if (!controller) {
+        return;
+    }
+
+    // Connexions directes : les commandes émises sont libérées après l'émission
+    connect(controller, &CommandeController::commandeCreated, this, &SlaEngine::onCommandeChanged);
+    connect(controller, &CommandeController::commandeUpdated, this, &SlaEngine::onCommandeChanged);
+    connect(controller, &CommandeController::commandeDeleted, this, &SlaEngine::onCommandeDeleted);
+    connect(controller, &CommandeController::commandeStatusChanged, this, &SlaEngine::onCommandeStatusChanged);
+}
+
+bool SlaEngine::reload()
+{
+    DatabaseManager& db = DatabaseManager::instance();
+
+    // Projection légère : pas d'objets Commande pour le chargement du tas
+    QSqlQuery query = db.prepareQuery(R"(
+        SELECT ID_COMMANDE, NUMERO_COMMANDE, DATE_LIVRAISON_PREVUE, PRIORITE
+        FROM COMMANDES
+        WHERE STATUT IN ('EN_ATTENTE', 'CONFIRMEE', 'EN_PREPARATION', 'EN_TRANSIT')
+          AND DATE_LIVRAISON_PREVUE IS NOT NULL
+    )");
+
+    if (!db.executeQuery(query)) {
+        qWarning() << "Erreur lors du chargement des échéances SLA:" << db.lastError();
+        return false;
+    }
+
+    m_heap.clear();
+    m_positions.clear();
+
+    while (query.next()) {
+        Deadline deadline;
+        deadline.idCommande = query.value(0).toInt();
+        deadline.numeroCommande = query.value(1).toString();
+        deadline.dateLivraisonPrevue = query.value(2).toDate();
+        deadline.priorite = Commande::stringToPriorite(query.value(3).toString());
+        m_heap.push_back(deadline);
+    }
+    QueryProfiler::instance().addRows(query.lastQuery(), static_cast<int>(m_heap.size()));
+
+    // Construction du tas en O(n)
+    for (int i = static_cast<int>(m_heap.size()) / 2 - 1; i >= 0; --i) {
+        siftDown(i);
+    }
+    for (int i = 0; i < static_cast<int>(m_heap.size()); ++i) {
+        m_positions.insert(m_heap[i].idCommande, i);
+    }
+
+    emit deadlinesChanged();
+    return true;
+}
+
+SlaEngine::Summary SlaEngine::summary(const QDate& reference) const
+{
+    Summary result;
+    DatabaseManager& db = DatabaseManager::instance();
+
+    const QDate demain = reference.addDays(1);
+    const QDate finRisque = reference.addDays(m_riskWindowDays + 1);
+
+    // Un seul parcours de plage sur (STATUT, DATE_LIVRAISON_PREVUE)
+    QSqlQuery query = db.prepareQuery(R"(
+        SELECT SUM(CASE WHEN DATE_LIVRAISON_PREVUE < ? THEN 1 ELSE 0 END),
+               SUM(CASE WHEN DATE_LIVRAISON_PREVUE >= ? AND DATE_LIVRAISON_PREVUE < ? THEN 1 ELSE 0 END),
+               SUM(CASE WHEN DATE_LIVRAISON_PREVUE >= ? THEN 1 ELSE 0 END)
+        FROM COMMANDES
+        WHERE STATUT IN ('EN_ATTENTE', 'CONFIRMEE', 'EN_PREPARATION', 'EN_TRANSIT')
+          AND DATE_LIVRAISON_PREVUE < ?
+    )");
+
+    if (!db.executeQuery(query, {reference, reference, demain, demain, finRisque}) || !query.next()) {
+        return result;
+    }
+
+    result.enRetard = query.value(0).toInt();
+    result.aLivrerAujourdhui = query.value(1).toInt();
+    result.aRisque = query.value(2).toInt();
+    return result;
+}
+
+QList<SlaEngine::Deadline> SlaEngine::nextDeadlines(int count) const
+{
+    QList<Deadline> result;
+    if (count <= 0 || m_heap.empty()) {
+        return result;
+    }
+
+    // Parcours du tas par une file de candidats : O(count log count)
+    auto later = [this](int a, int b) { return isEarlier(m_heap[b], m_heap[a]); };
+    std::priority_queue<int, std::vector<int>, decltype(later)> candidates(later);
+    candidates.push(0);
+
+    const int size = static_cast<int>(m_heap.size());
+    while (!candidates.empty() && result.size() < count) {
+        const int index = candidates.top();
+        candidates.pop();
+        result.append(m_heap[index]);
+
+        const int left = 2 * index + 1;
+        if (left < size) {
+            candidates.push(left);
+        }
+        if (left + 1 < size) {
+            candidates.push(left + 1);
+        }
+    }
+
+    return result;
+}
+
+int SlaEngine::trackedCount() const
+{
+    return static_cast<int>(m_heap.size());
+}
+
+void SlaEngine::onCommandeChanged(Commande* commande)
+{
+    if (!commande || commande->id() <= 0) {
+        return;
+    }
+
+    if (!isActive(commande->statut()) || !commande->dateLivraisonPrevue().isValid()) {
+        remove(commande->id());
+    } else {
+        upsert({commande->id(), commande->numeroCommande(),
+                commande->dateLivraisonPrevue(), commande->priorite()});
+    }
+
+    emit deadlinesChanged();
+}
+
+void SlaEngine::onCommandeDeleted(int commandeId)
+{
+    remove(commandeId);
+    emit deadlinesChanged();
+}
+
+void SlaEngine::onCommandeStatusChanged(int commandeId, Commande::Statut nouveauStatut)
+{
+    // Le passage à un statut actif est traité par commandeUpdated, qui porte la date
+    if (!isActive(nouveauStatut)) {
+        remove(commandeId);
+        emit deadlinesChanged();
+    }
+}
+
+bool SlaEngine::isActive(Commande::Statut statut)
+{
+    return statut != Commande::LIVREE && statut != Commande::ANNULEE;
+}
+
+bool SlaEngine::isEarlier(const Deadline& a, const Deadline& b)
+{
+    if (a.dateLivraisonPrevue != b.dateLivraisonPrevue) {
+        return a.dateLivraisonPrevue < b.dateLivraisonPrevue;
+    }
+    // À échéance égale, la priorité la plus haute passe en premier
+    if (a.priorite != b.priorite) {
+        return a.priorite > b.priorite;
+    }
+    return a.idCommande < b.idCommande;
+}
+
+void SlaEngine::upsert(const Deadline& deadline)
+{
+    auto it = m_positions.find(deadline.idCommande);
+    if (it == m_positions.end()) {
+        m_heap.push_back(deadline);
+        const int index = static_cast<int>(m_heap.size()) - 1;
+        m_positions.insert(deadline.idCommande, index);
+        siftUp(index);
+        return;
+    }
+
+    const int index = it.value();
+    m_heap[index] = deadline;
+    siftUp(index);
+    siftDown(m_positions.value(deadline.idCommande));
+}
+
+void SlaEngine::remove(int idCommande)
+{
+    auto it = m_positions.find(idCommande);
+    if (it == m_positions.end()) {
+        return;
+    }
+
+    const int index = it.value();
+    const int last = static_cast<int>(m_heap.size()) - 1;
+
+    swapEntries(index, last);
+    m_heap.pop_back();
+    m_positions.remove(idCommande);
+
+    if (index < last) {
+        siftUp(index);
+        siftDown(m_positions.value(m_heap[index].idCommande, index));
+    }
+}
+
+void SlaEngine::siftUp(int index)
+{
+    while (index > 0) {
+        const int parent = (index - 1) / 2;
+        if (!isEarlier(m_heap[index], m_heap[parent])) {
+            break;
+        }
+        swapEntries(index, parent);
+        index = parent;
+    }
+}
+
+void SlaEngine::siftDown(int index)
+{
+    const int size = static_cast<int>(m_heap.size());
+    while (true) {
+        const int left = 2 * index + 1;
+        const int right = left + 1;
+        int smallest = index;
+
+        if (left < size && isEarlier(m_heap[left], m_heap[smallest])) {
+            smallest = left;
+        }
+        if (right < size && isEarlier(m_heap[right], m_heap[smallest])) {
+            smallest = right;
+        }
+        if (smallest == index) {
+            break;
+        }
+
+        swapEntries(index, smallest);
+        index = smallest;
+    }
+}
+
+void SlaEngine::swapEntries(int a, int b)
+{
+    if (a == b) {
+        return;
+    }
+
+    std::swap(m_heap[a], m_heap[b]);
+    // Positions mises à jour uniquement pour les entrées déjà indexées
+    // (pendant reload(), l'index est reconstruit après le tassement)
+    if (m_positions.contains(m_heap[a].idCommande)) {
+        m_positions[m_heap[a].idCommande] = a;
+    }
+    if (m_positions.contains(m_heap[b].idCommande)) {
+        m_positions[m_heap[b].idCommande] = b;
+    }
+}
@@ -0,0 +1,125 @@
+#ifndef SLAENGINE_H
+#define SLAENGINE_H
+
+#include <QObject>
+#include <QDate>
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <vector>
+#include "models/commande.h"
+
+class CommandeController;
+
+/**
+ * @brief Moteur de suivi des délais de livraison (SLA)
+ *
+ * Calcule les commandes en retard, à livrer aujourd'hui et à risque avec des
+ * prédicats de date indépendants du driver (dates liées en paramètres), et
+ * maintient en mémoire un tas binaire indexé des échéances à venir. Le tas
+ * est chargé une fois puis mis à jour par les signaux du CommandeController,
+ * ce qui permet d'obtenir les N prochaines échéances sans interroger la base.
+ */
+class SlaEngine : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Échéance d'une commande active
+     */
+    struct Deadline {
+        int idCommande;
+        QString numeroCommande;
+        QDate dateLivraisonPrevue;
+        Commande::Priorite priorite;
+    };
+
+    /**
+     * @brief Synthèse SLA calculée en base
+     */
+    struct Summary {
+        int enRetard = 0;
+        int aLivrerAujourdhui = 0;
+        int aRisque = 0;
+    };
+
+    /**
+     * @brief Obtient l'instance unique du moteur SLA
+     * @return Référence vers l'instance unique
+     */
+    static SlaEngine& instance();
+
+    /**
+     * @brief Nombre de jours avant échéance à partir duquel une commande est à risque
+     * @param days Nombre de jours (défaut: 2)
+     */
+    void setRiskWindowDays(int days);
+    int riskWindowDays() const;
+
+    /**
+     * @brief Abonne le moteur aux signaux d'un contrôleur de commandes
+     * @param controller Contrôleur à suivre
+     */
+    void attach(CommandeController* controller);
+
+    /**
+     * @brief Recharge le tas des échéances depuis la base
+     * @return true si le chargement a réussi
+     */
+    bool reload();
+
+    /**
+     * @brief Compte les commandes en retard, du jour et à risque
+     * @param reference Date de référence (aujourd'hui par défaut)
+     * @return Synthèse SLA
+     */
+    Summary summary(const QDate& reference = QDate::currentDate()) const;
+
+    /**
+     * @brief Prochaines échéances, de la plus proche à la plus lointaine
+     * @param count Nombre d'échéances souhaitées
+     * @return Échéances triées, sans accès à la base
+     */
+    QList<Deadline> nextDeadlines(int count) const;
+
+    /**
+     * @brief Nombre d'échéances suivies en mémoire
+     */
+    int trackedCount() const;
+
+public slots:
+    void onCommandeChanged(Commande* commande);
+    void onCommandeDeleted(int commandeId);
+    void onCommandeStatusChanged(int commandeId, Commande::Statut nouveauStatut);
+
+signals:
+    /**
+     * @brief Signal émis quand l'ensemble des échéances suivies change
+     */
+    void deadlinesChanged();
+
+private:
+    SlaEngine(QObject *parent = nullptr);
+
+    // Empêche la copie et l'assignation
+    SlaEngine(const SlaEngine&) = delete;
+    SlaEngine& operator=(const SlaEngine&) = delete;
+
+    static bool isActive(Commande::Statut statut);
+    static bool isEarlier(const Deadline& a, const Deadline& b);
+
+    void upsert(const Deadline& deadline);
+    void remove(int idCommande);
+    void siftUp(int index);
+    void siftDown(int index);
+    void swapEntries(int a, int b);
+
+private:
+    std::vector<Deadline> m_heap;
+    QHash<int, int> m_positions;
+    int m_riskWindowDays;
+    static SlaEngine* m_instance;
+};
+
+#endif // SLAENGINE_H
@@ -0,0 +1,104 @@
+#include "archivemanager.h"
+#include "databasemanager.h"
+#include <QSqlQuery>
+#include <QDebug>
+
+int ArchiveManager::s_horizonDays = ArchiveManager::DEFAULT_HORIZON_DAYS;
+QDate ArchiveManager::s_archiveBoundary;
+bool ArchiveManager::s_boundaryLoaded = false;
+QString ArchiveManager::s_lastError;
+
+void ArchiveManager::setHorizonDays(int days)
+{
+    if (days > 0) {
+        s_horizonDays = days;
+    }
+}
+
+int ArchiveManager::horizonDays()
+{
+    return s_horizonDays;
+}
+
+int ArchiveManager::archiveCommandes()
+{
+    DatabaseManager& db = DatabaseManager::instance();
+    const QDate cutoff = QDate::currentDate().addDays(-s_horizonDays);
+
+    int archived = 0;
+
+    // Copie et suppression rejouées ensemble en cas de perte de session ;
+    // les requêtes sont préparées à chaque tentative sur la connexion courante
+    const bool success = db.runTransaction([&]() {
+        // La date limite est liée comme paramètre : prédicat identique Oracle/SQLite
+        QSqlQuery copyQuery = db.prepareQuery(R"(
+            INSERT INTO COMMANDES_ARCHIVE (ID_COMMANDE, ID_CLIENT, NUMERO_COMMANDE, DATE_COMMANDE,
+                   DATE_LIVRAISON_PREVUE, DATE_LIVRAISON_REELLE, ADRESSE_LIVRAISON, VILLE_LIVRAISON,
+                   CODE_POSTAL_LIVRAISON, STATUT, PRIORITE, POIDS_TOTAL, VOLUME_TOTAL, PRIX_TOTAL, COMMENTAIRES)
+            SELECT ID_COMMANDE, ID_CLIENT, NUMERO_COMMANDE, DATE_COMMANDE,
+                   DATE_LIVRAISON_PREVUE, DATE_LIVRAISON_REELLE, ADRESSE_LIVRAISON, VILLE_LIVRAISON,
+                   CODE_POSTAL_LIVRAISON, STATUT, PRIORITE, POIDS_TOTAL, VOLUME_TOTAL, PRIX_TOTAL, COMMENTAIRES
+            FROM COMMANDES
+            WHERE STATUT IN ('LIVREE', 'ANNULEE') AND DATE_COMMANDE < ?
+        )");
+
+        // Seules les lignes effectivement copiées sont supprimées
+        QSqlQuery deleteQuery = db.prepareQuery(R"(
+            DELETE FROM COMMANDES
+            WHERE DATE_COMMANDE < ?
+              AND ID_COMMANDE IN (SELECT ID_COMMANDE FROM COMMANDES_ARCHIVE WHERE DATE_COMMANDE < ?)
+        )");
+
+        if (!db.executeQuery(copyQuery, {cutoff}) || !db.executeQuery(deleteQuery, {cutoff, cutoff})) {
+            return false;
+        }
+
+        archived = deleteQuery.numRowsAffected();
+        return true;
+    });
+
+    if (!success) {
+        s_lastError = db.lastError();
+        qWarning() << "Erreur lors de l'archivage des commandes:" << s_lastError;
+        return -1;
+    }
+
+    s_boundaryLoaded = false;
+
+    qInfo() << "Commandes archivées:" << archived << "(antérieures au" << cutoff.toString(Qt::ISODate) << ")";
+    return archived;
+}
+
+QDate ArchiveManager::archiveBoundary()
+{
+    if (s_boundaryLoaded) {
+        return s_archiveBoundary;
+    }
+
+    DatabaseManager& db = DatabaseManager::instance();
+    QSqlQuery query = db.prepareQuery("SELECT MAX(DATE_COMMANDE) FROM COMMANDES_ARCHIVE");
+
+    s_archiveBoundary = QDate();
+    if (db.executeQuery(query) && query.next() && !query.value(0).isNull()) {
+        // Oracle renvoie une DATE, SQLite un texte ISO éventuellement horodaté
+        s_archiveBoundary = QDate::fromString(query.value(0).toString().left(10), Qt::ISODate);
+    }
+    s_boundaryLoaded = true;
+
+    return s_archiveBoundary;
+}
+
+bool ArchiveManager::includesArchive(const QDate& dateDebut)
+{
+    if (!dateDebut.isValid()) {
+        return false;
+    }
+
+    const QDate boundary = archiveBoundary();
+    return boundary.isValid() && dateDebut <= boundary;
+}
+
+QString ArchiveManager::lastError()
+{
+    return s_lastError;
+}
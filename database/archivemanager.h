@@ -0,0 +1,68 @@
+#ifndef ARCHIVEMANAGER_H
+#define ARCHIVEMANAGER_H
+
+#include <QString>
+#include <QDate>
+
+/**
+ * @brief Archivage des commandes historiques
+ *
+ * Déplace les commandes LIVREE/ANNULEE plus anciennes qu'un horizon
+ * configurable de COMMANDES vers COMMANDES_ARCHIVE, afin que les requêtes
+ * courantes (comptages, recherches, statistiques) ne parcourent que les
+ * commandes actives. Les recherches par période incluent l'archive
+ * uniquement lorsque la période demandée la recoupe.
+ */
+class ArchiveManager
+{
+public:
+    /**
+     * @brief Horizon d'archivage par défaut, en jours
+     */
+    static const int DEFAULT_HORIZON_DAYS = 365;
+
+    /**
+     * @brief Définit l'horizon d'archivage
+     * @param days Nombre de jours au-delà duquel une commande terminée est archivée
+     */
+    static void setHorizonDays(int days);
+
+    /**
+     * @brief Obtient l'horizon d'archivage
+     * @return Nombre de jours
+     */
+    static int horizonDays();
+
+    /**
+     * @brief Archive les commandes terminées antérieures à l'horizon
+     * @return Nombre de commandes archivées, -1 en cas d'erreur
+     */
+    static int archiveCommandes();
+
+    /**
+     * @brief Date de commande la plus récente présente dans l'archive
+     * @return Date limite, invalide si l'archive est vide
+     */
+    static QDate archiveBoundary();
+
+    /**
+     * @brief Indique si une recherche à partir de cette date doit inclure l'archive
+     * @param dateDebut Début de la période recherchée (invalide = pas de période)
+     * @return true si la période recoupe les commandes archivées
+     */
+    static bool includesArchive(const QDate& dateDebut);
+
+    /**
+     * @brief Obtient la dernière erreur
+     * @return Description de la dernière erreur
+     */
+    static QString lastError();
+
+private:
+    static int s_horizonDays;
+    static QDate s_archiveBoundary;
+    static bool s_boundaryLoaded;
+    static QString s_lastError;
+};
+
+#endif // ARCHIVEMANAGER_H
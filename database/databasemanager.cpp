@@ -1,8 +1,13 @@
 #include "databasemanager.h"
+#include "migrationmanager.h"
+#include "queryprofiler.h"
+#include "utils/tracer.h"
 #include <QSqlDriver>
 #include <QApplication>
 #include <QDate>
 #include <QDir>
+#include <QThread>
+#include <QElapsedTimer>
 #include <stdexcept>
 
 DatabaseManager* DatabaseManager::m_instance = nullptr;
@@ -73,8 +78,10 @@ bool DatabaseManager::initialize()
         } else {
             // Configuration SQLite
             qInfo() << "Configuring SQLite database connection";
-            QString dbPath = QDir::currentPath() + "/logistics.db";
+            QString dbPath = m_sqlitePath.isEmpty() ? QDir::currentPath() + "/logistics.db" : m_sqlitePath;
             m_database.setDatabaseName(dbPath);
+            // Attente des verrous posés par la file d'envoi et les travaux de fond
+            m_database.setConnectOptions("QSQLITE_BUSY_TIMEOUT=5000");
             qDebug() << "SQLite database path:" << dbPath;
         }
 
@@ -91,6 +98,7 @@ bool DatabaseManager::initialize()
                 m_database = QSqlDatabase::addDatabase("QSQLITE", "LogisticsConnection");
                 QString dbPath = QDir::currentPath() + "/logistics.db";
                 m_database.setDatabaseName(dbPath);
+                m_database.setConnectOptions("QSQLITE_BUSY_TIMEOUT=5000");
 
                 if (!m_database.open()) {
                     m_lastError = m_database.lastError().text();
@@ -109,6 +117,10 @@ bool DatabaseManager::initialize()
             }
         }
 
+        if (m_database.driverName() == "QSQLITE") {
+            enableWriteAheadLog();
+        }
+
         // Test the connection
         QSqlQuery testQuery(m_database);
         if (m_database.driverName() == "QOCI") {
@@ -123,10 +135,10 @@ bool DatabaseManager::initialize()
             qDebug() << "Database connection test successful";
         }
 
-        // Création des tables si nécessaire
-        qDebug() << "Creating database tables...";
-        if (!createTables()) {
-            qCritical() << "Erreur lors de la création des tables";
+        // Mise à jour du schéma par migrations versionnées
+        qDebug() << "Migrating database schema...";
+        if (!migrateSchema()) {
+            qCritical() << "Erreur lors de la migration du schéma";
             return false;
         }
 
@@ -144,39 +156,186 @@ bool DatabaseManager::initialize()
     }
 }
 
+void DatabaseManager::setSQLiteDatabasePath(const QString& databasePath)
+{
+    m_sqlitePath = databasePath;
+
+    if (m_database.driverName() != "QSQLITE") {
+        m_database = QSqlDatabase();
+        QSqlDatabase::removeDatabase("LogisticsConnection");
+        m_database = QSqlDatabase::addDatabase("QSQLITE", "LogisticsConnection");
+    }
+}
+
 void DatabaseManager::close()
 {
+    if (m_retryStats.transientErrors > 0) {
+        qInfo() << "Erreurs transitoires:" << m_retryStats.transientErrors
+                << "- rejeux requêtes:" << m_retryStats.statementRetries
+                << "- rejeux transactions:" << m_retryStats.transactionReplays
+                << "- reconnexions:" << m_retryStats.reconnects
+                << "(échecs:" << m_retryStats.failedReconnects << ")"
+                << "- budgets épuisés:" << m_retryStats.budgetExhausted;
+    }
+
     if (m_database.isOpen()) {
         m_database.close();
         qInfo() << "Connexion à la base de données fermée";
     }
 }
 
+void DatabaseManager::enableWriteAheadLog()
+{
+    // Journal WAL : les lectures de l'interface ne bloquent plus les écritures
+    // des autres connexions (et inversement) ; le mode est mémorisé dans le fichier
+    QSqlQuery pragma(m_database);
+    if (!pragma.exec("PRAGMA journal_mode=WAL")) {
+        qWarning() << "Journal WAL indisponible:" << pragma.lastError().text();
+    }
+}
+
+bool DatabaseManager::reconnect()
+{
+    qWarning() << "Reconnexion à la base de données...";
+    m_database.close();
+    m_inTransaction = false;
+
+    if (!m_database.open()) {
+        m_lastError = m_database.lastError().text();
+        ++m_retryStats.failedReconnects;
+        qCritical() << "Échec de la reconnexion:" << m_lastError;
+        return false;
+    }
+
+    ++m_retryStats.reconnects;
+    qInfo() << "Connexion à la base de données rétablie";
+    return true;
+}
+
 QSqlDatabase& DatabaseManager::database()
 {
     return m_database;
 }
 
 bool DatabaseManager::executeQuery(QSqlQuery& query, const QVariantList& params)
+{
+    TRACE_SPAN("db", "DatabaseManager::executeQuery");
+    QElapsedTimer timer;
+    timer.start();
+
+    {
+        QMutexLocker locker(&m_statementMutex);
+        m_currentStatement = query.lastQuery();
+        m_statementTimer.start();
+    }
+
+    const bool success = executeWithRetry(query, params);
+
+    {
+        QMutexLocker locker(&m_statementMutex);
+        m_currentStatement.clear();
+    }
+
+    // Lignes connues pour le DML ; pour les SELECT en lecture séquentielle,
+    // size() vaut -1 et les lignes sont ajoutées par chaque lecteur après lecture
+    const int rows = !success ? -1 : (query.isSelect() ? query.size() : query.numRowsAffected());
+    QueryProfiler::instance().record(query.lastQuery(), timer.nsecsElapsed(), rows, params);
+
+    return success;
+}
+
+bool DatabaseManager::executeWithRetry(QSqlQuery& query, const QVariantList& params)
 {
     // Liaison des paramètres
-    for (int i = 0; i < params.size(); ++i) {
-        query.bindValue(i, params.at(i));
+    bindParams(query, params);
+
+    if (query.exec()) {
+        return true;
     }
-    
-    if (!query.exec()) {
-        m_lastError = query.lastError().text();
-        qWarning() << "Erreur d'exécution de requête:" << m_lastError;
-        qWarning() << "Requête:" << query.lastQuery();
-        return false;
+
+    QSqlError error = query.lastError();
+
+    // Rejeu automatique des lectures hors transaction ; dans une transaction,
+    // c'est runTransaction() qui rejoue l'ensemble
+    if (isTransientError(error) && !m_inTransaction && isIdempotentRead(query.lastQuery())) {
+        const QString sql = query.lastQuery();
+        ++m_retryStats.transientErrors;
+
+        const int retryBudget = effectiveRetryBudget();
+        for (int attempt = 1; attempt <= retryBudget; ++attempt) {
+            if (!recoverFromTransientError(attempt)) {
+                continue;
+            }
+
+            QSqlQuery retry(m_database);
+            retry.setForwardOnly(query.isForwardOnly());
+            retry.prepare(sql);
+            bindParams(retry, params);
+            ++m_retryStats.statementRetries;
+
+            if (retry.exec()) {
+                query = retry;
+                return true;
+            }
+
+            error = retry.lastError();
+            if (!isTransientError(error)) {
+                break;
+            }
+            ++m_retryStats.transientErrors;
+        }
+
+        if (isTransientError(error)) {
+            ++m_retryStats.budgetExhausted;
+        }
+    }
+
+    m_lastSqlError = error;
+    m_lastError = error.text();
+    qWarning() << "Erreur d'exécution de requête:" << m_lastError;
+    qWarning() << "Requête:" << query.lastQuery();
+    return false;
+}
+
+bool DatabaseManager::runTransaction(const std::function<bool()>& work)
+{
+    bool reconnectFailed = false;
+    const int retryBudget = effectiveRetryBudget();
+
+    for (int attempt = 0; ; ++attempt) {
+        m_lastSqlError = QSqlError();
+
+        if (beginTransaction()) {
+            if (work() && commitTransaction()) {
+                return true;
+            }
+            rollbackTransaction();
+        }
+
+        // Erreur métier ou permanente : pas de rejeu. Après une reconnexion
+        // manquée, l'échec du BEGIN reste transitoire : on poursuit le rejeu
+        if (!reconnectFailed && !isTransientError(m_lastSqlError)) {
+            return false;
+        }
+        ++m_retryStats.transientErrors;
+
+        if (attempt >= retryBudget) {
+            ++m_retryStats.budgetExhausted;
+            qWarning() << "Budget de rejeu épuisé pour la transaction:" << m_lastError;
+            return false;
+        }
+
+        reconnectFailed = !recoverFromTransientError(attempt + 1);
+        ++m_retryStats.transactionReplays;
+        qWarning() << "Rejeu de la transaction après erreur transitoire, tentative" << attempt + 1;
     }
-    
-    return true;
 }
 
 QSqlQuery DatabaseManager::prepareQuery(const QString& sql)
 {
     QSqlQuery query(m_database);
+    // Lecture séquentielle : évite la mise en cache des lignes déjà lues
+    query.setForwardOnly(true);
     if (!query.prepare(sql)) {
         m_lastError = query.lastError().text();
         qWarning() << "Erreur de préparation de requête:" << m_lastError;
@@ -188,25 +347,30 @@ QSqlQuery DatabaseManager::prepareQuery(const QString& sql)
 bool DatabaseManager::beginTransaction()
 {
     if (!m_database.transaction()) {
-        m_lastError = m_database.lastError().text();
+        m_lastSqlError = m_database.lastError();
+        m_lastError = m_lastSqlError.text();
         qWarning() << "Erreur de début de transaction:" << m_lastError;
         return false;
     }
+    m_inTransaction = true;
     return true;
 }
 
 bool DatabaseManager::commitTransaction()
 {
     if (!m_database.commit()) {
-        m_lastError = m_database.lastError().text();
+        m_lastSqlError = m_database.lastError();
+        m_lastError = m_lastSqlError.text();
         qWarning() << "Erreur de validation de transaction:" << m_lastError;
         return false;
     }
+    m_inTransaction = false;
     return true;
 }
 
 bool DatabaseManager::rollbackTransaction()
 {
+    m_inTransaction = false;
     if (!m_database.rollback()) {
         m_lastError = m_database.lastError().text();
         qWarning() << "Erreur d'annulation de transaction:" << m_lastError;
@@ -225,200 +389,111 @@ QString DatabaseManager::lastError() const
     return m_lastError;
 }
 
-bool DatabaseManager::createTables()
+bool DatabaseManager::isTransientError(const QSqlError& error) const
 {
-    QStringList createTableQueries;
-
-    if (m_database.driverName() == "QOCI") {
-        // Oracle-specific table creation
-        qInfo() << "Creating Oracle tables";
-
-        // Table CLIENTS avec contraintes d'intégrité Oracle
-        createTableQueries << R"(
-            CREATE TABLE CLIENTS (
-                ID_CLIENT NUMBER GENERATED BY DEFAULT AS IDENTITY PRIMARY KEY,
-                NOM VARCHAR2(100) NOT NULL,
-                PRENOM VARCHAR2(100) NOT NULL,
-                EMAIL VARCHAR2(150) UNIQUE NOT NULL,
-                TELEPHONE VARCHAR2(20) NOT NULL,
-                ADRESSE VARCHAR2(500) NOT NULL,
-                VILLE VARCHAR2(100) NOT NULL,
-                CODE_POSTAL VARCHAR2(10) NOT NULL,
-                DATE_CREATION DATE DEFAULT SYSDATE,
-                STATUT VARCHAR2(20) DEFAULT 'ACTIF' CHECK (STATUT IN ('ACTIF', 'INACTIF', 'SUSPENDU'))
-            )
-        )";
-
-        // Table COMMANDES avec contraintes d'intégrité Oracle
-        createTableQueries << R"(
-            CREATE TABLE COMMANDES (
-                ID_COMMANDE NUMBER GENERATED BY DEFAULT AS IDENTITY PRIMARY KEY,
-                ID_CLIENT NUMBER NOT NULL,
-                NUMERO_COMMANDE VARCHAR2(50) UNIQUE NOT NULL,
-                DATE_COMMANDE DATE DEFAULT SYSDATE,
-                DATE_LIVRAISON_PREVUE DATE,
-                DATE_LIVRAISON_REELLE DATE,
-                ADRESSE_LIVRAISON VARCHAR2(500) NOT NULL,
-                VILLE_LIVRAISON VARCHAR2(100) NOT NULL,
-                CODE_POSTAL_LIVRAISON VARCHAR2(10) NOT NULL,
-                STATUT VARCHAR2(30) DEFAULT 'EN_ATTENTE' CHECK (STATUT IN ('EN_ATTENTE', 'CONFIRMEE', 'EN_PREPARATION', 'EN_TRANSIT', 'LIVREE', 'ANNULEE')),
-                PRIORITE VARCHAR2(20) DEFAULT 'NORMALE' CHECK (PRIORITE IN ('BASSE', 'NORMALE', 'HAUTE', 'URGENTE')),
-                POIDS_TOTAL NUMBER(8,2) DEFAULT 0,
-                VOLUME_TOTAL NUMBER(8,2) DEFAULT 0,
-                PRIX_TOTAL NUMBER(10,2) DEFAULT 0,
-                COMMENTAIRES VARCHAR2(1000),
-                CONSTRAINT FK_COMMANDE_CLIENT FOREIGN KEY (ID_CLIENT) REFERENCES CLIENTS(ID_CLIENT) ON DELETE CASCADE
-            )
-        )";
-    } else {
-        // SQLite-specific table creation
-        qInfo() << "Creating SQLite tables";
-
-        // Table CLIENTS pour SQLite
-        createTableQueries << R"(
-            CREATE TABLE IF NOT EXISTS CLIENTS (
-                ID_CLIENT INTEGER PRIMARY KEY AUTOINCREMENT,
-                NOM TEXT NOT NULL,
-                PRENOM TEXT NOT NULL,
-                EMAIL TEXT UNIQUE NOT NULL,
-                TELEPHONE TEXT NOT NULL,
-                ADRESSE TEXT NOT NULL,
-                VILLE TEXT NOT NULL,
-                CODE_POSTAL TEXT NOT NULL,
-                DATE_CREATION DATETIME DEFAULT CURRENT_TIMESTAMP,
-                STATUT TEXT DEFAULT 'ACTIF' CHECK (STATUT IN ('ACTIF', 'INACTIF', 'SUSPENDU'))
-            )
-        )";
-
-        // Table COMMANDES pour SQLite
-        createTableQueries << R"(
-            CREATE TABLE IF NOT EXISTS COMMANDES (
-                ID_COMMANDE INTEGER PRIMARY KEY AUTOINCREMENT,
-                ID_CLIENT INTEGER NOT NULL,
-                NUMERO_COMMANDE TEXT UNIQUE NOT NULL,
-                DATE_COMMANDE DATETIME DEFAULT CURRENT_TIMESTAMP,
-                DATE_LIVRAISON_PREVUE DATETIME,
-                DATE_LIVRAISON_REELLE DATETIME,
-                ADRESSE_LIVRAISON TEXT NOT NULL,
-                VILLE_LIVRAISON TEXT NOT NULL,
-                CODE_POSTAL_LIVRAISON TEXT NOT NULL,
-                STATUT TEXT DEFAULT 'EN_ATTENTE' CHECK (STATUT IN ('EN_ATTENTE', 'CONFIRMEE', 'EN_PREPARATION', 'EN_TRANSIT', 'LIVREE', 'ANNULEE')),
-                PRIORITE TEXT DEFAULT 'NORMALE' CHECK (PRIORITE IN ('BASSE', 'NORMALE', 'HAUTE', 'URGENTE')),
-                POIDS_TOTAL REAL DEFAULT 0,
-                VOLUME_TOTAL REAL DEFAULT 0,
-                PRIX_TOTAL REAL DEFAULT 0,
-                COMMENTAIRES TEXT,
-                FOREIGN KEY (ID_CLIENT) REFERENCES CLIENTS(ID_CLIENT) ON DELETE CASCADE
-            )
-        )";
+    if (!error.isValid()) {
+        return false;
     }
 
-    // Exécution des requêtes de création
-    for (const QString& query : createTableQueries) {
-        QSqlQuery sqlQuery = prepareQuery(query);
-        if (!sqlQuery.exec()) {
-            // Ignorer les erreurs "table already exists"
-            QString error = sqlQuery.lastError().text();
-            if (!error.contains("ORA-00955") && !error.contains("already exists")) {
-                qWarning() << "Erreur lors de la création des tables:" << error;
-                qWarning() << "Requête:" << query;
-                return false;
+    const QString text = error.text();
+    const QString code = error.nativeErrorCode();
+
+    if (m_database.driverName() == "QOCI") {
+        // Fin de fichier sur le canal, session non connectée, listener absent,
+        // connexion perdue, basculement (Application Continuity)
+        static const QStringList oracleCodes = {"3113", "3114", "12541", "3135", "25408"};
+        for (const QString& oracleCode : oracleCodes) {
+            if (code == oracleCode || text.contains("ORA-" + oracleCode.rightJustified(5, '0'))) {
+                return true;
             }
         }
+        return false;
     }
 
-    // Création des index pour optimiser les performances
-    createIndexes();
-
-    // Création des séquences et triggers
-    createSequencesAndTriggers();
+    // SQLITE_BUSY (5) et SQLITE_LOCKED (6)
+    return code == "5" || code == "6" || text.contains("database is locked");
+}
 
-    qInfo() << "Tables créées avec succès";
+void DatabaseManager::setRetryBudget(int attempts)
+{
+    if (attempts >= 0) {
+        m_retryBudget = attempts;
+    }
+}
 
-    // Insérer des données de test si les tables sont vides
-    insertSampleData();
+QString DatabaseManager::currentStatement(qint64* elapsedMs) const
+{
+    QMutexLocker locker(&m_statementMutex);
+    if (elapsedMs) {
+        *elapsedMs = m_currentStatement.isEmpty() ? 0 : m_statementTimer.elapsed();
+    }
+    return m_currentStatement;
+}
 
-    return true;
+DatabaseManager::RetryStats DatabaseManager::retryStats() const
+{
+    return m_retryStats;
 }
 
-bool DatabaseManager::createIndexes()
+bool DatabaseManager::recoverFromTransientError(int attempt)
 {
-    QStringList indexQueries;
+    // Délai exponentiel 100, 200, 400 ... ms, plafonné à 3,2 s, hors thread
+    // graphique uniquement : sur le thread graphique, le rejeu est immédiat
+    // et l'attente est portée par le délai d'occupation SQLite ou par la
+    // reconnexion Oracle, sans geler l'interface
+    const QCoreApplication* app = QCoreApplication::instance();
+    if (!app || QThread::currentThread() != app->thread()) {
+        const int delayMs = qMin(100 << qMin(attempt - 1, 5), 3200);
+        QThread::msleep(delayMs);
+    }
 
-    if (m_database.driverName() == "QOCI") {
-        // Oracle-specific indexes
-        indexQueries << "CREATE INDEX IDX_CLIENTS_EMAIL ON CLIENTS(EMAIL)";
-        indexQueries << "CREATE INDEX IDX_CLIENTS_NOM_PRENOM ON CLIENTS(NOM, PRENOM)";
-        indexQueries << "CREATE INDEX IDX_CLIENTS_VILLE ON CLIENTS(VILLE)";
-        indexQueries << "CREATE INDEX IDX_COMMANDES_CLIENT ON COMMANDES(ID_CLIENT)";
-        indexQueries << "CREATE INDEX IDX_COMMANDES_STATUT ON COMMANDES(STATUT)";
-        indexQueries << "CREATE INDEX IDX_COMMANDES_DATE ON COMMANDES(DATE_COMMANDE)";
-        indexQueries << "CREATE INDEX IDX_COMMANDES_NUMERO ON COMMANDES(NUMERO_COMMANDE)";
-        indexQueries << "CREATE INDEX IDX_COMMANDES_PRIORITE ON COMMANDES(PRIORITE)";
-        indexQueries << "CREATE INDEX IDX_COMMANDES_VILLE ON COMMANDES(VILLE_LIVRAISON)";
-    } else {
-        // SQLite-specific indexes with IF NOT EXISTS
-        indexQueries << "CREATE INDEX IF NOT EXISTS IDX_CLIENTS_EMAIL ON CLIENTS(EMAIL)";
-        indexQueries << "CREATE INDEX IF NOT EXISTS IDX_CLIENTS_NOM_PRENOM ON CLIENTS(NOM, PRENOM)";
-        indexQueries << "CREATE INDEX IF NOT EXISTS IDX_CLIENTS_VILLE ON CLIENTS(VILLE)";
-        indexQueries << "CREATE INDEX IF NOT EXISTS IDX_COMMANDES_CLIENT ON COMMANDES(ID_CLIENT)";
-        indexQueries << "CREATE INDEX IF NOT EXISTS IDX_COMMANDES_STATUT ON COMMANDES(STATUT)";
-        indexQueries << "CREATE INDEX IF NOT EXISTS IDX_COMMANDES_DATE ON COMMANDES(DATE_COMMANDE)";
-        indexQueries << "CREATE INDEX IF NOT EXISTS IDX_COMMANDES_NUMERO ON COMMANDES(NUMERO_COMMANDE)";
-        indexQueries << "CREATE INDEX IF NOT EXISTS IDX_COMMANDES_PRIORITE ON COMMANDES(PRIORITE)";
-        indexQueries << "CREATE INDEX IF NOT EXISTS IDX_COMMANDES_VILLE ON COMMANDES(VILLE_LIVRAISON)";
+    // SQLite verrouillée : la connexion reste valide
+    if (m_database.driverName() != "QOCI") {
+        return true;
     }
 
-    for (const QString& query : indexQueries) {
-        QSqlQuery sqlQuery = prepareQuery(query);
-        if (!sqlQuery.exec()) {
-            QString error = sqlQuery.lastError().text();
-            // Only show errors that are not "already exists" warnings
-            if (!error.contains("ORA-00955") && !error.contains("already exists") && !error.contains("duplicate")) {
-                qWarning() << "Erreur lors de la création des index:" << error;
-                qWarning() << "SQL:" << query;
-            }
-        }
+    return reconnect();
+}
+
+int DatabaseManager::effectiveRetryBudget() const
+{
+    // Thread graphique : une seule tentative, l'interface resterait sinon
+    // figée jusqu'à (budget + 1) fois le délai d'occupation SQLite
+    const QCoreApplication* app = QCoreApplication::instance();
+    if (app && QThread::currentThread() == app->thread()) {
+        return qMin(m_retryBudget, 1);
     }
+    return m_retryBudget;
+}
 
-    return true;
+bool DatabaseManager::isIdempotentRead(const QString& sql)
+{
+    const QString statement = sql.trimmed();
+    return statement.startsWith("SELECT", Qt::CaseInsensitive)
+        || statement.startsWith("WITH", Qt::CaseInsensitive);
 }
 
-bool DatabaseManager::createSequencesAndTriggers()
+void DatabaseManager::bindParams(QSqlQuery& query, const QVariantList& params)
 {
-    if (m_database.driverName() == "QOCI") {
-        // Oracle-specific sequences and triggers
-        QStringList queries;
-
-        // Séquence pour la génération des numéros de commande
-        queries << "CREATE SEQUENCE SEQ_NUMERO_COMMANDE START WITH 1000 INCREMENT BY 1";
-
-        // Trigger pour générer automatiquement le numéro de commande
-        queries << R"(
-            CREATE OR REPLACE TRIGGER TRG_NUMERO_COMMANDE
-            BEFORE INSERT ON COMMANDES
-            FOR EACH ROW
-            WHEN (NEW.NUMERO_COMMANDE IS NULL)
-            BEGIN
-                :NEW.NUMERO_COMMANDE := 'CMD' || LPAD(SEQ_NUMERO_COMMANDE.NEXTVAL, 6, '0');
-            END;
-        )";
-
-        for (const QString& query : queries) {
-            QSqlQuery sqlQuery = prepareQuery(query);
-            if (!sqlQuery.exec()) {
-                QString error = sqlQuery.lastError().text();
-                if (!error.contains("ORA-00955") && !error.contains("already exists")) {
-                    qWarning() << "Erreur lors de la création des séquences/triggers:" << error;
-                }
-            }
-        }
-    } else {
-        // SQLite doesn't need sequences (uses AUTOINCREMENT)
-        // and has limited trigger support, so we'll handle order numbers in the application
-        qInfo() << "SQLite: Using AUTOINCREMENT for primary keys, no additional sequences needed";
+    for (int i = 0; i < params.size(); ++i) {
+        query.bindValue(i, params.at(i));
+    }
+}
+
+bool DatabaseManager::migrateSchema()
+{
+    MigrationManager migrations(*this);
+    if (!migrations.migrate()) {
+        m_lastError = migrations.lastError();
+        qWarning() << "Erreur lors de la migration du schéma:" << m_lastError;
+        return false;
     }
 
+    qInfo() << "Schéma à jour (version" << migrations.currentVersion() << ")";
+
+    // Insérer des données de test si les tables sont vides
+    insertSampleData();
+
     return true;
 }
 
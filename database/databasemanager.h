@@ -8,6 +8,9 @@
 #include <QString>
 #include <QVariant>
 #include <QDebug>
+#include <QMutex>
+#include <QElapsedTimer>
+#include <functional>
 
 /**
  * @brief Gestionnaire de base de données singleton pour Oracle
@@ -20,6 +23,18 @@ class DatabaseManager : public QObject
     Q_OBJECT
 
 public:
+    /**
+     * @brief Compteurs des erreurs transitoires, rejeux et reconnexions
+     */
+    struct RetryStats {
+        quint64 transientErrors = 0;
+        quint64 statementRetries = 0;
+        quint64 transactionReplays = 0;
+        quint64 reconnects = 0;
+        quint64 failedReconnects = 0;
+        quint64 budgetExhausted = 0;
+    };
+
     /**
      * @brief Obtient l'instance unique du gestionnaire de base de données
      * @return Référence vers l'instance unique
@@ -31,11 +46,24 @@ public:
      * @return true si la connexion est établie avec succès
      */
     bool initialize();
+
+    /**
+     * @brief Force l'utilisation de SQLite sur un fichier donné (banc d'essai,
+     *        jeux de données synthétiques) ; à appeler avant initialize()
+     * @param databasePath Chemin du fichier SQLite
+     */
+    void setSQLiteDatabasePath(const QString& databasePath);
     
     /**
      * @brief Ferme la connexion à la base de données
      */
     void close();
+
+    /**
+     * @brief Rouvre la connexion principale avec les mêmes paramètres
+     * @return true si la connexion est rétablie
+     */
+    bool reconnect();
     
     /**
      * @brief Obtient la connexion à la base de données
@@ -50,9 +78,20 @@ public:
      * @return true si l'exécution réussit
      */
     bool executeQuery(QSqlQuery& query, const QVariantList& params = QVariantList());
+
+    /**
+     * @brief Exécute un traitement dans une transaction rejouée en cas d'erreur transitoire
+     *
+     * Le traitement complet (begin, work, commit) est rejoué après reconnexion
+     * tant que le budget de tentatives n'est pas épuisé. Il doit donc pouvoir
+     * être exécuté plusieurs fois.
+     * @param work Traitement à exécuter, renvoie false pour annuler
+     * @return true si la transaction est validée
+     */
+    bool runTransaction(const std::function<bool()>& work);
     
     /**
-     * @brief Prépare une requête SQL
+     * @brief Prépare une requête SQL en lecture séquentielle (forward-only)
      * @param sql La requête SQL à préparer
      * @return QSqlQuery préparée
      */
@@ -88,6 +127,36 @@ public:
      */
     QString lastError() const;
 
+    /**
+     * @brief Indique si une erreur est transitoire (session perdue, listener
+     *        indisponible, base SQLite verrouillée)
+     * @param error Erreur renvoyée par le driver
+     * @return true si l'opération peut être rejouée
+     */
+    bool isTransientError(const QSqlError& error) const;
+
+    /**
+     * @brief Nombre maximal de tentatives après une erreur transitoire
+     *
+     * Sur le thread graphique, le budget est plafonné à une tentative : chaque
+     * tentative SQLite peut attendre tout le délai d'occupation (5 s).
+     * @param attempts Nombre de tentatives (défaut: 4)
+     */
+    void setRetryBudget(int attempts);
+
+    /**
+     * @brief Requête en cours d'exécution (lisible depuis un autre thread)
+     * @param elapsedMs Reçoit la durée écoulée depuis son lancement (optionnel)
+     * @return Texte SQL, vide si aucune requête n'est en cours
+     */
+    QString currentStatement(qint64* elapsedMs = nullptr) const;
+
+    /**
+     * @brief Obtient les compteurs de rejeux et reconnexions
+     * @return Compteurs cumulés depuis le démarrage
+     */
+    RetryStats retryStats() const;
+
 private:
     DatabaseManager(QObject *parent = nullptr);
     ~DatabaseManager();
@@ -97,32 +166,58 @@ private:
     DatabaseManager& operator=(const DatabaseManager&) = delete;
     
     /**
-     * @brief Crée les tables si elles n'existent pas
-     * @return true si les tables sont créées avec succès
+     * @brief Applique les migrations de schéma en attente (voir MigrationManager)
+     * @return true si le schéma est à jour
      */
-    bool createTables();
+    bool migrateSchema();
 
     /**
-     * @brief Crée les index pour optimiser les performances
-     * @return true si les index sont créés avec succès
+     * @brief Insère des données de test
+     * @return true si les données sont insérées avec succès
      */
-    bool createIndexes();
+    bool insertSampleData();
 
     /**
-     * @brief Crée les séquences et triggers Oracle
-     * @return true si les séquences et triggers sont créés avec succès
+     * @brief Passe la base SQLite en journal WAL (lectures et écritures concurrentes)
      */
-    bool createSequencesAndTriggers();
+    void enableWriteAheadLog();
 
     /**
-     * @brief Insère des données de test
-     * @return true si les données sont insérées avec succès
+     * @brief Attend le délai de la tentative (hors thread graphique) puis
+     *        rouvre la session si nécessaire
+     * @param attempt Numéro de la tentative (1 pour la première)
+     * @return true si la connexion est utilisable
      */
-    bool insertSampleData();
+    bool recoverFromTransientError(int attempt);
+
+    /**
+     * @brief Budget de rejeu applicable au thread appelant
+     * @return m_retryBudget, plafonné à une tentative sur le thread graphique
+     */
+    int effectiveRetryBudget() const;
+
+    /**
+     * @brief Exécute une requête avec rejeu des lectures sur erreur transitoire
+     * @param query Requête préparée
+     * @param params Paramètres à lier
+     * @return true si l'exécution a réussi
+     */
+    bool executeWithRetry(QSqlQuery& query, const QVariantList& params);
+
+    static bool isIdempotentRead(const QString& sql);
+    static void bindParams(QSqlQuery& query, const QVariantList& params);
 
 private:
     QSqlDatabase m_database;
     QString m_lastError;
+    QSqlError m_lastSqlError;
+    mutable QMutex m_statementMutex;
+    QString m_currentStatement;
+    QElapsedTimer m_statementTimer;
+    QString m_sqlitePath;
+    bool m_inTransaction = false;
+    int m_retryBudget = 4;
+    RetryStats m_retryStats;
     static DatabaseManager* m_instance;
 };
 
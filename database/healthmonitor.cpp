@@ -0,0 +1,269 @@
+#include "healthmonitor.h"
+#include "databasemanager.h"
+#include "utils/percentile.h"
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QElapsedTimer>
+#include <QDebug>
+#include <algorithm>
+
+namespace {
+const char* const MAIN_CONNECTION = "LogisticsConnection";
+const char* const HEALTH_CONNECTION = "LogisticsHealthConnection";
+}
+
+// ---------------------------------------------------------------------------
+// HealthProbe
+// ---------------------------------------------------------------------------
+
+HealthProbe::HealthProbe(int intervalMs, int maxBackoffMs)
+    : QObject(nullptr)
+    , m_timer(nullptr)
+    , m_connectionName(HEALTH_CONNECTION)
+    , m_intervalMs(intervalMs)
+    , m_maxBackoffMs(maxBackoffMs)
+    , m_consecutiveFailures(0)
+{
+}
+
+void HealthProbe::start()
+{
+    // Le timer est créé dans le thread de la sonde
+    if (!m_timer) {
+        m_timer = new QTimer(this);
+        m_timer->setSingleShot(true);
+        connect(m_timer, &QTimer::timeout, this, &HealthProbe::probe);
+    }
+    probe();
+}
+
+void HealthProbe::stop()
+{
+    if (m_timer) {
+        m_timer->stop();
+    }
+
+    if (QSqlDatabase::contains(m_connectionName)) {
+        {
+            QSqlDatabase db = QSqlDatabase::database(m_connectionName, false);
+            db.close();
+        }
+        QSqlDatabase::removeDatabase(m_connectionName);
+    }
+}
+
+void HealthProbe::setInterval(int intervalMs)
+{
+    if (intervalMs > 0) {
+        m_intervalMs = intervalMs;
+    }
+}
+
+bool HealthProbe::ensureConnection(QString& error)
+{
+    if (!QSqlDatabase::contains(m_connectionName)) {
+        // Clone des paramètres de la connexion principale (driver, hôte, identifiants)
+        QSqlDatabase::cloneDatabase(MAIN_CONNECTION, m_connectionName);
+    }
+
+    QSqlDatabase db = QSqlDatabase::database(m_connectionName, false);
+    if (!db.isOpen() && !db.open()) {
+        error = db.lastError().text();
+        return false;
+    }
+
+    return true;
+}
+
+void HealthProbe::probe()
+{
+    QString error;
+    QElapsedTimer timer;
+    timer.start();
+
+    bool success = ensureConnection(error);
+    if (success) {
+        QSqlDatabase db = QSqlDatabase::database(m_connectionName, false);
+        QSqlQuery query(db);
+        const QString sql = db.driverName() == "QOCI" ? "SELECT 1 FROM DUAL" : "SELECT 1";
+        success = query.exec(sql) && query.next();
+        if (!success) {
+            error = query.lastError().text();
+            // Session probablement morte : forcer la réouverture au prochain essai
+            db.close();
+        }
+    }
+
+    emit probeCompleted(success, timer.nsecsElapsed() / 1.0e6, error);
+    scheduleNext(success);
+}
+
+void HealthProbe::scheduleNext(bool success)
+{
+    if (!m_timer) {
+        return;
+    }
+
+    int delay = m_intervalMs;
+    if (success) {
+        m_consecutiveFailures = 0;
+    } else {
+        // Délai exponentiel : 1x, 2x, 4x ... l'intervalle, plafonné
+        ++m_consecutiveFailures;
+        const int shift = std::min(m_consecutiveFailures - 1, 6);
+        delay = std::min(m_intervalMs << shift, m_maxBackoffMs);
+    }
+
+    m_timer->start(delay);
+}
+
+// ---------------------------------------------------------------------------
+// DatabaseHealthMonitor
+// ---------------------------------------------------------------------------
+
+DatabaseHealthMonitor::DatabaseHealthMonitor(QObject *parent)
+    : QObject(parent)
+    , m_probe(new HealthProbe(5000, 60000))
+    , m_state(INCONNU)
+    , m_degradedThresholdMs(250.0)
+    , m_nextSample(0)
+    , m_slowStreak(0)
+    , m_fastStreak(0)
+    , m_mainSessionStale(false)
+{
+    m_thread.setObjectName("DatabaseHealthMonitor");
+    m_probe->moveToThread(&m_thread);
+
+    connect(&m_thread, &QThread::finished, m_probe, &QObject::deleteLater);
+    connect(m_probe, &HealthProbe::probeCompleted, this, &DatabaseHealthMonitor::onProbeCompleted);
+
+    m_samples.reserve(SAMPLE_CAPACITY);
+}
+
+DatabaseHealthMonitor::~DatabaseHealthMonitor()
+{
+    stop();
+
+    // Sonde jamais démarrée : deleteLater() n'a pas été déclenché par le thread
+    if (!m_thread.isFinished()) {
+        delete m_probe;
+    }
+}
+
+void DatabaseHealthMonitor::start(int intervalMs)
+{
+    if (m_thread.isRunning()) {
+        return;
+    }
+
+    m_probe->setInterval(intervalMs);
+    m_thread.start(QThread::LowPriority);
+    QMetaObject::invokeMethod(m_probe, "start", Qt::QueuedConnection);
+}
+
+void DatabaseHealthMonitor::stop()
+{
+    if (!m_thread.isRunning()) {
+        return;
+    }
+
+    QMetaObject::invokeMethod(m_probe, "stop", Qt::BlockingQueuedConnection);
+    m_thread.quit();
+    m_thread.wait();
+}
+
+void DatabaseHealthMonitor::setDegradedThresholdMs(double thresholdMs)
+{
+    if (thresholdMs > 0.0) {
+        m_degradedThresholdMs = thresholdMs;
+    }
+}
+
+DatabaseHealthMonitor::State DatabaseHealthMonitor::state() const
+{
+    return m_state;
+}
+
+double DatabaseHealthMonitor::latencyPercentile(double percentile) const
+{
+    return percentileOf(m_samples, percentile);
+}
+
+QDateTime DatabaseHealthMonitor::lastSuccess() const
+{
+    return m_lastSuccess;
+}
+
+QString DatabaseHealthMonitor::stateToString(State state)
+{
+    switch (state) {
+        case CONNECTE: return "Connecté";
+        case DEGRADE: return "Dégradé";
+        case DECONNECTE: return "Déconnecté";
+        default: return "Inconnu";
+    }
+}
+
+void DatabaseHealthMonitor::onProbeCompleted(bool success, double latencyMs, const QString& error)
+{
+    if (!success) {
+        // La connexion principale partage le même serveur : sa session Oracle est
+        // présumée périmée. SQLite n'a pas de session serveur : rien à rouvrir, et
+        // une reconnexion invaliderait les requêtes en cours du thread graphique
+        m_mainSessionStale = DatabaseManager::instance().database().driverName() == "QOCI";
+        m_slowStreak = 0;
+        m_fastStreak = 0;
+        setState(DECONNECTE, error);
+        return;
+    }
+
+    // Tampon circulaire des dernières latences
+    if (m_samples.size() < SAMPLE_CAPACITY) {
+        m_samples.append(latencyMs);
+    } else {
+        m_samples[m_nextSample] = latencyMs;
+    }
+    m_nextSample = (m_nextSample + 1) % SAMPLE_CAPACITY;
+    m_lastSuccess = QDateTime::currentDateTime();
+
+    if (m_mainSessionStale) {
+        m_mainSessionStale = false;
+        const bool ok = DatabaseManager::instance().reconnect();
+        emit reconnected(ok);
+    }
+
+    const QString message = QString("p50 %1 ms, p95 %2 ms")
+                                .arg(latencyPercentile(50), 0, 'f', 1)
+                                .arg(latencyPercentile(95), 0, 'f', 1);
+
+    // Hystérésis : DEGRADE après plusieurs pings lents consécutifs, retour à
+    // CONNECTE après autant de pings rapides ; un rétablissement est immédiat
+    if (latencyMs > m_degradedThresholdMs) {
+        ++m_slowStreak;
+        m_fastStreak = 0;
+    } else {
+        ++m_fastStreak;
+        m_slowStreak = 0;
+    }
+
+    State next = m_state;
+    if (m_slowStreak >= STATE_CHANGE_SAMPLES) {
+        next = DEGRADE;
+    } else if (m_state != DEGRADE || m_fastStreak >= STATE_CHANGE_SAMPLES) {
+        next = CONNECTE;
+    }
+    setState(next, message);
+}
+
+void DatabaseHealthMonitor::setState(State state, const QString& message)
+{
+    if (state == m_state) {
+        return;
+    }
+
+    qInfo() << "État de la base de données:" << stateToString(m_state)
+            << "->" << stateToString(state) << message;
+    m_state = state;
+    emit stateChanged(state, message);
+}
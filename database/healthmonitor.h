@@ -0,0 +1,150 @@
+#ifndef HEALTHMONITOR_H
+#define HEALTHMONITOR_H
+
+#include <QObject>
+#include <QString>
+#include <QVector>
+#include <QThread>
+#include <QTimer>
+#include <QDateTime>
+
+/**
+ * @brief Sonde exécutée dans le thread du moniteur
+ *
+ * Possède sa propre connexion (clone de la connexion principale) et exécute
+ * un ping léger à intervalle régulier. En cas d'échec, la connexion est
+ * rouverte avec un délai exponentiel plafonné.
+ */
+class HealthProbe : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit HealthProbe(int intervalMs, int maxBackoffMs);
+
+public slots:
+    void start();
+    void stop();
+    void setInterval(int intervalMs);
+
+signals:
+    /**
+     * @brief Résultat d'un ping
+     * @param success true si la requête a abouti
+     * @param latencyMs Temps aller-retour en millisecondes
+     * @param error Message d'erreur éventuel
+     */
+    void probeCompleted(bool success, double latencyMs, const QString& error);
+
+private slots:
+    void probe();
+
+private:
+    bool ensureConnection(QString& error);
+    void scheduleNext(bool success);
+
+private:
+    QTimer *m_timer;
+    QString m_connectionName;
+    int m_intervalMs;
+    int m_maxBackoffMs;
+    int m_consecutiveFailures;
+};
+
+/**
+ * @brief Moniteur de santé de la base de données
+ *
+ * Pilote une HealthProbe dans un thread dédié, conserve les dernières
+ * latences pour calculer des percentiles et n'émet stateChanged() que lors
+ * d'une transition d'état. Le passage à DEGRADE, et le retour à CONNECTE,
+ * demandent plusieurs pings consécutifs du même côté du seuil : un ping
+ * lent isolé ne fait pas clignoter l'indicateur. Lorsqu'une panne est suivie d'un rétablissement,
+ * la connexion principale (probablement périmée) est rouverte.
+ */
+class DatabaseHealthMonitor : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum State {
+        INCONNU,
+        CONNECTE,
+        DEGRADE,
+        DECONNECTE
+    };
+    Q_ENUM(State)
+
+    explicit DatabaseHealthMonitor(QObject *parent = nullptr);
+    ~DatabaseHealthMonitor();
+
+    /**
+     * @brief Démarre la surveillance
+     * @param intervalMs Intervalle entre deux pings (défaut: 5000 ms)
+     */
+    void start(int intervalMs = 5000);
+
+    /**
+     * @brief Arrête la surveillance et ferme la connexion de la sonde
+     */
+    void stop();
+
+    /**
+     * @brief Seuil de latence au-delà duquel l'état passe à DEGRADE
+     *        (après plusieurs pings consécutifs au-dessus du seuil)
+     * @param thresholdMs Seuil en millisecondes (défaut: 250 ms)
+     */
+    void setDegradedThresholdMs(double thresholdMs);
+
+    State state() const;
+
+    /**
+     * @brief Percentile des latences récentes
+     * @param percentile Valeur entre 0 et 100 (ex. 50, 95, 99)
+     * @return Latence en millisecondes, 0 si aucune mesure
+     */
+    double latencyPercentile(double percentile) const;
+
+    /**
+     * @brief Date du dernier ping réussi
+     */
+    QDateTime lastSuccess() const;
+
+    static QString stateToString(State state);
+
+signals:
+    /**
+     * @brief Émis uniquement lors d'un changement d'état
+     * @param state Nouvel état
+     * @param message Détail (latence ou erreur)
+     */
+    void stateChanged(DatabaseHealthMonitor::State state, const QString& message);
+
+    /**
+     * @brief Émis après la réouverture de la connexion principale
+     * @param success true si la reconnexion a réussi
+     */
+    void reconnected(bool success);
+
+private slots:
+    void onProbeCompleted(bool success, double latencyMs, const QString& error);
+
+private:
+    void setState(State state, const QString& message);
+
+private:
+    static const int SAMPLE_CAPACITY = 256;
+    static const int STATE_CHANGE_SAMPLES = 3;  // Pings consécutifs pour entrer/sortir de DEGRADE
+
+    QThread m_thread;
+    HealthProbe *m_probe;
+    State m_state;
+    double m_degradedThresholdMs;
+    QVector<double> m_samples;
+    int m_nextSample;
+    int m_slowStreak;
+    int m_fastStreak;
+    bool m_mainSessionStale;
+    QDateTime m_lastSuccess;
+};
+
+#endif // HEALTHMONITOR_H
@@ -0,0 +1,432 @@
+#include "migrationmanager.h"
+#include "databasemanager.h"
+#include "schemamanager.h"
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QElapsedTimer>
+#include <QDebug>
+
+MigrationManager::MigrationManager(DatabaseManager& db)
+    : m_db(db)
+{
+}
+
+QList<MigrationManager::Migration> MigrationManager::migrations()
+{
+    QList<Migration> list;
+
+    // Version 1 : schéma initial (tables, séquence et trigger Oracle)
+    Migration initial;
+    initial.version = 1;
+    initial.description = "Schéma initial CLIENTS / COMMANDES";
+    initial.oracleSteps << R"(
+        CREATE TABLE CLIENTS (
+            ID_CLIENT NUMBER GENERATED BY DEFAULT AS IDENTITY PRIMARY KEY,
+            NOM VARCHAR2(100) NOT NULL,
+            PRENOM VARCHAR2(100) NOT NULL,
+            EMAIL VARCHAR2(150) UNIQUE NOT NULL,
+            TELEPHONE VARCHAR2(20) NOT NULL,
+            ADRESSE VARCHAR2(500) NOT NULL,
+            VILLE VARCHAR2(100) NOT NULL,
+            CODE_POSTAL VARCHAR2(10) NOT NULL,
+            DATE_CREATION DATE DEFAULT SYSDATE,
+            STATUT VARCHAR2(20) DEFAULT 'ACTIF' CHECK (STATUT IN ('ACTIF', 'INACTIF', 'SUSPENDU'))
+        )
+    )";
+    initial.oracleSteps << R"(
+        CREATE TABLE COMMANDES (
+            ID_COMMANDE NUMBER GENERATED BY DEFAULT AS IDENTITY PRIMARY KEY,
+            ID_CLIENT NUMBER NOT NULL,
+            NUMERO_COMMANDE VARCHAR2(50) UNIQUE NOT NULL,
+            DATE_COMMANDE DATE DEFAULT SYSDATE,
+            DATE_LIVRAISON_PREVUE DATE,
+            DATE_LIVRAISON_REELLE DATE,
+            ADRESSE_LIVRAISON VARCHAR2(500) NOT NULL,
+            VILLE_LIVRAISON VARCHAR2(100) NOT NULL,
+            CODE_POSTAL_LIVRAISON VARCHAR2(10) NOT NULL,
+            STATUT VARCHAR2(30) DEFAULT 'EN_ATTENTE' CHECK (STATUT IN ('EN_ATTENTE', 'CONFIRMEE', 'EN_PREPARATION', 'EN_TRANSIT', 'LIVREE', 'ANNULEE')),
+            PRIORITE VARCHAR2(20) DEFAULT 'NORMALE' CHECK (PRIORITE IN ('BASSE', 'NORMALE', 'HAUTE', 'URGENTE')),
+            POIDS_TOTAL NUMBER(8,2) DEFAULT 0,
+            VOLUME_TOTAL NUMBER(8,2) DEFAULT 0,
+            PRIX_TOTAL NUMBER(10,2) DEFAULT 0,
+            COMMENTAIRES VARCHAR2(1000),
+            CONSTRAINT FK_COMMANDE_CLIENT FOREIGN KEY (ID_CLIENT) REFERENCES CLIENTS(ID_CLIENT) ON DELETE CASCADE
+        )
+    )";
+    initial.oracleSteps << "CREATE SEQUENCE SEQ_NUMERO_COMMANDE START WITH 1000 INCREMENT BY 1";
+    initial.oracleSteps << R"(
+        CREATE OR REPLACE TRIGGER TRG_NUMERO_COMMANDE
+        BEFORE INSERT ON COMMANDES
+        FOR EACH ROW
+        WHEN (NEW.NUMERO_COMMANDE IS NULL)
+        BEGIN
+            :NEW.NUMERO_COMMANDE := 'CMD' || LPAD(SEQ_NUMERO_COMMANDE.NEXTVAL, 6, '0');
+        END;
+    )";
+    initial.sqliteSteps << R"(
+        CREATE TABLE IF NOT EXISTS CLIENTS (
+            ID_CLIENT INTEGER PRIMARY KEY AUTOINCREMENT,
+            NOM TEXT NOT NULL,
+            PRENOM TEXT NOT NULL,
+            EMAIL TEXT UNIQUE NOT NULL,
+            TELEPHONE TEXT NOT NULL,
+            ADRESSE TEXT NOT NULL,
+            VILLE TEXT NOT NULL,
+            CODE_POSTAL TEXT NOT NULL,
+            DATE_CREATION DATETIME DEFAULT CURRENT_TIMESTAMP,
+            STATUT TEXT DEFAULT 'ACTIF' CHECK (STATUT IN ('ACTIF', 'INACTIF', 'SUSPENDU'))
+        )
+    )";
+    initial.sqliteSteps << R"(
+        CREATE TABLE IF NOT EXISTS COMMANDES (
+            ID_COMMANDE INTEGER PRIMARY KEY AUTOINCREMENT,
+            ID_CLIENT INTEGER NOT NULL,
+            NUMERO_COMMANDE TEXT UNIQUE NOT NULL,
+            DATE_COMMANDE DATETIME DEFAULT CURRENT_TIMESTAMP,
+            DATE_LIVRAISON_PREVUE DATETIME,
+            DATE_LIVRAISON_REELLE DATETIME,
+            ADRESSE_LIVRAISON TEXT NOT NULL,
+            VILLE_LIVRAISON TEXT NOT NULL,
+            CODE_POSTAL_LIVRAISON TEXT NOT NULL,
+            STATUT TEXT DEFAULT 'EN_ATTENTE' CHECK (STATUT IN ('EN_ATTENTE', 'CONFIRMEE', 'EN_PREPARATION', 'EN_TRANSIT', 'LIVREE', 'ANNULEE')),
+            PRIORITE TEXT DEFAULT 'NORMALE' CHECK (PRIORITE IN ('BASSE', 'NORMALE', 'HAUTE', 'URGENTE')),
+            POIDS_TOTAL REAL DEFAULT 0,
+            VOLUME_TOTAL REAL DEFAULT 0,
+            PRIX_TOTAL REAL DEFAULT 0,
+            COMMENTAIRES TEXT,
+            FOREIGN KEY (ID_CLIENT) REFERENCES CLIENTS(ID_CLIENT) ON DELETE CASCADE
+        )
+    )";
+    list << initial;
+
+    // Version 2 : index composites/couvrants, suppression des index redondants.
+    // SQL figé : une migration appliquée ne change plus ; tout nouvel index est
+    // déployé par une nouvelle migration.
+    // Seule exception : IDX_CLIENTS_EMAIL, doublon de la contrainte UNIQUE
+    // (ORA-01408, jamais créé sous Oracle), retiré ici et supprimé par la version 5
+    Migration indexes;
+    indexes.version = 2;
+    indexes.description = "Index composites et couvrants";
+    indexes.oracleSteps = {
+        "DROP INDEX IDX_COMMANDES_NUMERO ONLINE",
+        "DROP INDEX IDX_COMMANDES_STATUT ONLINE",
+        "DROP INDEX IDX_COMMANDES_CLIENT ONLINE",
+        "DROP INDEX IDX_COMMANDES_PRIORITE ONLINE",
+        "CREATE INDEX IDX_CLIENTS_NOM_PRENOM ON CLIENTS(NOM, PRENOM) ONLINE",
+        "CREATE INDEX IDX_CLIENTS_VILLE ON CLIENTS(VILLE) ONLINE",
+        "CREATE INDEX IDX_COMMANDES_STATUT_LIVRAISON ON COMMANDES(STATUT, DATE_LIVRAISON_PREVUE) ONLINE",
+        "CREATE INDEX IDX_COMMANDES_CLIENT_STATUT ON COMMANDES(ID_CLIENT, STATUT) ONLINE",
+        "CREATE INDEX IDX_COMMANDES_DATE ON COMMANDES(DATE_COMMANDE) ONLINE",
+        "CREATE INDEX IDX_COMMANDES_VILLE ON COMMANDES(VILLE_LIVRAISON) ONLINE",
+        "CREATE INDEX IDX_COMMANDES_STATUT_PRIX ON COMMANDES(STATUT, PRIX_TOTAL) ONLINE",
+        "CREATE INDEX IDX_COMMANDES_PRIORITE_PRIX ON COMMANDES(PRIORITE, PRIX_TOTAL) ONLINE"
+    };
+    indexes.sqliteSteps = {
+        "DROP INDEX IF EXISTS IDX_COMMANDES_NUMERO",
+        "DROP INDEX IF EXISTS IDX_COMMANDES_STATUT",
+        "DROP INDEX IF EXISTS IDX_COMMANDES_CLIENT",
+        "DROP INDEX IF EXISTS IDX_COMMANDES_PRIORITE",
+        "CREATE INDEX IF NOT EXISTS IDX_CLIENTS_NOM_PRENOM ON CLIENTS(NOM, PRENOM)",
+        "CREATE INDEX IF NOT EXISTS IDX_CLIENTS_VILLE ON CLIENTS(VILLE)",
+        "CREATE INDEX IF NOT EXISTS IDX_COMMANDES_STATUT_LIVRAISON ON COMMANDES(STATUT, DATE_LIVRAISON_PREVUE)",
+        "CREATE INDEX IF NOT EXISTS IDX_COMMANDES_CLIENT_STATUT ON COMMANDES(ID_CLIENT, STATUT)",
+        "CREATE INDEX IF NOT EXISTS IDX_COMMANDES_DATE ON COMMANDES(DATE_COMMANDE)",
+        "CREATE INDEX IF NOT EXISTS IDX_COMMANDES_VILLE ON COMMANDES(VILLE_LIVRAISON)",
+        "CREATE INDEX IF NOT EXISTS IDX_COMMANDES_STATUT_PRIX ON COMMANDES(STATUT, PRIX_TOTAL)",
+        "CREATE INDEX IF NOT EXISTS IDX_COMMANDES_PRIORITE_PRIX ON COMMANDES(PRIORITE, PRIX_TOTAL)"
+    };
+    list << indexes;
+
+    // Version 3 : table d'archive des commandes livrées/annulées anciennes
+    Migration archive;
+    archive.version = 3;
+    archive.description = "Table COMMANDES_ARCHIVE";
+    archive.oracleSteps << R"(
+        CREATE TABLE COMMANDES_ARCHIVE (
+            ID_COMMANDE NUMBER PRIMARY KEY,
+            ID_CLIENT NUMBER NOT NULL,
+            NUMERO_COMMANDE VARCHAR2(50) NOT NULL,
+            DATE_COMMANDE DATE,
+            DATE_LIVRAISON_PREVUE DATE,
+            DATE_LIVRAISON_REELLE DATE,
+            ADRESSE_LIVRAISON VARCHAR2(500) NOT NULL,
+            VILLE_LIVRAISON VARCHAR2(100) NOT NULL,
+            CODE_POSTAL_LIVRAISON VARCHAR2(10) NOT NULL,
+            STATUT VARCHAR2(30) NOT NULL,
+            PRIORITE VARCHAR2(20),
+            POIDS_TOTAL NUMBER(8,2),
+            VOLUME_TOTAL NUMBER(8,2),
+            PRIX_TOTAL NUMBER(10,2),
+            COMMENTAIRES VARCHAR2(1000),
+            DATE_ARCHIVAGE DATE DEFAULT SYSDATE,
+            CONSTRAINT FK_ARCHIVE_CLIENT FOREIGN KEY (ID_CLIENT) REFERENCES CLIENTS(ID_CLIENT) ON DELETE CASCADE
+        )
+    )";
+    archive.oracleSteps << "CREATE INDEX IDX_ARCHIVE_DATE ON COMMANDES_ARCHIVE(DATE_COMMANDE) ONLINE";
+    archive.oracleSteps << "CREATE INDEX IDX_ARCHIVE_CLIENT ON COMMANDES_ARCHIVE(ID_CLIENT) ONLINE";
+    archive.sqliteSteps << R"(
+        CREATE TABLE IF NOT EXISTS COMMANDES_ARCHIVE (
+            ID_COMMANDE INTEGER PRIMARY KEY,
+            ID_CLIENT INTEGER NOT NULL,
+            NUMERO_COMMANDE TEXT NOT NULL,
+            DATE_COMMANDE DATETIME,
+            DATE_LIVRAISON_PREVUE DATETIME,
+            DATE_LIVRAISON_REELLE DATETIME,
+            ADRESSE_LIVRAISON TEXT NOT NULL,
+            VILLE_LIVRAISON TEXT NOT NULL,
+            CODE_POSTAL_LIVRAISON TEXT NOT NULL,
+            STATUT TEXT NOT NULL,
+            PRIORITE TEXT,
+            POIDS_TOTAL REAL,
+            VOLUME_TOTAL REAL,
+            PRIX_TOTAL REAL,
+            COMMENTAIRES TEXT,
+            DATE_ARCHIVAGE DATETIME DEFAULT CURRENT_TIMESTAMP,
+            FOREIGN KEY (ID_CLIENT) REFERENCES CLIENTS(ID_CLIENT) ON DELETE CASCADE
+        )
+    )";
+    archive.sqliteSteps << "CREATE INDEX IF NOT EXISTS IDX_ARCHIVE_DATE ON COMMANDES_ARCHIVE(DATE_COMMANDE)";
+    archive.sqliteSteps << "CREATE INDEX IF NOT EXISTS IDX_ARCHIVE_CLIENT ON COMMANDES_ARCHIVE(ID_CLIENT)";
+    list << archive;
+
+    // Version 4 : file d'envoi persistante des emails
+    Migration outbox;
+    outbox.version = 4;
+    outbox.description = "Table EMAIL_OUTBOX";
+    outbox.oracleSteps << R"(
+        CREATE TABLE EMAIL_OUTBOX (
+            ID_EMAIL NUMBER GENERATED BY DEFAULT AS IDENTITY PRIMARY KEY,
+            CLE_DEDOUBLONNAGE VARCHAR2(200) UNIQUE,
+            DESTINATAIRE VARCHAR2(150) NOT NULL,
+            SUJET VARCHAR2(500) NOT NULL,
+            CORPS_TEXTE CLOB,
+            CORPS_HTML CLOB,
+            STATUT VARCHAR2(20) DEFAULT 'EN_ATTENTE' CHECK (STATUT IN ('EN_ATTENTE', 'EN_COURS', 'ENVOYE', 'ECHEC')),
+            TENTATIVES NUMBER DEFAULT 0,
+            PROCHAINE_TENTATIVE DATE NOT NULL,
+            DERNIERE_ERREUR VARCHAR2(1000),
+            DATE_CREATION DATE DEFAULT SYSDATE,
+            DATE_ENVOI DATE
+        )
+    )";
+    outbox.oracleSteps << "CREATE INDEX IDX_OUTBOX_STATUT ON EMAIL_OUTBOX(STATUT, PROCHAINE_TENTATIVE) ONLINE";
+    outbox.sqliteSteps << R"(
+        CREATE TABLE IF NOT EXISTS EMAIL_OUTBOX (
+            ID_EMAIL INTEGER PRIMARY KEY AUTOINCREMENT,
+            CLE_DEDOUBLONNAGE TEXT UNIQUE,
+            DESTINATAIRE TEXT NOT NULL,
+            SUJET TEXT NOT NULL,
+            CORPS_TEXTE TEXT,
+            CORPS_HTML TEXT,
+            STATUT TEXT DEFAULT 'EN_ATTENTE' CHECK (STATUT IN ('EN_ATTENTE', 'EN_COURS', 'ENVOYE', 'ECHEC')),
+            TENTATIVES INTEGER DEFAULT 0,
+            PROCHAINE_TENTATIVE DATETIME NOT NULL,
+            DERNIERE_ERREUR TEXT,
+            DATE_CREATION DATETIME DEFAULT CURRENT_TIMESTAMP,
+            DATE_ENVOI DATETIME
+        )
+    )";
+    outbox.sqliteSteps << "CREATE INDEX IF NOT EXISTS IDX_OUTBOX_STATUT ON EMAIL_OUTBOX(STATUT, PROCHAINE_TENTATIVE)";
+    list << outbox;
+
+    // Version 5 : index sur LOWER(EMAIL) pour Client::findByEmail, dont le
+    // filtre insensible à la casse ne peut pas utiliser l'index de la contrainte UNIQUE
+    Migration emailIndex;
+    emailIndex.version = 5;
+    emailIndex.description = "Index LOWER(EMAIL)";
+    emailIndex.oracleSteps << "DROP INDEX IDX_CLIENTS_EMAIL ONLINE";
+    emailIndex.oracleSteps << "CREATE INDEX IDX_CLIENTS_EMAIL_LOWER ON CLIENTS(LOWER(EMAIL)) ONLINE";
+    emailIndex.sqliteSteps << "DROP INDEX IF EXISTS IDX_CLIENTS_EMAIL";
+    emailIndex.sqliteSteps << "CREATE INDEX IF NOT EXISTS IDX_CLIENTS_EMAIL_LOWER ON CLIENTS(LOWER(EMAIL))";
+    list << emailIndex;
+
+    // Version 6 : expéditeur enregistré avec chaque message de la file
+    Migration outboxSender;
+    outboxSender.version = 6;
+    outboxSender.description = "Expéditeur des messages EMAIL_OUTBOX";
+    outboxSender.oracleSteps << R"(
+        ALTER TABLE EMAIL_OUTBOX ADD (
+            EXPEDITEUR VARCHAR2(150),
+            NOM_EXPEDITEUR VARCHAR2(150),
+            REPONDRE_A VARCHAR2(150)
+        )
+    )";
+    outboxSender.sqliteSteps << "ALTER TABLE EMAIL_OUTBOX ADD COLUMN EXPEDITEUR TEXT";
+    outboxSender.sqliteSteps << "ALTER TABLE EMAIL_OUTBOX ADD COLUMN NOM_EXPEDITEUR TEXT";
+    outboxSender.sqliteSteps << "ALTER TABLE EMAIL_OUTBOX ADD COLUMN REPONDRE_A TEXT";
+    list << outboxSender;
+
+    return list;
+}
+
+int MigrationManager::latestVersion()
+{
+    const QList<Migration> list = migrations();
+    return list.isEmpty() ? 0 : list.last().version;
+}
+
+bool MigrationManager::migrate()
+{
+    m_steps.clear();
+
+    if (!ensureVersionTable() || !adoptLegacySchema()) {
+        return false;
+    }
+
+    const int current = currentVersion();
+    qInfo() << "Version du schéma:" << current << "/ dernière version:" << latestVersion();
+
+    for (const Migration& migration : migrations()) {
+        if (migration.version <= current) {
+            continue;
+        }
+        if (!applyMigration(migration)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int MigrationManager::currentVersion()
+{
+    QSqlQuery query = m_db.prepareQuery("SELECT MAX(VERSION) FROM SCHEMA_VERSION");
+    if (!m_db.executeQuery(query) || !query.next()) {
+        return 0;
+    }
+
+    return query.value(0).toInt();
+}
+
+QList<MigrationManager::StepResult> MigrationManager::executedSteps() const
+{
+    return m_steps;
+}
+
+QString MigrationManager::lastError() const
+{
+    return m_lastError;
+}
+
+bool MigrationManager::ensureVersionTable()
+{
+    if (m_db.database().tables().contains("SCHEMA_VERSION", Qt::CaseInsensitive)) {
+        return true;
+    }
+
+    QString sql;
+    if (m_db.database().driverName() == "QOCI") {
+        sql = R"(
+            CREATE TABLE SCHEMA_VERSION (
+                VERSION NUMBER PRIMARY KEY,
+                DESCRIPTION VARCHAR2(200) NOT NULL,
+                APPLIED_AT DATE DEFAULT SYSDATE,
+                DURATION_MS NUMBER DEFAULT 0
+            )
+        )";
+    } else {
+        sql = R"(
+            CREATE TABLE IF NOT EXISTS SCHEMA_VERSION (
+                VERSION INTEGER PRIMARY KEY,
+                DESCRIPTION TEXT NOT NULL,
+                APPLIED_AT DATETIME DEFAULT CURRENT_TIMESTAMP,
+                DURATION_MS INTEGER DEFAULT 0
+            )
+        )";
+    }
+
+    QSqlQuery query(m_db.database());
+    if (!query.exec(sql) && !SchemaManager::isIgnorableError(sql, query.lastError().text())) {
+        m_lastError = query.lastError().text();
+        qCritical() << "Impossible de créer la table SCHEMA_VERSION:" << m_lastError;
+        return false;
+    }
+
+    return true;
+}
+
+bool MigrationManager::adoptLegacySchema()
+{
+    // Base créée avant l'introduction des migrations : les tables existent
+    // déjà mais aucune version n'est enregistrée, on marque la version 1
+    if (currentVersion() > 0
+        || !m_db.database().tables().contains("COMMANDES", Qt::CaseInsensitive)) {
+        return true;
+    }
+
+    qInfo() << "Schéma existant sans version détecté, enregistrement de la version 1";
+    return recordVersion(migrations().first(), 0);
+}
+
+bool MigrationManager::applyMigration(const Migration& migration)
+{
+    const bool isOracle = m_db.database().driverName() == "QOCI";
+    const QStringList& steps = isOracle ? migration.oracleSteps : migration.sqliteSteps;
+
+    qInfo() << "Application de la migration" << migration.version << ":" << migration.description;
+
+    // Le DDL Oracle valide implicitement : la transaction ne vaut que pour SQLite
+    const bool transactional = !isOracle;
+    if (transactional && !m_db.beginTransaction()) {
+        m_lastError = m_db.lastError();
+        return false;
+    }
+
+    QElapsedTimer total;
+    total.start();
+
+    for (int i = 0; i < steps.size(); ++i) {
+        QElapsedTimer timer;
+        timer.start();
+
+        QSqlQuery query(m_db.database());
+        bool success = query.exec(steps.at(i));
+        if (!success && SchemaManager::isIgnorableError(steps.at(i), query.lastError().text())) {
+            // Objet déjà présent (ou déjà supprimé) : étape considérée comme appliquée
+            success = true;
+        }
+
+        const StepResult result{migration.version, steps.at(i).simplified(), timer.elapsed(), success};
+        m_steps.append(result);
+        qInfo().noquote() << QString("  v%1 étape %2/%3 : %4 ms")
+                             .arg(migration.version).arg(i + 1).arg(steps.size()).arg(result.elapsedMs)
+                          << result.sql.left(80);
+
+        if (!success) {
+            m_lastError = query.lastError().text();
+            qCritical() << "Échec de la migration" << migration.version << ":" << m_lastError;
+            if (transactional) {
+                m_db.rollbackTransaction();
+            }
+            return false;
+        }
+    }
+
+    if (!recordVersion(migration, total.elapsed())) {
+        if (transactional) {
+            m_db.rollbackTransaction();
+        }
+        return false;
+    }
+
+    if (transactional && !m_db.commitTransaction()) {
+        m_lastError = m_db.lastError();
+        return false;
+    }
+
+    qInfo() << "Migration" << migration.version << "appliquée en" << total.elapsed() << "ms";
+    return true;
+}
+
+bool MigrationManager::recordVersion(const Migration& migration, qint64 elapsedMs)
+{
+    QSqlQuery query = m_db.prepareQuery(
+        "INSERT INTO SCHEMA_VERSION (VERSION, DESCRIPTION, DURATION_MS) VALUES (?, ?, ?)");
+
+    if (!m_db.executeQuery(query, {migration.version, migration.description, elapsedMs})) {
+        m_lastError = m_db.lastError();
+        return false;
+    }
+
+    return true;
+}
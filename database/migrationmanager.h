@@ -0,0 +1,95 @@
+#ifndef MIGRATIONMANAGER_H
+#define MIGRATIONMANAGER_H
+
+#include <QString>
+#include <QStringList>
+#include <QList>
+
+class DatabaseManager;
+
+/**
+ * @brief Moteur de migrations de schéma versionnées
+ *
+ * Les migrations sont numérotées, ordonnées et définies pour chaque driver
+ * (Oracle et SQLite). La version appliquée est conservée dans la table
+ * SCHEMA_VERSION ; seules les migrations postérieures sont exécutées, étape
+ * par étape, avec mesure du temps de chaque étape.
+ */
+class MigrationManager
+{
+public:
+    /**
+     * @brief Migration montante pour une version du schéma
+     */
+    struct Migration {
+        int version;
+        QString description;
+        QStringList oracleSteps;
+        QStringList sqliteSteps;
+    };
+
+    /**
+     * @brief Résultat d'exécution d'une étape de migration
+     */
+    struct StepResult {
+        int version;
+        QString sql;
+        qint64 elapsedMs;
+        bool success;
+    };
+
+    /**
+     * @brief Constructeur
+     * @param db Gestionnaire de base de données connecté
+     */
+    explicit MigrationManager(DatabaseManager& db);
+
+    /**
+     * @brief Applique toutes les migrations en attente
+     * @return true si le schéma est à jour
+     */
+    bool migrate();
+
+    /**
+     * @brief Version actuellement appliquée du schéma
+     * @return Numéro de version, 0 si aucune migration n'est appliquée
+     */
+    int currentVersion();
+
+    /**
+     * @brief Dernière version connue du code
+     * @return Numéro de la dernière migration
+     */
+    static int latestVersion();
+
+    /**
+     * @brief Liste ordonnée des migrations
+     * @return Migrations par version croissante
+     */
+    static QList<Migration> migrations();
+
+    /**
+     * @brief Étapes exécutées lors du dernier appel à migrate()
+     * @return Résultats avec durée de chaque étape
+     */
+    QList<StepResult> executedSteps() const;
+
+    /**
+     * @brief Obtient la dernière erreur
+     * @return Description de la dernière erreur
+     */
+    QString lastError() const;
+
+private:
+    bool ensureVersionTable();
+    bool adoptLegacySchema();
+    bool applyMigration(const Migration& migration);
+    bool recordVersion(const Migration& migration, qint64 elapsedMs);
+
+private:
+    DatabaseManager& m_db;
+    QList<StepResult> m_steps;
+    QString m_lastError;
+};
+
+#endif // MIGRATIONMANAGER_H
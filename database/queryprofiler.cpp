@@ -0,0 +1,189 @@
+#include "queryprofiler.h"
+#include "utils/percentile.h"
+#include <QRegularExpression>
+#include <QMutexLocker>
+#include <QDebug>
+#include <algorithm>
+
+QueryProfiler* QueryProfiler::m_instance = nullptr;
+
+QueryProfiler& QueryProfiler::instance()
+{
+    if (!m_instance) {
+        m_instance = new QueryProfiler();
+    }
+    return *m_instance;
+}
+
+QueryProfiler::QueryProfiler()
+    : m_slowThresholdMs(200.0)
+    , m_enabled(true)
+{
+}
+
+void QueryProfiler::record(const QString& sql, qint64 elapsedNs, int rows, const QVariantList& params)
+{
+    if (!m_enabled.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    const double elapsedMs = elapsedNs / 1.0e6;
+
+    QMutexLocker locker(&m_mutex);
+
+    Entry& entry = m_entries[normalizedKey(sql)];
+    ++entry.count;
+    entry.totalNs += elapsedNs;
+    entry.maxNs = qMax(entry.maxNs, elapsedNs);
+    if (rows > 0) {
+        entry.rows += rows;
+    }
+
+    // Échantillons circulaires pour les percentiles
+    if (entry.samples.size() < SAMPLE_CAPACITY) {
+        entry.samples.append(elapsedNs);
+    } else {
+        entry.samples[entry.nextSample] = elapsedNs;
+    }
+    entry.nextSample = (entry.nextSample + 1) % SAMPLE_CAPACITY;
+
+    if (elapsedMs >= m_slowThresholdMs) {
+        SlowQuery slow;
+        slow.timestamp = QDateTime::currentDateTime();
+        slow.sql = sql.simplified();
+        slow.params = params;
+        slow.elapsedMs = elapsedMs;
+
+        m_slowQueries.prepend(slow);
+        if (m_slowQueries.size() > SLOW_LOG_CAPACITY) {
+            m_slowQueries.removeLast();
+        }
+
+        qWarning().noquote() << QString("Requête lente (%1 ms):").arg(elapsedMs, 0, 'f', 1)
+                             << slow.sql << "- paramètres:" << params;
+    }
+}
+
+void QueryProfiler::addRows(const QString& sql, int rows)
+{
+    if (!m_enabled.load(std::memory_order_relaxed) || rows <= 0) {
+        return;
+    }
+
+    QMutexLocker locker(&m_mutex);
+    m_entries[normalizedKey(sql)].rows += rows;
+}
+
+void QueryProfiler::setSlowThresholdMs(double thresholdMs)
+{
+    QMutexLocker locker(&m_mutex);
+    m_slowThresholdMs = thresholdMs;
+}
+
+void QueryProfiler::setEnabled(bool enabled)
+{
+    m_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool QueryProfiler::isEnabled() const
+{
+    return m_enabled.load(std::memory_order_relaxed);
+}
+
+QList<QueryProfiler::QueryStat> QueryProfiler::snapshot(int limit) const
+{
+    QList<QueryStat> stats;
+
+    {
+        QMutexLocker locker(&m_mutex);
+        stats.reserve(m_entries.size());
+
+        for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); ++it) {
+            const Entry& entry = it.value();
+            QueryStat stat;
+            stat.sql = it.key();
+            stat.count = entry.count;
+            stat.totalMs = entry.totalNs / 1.0e6;
+            stat.maxMs = entry.maxNs / 1.0e6;
+            stat.p50Ms = percentileOf(entry.samples, 50) / 1.0e6;
+            stat.p95Ms = percentileOf(entry.samples, 95) / 1.0e6;
+            stat.p99Ms = percentileOf(entry.samples, 99) / 1.0e6;
+            stat.rows = entry.rows;
+            stats.append(stat);
+        }
+    }
+
+    std::sort(stats.begin(), stats.end(), [](const QueryStat& a, const QueryStat& b) {
+        return a.totalMs > b.totalMs;
+    });
+
+    if (limit > 0 && stats.size() > limit) {
+        stats = stats.mid(0, limit);
+    }
+
+    return stats;
+}
+
+QList<QueryProfiler::SlowQuery> QueryProfiler::slowQueries() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_slowQueries;
+}
+
+void QueryProfiler::reset()
+{
+    QMutexLocker locker(&m_mutex);
+    m_entries.clear();
+    m_slowQueries.clear();
+}
+
+QString QueryProfiler::report(int limit) const
+{
+    QString text;
+    text += QString("%1 %2 %3 %4 %5 %6  %7\n")
+                .arg("Appels", 8).arg("Total ms", 10).arg("p50", 8)
+                .arg("p95", 8).arg("p99", 8).arg("Lignes", 9).arg("Requête");
+
+    for (const QueryStat& stat : snapshot(limit)) {
+        text += QString("%1 %2 %3 %4 %5 %6  %7\n")
+                    .arg(stat.count, 8)
+                    .arg(stat.totalMs, 10, 'f', 1)
+                    .arg(stat.p50Ms, 8, 'f', 2)
+                    .arg(stat.p95Ms, 8, 'f', 2)
+                    .arg(stat.p99Ms, 8, 'f', 2)
+                    .arg(stat.rows, 9)
+                    .arg(stat.sql.left(120));
+    }
+
+    return text;
+}
+
+QString QueryProfiler::normalize(const QString& sql)
+{
+    static const QRegularExpression stringLiteral("'(?:[^']|'')*'");
+    static const QRegularExpression numberLiteral("\\b\\d+(?:\\.\\d+)?\\b");
+
+    QString normalized = sql.simplified();
+    normalized.replace(stringLiteral, "?");
+    normalized.replace(numberLiteral, "?");
+    return normalized;
+}
+
+QString QueryProfiler::normalizedKey(const QString& sql)
+{
+    // Les requêtes préparées réutilisent le même texte : la normalisation
+    // (expressions régulières) n'est faite qu'une fois par texte distinct
+    auto it = m_normalizedCache.constFind(sql);
+    if (it != m_normalizedCache.constEnd()) {
+        return it.value();
+    }
+
+    // SQL dynamique avec littéraux : borne la taille du cache
+    if (m_normalizedCache.size() >= NORMALIZED_CACHE_CAPACITY) {
+        m_normalizedCache.clear();
+    }
+
+    const QString key = normalize(sql);
+    m_normalizedCache.insert(sql, key);
+    return key;
+}
@@ -0,0 +1,147 @@
+#ifndef QUERYPROFILER_H
+#define QUERYPROFILER_H
+
+#include <QString>
+#include <QVariant>
+#include <QDateTime>
+#include <QHash>
+#include <QList>
+#include <QVector>
+#include <QMutex>
+#include <atomic>
+
+/**
+ * @brief Mesure des temps d'exécution SQL
+ *
+ * Agrège les exécutions par texte SQL normalisé (littéraux remplacés par ?,
+ * espaces compactés) : nombre, temps total, percentiles p50/p95/p99 et
+ * lignes renvoyées. Les requêtes dépassant un seuil sont conservées avec
+ * leurs valeurs liées dans un journal des requêtes lentes.
+ */
+class QueryProfiler
+{
+public:
+    /**
+     * @brief Statistiques agrégées d'une requête normalisée
+     */
+    struct QueryStat {
+        QString sql;
+        quint64 count = 0;
+        double totalMs = 0.0;
+        double maxMs = 0.0;
+        double p50Ms = 0.0;
+        double p95Ms = 0.0;
+        double p99Ms = 0.0;
+        quint64 rows = 0;
+    };
+
+    /**
+     * @brief Entrée du journal des requêtes lentes
+     */
+    struct SlowQuery {
+        QDateTime timestamp;
+        QString sql;
+        QVariantList params;
+        double elapsedMs = 0.0;
+    };
+
+    /**
+     * @brief Obtient l'instance unique du profileur
+     * @return Référence vers l'instance unique
+     */
+    static QueryProfiler& instance();
+
+    /**
+     * @brief Enregistre une exécution
+     * @param sql Texte SQL tel qu'exécuté
+     * @param elapsedNs Durée en nanosecondes
+     * @param rows Lignes affectées ou renvoyées (négatif si inconnu, cas des
+     *             SELECT en lecture séquentielle : le lecteur les ajoute
+     *             ensuite via addRows())
+     * @param params Valeurs liées (conservées uniquement pour les requêtes lentes)
+     */
+    void record(const QString& sql, qint64 elapsedNs, int rows, const QVariantList& params);
+
+    /**
+     * @brief Ajoute des lignes lues a posteriori (requêtes en lecture séquentielle)
+     * @param sql Texte SQL tel qu'exécuté
+     * @param rows Nombre de lignes lues
+     */
+    void addRows(const QString& sql, int rows);
+
+    /**
+     * @brief Seuil du journal des requêtes lentes
+     * @param thresholdMs Seuil en millisecondes (défaut: 200 ms)
+     */
+    void setSlowThresholdMs(double thresholdMs);
+
+    /**
+     * @brief Active ou désactive la mesure
+     */
+    void setEnabled(bool enabled);
+    bool isEnabled() const;
+
+    /**
+     * @brief Instantané des statistiques, trié par temps total décroissant
+     * @param limit Nombre maximal d'entrées (0 pour toutes)
+     * @return Statistiques par requête normalisée
+     */
+    QList<QueryStat> snapshot(int limit = 0) const;
+
+    /**
+     * @brief Dernières requêtes lentes, de la plus récente à la plus ancienne
+     */
+    QList<SlowQuery> slowQueries() const;
+
+    /**
+     * @brief Remet les compteurs à zéro
+     */
+    void reset();
+
+    /**
+     * @brief Rapport texte des requêtes les plus coûteuses
+     * @param limit Nombre de requêtes affichées
+     * @return Rapport multi-lignes
+     */
+    QString report(int limit = 10) const;
+
+    /**
+     * @brief Normalise un texte SQL (littéraux et espaces)
+     * @param sql Texte SQL
+     * @return Texte normalisé servant de clé d'agrégation
+     */
+    static QString normalize(const QString& sql);
+
+private:
+    QueryProfiler();
+
+    // Empêche la copie et l'assignation
+    QueryProfiler(const QueryProfiler&) = delete;
+    QueryProfiler& operator=(const QueryProfiler&) = delete;
+
+    struct Entry {
+        quint64 count = 0;
+        qint64 totalNs = 0;
+        qint64 maxNs = 0;
+        quint64 rows = 0;
+        QVector<qint64> samples;
+        int nextSample = 0;
+    };
+
+    QString normalizedKey(const QString& sql);
+
+private:
+    static const int SAMPLE_CAPACITY = 512;
+    static const int SLOW_LOG_CAPACITY = 100;
+    static const int NORMALIZED_CACHE_CAPACITY = 1000;
+
+    mutable QMutex m_mutex;
+    QHash<QString, Entry> m_entries;
+    QHash<QString, QString> m_normalizedCache;
+    QList<SlowQuery> m_slowQueries;
+    double m_slowThresholdMs;
+    std::atomic<bool> m_enabled;
+    static QueryProfiler* m_instance;
+};
+
+#endif // QUERYPROFILER_H
@@ -0,0 +1,133 @@
+#include "schemamanager.h"
+#include "databasemanager.h"
+#include "models/client.h"
+#include "models/commande.h"
+#include <QSqlQuery>
+#include <QSqlRecord>
+#include <QSqlError>
+#include <QDate>
+#include <QDebug>
+
+namespace {
+
+const char* const EXPLAIN_STATEMENT_ID = "LOGISTICS_EXPLAIN";
+
+} // namespace
+
+QList<SchemaManager::ModelQuery> SchemaManager::modelQueries()
+{
+    // Requêtes reprises des modèles : le plan affiché est celui réellement exécuté.
+    // Les requêtes construites à la demande le sont avec des critères représentatifs
+    QVariantList clientSearchParams;
+    const QString clientSearch = Client::searchSql("DUP", QString(), QString(), -1, clientSearchParams);
+
+    QVariantList commandeSearchParams;
+    const QString commandeSearch = Commande::searchSql(QString(), 0, Commande::EN_ATTENTE, -1,
+                                                       QDate(), QDate(), commandeSearchParams);
+
+    QVariantList echeanceParams;
+    const QString echeance = Commande::echeanceSql(QDate(), QDate::currentDate(), echeanceParams);
+
+    return {
+        {"Client::findAll", Client::SQL_FIND_ALL, {}},
+        {"Client::findById", Client::SQL_FIND_BY_ID, {1}},
+        {"Client::findByEmail", Client::SQL_FIND_BY_EMAIL, {"client@example.com"}},
+        {"Client::search", clientSearch, clientSearchParams},
+        {"Client::count", Client::SQL_COUNT, {}},
+        {"Client::countByStatut", Client::SQL_COUNT_BY_STATUT, {"ACTIF"}},
+
+        {"Commande::findAll", Commande::SQL_FIND_ALL, {}},
+        {"Commande::findById", Commande::SQL_FIND_BY_ID, {1, 1}},
+        {"Commande::findByNumero", Commande::SQL_FIND_BY_NUMERO, {"CMD000001", "CMD000001"}},
+        {"Commande::findByClient", Commande::SQL_FIND_BY_CLIENT, {1, 1}},
+        {"Commande::search", commandeSearch, commandeSearchParams},
+        {"Commande::count", Commande::SQL_COUNT, {}},
+        {"Commande::countByStatut", Commande::SQL_COUNT_BY_STATUT, {"EN_ATTENTE"}},
+        {"Commande::countByStatut (archive)", Commande::SQL_COUNT_BY_STATUT_ARCHIVE, {"LIVREE", "LIVREE"}},
+        {"Commande::countByPriorite", Commande::SQL_COUNT_BY_PRIORITE, {"HAUTE", "HAUTE"}},
+        {"Commande::countActivesByClient", Commande::SQL_COUNT_ACTIVES_BY_CLIENT, {1}},
+        {"Commande::totalChiffreAffaires", Commande::SQL_TOTAL_CHIFFRE_AFFAIRES, {}},
+        {"Commande::moyennePrixCommandes", Commande::SQL_MOYENNE_PRIX, {}},
+        {"Commande::findByEcheance", echeance, echeanceParams}
+    };
+}
+
+QStringList SchemaManager::explainPlan(DatabaseManager& db, const QString& sql,
+                                       const QVariantList& params)
+{
+    QStringList plan;
+
+    if (db.database().driverName() == "QOCI") {
+        // EXPLAIN PLAN n'exécute pas la requête : les variables de liaison
+        // n'ont pas besoin de valeur, on remplace simplement les '?' par des noms
+        QString oracleSql = sql;
+        int bindIndex = 0;
+        for (int pos = oracleSql.indexOf('?'); pos >= 0; pos = oracleSql.indexOf('?', pos)) {
+            const QString name = QString(":p%1").arg(++bindIndex);
+            oracleSql.replace(pos, 1, name);
+            pos += name.length();
+        }
+
+        QSqlQuery query(db.database());
+        query.exec(QString("DELETE FROM PLAN_TABLE WHERE STATEMENT_ID = '%1'").arg(EXPLAIN_STATEMENT_ID));
+
+        if (!query.exec(QString("EXPLAIN PLAN SET STATEMENT_ID = '%1' FOR %2")
+                            .arg(EXPLAIN_STATEMENT_ID, oracleSql))) {
+            qWarning() << "EXPLAIN PLAN impossible:" << query.lastError().text();
+            return plan;
+        }
+
+        if (!query.exec(QString("SELECT PLAN_TABLE_OUTPUT FROM TABLE(DBMS_XPLAN.DISPLAY('PLAN_TABLE', '%1', 'BASIC'))")
+                            .arg(EXPLAIN_STATEMENT_ID))) {
+            qWarning() << "Lecture du plan impossible:" << query.lastError().text();
+            return plan;
+        }
+
+        while (query.next()) {
+            plan << query.value(0).toString();
+        }
+        return plan;
+    }
+
+    QSqlQuery query = db.prepareQuery("EXPLAIN QUERY PLAN " + sql);
+    if (!db.executeQuery(query, params)) {
+        return plan;
+    }
+
+    const int detail = query.record().indexOf("detail");
+    while (query.next()) {
+        plan << query.value(detail).toString();
+    }
+
+    return plan;
+}
+
+void SchemaManager::dumpExplainPlans(DatabaseManager& db)
+{
+    const QString driverName = db.database().driverName();
+    qInfo() << "=== Plans d'exécution (" << driverName << ") ===";
+
+    for (const ModelQuery& modelQuery : modelQueries()) {
+        qInfo().noquote() << "--" << modelQuery.name;
+        const QStringList plan = explainPlan(db, modelQuery.sql, modelQuery.params);
+        for (const QString& line : plan) {
+            qInfo().noquote() << "   " << line;
+        }
+    }
+}
+
+bool SchemaManager::isIgnorableError(const QString& sql, const QString& error)
+{
+    // Le DDL Oracle valide étape par étape : une migration interrompue est
+    // rejouée sur des index déjà créés (ORA-00955) ou déjà supprimés (ORA-01418).
+    // Les étapes SQLite portent IF [NOT] EXISTS, et une table existante n'est
+    // jamais ignorée : sa structure pourrait différer de celle de la migration
+    const QString statement = sql.simplified();
+    if (statement.startsWith("CREATE INDEX", Qt::CaseInsensitive)) {
+        return error.contains("ORA-00955");
+    }
+    if (statement.startsWith("DROP INDEX", Qt::CaseInsensitive)) {
+        return error.contains("ORA-01418");
+    }
+    return false;
+}
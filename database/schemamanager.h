@@ -0,0 +1,64 @@
+#ifndef SCHEMAMANAGER_H
+#define SCHEMAMANAGER_H
+
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+#include <QList>
+
+class DatabaseManager;
+
+/**
+ * @brief Analyse des plans d'exécution des requêtes des modèles
+ *
+ * Cette classe affiche les plans d'exécution (EXPLAIN) des requêtes de
+ * référence des modèles pour Oracle et SQLite. Les index eux-mêmes sont
+ * définis et déployés uniquement par les migrations (MigrationManager).
+ */
+class SchemaManager
+{
+public:
+    /**
+     * @brief Requête de référence d'un modèle, utilisée pour EXPLAIN
+     */
+    struct ModelQuery {
+        QString name;
+        QString sql;
+        QVariantList params;
+    };
+
+    /**
+     * @brief Requêtes de référence des modèles (Client, Commande, statistiques)
+     * @return Liste des requêtes avec des paramètres représentatifs
+     */
+    static QList<ModelQuery> modelQueries();
+
+    /**
+     * @brief Obtient le plan d'exécution d'une requête
+     * @param db Gestionnaire de base de données connecté
+     * @param sql Requête à analyser (placeholders ?)
+     * @param params Paramètres représentatifs
+     * @return Lignes du plan, vide en cas d'erreur
+     */
+    static QStringList explainPlan(DatabaseManager& db, const QString& sql,
+                                   const QVariantList& params = QVariantList());
+
+    /**
+     * @brief Affiche le plan d'exécution de toutes les requêtes de référence
+     * @param db Gestionnaire de base de données connecté
+     */
+    static void dumpExplainPlans(DatabaseManager& db);
+
+    /**
+     * @brief Indique si l'échec d'une étape DDL signifie qu'elle est déjà appliquée
+     *
+     * Seuls un index Oracle déjà créé (ORA-00955) ou déjà supprimé (ORA-01418)
+     * sont acceptés ; toute autre erreur, et toute erreur sur une table, échoue.
+     * @param sql Instruction exécutée
+     * @param error Texte de l'erreur du driver
+     * @return true si l'erreur peut être ignorée
+     */
+    static bool isIgnorableError(const QString& sql, const QString& error);
+};
+
+#endif // SCHEMAMANAGER_H
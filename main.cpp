@@ -4,11 +4,23 @@
 #include <QMessageBox>
 #include <QSplashScreen>
 #include <QPixmap>
-#include <QTimer>
+#include <QElapsedTimer>
+#include <QScopeGuard>
 #include <QDebug>
 #include <iostream>
 #include "mainwindow.h"
 #include "database/databasemanager.h"
+#include "database/schemamanager.h"
+#include "database/archivemanager.h"
+#include "controllers/remindercampaign.h"
+#include "utils/batchdocumentjob.h"
+#include "utils/labelprinter.h"
+#include "utils/printmanager.h"
+#include "utils/tracer.h"
+#include "benchmark/benchmarkrunner.h"
+#include "benchmark/guiharness.h"
+#include "benchmark/smtpstandin.h"
+#include "utils/emailoutbox.h"
 
 #ifdef _WIN32
 #include <windows.h>
@@ -18,6 +30,24 @@
 
 int main(int argc, char *argv[])
 {
+    // Les bancs d'essai et les traitements en ligne de commande s'exécutent sans affichage
+    static const char* const cliFlags[] = {
+        "--benchmark", "--gui-benchmark", "--smtp-standin", "--archive", "--reminders",
+        "--batch-pdf", "--labels", "--report", "--explain"
+    };
+    bool cliMode = false;
+    for (int i = 1; i < argc && !cliMode; ++i) {
+        for (const char* flag : cliFlags) {
+            if (qstrcmp(argv[i], flag) == 0) {
+                cliMode = true;
+                break;
+            }
+        }
+    }
+    if (cliMode && qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
     QApplication app(argc, argv);
 
 #ifdef _WIN32
@@ -32,6 +62,10 @@ int main(int argc, char *argv[])
     }
 #endif
 
+    // Durée de démarrage, rapportée quand la première vue est prête
+    QElapsedTimer startupTimer;
+    startupTimer.start();
+
     std::cout << "=== Logistics Management System Starting ===" << std::endl;
     qDebug() << "Qt Application initialized";
 
@@ -41,6 +75,41 @@ int main(int argc, char *argv[])
     app.setOrganizationName("Logistics Management Corp");
     app.setOrganizationDomain("logistics-corp.com");
 
+    // Traçage des portées : --trace <fichier.json>, exporté à la sortie de main()
+    // par tous les chemins de retour (les modes en ligne de commande quittent
+    // sans passer par la boucle d'événements ni aboutToQuit)
+    const QStringList arguments = app.arguments();
+    const int traceIndex = arguments.indexOf("--trace");
+    QString traceFile;
+    if (traceIndex >= 0) {
+        traceFile = traceIndex + 1 < arguments.size()
+                        ? arguments.at(traceIndex + 1)
+                        : QString("logistics-trace.json");
+        Tracer::setEnabled(true);
+    }
+    const auto traceExport = qScopeGuard([&traceFile]() {
+        if (!traceFile.isEmpty()) {
+            Tracer::exportChromeTrace(traceFile);
+        }
+    });
+
+    // Serveur SMTP local de test : --smtp-standin [port] [--smtp-standin-dir d] [--smtp-standin-fail n]
+    if (arguments.contains("--smtp-standin")) {
+        return SmtpStandIn::runFromArguments(arguments);
+    }
+
+    // Serveur d'envoi de la file d'emails : --smtp hôte[:port]
+    const int smtpIndex = arguments.indexOf("--smtp");
+    if (smtpIndex >= 0 && smtpIndex + 1 < arguments.size()) {
+        SmtpClient::Settings smtp = EmailOutbox::instance().smtpSettings();
+        const QString endpoint = arguments.at(smtpIndex + 1);
+        smtp.host = endpoint.section(':', 0, 0);
+        if (endpoint.contains(':')) {
+            smtp.port = endpoint.section(':', 1).toInt();
+        }
+        EmailOutbox::instance().setSmtpSettings(smtp);
+    }
+
     // Style moderne
     app.setStyle(QStyleFactory::create("Fusion"));
 
@@ -61,11 +130,13 @@ int main(int argc, char *argv[])
     modernPalette.setColor(QPalette::HighlightedText, Qt::white);
     app.setPalette(modernPalette);
 
-    // Écran de démarrage
+    // Écran de démarrage, jamais affiché en ligne de commande
     QPixmap pixmap(400, 300);
     pixmap.fill(QColor(0, 120, 215));
     QSplashScreen splash(pixmap);
-    splash.show();
+    if (!cliMode) {
+        splash.show();
+    }
     splash.showMessage("Initialisation du système...", Qt::AlignBottom | Qt::AlignCenter, Qt::white);
 
     app.processEvents();
@@ -77,10 +148,24 @@ int main(int argc, char *argv[])
     std::cout << "Initializing database..." << std::endl;
 
     DatabaseManager& dbManager = DatabaseManager::instance();
+
+    // Banc d'essai : --benchmark [--bench-db fichier] [--bench-clients n] [--bench-orders n] ...
+    const bool benchmarkMode = arguments.contains("--benchmark");
+    const bool guiBenchmarkMode = arguments.contains("--gui-benchmark");
+    const BenchmarkRunner::Config benchmarkConfig = BenchmarkRunner::configFromArguments(arguments);
+    if (benchmarkMode || guiBenchmarkMode) {
+        dbManager.setSQLiteDatabasePath(benchmarkConfig.databasePath);
+    }
+
     if (!dbManager.initialize()) {
         splash.close();
         std::cout << "Database initialization failed: " << dbManager.lastError().toStdString() << std::endl;
 
+        // Aucun dialogue en ligne de commande : l'échec se lit dans le code de sortie
+        if (cliMode) {
+            return -1;
+        }
+
         QMessageBox::StandardButton reply = QMessageBox::question(nullptr, "Erreur de Base de Données",
                              "Impossible de se connecter à la base de données.\n\n"
                              "L'application va utiliser SQLite comme base de données de secours.\n\n"
@@ -98,6 +183,82 @@ int main(int argc, char *argv[])
         std::cout << "Database initialized successfully!" << std::endl;
     }
 
+    const qint64 databaseReadyMs = startupTimer.elapsed();
+
+    if (benchmarkMode) {
+        splash.close();
+        BenchmarkRunner runner(benchmarkConfig);
+        return runner.run();
+    }
+
+    // Banc d'essai de l'interface : --gui-benchmark [--gui-iterations n] [--gui-budget nom=ms] ...
+    if (guiBenchmarkMode) {
+        splash.close();
+        if (!DataGenerator::matches(dbManager, benchmarkConfig.dataset)
+            && !DataGenerator::generate(dbManager, benchmarkConfig.dataset)) {
+            return -1;
+        }
+        GuiHarness harness(GuiHarness::configFromArguments(arguments));
+        return harness.run();
+    }
+
+    // Archivage des commandes terminées : --archive [jours]
+    const int archiveIndex = arguments.indexOf("--archive");
+    if (archiveIndex >= 0) {
+        splash.close();
+        if (archiveIndex + 1 < arguments.size()) {
+            ArchiveManager::setHorizonDays(arguments.at(archiveIndex + 1).toInt());
+        }
+        return ArchiveManager::archiveCommandes() >= 0 ? 0 : -1;
+    }
+
+    // Campagne de rappels : --reminders [aaaa-mm-jj] [--reminders-deliver] [--reminders-rate n] ...
+    if (arguments.contains("--reminders")) {
+        splash.close();
+        ReminderCampaign campaign(ReminderCampaign::configFromArguments(arguments));
+        if (!campaign.run()) {
+            return -1;
+        }
+        if (arguments.contains("--reminders-deliver") && !campaign.deliver()) {
+            return -1;
+        }
+        return 0;
+    }
+
+    // Documents en lot : --batch-pdf facture|etiquette [--batch-ids 1,2,3 | --batch-date aaaa-mm-jj] ...
+    if (arguments.contains("--batch-pdf")) {
+        splash.close();
+        BatchDocumentJob job(BatchDocumentJob::configFromArguments(arguments));
+        QObject::connect(&job, &BatchDocumentJob::progress, [](int done, int total) {
+            std::cout << "\r" << done << "/" << total << std::flush;
+        });
+        const bool ok = job.run(BatchDocumentJob::idsFromArguments(arguments));
+        std::cout << std::endl;
+        for (const QString& error : job.report().errors) {
+            qWarning().noquote() << error;
+        }
+        return ok ? 0 : -1;
+    }
+
+    // Étiquettes thermiques : --labels zpl|escpos [--labels-output hôte:port|fichier] [--batch-ids ...]
+    if (arguments.contains("--labels")) {
+        splash.close();
+        return LabelPrinter::runFromArguments(arguments);
+    }
+
+    // Rapports paginés en PDF : --report commandes|clients [--report-output fichier.pdf] ...
+    if (arguments.contains("--report")) {
+        splash.close();
+        return PrintManager::runReportFromArguments(arguments);
+    }
+
+    // Mode diagnostic : affiche les plans d'exécution des requêtes des modèles
+    if (arguments.contains("--explain")) {
+        splash.close();
+        SchemaManager::dumpExplainPlans(dbManager);
+        return 0;
+    }
+
     splash.showMessage("Chargement de l'interface...", Qt::AlignBottom | Qt::AlignCenter, Qt::white);
     app.processEvents();
 
@@ -107,10 +268,17 @@ int main(int argc, char *argv[])
         // Création et affichage de la fenêtre principale
         MainWindow window;
         std::cout << "Main window created successfully" << std::endl;
+        const qint64 windowCreatedMs = startupTimer.elapsed();
 
-        // Fermeture de l'écran de démarrage après un délai
-        QTimer::singleShot(1000, &splash, &QSplashScreen::close);
-        QTimer::singleShot(1000, &window, &MainWindow::show);
+        // L'écran de démarrage se ferme dès que la première vue a chargé ses données
+        QObject::connect(&window, &MainWindow::firstViewReady, &splash,
+                         [&splash, &window, &startupTimer, databaseReadyMs, windowCreatedMs]() {
+            splash.finish(&window);
+            std::cout << "Startup: database " << databaseReadyMs << " ms, main window "
+                      << windowCreatedMs << " ms, first view ready " << startupTimer.elapsed()
+                      << " ms" << std::endl;
+        });
+        window.show();
 
         std::cout << "Starting application event loop..." << std::endl;
         return app.exec();
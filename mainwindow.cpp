@@ -2,10 +2,13 @@
 #include "views/clientview.h"
 #include "views/commandeview.h"
 #include "views/statisticsview.h"
+#include "views/querystatsdialog.h"
 #include "controllers/clientcontroller.h"
 #include "controllers/commandecontroller.h"
+#include "controllers/slaengine.h"
 #include "database/databasemanager.h"
 #include "utils/stylemanager.h"
+#include "utils/emailoutbox.h"
 
 #include <QApplication>
 #include <QMenuBar>
@@ -19,7 +22,10 @@
 #include <QMessageBox>
 #include <QCloseEvent>
 #include <QDateTime>
+#include <QElapsedTimer>
 #include <QIcon>
+#include <QFileDialog>
+#include <QWindow>
 #include <stdexcept>
 
 MainWindow::MainWindow(QWidget *parent)
@@ -30,7 +36,11 @@ MainWindow::MainWindow(QWidget *parent)
     , m_statisticsView(nullptr)
     , m_clientController(nullptr)
     , m_commandeController(nullptr)
+    , m_slaLabel(nullptr)
     , m_statusTimer(new QTimer(this))
+    , m_healthMonitor(new DatabaseHealthMonitor(this))
+    , m_stallWatchdog(new StallWatchdog(this))
+    , m_firstViewLoaded(false)
 {
     try {
         qDebug() << "Initializing MainWindow...";
@@ -56,6 +66,10 @@ MainWindow::MainWindow(QWidget *parent)
             throw std::runtime_error("Failed to create CommandeController");
         }
 
+        // Suivi des échéances SLA, tenu à jour par les signaux du contrôleur ;
+        // chargé après la première vue (loadFirstView)
+        SlaEngine::instance().attach(m_commandeController);
+
         qDebug() << "Setting up UI...";
         // Configuration de l'interface
         setupUI();
@@ -71,6 +85,15 @@ MainWindow::MainWindow(QWidget *parent)
         // Mise à jour initiale
         updateStatusBar();
 
+        // Surveillance de la base dans un thread dédié (ping + latences)
+        m_healthMonitor->start();
+
+        // Détection des blocages du thread graphique (requêtes lentes, traitements longs)
+        m_stallWatchdog->start();
+
+        // Envoi des emails en file dans un thread dédié (sessions SMTP par lots)
+        EmailOutbox::instance().start();
+
         qDebug() << "MainWindow initialization completed successfully";
 
     } catch (const std::exception& e) {
@@ -95,6 +118,7 @@ void MainWindow::setupUI()
 {
     // Widget central avec onglets
     m_tabWidget = new QTabWidget(this);
+    m_tabWidget->setObjectName("mainTabWidget");
     m_tabWidget->setTabPosition(QTabWidget::North);
     m_tabWidget->setMovable(false);
     m_tabWidget->setTabsClosable(false);
@@ -102,19 +126,94 @@ void MainWindow::setupUI()
     // Apply professional styling to tab widget
     StyleManager::instance().applyTabWidgetStyle(m_tabWidget);
 
-    // Création des vues
-    m_clientView = new ClientView(m_clientController, this);
-    m_commandeView = new CommandeView(m_commandeController, this);
-    m_statisticsView = new StatisticsView(this);
+    // Pages vides : chaque vue est construite à la première activation de son onglet
+    const QList<QPair<QString, QString>> tabs = {
+        {":/icons/clients.png", "👥 Gestion des Clients"},
+        {":/icons/orders.png", "📦 Gestion des Commandes"},
+        {":/icons/stats.png", "📊 Statistiques et Rapports"}
+    };
+    for (const auto& tab : tabs) {
+        QWidget *page = new QWidget(m_tabWidget);
+        QVBoxLayout *layout = new QVBoxLayout(page);
+        layout->setContentsMargins(0, 0, 0, 0);
+        m_tabWidget->addTab(page, QIcon(tab.first), tab.second);
+    }
 
-    // Ajout des onglets avec icônes
-    m_tabWidget->addTab(m_clientView, QIcon(":/icons/clients.png"), "👥 Gestion des Clients");
-    m_tabWidget->addTab(m_commandeView, QIcon(":/icons/orders.png"), "📦 Gestion des Commandes");
-    m_tabWidget->addTab(m_statisticsView, QIcon(":/icons/stats.png"), "📊 Statistiques et Rapports");
+    // Seule la vue affichée au démarrage est construite ; ses données sont
+    // chargées après la première exposition de la fenêtre (loadFirstView)
+    ensureView(m_tabWidget->currentIndex());
 
     setCentralWidget(m_tabWidget);
 }
 
+QWidget* MainWindow::ensureView(int index)
+{
+    QWidget *page = m_tabWidget->widget(index);
+    if (!page) {
+        return nullptr;
+    }
+
+    QWidget *view = nullptr;
+    QElapsedTimer timer;
+    timer.start();
+
+    // Chargement différé : l'onglet s'affiche avant la lecture des données.
+    // Avant le premier affichage, c'est loadFirstView() qui charge la vue
+    switch (index) {
+        case TAB_CLIENTS:
+            if (m_clientView) {
+                return m_clientView;
+            }
+            m_clientView = new ClientView(m_clientController, page);
+            if (m_firstViewLoaded) {
+                QTimer::singleShot(0, m_clientView, &ClientView::refreshData);
+            }
+            view = m_clientView;
+            break;
+        case TAB_COMMANDES:
+            if (m_commandeView) {
+                return m_commandeView;
+            }
+            m_commandeView = new CommandeView(m_commandeController, page);
+            if (m_firstViewLoaded) {
+                QTimer::singleShot(0, m_commandeView, &CommandeView::refreshData);
+            }
+            view = m_commandeView;
+            break;
+        case TAB_STATISTIQUES:
+            if (m_statisticsView) {
+                return m_statisticsView;
+            }
+            m_statisticsView = new StatisticsView(m_clientController, m_commandeController, page);
+            if (m_firstViewLoaded) {
+                QTimer::singleShot(0, m_statisticsView, &StatisticsView::refreshData);
+            }
+            view = m_statisticsView;
+            break;
+        default:
+            return nullptr;
+    }
+
+    page->layout()->addWidget(view);
+    qDebug() << "Vue" << index << "construite en" << timer.elapsed() << "ms";
+    return view;
+}
+
+ClientView* MainWindow::clientView()
+{
+    return static_cast<ClientView*>(ensureView(TAB_CLIENTS));
+}
+
+CommandeView* MainWindow::commandeView()
+{
+    return static_cast<CommandeView*>(ensureView(TAB_COMMANDES));
+}
+
+StatisticsView* MainWindow::statisticsView()
+{
+    return static_cast<StatisticsView*>(ensureView(TAB_STATISTIQUES));
+}
+
 void MainWindow::createMenus()
 {
     // Menu Fichier
@@ -144,6 +243,14 @@ void MainWindow::createMenus()
     
     // Menu Outils
     m_toolsMenu = menuBar()->addMenu("&Outils");
+
+    m_queryStatsAction = new QAction("&Statistiques des requêtes SQL", this);
+    m_queryStatsAction->setStatusTip("Afficher les temps d'exécution et les requêtes lentes");
+    m_toolsMenu->addAction(m_queryStatsAction);
+
+    m_exportStallsAction = new QAction("&Exporter les blocages de l'interface...", this);
+    m_exportStallsAction->setStatusTip("Enregistrer les blocages détectés avec les opérations en cours");
+    m_toolsMenu->addAction(m_exportStallsAction);
     
     // Menu Aide
     m_helpMenu = menuBar()->addMenu("&Aide");
@@ -165,16 +272,18 @@ void MainWindow::createToolBars()
 void MainWindow::createStatusBar()
 {
     m_statusLabel = new QLabel("Prêt");
-    m_connectionLabel = new QLabel();
+    m_connectionLabel = new QLabel("● Vérification de la connexion...");
+    m_slaLabel = new QLabel("SLA : chargement...");
     m_timeLabel = new QLabel();
     
     statusBar()->addWidget(m_statusLabel, 1);
+    statusBar()->addPermanentWidget(m_slaLabel);
     statusBar()->addPermanentWidget(m_connectionLabel);
     statusBar()->addPermanentWidget(m_timeLabel);
     
     // Style pour les labels de statut
-    m_connectionLabel->setStyleSheet("QLabel { color: green; font-weight: bold; }");
-    m_timeLabel->setStyleSheet("QLabel { color: blue; }");
+    StyleManager::setStyleState(m_connectionLabel, "connection", "unknown");
+    StyleManager::setStyleClass(m_timeLabel, "clock");
 }
 
 void MainWindow::connectSignals()
@@ -183,12 +292,20 @@ void MainWindow::connectSignals()
     connect(m_exitAction, &QAction::triggered, this, &QWidget::close);
     connect(m_aboutAction, &QAction::triggered, this, &MainWindow::about);
     connect(m_refreshAction, &QAction::triggered, this, &MainWindow::refreshAllData);
+    connect(m_queryStatsAction, &QAction::triggered, this, &MainWindow::showQueryStats);
+    connect(m_exportStallsAction, &QAction::triggered, this, &MainWindow::exportStalls);
     
     // Connexion du changement d'onglet
     connect(m_tabWidget, &QTabWidget::currentChanged, this, &MainWindow::onTabChanged);
     
     // Connexion du timer de statut
     connect(m_statusTimer, &QTimer::timeout, this, &MainWindow::updateStatusBar);
+
+    // L'indicateur de connexion ne change que sur transition d'état
+    connect(m_healthMonitor, &DatabaseHealthMonitor::stateChanged, this, &MainWindow::onDatabaseStateChanged);
+
+    // Indicateur SLA recalculé quand les échéances suivies changent
+    connect(&SlaEngine::instance(), &SlaEngine::deadlinesChanged, this, &MainWindow::updateSlaIndicator);
 }
 
 void MainWindow::about()
@@ -208,6 +325,28 @@ void MainWindow::about()
                       "<p>© 2024 Logistics Management Corp</p>");
 }
 
+void MainWindow::showQueryStats()
+{
+    QueryStatsDialog *dialog = new QueryStatsDialog(this);
+    dialog->setAttribute(Qt::WA_DeleteOnClose);
+    dialog->show();
+}
+
+void MainWindow::exportStalls()
+{
+    const QString filePath = QFileDialog::getSaveFileName(this, "Exporter les blocages de l'interface",
+                                                          "blocages-interface.json", "JSON (*.json)");
+    if (filePath.isEmpty()) {
+        return;
+    }
+
+    if (m_stallWatchdog->exportJson(filePath)) {
+        m_statusLabel->setText(QString("%1 blocage(s) exporté(s)").arg(m_stallWatchdog->events().size()));
+    } else {
+        QMessageBox::warning(this, "Erreur", "Impossible d'écrire le fichier " + filePath);
+    }
+}
+
 void MainWindow::refreshAllData()
 {
     m_statusLabel->setText("Actualisation des données...");
@@ -233,27 +372,104 @@ void MainWindow::refreshAllData()
 
 void MainWindow::updateStatusBar()
 {
-    // Mise à jour de l'heure
+    // Mise à jour de l'heure ; l'état de la connexion est suivi par m_healthMonitor
     m_timeLabel->setText(QDateTime::currentDateTime().toString("dd/MM/yyyy hh:mm:ss"));
-    
-    // Vérification de la connexion à la base de données
-    DatabaseManager& dbManager = DatabaseManager::instance();
-    if (dbManager.isConnected()) {
-        m_connectionLabel->setText("● Connecté à Oracle");
-        m_connectionLabel->setStyleSheet("QLabel { color: green; font-weight: bold; }");
-    } else {
-        m_connectionLabel->setText("● Déconnecté");
-        m_connectionLabel->setStyleSheet("QLabel { color: red; font-weight: bold; }");
+}
+
+void MainWindow::onDatabaseStateChanged(DatabaseHealthMonitor::State state, const QString& message)
+{
+    const bool isOracle = DatabaseManager::instance().database().driverName() == "QOCI";
+
+    switch (state) {
+        case DatabaseHealthMonitor::CONNECTE:
+            m_connectionLabel->setText(isOracle ? "● Connecté à Oracle" : "● Connecté à SQLite");
+            StyleManager::setStyleState(m_connectionLabel, "connection", "connected");
+            break;
+        case DatabaseHealthMonitor::DEGRADE:
+            m_connectionLabel->setText("● Connexion lente");
+            StyleManager::setStyleState(m_connectionLabel, "connection", "degraded");
+            break;
+        default:
+            m_connectionLabel->setText("● Déconnecté");
+            StyleManager::setStyleState(m_connectionLabel, "connection", "disconnected");
+            break;
     }
+
+    m_connectionLabel->setToolTip(message);
+}
+
+void MainWindow::updateSlaIndicator()
+{
+    const SlaEngine& sla = SlaEngine::instance();
+    const SlaEngine::Summary summary = sla.summary();
+
+    m_slaLabel->setText(QString("SLA : %1 en retard · %2 aujourd'hui · %3 à risque")
+                            .arg(summary.enRetard).arg(summary.aLivrerAujourdhui).arg(summary.aRisque));
+    StyleManager::setStyleState(m_slaLabel, "sla",
+                                summary.enRetard > 0 ? "late" : (summary.aRisque > 0 ? "risk" : "ok"));
+
+    // Prochaines échéances lues dans le tas en mémoire, sans requête
+    QStringList lines;
+    lines << "Prochaines échéances :";
+    for (const SlaEngine::Deadline& deadline : sla.nextDeadlines(5)) {
+        lines << QString("%1 - %2 (%3)")
+                     .arg(deadline.dateLivraisonPrevue.toString("dd/MM/yyyy"), deadline.numeroCommande,
+                          Commande::prioriteToString(deadline.priorite));
+    }
+    m_slaLabel->setToolTip(lines.join("\n"));
+}
+
+void MainWindow::showEvent(QShowEvent *event)
+{
+    QMainWindow::showEvent(event);
+
+    // La fenêtre n'est pas encore exposée : le chargement attend l'exposition
+    if (!m_firstViewLoaded && windowHandle()) {
+        windowHandle()->installEventFilter(this);
+    }
+}
+
+bool MainWindow::eventFilter(QObject *watched, QEvent *event)
+{
+    if (watched == windowHandle() && event->type() == QEvent::Expose && windowHandle()->isExposed()) {
+        windowHandle()->removeEventFilter(this);
+        // Posté : la fenêtre est peinte pendant le traitement de cette exposition
+        QTimer::singleShot(0, this, &MainWindow::loadFirstView);
+    }
+    return QMainWindow::eventFilter(watched, event);
+}
+
+void MainWindow::loadFirstView()
+{
+    if (m_firstViewLoaded) {
+        return;
+    }
+    m_firstViewLoaded = true;
+
+    if (m_clientView) {
+        m_clientView->refreshData();
+    }
+    if (m_commandeView) {
+        m_commandeView->refreshData();
+    }
+    if (m_statisticsView) {
+        m_statisticsView->refreshData();
+    }
+    emit firstViewReady();
+
+    // Échéances SLA : l'indicateur suit deadlinesChanged
+    QTimer::singleShot(0, this, []() { SlaEngine::instance().reload(); });
 }
 
 void MainWindow::onTabChanged(int index)
 {
+    ensureView(index);
+
     QString tabName;
     switch (index) {
-        case 0: tabName = "Gestion des Clients"; break;
-        case 1: tabName = "Gestion des Commandes"; break;
-        case 2: tabName = "Statistiques et Rapports"; break;
+        case TAB_CLIENTS: tabName = "Gestion des Clients"; break;
+        case TAB_COMMANDES: tabName = "Gestion des Commandes"; break;
+        case TAB_STATISTIQUES: tabName = "Statistiques et Rapports"; break;
         default: tabName = "Module inconnu"; break;
     }
     
@@ -269,7 +485,10 @@ void MainWindow::closeEvent(QCloseEvent *event)
         QMessageBox::No);
     
     if (reply == QMessageBox::Yes) {
-        // Fermeture de la connexion à la base de données
+        // Arrêt de la surveillance et de l'envoi puis fermeture de la connexion
+        m_stallWatchdog->stop();
+        m_healthMonitor->stop();
+        EmailOutbox::instance().stop();
         DatabaseManager::instance().close();
         event->accept();
     } else {
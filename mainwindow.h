@@ -10,6 +10,9 @@
 #include <QLabel>
 #include <QTimer>
 #include <QCloseEvent>
+#include <QShowEvent>
+#include "database/healthmonitor.h"
+#include "utils/stallwatchdog.h"
 
 // Forward declarations
 class ClientView;
@@ -33,9 +36,37 @@ class MainWindow : public QMainWindow
     Q_OBJECT
 
 public:
+    /**
+     * @brief Onglets de la fenêtre principale
+     */
+    enum Tab {
+        TAB_CLIENTS,
+        TAB_COMMANDES,
+        TAB_STATISTIQUES
+    };
+
     MainWindow(QWidget *parent = nullptr);
     ~MainWindow();
 
+    /**
+     * @brief Vues des onglets, construites à la demande
+     *
+     * Seule la vue de l'onglet courant est construite au démarrage ; les
+     * autres le sont à la première activation de leur onglet. Les données
+     * d'une vue sont chargées après son affichage : pour la première vue,
+     * une fois la fenêtre exposée et peinte ; ensuite, au retour dans la
+     * boucle d'événements.
+     */
+    ClientView* clientView();
+    CommandeView* commandeView();
+    StatisticsView* statisticsView();
+
+signals:
+    /**
+     * @brief Émis une fois la fenêtre peinte et les données de la première vue chargées
+     */
+    void firstViewReady();
+
 protected:
     /**
      * @brief Gère l'événement de fermeture de l'application
@@ -43,6 +74,16 @@ protected:
      */
     void closeEvent(QCloseEvent *event) override;
 
+    /**
+     * @brief Premier affichage : surveille l'exposition de la fenêtre
+     */
+    void showEvent(QShowEvent *event) override;
+
+    /**
+     * @brief Planifie le premier chargement à la première exposition
+     */
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
 private slots:
     /**
      * @brief Affiche la boîte de dialogue À propos
@@ -53,11 +94,33 @@ private slots:
      * @brief Actualise les données de tous les modules
      */
     void refreshAllData();
+
+    /**
+     * @brief Affiche le panneau des statistiques de requêtes SQL
+     */
+    void showQueryStats();
+
+    /**
+     * @brief Exporte le journal des blocages de l'interface (JSON)
+     */
+    void exportStalls();
     
     /**
      * @brief Met à jour la barre de statut
      */
     void updateStatusBar();
+
+    /**
+     * @brief Met à jour l'indicateur de connexion lors d'un changement d'état
+     * @param state Nouvel état de la base de données
+     * @param message Détail (latences ou erreur)
+     */
+    void onDatabaseStateChanged(DatabaseHealthMonitor::State state, const QString& message);
+
+    /**
+     * @brief Met à jour l'indicateur SLA (retards, échéances du jour, à risque)
+     */
+    void updateSlaIndicator();
     
     /**
      * @brief Gère le changement d'onglet
@@ -65,6 +128,11 @@ private slots:
      */
     void onTabChanged(int index);
 
+    /**
+     * @brief Charge les données des vues construites, puis les échéances SLA
+     */
+    void loadFirstView();
+
 private:
     /**
      * @brief Initialise l'interface utilisateur
@@ -91,11 +159,18 @@ private:
      */
     void connectSignals();
 
+    /**
+     * @brief Construit la vue d'un onglet si nécessaire
+     * @param index Index de l'onglet
+     * @return La vue, ou nullptr pour un index inconnu
+     */
+    QWidget* ensureView(int index);
+
 private:
     // Interface utilisateur
     QTabWidget *m_tabWidget;
     
-    // Vues
+    // Vues (nullptr tant que l'onglet n'a pas été activé)
     ClientView *m_clientView;
     CommandeView *m_commandeView;
     StatisticsView *m_statisticsView;
@@ -116,6 +191,8 @@ private:
     QAction *m_aboutAction;
     QAction *m_refreshAction;
     QAction *m_preferencesAction;
+    QAction *m_queryStatsAction;
+    QAction *m_exportStallsAction;
     
     // Barres d'outils
     QToolBar *m_mainToolBar;
@@ -123,8 +200,12 @@ private:
     // Barre de statut
     QLabel *m_statusLabel;
     QLabel *m_connectionLabel;
+    QLabel *m_slaLabel;
     QLabel *m_timeLabel;
     QTimer *m_statusTimer;
+    DatabaseHealthMonitor *m_healthMonitor;
+    StallWatchdog *m_stallWatchdog;
+    bool m_firstViewLoaded;
 };
 
 #endif // MAINWINDOW_H
@@ -1,13 +1,32 @@
 #include "client.h"
 #include "database/databasemanager.h"
+#include "database/queryprofiler.h"
+#include "utils/tracer.h"
+#include "utils/validator.h"
 #include <QSqlQuery>
 #include <QSqlError>
+#include <QSqlRecord>
 #include <QVariant>
-#include <QRegularExpression>
 #include <QDebug>
 #include <algorithm>
 #include <stdexcept>
 
+namespace {
+
+const char* const SELECT_COLUMNS = R"(
+        SELECT ID_CLIENT, NOM, PRENOM, EMAIL, TELEPHONE, ADRESSE, VILLE,
+               CODE_POSTAL, DATE_CREATION, STATUT
+)";
+
+} // namespace
+
+const QString Client::SQL_FIND_ALL = QString(SELECT_COLUMNS) + " FROM CLIENTS ORDER BY NOM, PRENOM";
+const QString Client::SQL_FIND_BY_ID = QString(SELECT_COLUMNS) + " FROM CLIENTS WHERE ID_CLIENT = ?";
+const QString Client::SQL_FIND_BY_EMAIL =
+    QString(SELECT_COLUMNS) + " FROM CLIENTS WHERE LOWER(EMAIL) = LOWER(?)";
+const QString Client::SQL_COUNT = "SELECT COUNT(*) FROM CLIENTS";
+const QString Client::SQL_COUNT_BY_STATUT = "SELECT COUNT(*) FROM CLIENTS WHERE STATUT = ?";
+
 Client::Client(QObject *parent)
     : QObject(parent)
     , m_id(-1)
@@ -263,26 +282,23 @@ bool Client::save()
 bool Client::load(int id)
 {
     DatabaseManager& db = DatabaseManager::instance();
-    QSqlQuery query = db.prepareQuery(R"(
-        SELECT ID_CLIENT, NOM, PRENOM, EMAIL, TELEPHONE, ADRESSE, VILLE, 
-               CODE_POSTAL, DATE_CREATION, STATUT
-        FROM CLIENTS WHERE ID_CLIENT = ?
-    )");
+    QSqlQuery query = db.prepareQuery(SQL_FIND_BY_ID);
     
     if (!db.executeQuery(query, {id}) || !query.next()) {
         return false;
     }
     
-    m_id = query.value("ID_CLIENT").toInt();
-    m_nom = query.value("NOM").toString();
-    m_prenom = query.value("PRENOM").toString();
-    m_email = query.value("EMAIL").toString();
-    m_telephone = query.value("TELEPHONE").toString();
-    m_adresse = query.value("ADRESSE").toString();
-    m_ville = query.value("VILLE").toString();
-    m_codePostal = query.value("CODE_POSTAL").toString();
-    m_dateCreation = query.value("DATE_CREATION").toDate();
-    m_statut = stringToStatut(query.value("STATUT").toString());
+    const ColumnIndex columns = resolveColumns(query.record());
+    m_id = query.value(columns.id).toInt();
+    m_nom = query.value(columns.nom).toString();
+    m_prenom = query.value(columns.prenom).toString();
+    m_email = query.value(columns.email).toString();
+    m_telephone = query.value(columns.telephone).toString();
+    m_adresse = query.value(columns.adresse).toString();
+    m_ville = query.value(columns.ville).toString();
+    m_codePostal = query.value(columns.codePostal).toString();
+    m_dateCreation = query.value(columns.dateCreation).toDate();
+    m_statut = stringToStatut(query.value(columns.statut).toString());
     
     return true;
 }
@@ -308,36 +324,23 @@ bool Client::remove()
 // Méthodes statiques pour les opérations de recherche
 QList<Client*> Client::findAll()
 {
-    QList<Client*> clients;
+    TRACE_SPAN("model", "Client::findAll");
     DatabaseManager& db = DatabaseManager::instance();
 
-    QSqlQuery query = db.prepareQuery(R"(
-        SELECT ID_CLIENT, NOM, PRENOM, EMAIL, TELEPHONE, ADRESSE, VILLE,
-               CODE_POSTAL, DATE_CREATION, STATUT
-        FROM CLIENTS
-        ORDER BY NOM, PRENOM
-    )");
+    QSqlQuery query = db.prepareQuery(SQL_FIND_ALL);
 
     if (!db.executeQuery(query)) {
         qWarning() << "Erreur lors de la récupération des clients:" << db.lastError();
-        return clients;
+        return QList<Client*>();
     }
 
-    while (query.next()) {
-        clients.append(fromQuery(query));
-    }
-
-    return clients;
+    return fromResultSet(query);
 }
 
 Client* Client::findById(int id)
 {
     DatabaseManager& db = DatabaseManager::instance();
-    QSqlQuery query = db.prepareQuery(R"(
-        SELECT ID_CLIENT, NOM, PRENOM, EMAIL, TELEPHONE, ADRESSE, VILLE,
-               CODE_POSTAL, DATE_CREATION, STATUT
-        FROM CLIENTS WHERE ID_CLIENT = ?
-    )");
+    QSqlQuery query = db.prepareQuery(SQL_FIND_BY_ID);
 
     if (!db.executeQuery(query, {id}) || !query.next()) {
         return nullptr;
@@ -349,11 +352,7 @@ Client* Client::findById(int id)
 Client* Client::findByEmail(const QString& email)
 {
     DatabaseManager& db = DatabaseManager::instance();
-    QSqlQuery query = db.prepareQuery(R"(
-        SELECT ID_CLIENT, NOM, PRENOM, EMAIL, TELEPHONE, ADRESSE, VILLE,
-               CODE_POSTAL, DATE_CREATION, STATUT
-        FROM CLIENTS WHERE LOWER(EMAIL) = LOWER(?)
-    )");
+    QSqlQuery query = db.prepareQuery(SQL_FIND_BY_EMAIL);
 
     if (!db.executeQuery(query, {email}) || !query.next()) {
         return nullptr;
@@ -365,16 +364,25 @@ Client* Client::findByEmail(const QString& email)
 QList<Client*> Client::search(const QString& nom, const QString& prenom,
                              const QString& ville, int statut)
 {
-    QList<Client*> clients;
+    TRACE_SPAN("model", "Client::search");
     DatabaseManager& db = DatabaseManager::instance();
 
-    QString sql = R"(
-        SELECT ID_CLIENT, NOM, PRENOM, EMAIL, TELEPHONE, ADRESSE, VILLE,
-               CODE_POSTAL, DATE_CREATION, STATUT
-        FROM CLIENTS WHERE 1=1
-    )";
-
     QVariantList params;
+    const QString sql = searchSql(nom, prenom, ville, statut, params);
+
+    QSqlQuery query = db.prepareQuery(sql);
+    if (!db.executeQuery(query, params)) {
+        qWarning() << "Erreur lors de la recherche de clients:" << db.lastError();
+        return QList<Client*>();
+    }
+
+    return fromResultSet(query);
+}
+
+QString Client::searchSql(const QString& nom, const QString& prenom, const QString& ville,
+                          int statut, QVariantList& params)
+{
+    QString sql = QString(SELECT_COLUMNS) + " FROM CLIENTS WHERE 1=1";
 
     if (!nom.isEmpty()) {
         sql += " AND UPPER(NOM) LIKE UPPER(?)";
@@ -397,18 +405,7 @@ QList<Client*> Client::search(const QString& nom, const QString& prenom,
     }
 
     sql += " ORDER BY NOM, PRENOM";
-
-    QSqlQuery query = db.prepareQuery(sql);
-    if (!db.executeQuery(query, params)) {
-        qWarning() << "Erreur lors de la recherche de clients:" << db.lastError();
-        return clients;
-    }
-
-    while (query.next()) {
-        clients.append(fromQuery(query));
-    }
-
-    return clients;
+    return sql;
 }
 
 void Client::sort(QList<Client*>& clients, const QString& critere, bool ordre)
@@ -438,7 +435,7 @@ void Client::sort(QList<Client*>& clients, const QString& critere, bool ordre)
 int Client::count()
 {
     DatabaseManager& db = DatabaseManager::instance();
-    QSqlQuery query = db.prepareQuery("SELECT COUNT(*) FROM CLIENTS");
+    QSqlQuery query = db.prepareQuery(SQL_COUNT);
 
     if (!db.executeQuery(query) || !query.next()) {
         return 0;
@@ -450,7 +447,7 @@ int Client::count()
 int Client::countByStatut(Statut statut)
 {
     DatabaseManager& db = DatabaseManager::instance();
-    QSqlQuery query = db.prepareQuery("SELECT COUNT(*) FROM CLIENTS WHERE STATUT = ?");
+    QSqlQuery query = db.prepareQuery(SQL_COUNT_BY_STATUT);
 
     if (!db.executeQuery(query, {statutToString(statut)}) || !query.next()) {
         return 0;
@@ -460,31 +457,67 @@ int Client::countByStatut(Statut statut)
 }
 
 // Méthodes privées
-Client* Client::fromQuery(const QSqlQuery& query)
+Client::ColumnIndex Client::resolveColumns(const QSqlRecord& record)
+{
+    ColumnIndex columns;
+    columns.id = record.indexOf("ID_CLIENT");
+    columns.nom = record.indexOf("NOM");
+    columns.prenom = record.indexOf("PRENOM");
+    columns.email = record.indexOf("EMAIL");
+    columns.telephone = record.indexOf("TELEPHONE");
+    columns.adresse = record.indexOf("ADRESSE");
+    columns.ville = record.indexOf("VILLE");
+    columns.codePostal = record.indexOf("CODE_POSTAL");
+    columns.dateCreation = record.indexOf("DATE_CREATION");
+    columns.statut = record.indexOf("STATUT");
+    return columns;
+}
+
+Client* Client::fromQuery(const QSqlQuery& query, const ColumnIndex& columns)
 {
     return new Client(
-        query.value("ID_CLIENT").toInt(),
-        query.value("NOM").toString(),
-        query.value("PRENOM").toString(),
-        query.value("EMAIL").toString(),
-        query.value("TELEPHONE").toString(),
-        query.value("ADRESSE").toString(),
-        query.value("VILLE").toString(),
-        query.value("CODE_POSTAL").toString(),
-        query.value("DATE_CREATION").toDate(),
-        stringToStatut(query.value("STATUT").toString())
+        query.value(columns.id).toInt(),
+        query.value(columns.nom).toString(),
+        query.value(columns.prenom).toString(),
+        query.value(columns.email).toString(),
+        query.value(columns.telephone).toString(),
+        query.value(columns.adresse).toString(),
+        query.value(columns.ville).toString(),
+        query.value(columns.codePostal).toString(),
+        query.value(columns.dateCreation).toDate(),
+        stringToStatut(query.value(columns.statut).toString())
     );
 }
 
+Client* Client::fromQuery(const QSqlQuery& query)
+{
+    return fromQuery(query, resolveColumns(query.record()));
+}
+
+QList<Client*> Client::fromResultSet(QSqlQuery& query)
+{
+    TRACE_SPAN("model", "Client::fromResultSet");
+    QList<Client*> clients;
+
+    // Positions résolues une seule fois pour tout le jeu de résultats
+    const ColumnIndex columns = resolveColumns(query.record());
+    while (query.next()) {
+        clients.append(fromQuery(query, columns));
+    }
+
+    QueryProfiler::instance().addRows(query.lastQuery(), clients.size());
+
+    return clients;
+}
+
 bool Client::isValidEmail(const QString& email)
 {
     if (email.isEmpty() || email.length() > 150) {
         return false;
     }
 
-    // Expression régulière pour valider l'email
-    QRegularExpression emailRegex(R"(^[A-Za-z0-9._%+-]+@[A-Za-z0-9.-]+\.[A-Za-z]{2,}$)");
-    return emailRegex.match(email).hasMatch();
+    // Même règle que l'expression régulière du Validator, parcours ASCII sans allocation
+    return Validator::matchesEmail(email);
 }
 
 bool Client::isValidTelephone(const QString& telephone)
@@ -493,7 +526,5 @@ bool Client::isValidTelephone(const QString& telephone)
         return false;
     }
 
-    // Expression régulière pour valider le téléphone
-    QRegularExpression phoneRegex(R"(^[0-9+\-\s\(\)]{8,20}$)");
-    return phoneRegex.match(telephone).hasMatch();
+    return Validator::matchesTelephone(telephone);
 }
@@ -7,6 +7,7 @@
 #include <QVariant>
 #include <QList>
 #include <QSqlQuery>
+#include <QSqlRecord>
 
 /**
  * @brief Classe modèle pour la gestion des clients
@@ -161,6 +162,25 @@ public:
      */
     static int countByStatut(Statut statut);
 
+    /**
+     * @brief Requêtes SQL du modèle
+     *
+     * Exécutées telles quelles par les méthodes ci-dessus et reprises par
+     * SchemaManager::modelQueries() : le plan EXPLAIN affiché est celui de la
+     * requête réellement exécutée.
+     */
+    static const QString SQL_FIND_ALL;
+    static const QString SQL_FIND_BY_ID;
+    static const QString SQL_FIND_BY_EMAIL;
+    static const QString SQL_COUNT;
+    static const QString SQL_COUNT_BY_STATUT;
+
+    /**
+     * @brief Construit la requête de search() et ses paramètres
+     */
+    static QString searchSql(const QString& nom, const QString& prenom, const QString& ville,
+                             int statut, QVariantList& params);
+
 signals:
     /**
      * @brief Signal émis quand les données du client changent
@@ -168,12 +188,53 @@ signals:
     void dataChanged();
 
 private:
+    /**
+     * @brief Positions des colonnes CLIENTS dans un jeu de résultats
+     *
+     * Résolues une seule fois par jeu de résultats pour éviter la recherche
+     * par nom de colonne à chaque ligne.
+     */
+    struct ColumnIndex {
+        int id = -1;
+        int nom = -1;
+        int prenom = -1;
+        int email = -1;
+        int telephone = -1;
+        int adresse = -1;
+        int ville = -1;
+        int codePostal = -1;
+        int dateCreation = -1;
+        int statut = -1;
+    };
+
+    /**
+     * @brief Résout les positions des colonnes à partir de l'enregistrement
+     * @param record Enregistrement décrivant le jeu de résultats
+     * @return Positions des colonnes
+     */
+    static ColumnIndex resolveColumns(const QSqlRecord& record);
+
     /**
      * @brief Crée un objet Client à partir d'une requête SQL
      * @param query Requête SQL positionnée sur un enregistrement
+     * @param columns Positions des colonnes résolues pour ce jeu de résultats
+     * @return Pointeur vers le nouveau client
+     */
+    static Client* fromQuery(const QSqlQuery& query, const ColumnIndex& columns);
+
+    /**
+     * @brief Crée un objet Client à partir de l'enregistrement courant
+     * @param query Requête SQL positionnée sur un enregistrement
      * @return Pointeur vers le nouveau client
      */
     static Client* fromQuery(const QSqlQuery& query);
+
+    /**
+     * @brief Matérialise toutes les lignes restantes d'une requête exécutée
+     * @param query Requête exécutée en lecture séquentielle
+     * @return Liste des clients lus
+     */
+    static QList<Client*> fromResultSet(QSqlQuery& query);
     
     /**
      * @brief Valide un email
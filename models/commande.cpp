@@ -1,12 +1,79 @@
 #include "commande.h"
 #include "client.h"
 #include "database/databasemanager.h"
+#include "database/queryprofiler.h"
+#include "database/archivemanager.h"
+#include "utils/tracer.h"
 #include <QSqlQuery>
 #include <QSqlError>
+#include <QSqlRecord>
 #include <QVariant>
 #include <QDebug>
+#include <QSet>
 #include <algorithm>
 
+namespace {
+
+// Identifiants par lot : liés deux fois (COMMANDES et COMMANDES_ARCHIVE),
+// chaque liste IN reste sous la limite Oracle de 1000 éléments
+const int IDS_PER_QUERY = 400;
+
+const char* const SELECT_COLUMNS = R"(
+        SELECT ID_COMMANDE, ID_CLIENT, NUMERO_COMMANDE, DATE_COMMANDE, DATE_LIVRAISON_PREVUE,
+               DATE_LIVRAISON_REELLE, ADRESSE_LIVRAISON, VILLE_LIVRAISON, CODE_POSTAL_LIVRAISON,
+               STATUT, PRIORITE, POIDS_TOTAL, VOLUME_TOTAL, PRIX_TOTAL, COMMENTAIRES
+)";
+
+// Sources des requêtes qui lisent aussi l'archive : la colonne ARCHIVEE
+// signale les commandes en lecture seule (voir Commande::estArchivee())
+const char* const FROM_ACTIVES = ", 0 AS ARCHIVEE FROM COMMANDES";
+const char* const FROM_ARCHIVE = ", 1 AS ARCHIVEE FROM COMMANDES_ARCHIVE";
+
+} // namespace
+
+// Liste courante : commandes actives seulement (voir ArchiveManager)
+const QString Commande::SQL_FIND_ALL =
+    QString(SELECT_COLUMNS) + " FROM COMMANDES ORDER BY DATE_COMMANDE DESC";
+
+// Recherches unitaires et agrégats : COMMANDES et COMMANDES_ARCHIVE, les
+// paramètres sont liés une fois par table
+const QString Commande::SQL_FIND_BY_ID =
+    QString(SELECT_COLUMNS) + FROM_ACTIVES + " WHERE ID_COMMANDE = ?"
+    " UNION ALL " + SELECT_COLUMNS + FROM_ARCHIVE + " WHERE ID_COMMANDE = ?";
+const QString Commande::SQL_FIND_BY_NUMERO =
+    QString(SELECT_COLUMNS) + FROM_ACTIVES + " WHERE NUMERO_COMMANDE = ?"
+    " UNION ALL " + SELECT_COLUMNS + FROM_ARCHIVE + " WHERE NUMERO_COMMANDE = ?";
+const QString Commande::SQL_FIND_BY_CLIENT =
+    QString(SELECT_COLUMNS) + FROM_ACTIVES + " WHERE ID_CLIENT = ?"
+    " UNION ALL " + SELECT_COLUMNS + FROM_ARCHIVE + " WHERE ID_CLIENT = ?"
+    " ORDER BY DATE_COMMANDE DESC";
+const QString Commande::SQL_COUNT =
+    "SELECT SUM(N) FROM (SELECT COUNT(*) AS N FROM COMMANDES"
+    " UNION ALL SELECT COUNT(*) FROM COMMANDES_ARCHIVE)";
+const QString Commande::SQL_COUNT_BY_STATUT = "SELECT COUNT(*) FROM COMMANDES WHERE STATUT = ?";
+// Seuls les statuts terminés (LIVREE, ANNULEE) sont présents dans l'archive
+const QString Commande::SQL_COUNT_BY_STATUT_ARCHIVE =
+    "SELECT SUM(N) FROM (SELECT COUNT(*) AS N FROM COMMANDES WHERE STATUT = ?"
+    " UNION ALL SELECT COUNT(*) FROM COMMANDES_ARCHIVE WHERE STATUT = ?)";
+const QString Commande::SQL_COUNT_BY_PRIORITE =
+    "SELECT SUM(N) FROM (SELECT COUNT(*) AS N FROM COMMANDES WHERE PRIORITE = ?"
+    " UNION ALL SELECT COUNT(*) FROM COMMANDES_ARCHIVE WHERE PRIORITE = ?)";
+// Servie par l'index composite IDX_COMMANDES_CLIENT_STATUT ; l'archive ne
+// contient aucune commande active
+const QString Commande::SQL_COUNT_ACTIVES_BY_CLIENT =
+    "SELECT COUNT(*) FROM COMMANDES WHERE ID_CLIENT = ? AND STATUT NOT IN ('LIVREE', 'ANNULEE')";
+const QString Commande::SQL_TOTAL_CHIFFRE_AFFAIRES =
+    "SELECT SUM(PRIX_TOTAL) FROM (SELECT PRIX_TOTAL FROM COMMANDES WHERE STATUT != 'ANNULEE'"
+    " UNION ALL SELECT PRIX_TOTAL FROM COMMANDES_ARCHIVE WHERE STATUT != 'ANNULEE')";
+const QString Commande::SQL_MOYENNE_PRIX =
+    "SELECT AVG(PRIX_TOTAL) FROM (SELECT PRIX_TOTAL FROM COMMANDES WHERE STATUT != 'ANNULEE'"
+    " UNION ALL SELECT PRIX_TOTAL FROM COMMANDES_ARCHIVE WHERE STATUT != 'ANNULEE')";
+// Numérotation SQLite : identifiants jamais réutilisés (AUTOINCREMENT) et
+// conservés par l'archivage, le maximum couvre donc tous les numéros attribués
+const QString Commande::SQL_NEXT_NUMERO =
+    "SELECT MAX(ID) FROM (SELECT MAX(ID_COMMANDE) AS ID FROM COMMANDES"
+    " UNION ALL SELECT MAX(ID_COMMANDE) FROM COMMANDES_ARCHIVE)";
+
 Commande::Commande(QObject *parent)
     : QObject(parent)
     , m_id(-1)
@@ -17,6 +84,7 @@ Commande::Commande(QObject *parent)
     , m_poidsTotal(0.0)
     , m_volumeTotal(0.0)
     , m_prixTotal(0.0)
+    , m_archivee(false)
 {
 }
 
@@ -42,6 +110,7 @@ Commande::Commande(int id, int idClient, const QString& numeroCommande, const QD
     , m_volumeTotal(volumeTotal)
     , m_prixTotal(prixTotal)
     , m_commentaires(commentaires)
+    , m_archivee(false)
 {
 }
 
@@ -288,6 +357,12 @@ bool Commande::save()
         return false;
     }
 
+    // L'archive est en lecture seule : une mise à jour de COMMANDES n'y changerait rien
+    if (m_archivee) {
+        qWarning() << "Commande archivée, impossible de la modifier:" << m_numeroCommande;
+        return false;
+    }
+
     DatabaseManager& db = DatabaseManager::instance();
 
     if (m_id == -1) {
@@ -296,10 +371,11 @@ bool Commande::save()
         // Générer le numéro de commande
         if (m_numeroCommande.isEmpty()) {
             if (db.database().driverName() == "QSQLITE") {
-                // Pour SQLite, générer un numéro unique basé sur l'ID
-                QSqlQuery countQuery = db.prepareQuery("SELECT COUNT(*) FROM COMMANDES");
-                if (db.executeQuery(countQuery) && countQuery.next()) {
-                    int nextId = countQuery.value(0).toInt() + 1;
+                // Pour SQLite, générer un numéro unique basé sur le plus grand ID attribué,
+                // archive comprise (un comptage réattribuerait les numéros archivés)
+                QSqlQuery maxQuery = db.prepareQuery(SQL_NEXT_NUMERO);
+                if (db.executeQuery(maxQuery) && maxQuery.next()) {
+                    int nextId = maxQuery.value(0).toInt() + 1;
                     m_numeroCommande = QString("CMD%1").arg(nextId, 6, 10, QChar('0'));
                 } else {
                     m_numeroCommande = "CMD000001"; // Par défaut
@@ -361,6 +437,11 @@ bool Commande::save()
             qWarning() << "Erreur lors de la mise à jour de la commande:" << db.lastError();
             return false;
         }
+
+        if (query.numRowsAffected() == 0) {
+            qWarning() << "Commande introuvable, aucune ligne mise à jour:" << m_id;
+            return false;
+        }
     }
 
     emit dataChanged();
@@ -370,32 +451,29 @@ bool Commande::save()
 bool Commande::load(int id)
 {
     DatabaseManager& db = DatabaseManager::instance();
-    QSqlQuery query = db.prepareQuery(R"(
-        SELECT ID_COMMANDE, ID_CLIENT, NUMERO_COMMANDE, DATE_COMMANDE, DATE_LIVRAISON_PREVUE,
-               DATE_LIVRAISON_REELLE, ADRESSE_LIVRAISON, VILLE_LIVRAISON, CODE_POSTAL_LIVRAISON,
-               STATUT, PRIORITE, POIDS_TOTAL, VOLUME_TOTAL, PRIX_TOTAL, COMMENTAIRES
-        FROM COMMANDES WHERE ID_COMMANDE = ?
-    )");
+    QSqlQuery query = db.prepareQuery(SQL_FIND_BY_ID);
 
-    if (!db.executeQuery(query, {id}) || !query.next()) {
+    if (!db.executeQuery(query, {id, id}) || !query.next()) {
         return false;
     }
 
-    m_id = query.value("ID_COMMANDE").toInt();
-    m_idClient = query.value("ID_CLIENT").toInt();
-    m_numeroCommande = query.value("NUMERO_COMMANDE").toString();
-    m_dateCommande = query.value("DATE_COMMANDE").toDate();
-    m_dateLivraisonPrevue = query.value("DATE_LIVRAISON_PREVUE").toDate();
-    m_dateLivraisonReelle = query.value("DATE_LIVRAISON_REELLE").toDate();
-    m_adresseLivraison = query.value("ADRESSE_LIVRAISON").toString();
-    m_villeLivraison = query.value("VILLE_LIVRAISON").toString();
-    m_codePostalLivraison = query.value("CODE_POSTAL_LIVRAISON").toString();
-    m_statut = stringToStatut(query.value("STATUT").toString());
-    m_priorite = stringToPriorite(query.value("PRIORITE").toString());
-    m_poidsTotal = query.value("POIDS_TOTAL").toDouble();
-    m_volumeTotal = query.value("VOLUME_TOTAL").toDouble();
-    m_prixTotal = query.value("PRIX_TOTAL").toDouble();
-    m_commentaires = query.value("COMMENTAIRES").toString();
+    const ColumnIndex columns = resolveColumns(query.record());
+    m_id = query.value(columns.id).toInt();
+    m_idClient = query.value(columns.idClient).toInt();
+    m_numeroCommande = query.value(columns.numero).toString();
+    m_dateCommande = query.value(columns.dateCommande).toDate();
+    m_dateLivraisonPrevue = query.value(columns.dateLivraisonPrevue).toDate();
+    m_dateLivraisonReelle = query.value(columns.dateLivraisonReelle).toDate();
+    m_adresseLivraison = query.value(columns.adresseLivraison).toString();
+    m_villeLivraison = query.value(columns.villeLivraison).toString();
+    m_codePostalLivraison = query.value(columns.codePostalLivraison).toString();
+    m_statut = stringToStatut(query.value(columns.statut).toString());
+    m_priorite = stringToPriorite(query.value(columns.priorite).toString());
+    m_poidsTotal = query.value(columns.poidsTotal).toDouble();
+    m_volumeTotal = query.value(columns.volumeTotal).toDouble();
+    m_prixTotal = query.value(columns.prixTotal).toDouble();
+    m_commentaires = query.value(columns.commentaires).toString();
+    m_archivee = columns.archivee >= 0 && query.value(columns.archivee).toInt() != 0;
 
     return true;
 }
@@ -406,6 +484,11 @@ bool Commande::remove()
         return false;
     }
 
+    if (m_archivee) {
+        qWarning() << "Commande archivée, impossible de la supprimer:" << m_numeroCommande;
+        return false;
+    }
+
     DatabaseManager& db = DatabaseManager::instance();
     QSqlQuery query = db.prepareQuery("DELETE FROM COMMANDES WHERE ID_COMMANDE = ?");
 
@@ -414,6 +497,11 @@ bool Commande::remove()
         return false;
     }
 
+    if (query.numRowsAffected() == 0) {
+        qWarning() << "Commande introuvable, aucune ligne supprimée:" << m_id;
+        return false;
+    }
+
     m_id = -1;
     return true;
 }
@@ -421,40 +509,25 @@ bool Commande::remove()
 // Méthodes statiques pour les opérations de recherche
 QList<Commande*> Commande::findAll()
 {
-    QList<Commande*> commandes;
+    TRACE_SPAN("model", "Commande::findAll");
     DatabaseManager& db = DatabaseManager::instance();
 
-    QSqlQuery query = db.prepareQuery(R"(
-        SELECT ID_COMMANDE, ID_CLIENT, NUMERO_COMMANDE, DATE_COMMANDE, DATE_LIVRAISON_PREVUE,
-               DATE_LIVRAISON_REELLE, ADRESSE_LIVRAISON, VILLE_LIVRAISON, CODE_POSTAL_LIVRAISON,
-               STATUT, PRIORITE, POIDS_TOTAL, VOLUME_TOTAL, PRIX_TOTAL, COMMENTAIRES
-        FROM COMMANDES
-        ORDER BY DATE_COMMANDE DESC
-    )");
+    QSqlQuery query = db.prepareQuery(SQL_FIND_ALL);
 
     if (!db.executeQuery(query)) {
         qWarning() << "Erreur lors de la récupération des commandes:" << db.lastError();
-        return commandes;
-    }
-
-    while (query.next()) {
-        commandes.append(fromQuery(query));
+        return QList<Commande*>();
     }
 
-    return commandes;
+    return fromResultSet(query);
 }
 
 Commande* Commande::findById(int id)
 {
     DatabaseManager& db = DatabaseManager::instance();
-    QSqlQuery query = db.prepareQuery(R"(
-        SELECT ID_COMMANDE, ID_CLIENT, NUMERO_COMMANDE, DATE_COMMANDE, DATE_LIVRAISON_PREVUE,
-               DATE_LIVRAISON_REELLE, ADRESSE_LIVRAISON, VILLE_LIVRAISON, CODE_POSTAL_LIVRAISON,
-               STATUT, PRIORITE, POIDS_TOTAL, VOLUME_TOTAL, PRIX_TOTAL, COMMENTAIRES
-        FROM COMMANDES WHERE ID_COMMANDE = ?
-    )");
+    QSqlQuery query = db.prepareQuery(SQL_FIND_BY_ID);
 
-    if (!db.executeQuery(query, {id}) || !query.next()) {
+    if (!db.executeQuery(query, {id, id}) || !query.next()) {
         return nullptr;
     }
 
@@ -464,14 +537,9 @@ Commande* Commande::findById(int id)
 Commande* Commande::findByNumero(const QString& numero)
 {
     DatabaseManager& db = DatabaseManager::instance();
-    QSqlQuery query = db.prepareQuery(R"(
-        SELECT ID_COMMANDE, ID_CLIENT, NUMERO_COMMANDE, DATE_COMMANDE, DATE_LIVRAISON_PREVUE,
-               DATE_LIVRAISON_REELLE, ADRESSE_LIVRAISON, VILLE_LIVRAISON, CODE_POSTAL_LIVRAISON,
-               STATUT, PRIORITE, POIDS_TOTAL, VOLUME_TOTAL, PRIX_TOTAL, COMMENTAIRES
-        FROM COMMANDES WHERE NUMERO_COMMANDE = ?
-    )");
+    QSqlQuery query = db.prepareQuery(SQL_FIND_BY_NUMERO);
 
-    if (!db.executeQuery(query, {numero}) || !query.next()) {
+    if (!db.executeQuery(query, {numero, numero}) || !query.next()) {
         return nullptr;
     }
 
@@ -480,88 +548,85 @@ Commande* Commande::findByNumero(const QString& numero)
 
 QList<Commande*> Commande::findByClient(int idClient)
 {
-    QList<Commande*> commandes;
     DatabaseManager& db = DatabaseManager::instance();
 
-    QSqlQuery query = db.prepareQuery(R"(
-        SELECT ID_COMMANDE, ID_CLIENT, NUMERO_COMMANDE, DATE_COMMANDE, DATE_LIVRAISON_PREVUE,
-               DATE_LIVRAISON_REELLE, ADRESSE_LIVRAISON, VILLE_LIVRAISON, CODE_POSTAL_LIVRAISON,
-               STATUT, PRIORITE, POIDS_TOTAL, VOLUME_TOTAL, PRIX_TOTAL, COMMENTAIRES
-        FROM COMMANDES WHERE ID_CLIENT = ?
-        ORDER BY DATE_COMMANDE DESC
-    )");
+    QSqlQuery query = db.prepareQuery(SQL_FIND_BY_CLIENT);
 
-    if (!db.executeQuery(query, {idClient})) {
+    if (!db.executeQuery(query, {idClient, idClient})) {
         qWarning() << "Erreur lors de la récupération des commandes du client:" << db.lastError();
-        return commandes;
-    }
-
-    while (query.next()) {
-        commandes.append(fromQuery(query));
+        return QList<Commande*>();
     }
 
-    return commandes;
+    return fromResultSet(query);
 }
 
 QList<Commande*> Commande::search(const QString& numeroCommande, int idClient,
                                  int statut, int priorite,
                                  const QDate& dateDebut, const QDate& dateFin)
 {
-    QList<Commande*> commandes;
+    TRACE_SPAN("model", "Commande::search");
     DatabaseManager& db = DatabaseManager::instance();
 
-    QString sql = R"(
-        SELECT ID_COMMANDE, ID_CLIENT, NUMERO_COMMANDE, DATE_COMMANDE, DATE_LIVRAISON_PREVUE,
-               DATE_LIVRAISON_REELLE, ADRESSE_LIVRAISON, VILLE_LIVRAISON, CODE_POSTAL_LIVRAISON,
-               STATUT, PRIORITE, POIDS_TOTAL, VOLUME_TOTAL, PRIX_TOTAL, COMMENTAIRES
-        FROM COMMANDES WHERE 1=1
-    )";
-
     QVariantList params;
+    const QString sql = searchSql(numeroCommande, idClient, statut, priorite, dateDebut, dateFin, params);
+
+    QSqlQuery query = db.prepareQuery(sql);
+    if (!db.executeQuery(query, params)) {
+        qWarning() << "Erreur lors de la recherche de commandes:" << db.lastError();
+        return QList<Commande*>();
+    }
+
+    return fromResultSet(query);
+}
+
+QString Commande::searchSql(const QString& numeroCommande, int idClient, int statut, int priorite,
+                           const QDate& dateDebut, const QDate& dateFin, QVariantList& params)
+{
+    const QString columns = SELECT_COLUMNS;
+
+    QString where = " WHERE 1=1";
 
     if (!numeroCommande.isEmpty()) {
-        sql += " AND UPPER(NUMERO_COMMANDE) LIKE UPPER(?)";
+        where += " AND UPPER(NUMERO_COMMANDE) LIKE UPPER(?)";
         params << ("%" + numeroCommande + "%");
     }
 
     if (idClient > 0) {
-        sql += " AND ID_CLIENT = ?";
+        where += " AND ID_CLIENT = ?";
         params << idClient;
     }
 
     if (statut >= 0 && statut <= 5) {
-        sql += " AND STATUT = ?";
+        where += " AND STATUT = ?";
         params << statutToString(static_cast<Statut>(statut));
     }
 
     if (priorite >= 0 && priorite <= 3) {
-        sql += " AND PRIORITE = ?";
+        where += " AND PRIORITE = ?";
         params << prioriteToString(static_cast<Priorite>(priorite));
     }
 
     if (dateDebut.isValid()) {
-        sql += " AND DATE_COMMANDE >= ?";
+        where += " AND DATE_COMMANDE >= ?";
         params << dateDebut;
     }
 
     if (dateFin.isValid()) {
-        sql += " AND DATE_COMMANDE <= ?";
+        where += " AND DATE_COMMANDE <= ?";
         params << dateFin;
     }
 
-    sql += " ORDER BY DATE_COMMANDE DESC";
-
-    QSqlQuery query = db.prepareQuery(sql);
-    if (!db.executeQuery(query, params)) {
-        qWarning() << "Erreur lors de la recherche de commandes:" << db.lastError();
-        return commandes;
-    }
+    QString sql = columns + FROM_ACTIVES + where;
 
-    while (query.next()) {
-        commandes.append(fromQuery(query));
+    // L'archive n'est lue que si la période demandée remonte jusqu'à elle
+    if (ArchiveManager::includesArchive(dateDebut)) {
+        const QVariantList activeParams = params;
+        sql += " UNION ALL " + columns + FROM_ARCHIVE + where;
+        params += activeParams;
     }
 
-    return commandes;
+    sql += " ORDER BY DATE_COMMANDE DESC";
+    return sql;
 }
 
 void Commande::sort(QList<Commande*>& commandes, const QString& critere, bool ordre)
@@ -594,7 +659,7 @@ void Commande::sort(QList<Commande*>& commandes, const QString& critere, bool or
 int Commande::count()
 {
     DatabaseManager& db = DatabaseManager::instance();
-    QSqlQuery query = db.prepareQuery("SELECT COUNT(*) FROM COMMANDES");
+    QSqlQuery query = db.prepareQuery(SQL_COUNT);
 
     if (!db.executeQuery(query) || !query.next()) {
         return 0;
@@ -606,9 +671,12 @@ int Commande::count()
 int Commande::countByStatut(Statut statut)
 {
     DatabaseManager& db = DatabaseManager::instance();
-    QSqlQuery query = db.prepareQuery("SELECT COUNT(*) FROM COMMANDES WHERE STATUT = ?");
+    const QString value = statutToString(statut);
+    const bool withArchive = statut == LIVREE || statut == ANNULEE;
+    QSqlQuery query = db.prepareQuery(withArchive ? SQL_COUNT_BY_STATUT_ARCHIVE : SQL_COUNT_BY_STATUT);
 
-    if (!db.executeQuery(query, {statutToString(statut)}) || !query.next()) {
+    const QVariantList params = withArchive ? QVariantList{value, value} : QVariantList{value};
+    if (!db.executeQuery(query, params) || !query.next()) {
         return 0;
     }
 
@@ -618,19 +686,32 @@ int Commande::countByStatut(Statut statut)
 int Commande::countByPriorite(Priorite priorite)
 {
     DatabaseManager& db = DatabaseManager::instance();
-    QSqlQuery query = db.prepareQuery("SELECT COUNT(*) FROM COMMANDES WHERE PRIORITE = ?");
+    QSqlQuery query = db.prepareQuery(SQL_COUNT_BY_PRIORITE);
 
-    if (!db.executeQuery(query, {prioriteToString(priorite)}) || !query.next()) {
+    const QString value = prioriteToString(priorite);
+    if (!db.executeQuery(query, {value, value}) || !query.next()) {
         return 0;
     }
 
     return query.value(0).toInt();
 }
 
+int Commande::countActivesByClient(int idClient)
+{
+    DatabaseManager& db = DatabaseManager::instance();
+    QSqlQuery query = db.prepareQuery(SQL_COUNT_ACTIVES_BY_CLIENT);
+
+    if (!db.executeQuery(query, {idClient}) || !query.next()) {
+        return -1;
+    }
+
+    return query.value(0).toInt();
+}
+
 double Commande::totalChiffreAffaires()
 {
     DatabaseManager& db = DatabaseManager::instance();
-    QSqlQuery query = db.prepareQuery("SELECT SUM(PRIX_TOTAL) FROM COMMANDES WHERE STATUT != 'ANNULEE'");
+    QSqlQuery query = db.prepareQuery(SQL_TOTAL_CHIFFRE_AFFAIRES);
 
     if (!db.executeQuery(query) || !query.next()) {
         return 0.0;
@@ -642,7 +723,7 @@ double Commande::totalChiffreAffaires()
 double Commande::moyennePrixCommandes()
 {
     DatabaseManager& db = DatabaseManager::instance();
-    QSqlQuery query = db.prepareQuery("SELECT AVG(PRIX_TOTAL) FROM COMMANDES WHERE STATUT != 'ANNULEE'");
+    QSqlQuery query = db.prepareQuery(SQL_MOYENNE_PRIX);
 
     if (!db.executeQuery(query) || !query.next()) {
         return 0.0;
@@ -653,49 +734,155 @@ double Commande::moyennePrixCommandes()
 
 QList<Commande*> Commande::commandesEnRetard()
 {
-    QList<Commande*> commandes;
+    return findByEcheance(QDate(), QDate::currentDate());
+}
+
+QList<Commande*> Commande::findByEcheance(const QDate& debut, const QDate& fin)
+{
     DatabaseManager& db = DatabaseManager::instance();
 
-    QSqlQuery query = db.prepareQuery(R"(
-        SELECT ID_COMMANDE, ID_CLIENT, NUMERO_COMMANDE, DATE_COMMANDE, DATE_LIVRAISON_PREVUE,
-               DATE_LIVRAISON_REELLE, ADRESSE_LIVRAISON, VILLE_LIVRAISON, CODE_POSTAL_LIVRAISON,
-               STATUT, PRIORITE, POIDS_TOTAL, VOLUME_TOTAL, PRIX_TOTAL, COMMENTAIRES
-        FROM COMMANDES
-        WHERE DATE_LIVRAISON_PREVUE < SYSDATE
-          AND STATUT NOT IN ('LIVREE', 'ANNULEE')
-        ORDER BY DATE_LIVRAISON_PREVUE ASC
-    )");
+    QVariantList params;
+    const QString sql = echeanceSql(debut, fin, params);
 
-    if (!db.executeQuery(query)) {
-        qWarning() << "Erreur lors de la récupération des commandes en retard:" << db.lastError();
-        return commandes;
+    QSqlQuery query = db.prepareQuery(sql);
+    if (!db.executeQuery(query, params)) {
+        qWarning() << "Erreur lors de la récupération des commandes par échéance:" << db.lastError();
+        return QList<Commande*>();
     }
 
-    while (query.next()) {
-        commandes.append(fromQuery(query));
+    return fromResultSet(query);
+}
+
+bool Commande::forEachWithClient(const QList<int>& idsCommande, const QString& columns,
+                                 const std::function<void(const QSqlQuery&)>& readRow)
+{
+    DatabaseManager& db = DatabaseManager::instance();
+
+    QList<int> ids;
+    ids.reserve(idsCommande.size());
+    QSet<int> seen;
+    for (int id : idsCommande) {
+        if (!seen.contains(id)) {
+            seen.insert(id);
+            ids.append(id);
+        }
     }
 
-    return commandes;
+    for (int begin = 0; begin < ids.size(); begin += IDS_PER_QUERY) {
+        const QList<int> chunk = ids.mid(begin, IDS_PER_QUERY);
+
+        QStringList placeholders;
+        QVariantList values;
+        for (int id : chunk) {
+            placeholders << "?";
+            values << id;
+        }
+        values += values;
+
+        const QString inList = placeholders.join(", ");
+        QSqlQuery query = db.prepareQuery(
+            "SELECT " + columns + " FROM ("
+            + SELECT_COLUMNS + " FROM COMMANDES WHERE ID_COMMANDE IN (" + inList + ")"
+            " UNION ALL " + SELECT_COLUMNS + " FROM COMMANDES_ARCHIVE WHERE ID_COMMANDE IN (" + inList + ")"
+            ") c JOIN CLIENTS cl ON cl.ID_CLIENT = c.ID_CLIENT");
+
+        if (!db.executeQuery(query, values)) {
+            return false;
+        }
+
+        int rows = 0;
+        while (query.next()) {
+            ++rows;
+            readRow(query);
+        }
+        QueryProfiler::instance().addRows(query.lastQuery(), rows);
+    }
+    return true;
+}
+
+QString Commande::echeanceSql(const QDate& debut, const QDate& fin, QVariantList& params)
+{
+    // Dates liées en paramètres (pas de SYSDATE) : même requête Oracle/SQLite.
+    // Statuts actifs énumérés pour parcourir IDX_COMMANDES_STATUT_LIVRAISON
+    QString sql = QString(SELECT_COLUMNS) + R"(
+        FROM COMMANDES
+        WHERE STATUT IN ('EN_ATTENTE', 'CONFIRMEE', 'EN_PREPARATION', 'EN_TRANSIT')
+          AND DATE_LIVRAISON_PREVUE < ?
+    )";
+    params << fin;
+
+    if (debut.isValid()) {
+        sql += " AND DATE_LIVRAISON_PREVUE >= ?";
+        params << debut;
+    }
+
+    sql += " ORDER BY DATE_LIVRAISON_PREVUE ASC";
+    return sql;
 }
 
 // Méthode privée
+Commande::ColumnIndex Commande::resolveColumns(const QSqlRecord& record)
+{
+    ColumnIndex columns;
+    columns.id = record.indexOf("ID_COMMANDE");
+    columns.idClient = record.indexOf("ID_CLIENT");
+    columns.numero = record.indexOf("NUMERO_COMMANDE");
+    columns.dateCommande = record.indexOf("DATE_COMMANDE");
+    columns.dateLivraisonPrevue = record.indexOf("DATE_LIVRAISON_PREVUE");
+    columns.dateLivraisonReelle = record.indexOf("DATE_LIVRAISON_REELLE");
+    columns.adresseLivraison = record.indexOf("ADRESSE_LIVRAISON");
+    columns.villeLivraison = record.indexOf("VILLE_LIVRAISON");
+    columns.codePostalLivraison = record.indexOf("CODE_POSTAL_LIVRAISON");
+    columns.statut = record.indexOf("STATUT");
+    columns.priorite = record.indexOf("PRIORITE");
+    columns.poidsTotal = record.indexOf("POIDS_TOTAL");
+    columns.volumeTotal = record.indexOf("VOLUME_TOTAL");
+    columns.prixTotal = record.indexOf("PRIX_TOTAL");
+    columns.commentaires = record.indexOf("COMMENTAIRES");
+    columns.archivee = record.indexOf("ARCHIVEE");
+    return columns;
+}
+
+Commande* Commande::fromQuery(const QSqlQuery& query, const ColumnIndex& columns)
+{
+    Commande* commande = new Commande(
+        query.value(columns.id).toInt(),
+        query.value(columns.idClient).toInt(),
+        query.value(columns.numero).toString(),
+        query.value(columns.dateCommande).toDate(),
+        query.value(columns.dateLivraisonPrevue).toDate(),
+        query.value(columns.dateLivraisonReelle).toDate(),
+        query.value(columns.adresseLivraison).toString(),
+        query.value(columns.villeLivraison).toString(),
+        query.value(columns.codePostalLivraison).toString(),
+        stringToStatut(query.value(columns.statut).toString()),
+        stringToPriorite(query.value(columns.priorite).toString()),
+        query.value(columns.poidsTotal).toDouble(),
+        query.value(columns.volumeTotal).toDouble(),
+        query.value(columns.prixTotal).toDouble(),
+        query.value(columns.commentaires).toString()
+    );
+    commande->m_archivee = columns.archivee >= 0 && query.value(columns.archivee).toInt() != 0;
+    return commande;
+}
+
 Commande* Commande::fromQuery(const QSqlQuery& query)
 {
-    return new Commande(
-        query.value("ID_COMMANDE").toInt(),
-        query.value("ID_CLIENT").toInt(),
-        query.value("NUMERO_COMMANDE").toString(),
-        query.value("DATE_COMMANDE").toDate(),
-        query.value("DATE_LIVRAISON_PREVUE").toDate(),
-        query.value("DATE_LIVRAISON_REELLE").toDate(),
-        query.value("ADRESSE_LIVRAISON").toString(),
-        query.value("VILLE_LIVRAISON").toString(),
-        query.value("CODE_POSTAL_LIVRAISON").toString(),
-        stringToStatut(query.value("STATUT").toString()),
-        stringToPriorite(query.value("PRIORITE").toString()),
-        query.value("POIDS_TOTAL").toDouble(),
-        query.value("VOLUME_TOTAL").toDouble(),
-        query.value("PRIX_TOTAL").toDouble(),
-        query.value("COMMENTAIRES").toString()
-    );
+    return fromQuery(query, resolveColumns(query.record()));
+}
+
+QList<Commande*> Commande::fromResultSet(QSqlQuery& query)
+{
+    TRACE_SPAN("model", "Commande::fromResultSet");
+    QList<Commande*> commandes;
+
+    // Positions résolues une seule fois pour tout le jeu de résultats
+    const ColumnIndex columns = resolveColumns(query.record());
+    while (query.next()) {
+        commandes.append(fromQuery(query, columns));
+    }
+
+    QueryProfiler::instance().addRows(query.lastQuery(), commandes.size());
+
+    return commandes;
 }
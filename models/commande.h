@@ -7,6 +7,8 @@
 #include <QVariant>
 #include <QList>
 #include <QSqlQuery>
+#include <QSqlRecord>
+#include <functional>
 
 // Forward declaration
 class Client;
@@ -78,6 +80,13 @@ public:
     double volumeTotal() const { return m_volumeTotal; }
     double prixTotal() const { return m_prixTotal; }
     QString commentaires() const { return m_commentaires; }
+
+    /**
+     * @brief Indique si la commande a été lue dans COMMANDES_ARCHIVE
+     *
+     * Une commande archivée est en lecture seule : save() et remove() la refusent.
+     */
+    bool estArchivee() const { return m_archivee; }
     
     // Setters avec validation
     void setId(int id) { m_id = id; }
@@ -131,7 +140,9 @@ public:
     bool load(int id);
     bool remove();
     
-    // Méthodes statiques pour les opérations de recherche
+    // Méthodes statiques pour les opérations de recherche. findAll() ne lit que
+    // les commandes actives ; les recherches unitaires, par client et les
+    // statistiques incluent les commandes archivées
     static QList<Commande*> findAll();
     static Commande* findById(int id);
     static Commande* findByNumero(const QString& numero);
@@ -143,7 +154,8 @@ public:
      * @param idClient ID du client (0 pour tous)
      * @param statut Statut à rechercher (-1 pour tous)
      * @param priorite Priorité à rechercher (-1 pour toutes)
-     * @param dateDebut Date de début de période (invalide pour ignorer)
+     * @param dateDebut Date de début de période (invalide pour ignorer) ; les
+     *        commandes archivées sont incluses si la période remonte jusqu'à elles
      * @param dateFin Date de fin de période (invalide pour ignorer)
      * @return Liste des commandes correspondantes
      */
@@ -164,15 +176,91 @@ public:
     static int count();
     static int countByStatut(Statut statut);
     static int countByPriorite(Priorite priorite);
+    static int countActivesByClient(int idClient);
     static double totalChiffreAffaires();
     static double moyennePrixCommandes();
     static QList<Commande*> commandesEnRetard();
 
+    /**
+     * @brief Commandes actives dont la livraison prévue est dans [debut, fin[
+     * @param debut Borne inférieure incluse (invalide pour ignorer)
+     * @param fin Borne supérieure exclue
+     * @return Liste des commandes triées par échéance
+     */
+    static QList<Commande*> findByEcheance(const QDate& debut, const QDate& fin);
+
+    /**
+     * @brief Lit des commandes actives et archivées par identifiants, jointes à leur client
+     *
+     * Les identifiants sont dédoublonnés puis lus par lots (liste IN bornée
+     * pour Oracle). Dans les colonnes, la commande est aliasée c et le client cl.
+     * @param idsCommande Identifiants recherchés
+     * @param columns Colonnes sélectionnées, c.ID_COMMANDE en première position
+     * @param readRow Appelé pour chaque ligne lue, dans un ordre quelconque
+     * @return false en cas d'erreur de base de données (DatabaseManager::lastError())
+     */
+    static bool forEachWithClient(const QList<int>& idsCommande, const QString& columns,
+                                  const std::function<void(const QSqlQuery&)>& readRow);
+
+    /**
+     * @brief Requêtes SQL du modèle
+     *
+     * Exécutées telles quelles par les méthodes ci-dessus et reprises par
+     * SchemaManager::modelQueries() : le plan EXPLAIN affiché est celui de la
+     * requête réellement exécutée.
+     */
+    static const QString SQL_FIND_ALL;
+    static const QString SQL_FIND_BY_ID;
+    static const QString SQL_FIND_BY_NUMERO;
+    static const QString SQL_FIND_BY_CLIENT;
+    static const QString SQL_COUNT;
+    static const QString SQL_COUNT_BY_STATUT;
+    static const QString SQL_COUNT_BY_STATUT_ARCHIVE;
+    static const QString SQL_COUNT_BY_PRIORITE;
+    static const QString SQL_COUNT_ACTIVES_BY_CLIENT;
+    static const QString SQL_TOTAL_CHIFFRE_AFFAIRES;
+    static const QString SQL_MOYENNE_PRIX;
+    static const QString SQL_NEXT_NUMERO;
+
+    /**
+     * @brief Construit la requête de search() et ses paramètres
+     */
+    static QString searchSql(const QString& numeroCommande, int idClient, int statut, int priorite,
+                             const QDate& dateDebut, const QDate& dateFin, QVariantList& params);
+
+    /**
+     * @brief Construit la requête de findByEcheance() et ses paramètres
+     */
+    static QString echeanceSql(const QDate& debut, const QDate& fin, QVariantList& params);
+
 signals:
     void dataChanged();
 
 private:
+    // Positions des colonnes COMMANDES, résolues une fois par jeu de résultats
+    struct ColumnIndex {
+        int id = -1;
+        int idClient = -1;
+        int numero = -1;
+        int dateCommande = -1;
+        int dateLivraisonPrevue = -1;
+        int dateLivraisonReelle = -1;
+        int adresseLivraison = -1;
+        int villeLivraison = -1;
+        int codePostalLivraison = -1;
+        int statut = -1;
+        int priorite = -1;
+        int poidsTotal = -1;
+        int volumeTotal = -1;
+        int prixTotal = -1;
+        int commentaires = -1;
+        int archivee = -1;
+    };
+
+    static ColumnIndex resolveColumns(const QSqlRecord& record);
+    static Commande* fromQuery(const QSqlQuery& query, const ColumnIndex& columns);
     static Commande* fromQuery(const QSqlQuery& query);
+    static QList<Commande*> fromResultSet(QSqlQuery& query);
     
 private:
     int m_id;
@@ -190,6 +278,7 @@ private:
     double m_volumeTotal;
     double m_prixTotal;
     QString m_commentaires;
+    bool m_archivee;
 };
 
 #endif // COMMANDE_H
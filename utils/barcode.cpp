@@ -0,0 +1,217 @@
+#include "barcode.h"
+#include <QPainter>
+#include <QCache>
+#include <QMutex>
+#include <QMutexLocker>
+#include <cstring>
+
+namespace {
+
+// Largeurs barre/espace des symboles 0 à 105, puis STOP (barre finale incluse)
+const char* const PATTERNS[] = {
+    "212222", "222122", "222221", "121223", "121322", "131222", "122213", "122312", "132212", "221213",
+    "221312", "231212", "112232", "122132", "122231", "113222", "123122", "123221", "223211", "221132",
+    "221231", "213212", "223112", "312131", "311222", "321122", "321221", "312212", "322112", "322211",
+    "212123", "212321", "232121", "111323", "131123", "131321", "112313", "132113", "132311", "211313",
+    "231113", "231311", "112133", "112331", "132131", "113123", "113321", "133121", "313121", "211331",
+    "231131", "213113", "213311", "213131", "311123", "311321", "331121", "312113", "312311", "332111",
+    "314111", "221411", "431111", "111224", "111422", "121124", "121421", "141122", "141221", "112214",
+    "112412", "122114", "122411", "142112", "142211", "241211", "221114", "413111", "241112", "134111",
+    "111242", "121142", "121241", "114212", "124112", "124211", "411212", "421112", "421211", "212141",
+    "214121", "412121", "111143", "111341", "131141", "114113", "114311", "411113", "411311", "113141",
+    "114131", "311141", "411131", "211412", "211214", "211232", "2331112"
+};
+
+const int CODE_C = 99;
+const int CODE_B = 100;
+const int START_B = 104;
+const int START_C = 105;
+const int STOP = 106;
+
+const int DEFAULT_CACHE_SIZE = 2048;
+
+struct Caches {
+    QMutex mutex;
+    QCache<QString, QVector<quint8>> patterns{DEFAULT_CACHE_SIZE};
+    QCache<QString, QImage> images{DEFAULT_CACHE_SIZE};
+};
+
+Caches& caches()
+{
+    static Caches instance;
+    return instance;
+}
+
+int digitRun(const QByteArray& bytes, int from)
+{
+    int end = from;
+    while (end < bytes.size() && bytes.at(end) >= '0' && bytes.at(end) <= '9') {
+        ++end;
+    }
+    return end - from;
+}
+
+QVector<quint8> encode(const QString& data)
+{
+    QByteArray bytes;
+    bytes.reserve(data.size());
+    for (const QChar c : data) {
+        const ushort code = c.unicode();
+        bytes.append(code >= 32 && code <= 126 ? static_cast<char>(code) : '?');
+    }
+
+    // Jeu C (paires de chiffres) dès qu'une suite d'au moins 4 chiffres le rend rentable
+    QVector<int> values;
+    values.reserve(bytes.size() + 4);
+    bool setC = digitRun(bytes, 0) >= 4 || (bytes.size() == 2 && digitRun(bytes, 0) == 2);
+    values.append(setC ? START_C : START_B);
+
+    int i = 0;
+    while (i < bytes.size()) {
+        const int run = digitRun(bytes, i);
+        if (setC) {
+            if (run >= 2) {
+                values.append((bytes.at(i) - '0') * 10 + (bytes.at(i + 1) - '0'));
+                i += 2;
+                continue;
+            }
+            values.append(CODE_B);
+            setC = false;
+        } else if (run >= 4 && run % 2 == 0) {
+            values.append(CODE_C);
+            setC = true;
+            continue;
+        }
+        // Jeu B ; une suite impaire laisse son premier chiffre en B
+        values.append(bytes.at(i) - 32);
+        ++i;
+    }
+
+    int checksum = values.first();
+    for (int k = 1; k < values.size(); ++k) {
+        checksum += k * values.at(k);
+    }
+    values.append(checksum % 103);
+    values.append(STOP);
+
+    QVector<quint8> widths;
+    widths.reserve(values.size() * 6 + 1);
+    for (int value : values) {
+        for (const char* width = PATTERNS[value]; *width; ++width) {
+            widths.append(static_cast<quint8>(*width - '0'));
+        }
+    }
+    return widths;
+}
+
+} // namespace
+
+QVector<quint8> Barcode::code128(const QString& data)
+{
+    Caches& cache = caches();
+    {
+        QMutexLocker locker(&cache.mutex);
+        if (const QVector<quint8>* pattern = cache.patterns.object(data)) {
+            return *pattern;
+        }
+    }
+
+    // Encodage hors verrou : deux threads peuvent encoder le même code, sans conséquence
+    const QVector<quint8> pattern = encode(data);
+    QMutexLocker locker(&cache.mutex);
+    cache.patterns.insert(data, new QVector<quint8>(pattern));
+    return pattern;
+}
+
+int Barcode::moduleCount(const QString& data)
+{
+    int modules = 2 * QUIET_ZONE;
+    for (quint8 width : code128(data)) {
+        modules += width;
+    }
+    return modules;
+}
+
+void Barcode::drawCode128(QPainter& painter, const QRectF& rect, const QString& data)
+{
+    const QVector<quint8> pattern = code128(data);
+    int modules = 2 * QUIET_ZONE;
+    for (quint8 width : pattern) {
+        modules += width;
+    }
+
+    const double module = rect.width() / modules;
+    double x = rect.left() + QUIET_ZONE * module;
+    for (int i = 0; i < pattern.size(); ++i) {
+        const double width = pattern.at(i) * module;
+        if (i % 2 == 0) {
+            painter.fillRect(QRectF(x, rect.top(), width, rect.height()), Qt::black);
+        }
+        x += width;
+    }
+}
+
+QImage Barcode::code128Image(const QString& data, int moduleWidth, int height)
+{
+    moduleWidth = qMax(1, moduleWidth);
+    height = qMax(1, height);
+    const QString key = QString("%1/%2x%3").arg(data).arg(moduleWidth).arg(height);
+
+    Caches& cache = caches();
+    {
+        QMutexLocker locker(&cache.mutex);
+        if (const QImage* image = cache.images.object(key)) {
+            return *image;
+        }
+    }
+
+    const QVector<quint8> pattern = code128(data);
+    const int width = moduleCount(data) * moduleWidth;
+    QImage image(width, height, QImage::Format_Grayscale8);
+
+    // Une ligne est construite puis recopiée : aucun QPainter nécessaire
+    uchar* first = image.scanLine(0);
+    std::memset(first, 255, width);
+    int x = QUIET_ZONE * moduleWidth;
+    for (int i = 0; i < pattern.size(); ++i) {
+        const int span = pattern.at(i) * moduleWidth;
+        if (i % 2 == 0) {
+            std::memset(first + x, 0, span);
+        }
+        x += span;
+    }
+    for (int y = 1; y < height; ++y) {
+        std::memcpy(image.scanLine(y), first, width);
+    }
+
+    QMutexLocker locker(&cache.mutex);
+    cache.images.insert(key, new QImage(image));
+    return image;
+}
+
+QString Barcode::code128Text(const QString& data)
+{
+    const QVector<quint8> pattern = code128(data);
+    QString text(QUIET_ZONE, ' ');
+    for (int i = 0; i < pattern.size(); ++i) {
+        text += QString(pattern.at(i), i % 2 == 0 ? QChar(0x2588) : QChar(' '));
+    }
+    text += QString(QUIET_ZONE, ' ');
+    return text;
+}
+
+void Barcode::setCacheSize(int codes)
+{
+    Caches& cache = caches();
+    QMutexLocker locker(&cache.mutex);
+    cache.patterns.setMaxCost(qMax(1, codes));
+    cache.images.setMaxCost(qMax(1, codes));
+}
+
+void Barcode::clearCache()
+{
+    Caches& cache = caches();
+    QMutexLocker locker(&cache.mutex);
+    cache.patterns.clear();
+    cache.images.clear();
+}
@@ -0,0 +1,69 @@
+#ifndef BARCODE_H
+#define BARCODE_H
+
+#include <QString>
+#include <QVector>
+#include <QImage>
+#include <QRectF>
+
+class QPainter;
+
+/**
+ * @brief Codes-barres Code 128 des numéros de commande
+ *
+ * Encodage natif (jeux B et C, bascule en C sur les suites de chiffres,
+ * somme de contrôle modulo 103). Le motif encodé est une suite de largeurs
+ * alternant barres et espaces, en modules ; il peut être dessiné en
+ * vectoriel (PDF, aperçu), converti en petite image (documents HTML) ou en
+ * texte (aperçus texte).
+ *
+ * Les motifs et les images sont conservés dans des caches LRU indexés par
+ * numéro de commande : réimpressions et traitements en lot ne réencodent
+ * pas. Les caches sont protégés par un verrou, toutes les méthodes sont
+ * utilisables depuis les threads de rendu.
+ */
+class Barcode
+{
+public:
+    /**
+     * @brief Zone blanche à gauche et à droite du code, en modules
+     */
+    static const int QUIET_ZONE = 10;
+
+    /**
+     * @brief Motif Code 128 (largeurs en modules, barre en premier)
+     * @param data Texte ASCII imprimable ; les autres caractères deviennent '?'
+     */
+    static QVector<quint8> code128(const QString& data);
+
+    /**
+     * @brief Largeur totale du code, zones blanches comprises, en modules
+     */
+    static int moduleCount(const QString& data);
+
+    /**
+     * @brief Dessine le code en vectoriel dans un rectangle (zones blanches comprises)
+     */
+    static void drawCode128(QPainter& painter, const QRectF& rect, const QString& data);
+
+    /**
+     * @brief Image du code (niveaux de gris), mise en cache
+     * @param moduleWidth Largeur d'un module en pixels
+     * @param height Hauteur des barres en pixels
+     */
+    static QImage code128Image(const QString& data, int moduleWidth = 2, int height = 60);
+
+    /**
+     * @brief Représentation texte du code, un caractère par module
+     */
+    static QString code128Text(const QString& data);
+
+    /**
+     * @brief Taille maximale des caches, en nombre de codes
+     */
+    static void setCacheSize(int codes);
+
+    static void clearCache();
+};
+
+#endif // BARCODE_H
@@ -0,0 +1,533 @@
+#include "batchdocumentjob.h"
+#include "barcode.h"
+#include "database/databasemanager.h"
+#include "models/commande.h"
+#include "database/queryprofiler.h"
+#include <QSqlQuery>
+#include <QPdfWriter>
+#include <QPainter>
+#include <QPicture>
+#include <QPageLayout>
+#include <QThread>
+#include <QThreadPool>
+#include <QAtomicInt>
+#include <QElapsedTimer>
+#include <QDateTime>
+#include <QHash>
+#include <QSet>
+#include <QDir>
+#include <QDebug>
+#include <vector>
+
+namespace {
+
+// Dimensions en points (1/72 pouce)
+const double LINE_HEIGHT = 14.0;
+const double LOGO_HEIGHT = 40.0;
+const QColor HEADER_BACKGROUND(52, 73, 94);
+const QColor GRID_COLOR(222, 226, 230);
+
+QString option(const QStringList& arguments, const QString& name)
+{
+    const int index = arguments.indexOf(name);
+    return index >= 0 && index + 1 < arguments.size() ? arguments.at(index + 1) : QString();
+}
+
+QString statutLabel(const QString& statut)
+{
+    if (statut == "EN_ATTENTE") return "En attente";
+    if (statut == "CONFIRMEE") return "Confirmée";
+    if (statut == "EN_PREPARATION") return "En préparation";
+    if (statut == "EN_TRANSIT") return "En transit";
+    if (statut == "LIVREE") return "Livrée";
+    if (statut == "ANNULEE") return "Annulée";
+    return statut;
+}
+
+QString prioriteLabel(const QString& priorite)
+{
+    if (priorite == "BASSE") return "Basse";
+    if (priorite == "NORMALE") return "Normale";
+    if (priorite == "HAUTE") return "Haute";
+    if (priorite == "URGENTE") return "Urgente";
+    return priorite;
+}
+
+QString amount(double value)
+{
+    return QString::number(value, 'f', 3) + " TND";
+}
+
+} // namespace
+
+BatchDocumentJob::Config BatchDocumentJob::configFromArguments(const QStringList& arguments)
+{
+    Config config;
+    config.kind = option(arguments, "--batch-pdf") == "facture" ? FACTURE : ETIQUETTE_LIVRAISON;
+
+    const QString output = option(arguments, "--batch-output");
+    if (!output.isEmpty()) {
+        config.outputDirectory = output;
+    }
+    config.singleFile = option(arguments, "--batch-single");
+    config.logoPath = option(arguments, "--batch-logo");
+
+    bool ok = false;
+    const int threads = option(arguments, "--batch-threads").toInt(&ok);
+    if (ok) {
+        config.threads = qMax(0, threads);
+    }
+    return config;
+}
+
+QList<int> BatchDocumentJob::idsFromArguments(const QStringList& arguments)
+{
+    const QString ids = option(arguments, "--batch-ids");
+    if (!ids.isEmpty()) {
+        QList<int> result;
+        for (const QString& id : ids.split(',', Qt::SkipEmptyParts)) {
+            bool ok = false;
+            const int value = id.trimmed().toInt(&ok);
+            if (ok) {
+                result.append(value);
+            }
+        }
+        return result;
+    }
+
+    // Par défaut : départs du jour
+    const QDate date = QDate::fromString(option(arguments, "--batch-date"), Qt::ISODate);
+    return idsForDelivery(date.isValid() ? date : QDate::currentDate());
+}
+
+QList<int> BatchDocumentJob::idsForDelivery(const QDate& date)
+{
+    DatabaseManager& db = DatabaseManager::instance();
+    QList<int> ids;
+
+    QSqlQuery query = db.prepareQuery(R"(
+        SELECT ID_COMMANDE FROM COMMANDES
+        WHERE STATUT IN ('EN_ATTENTE', 'CONFIRMEE', 'EN_PREPARATION', 'EN_TRANSIT')
+          AND DATE_LIVRAISON_PREVUE >= ? AND DATE_LIVRAISON_PREVUE < ?
+        ORDER BY ID_COMMANDE
+    )");
+
+    if (!db.executeQuery(query, {date, date.addDays(1)})) {
+        qWarning() << "Documents en lot: sélection des départs impossible:" << db.lastError();
+        return ids;
+    }
+    while (query.next()) {
+        ids.append(query.value(0).toInt());
+    }
+    QueryProfiler::instance().addRows(query.lastQuery(), ids.size());
+    return ids;
+}
+
+BatchDocumentJob::BatchDocumentJob(const Config& config, QObject *parent)
+    : QObject(parent)
+    , m_config(config)
+{
+}
+
+bool BatchDocumentJob::run(const QList<int>& idsCommande)
+{
+    m_report = Report();
+
+    // Un seul document par commande, dans l'ordre de première occurrence
+    QList<int> ids;
+    ids.reserve(idsCommande.size());
+    QSet<int> seen;
+    for (int id : idsCommande) {
+        if (!seen.contains(id)) {
+            seen.insert(id);
+            ids.append(id);
+        }
+    }
+    m_report.requested = ids.size();
+
+    // 1. Lecture : toute la base est lue ici, les tâches ne font que dessiner
+    QElapsedTimer step;
+    step.start();
+    QList<DocumentData> documents;
+    if (!loadDocuments(ids, documents)) {
+        qWarning() << "Documents en lot: lecture impossible:" << m_report.errors;
+        return false;
+    }
+    m_report.loadMs = step.elapsed();
+
+    prepareResources();
+
+    // 2. Rendu parallèle
+    step.restart();
+    const int total = documents.size();
+    const bool singleFile = !m_config.singleFile.isEmpty();
+    if (!singleFile && !QDir().mkpath(m_config.outputDirectory)) {
+        m_report.errors << "Dossier de sortie inaccessible: " + m_config.outputDirectory;
+        return false;
+    }
+
+    std::vector<char> succeeded(total, 0);
+    std::vector<QPicture> pictures(singleFile ? total : 0);
+    QAtomicInt done(0);
+
+    // Géométrie identique pour toutes les pages d'un même lot
+    const QSizeF page = pageLayout().paintRect(QPageLayout::Point).size();
+
+    {
+        const int threads = m_config.threads > 0 ? m_config.threads : QThread::idealThreadCount();
+        QThreadPool pool;
+        pool.setMaxThreadCount(qMax(1, threads));
+
+        const DocumentData* input = documents.constData();
+        char* result = succeeded.data();
+        QPicture* recorded = pictures.data();
+
+        for (int i = 0; i < total; ++i) {
+            pool.start([this, input, result, recorded, singleFile, page, i, &done]() {
+                const DocumentData& document = input[i];
+                QPainter painter;
+
+                if (singleFile) {
+                    // Enregistrement vectoriel, rejoué ensuite dans le PDF unique
+                    if (painter.begin(&recorded[i])) {
+                        paintDocument(painter, page, document);
+                        result[i] = painter.end();
+                    }
+                } else {
+                    // Un QPdfWriter par tâche : aucun état partagé pendant l'écriture
+                    QPdfWriter writer(QDir(m_config.outputDirectory).filePath(fileNameFor(document)));
+                    setupWriter(writer);
+                    if (painter.begin(&writer)) {
+                        painter.scale(writer.logicalDpiX() / 72.0, writer.logicalDpiY() / 72.0);
+                        paintDocument(painter, page, document);
+                        result[i] = painter.end();
+                    }
+                }
+                done.fetchAndAddRelaxed(1);
+            });
+        }
+
+        while (!pool.waitForDone(100)) {
+            emit progress(done.loadRelaxed(), total);
+        }
+        emit progress(total, total);
+    }
+
+    // 3. PDF unique : assemblage séquentiel des pages enregistrées
+    if (singleFile) {
+        QPdfWriter writer(m_config.singleFile);
+        setupWriter(writer);
+        QPainter painter;
+        if (!painter.begin(&writer)) {
+            m_report.errors << "Impossible d'écrire " + m_config.singleFile;
+            return false;
+        }
+        painter.scale(writer.logicalDpiX() / 72.0, writer.logicalDpiY() / 72.0);
+
+        bool firstPage = true;
+        for (int i = 0; i < total; ++i) {
+            if (!succeeded[i]) {
+                continue;
+            }
+            if (!firstPage) {
+                writer.newPage();
+            }
+            painter.drawPicture(0, 0, pictures[i]);
+            firstPage = false;
+        }
+        painter.end();
+        m_report.files << m_config.singleFile;
+    }
+    m_report.renderMs = step.elapsed();
+
+    for (int i = 0; i < total; ++i) {
+        if (succeeded[i]) {
+            ++m_report.documents;
+            if (!singleFile) {
+                m_report.files << QDir(m_config.outputDirectory).filePath(fileNameFor(documents.at(i)));
+            }
+        } else {
+            ++m_report.failed;
+            m_report.errors << "Rendu impossible: " + documents.at(i).numeroCommande;
+        }
+    }
+    m_report.failed += m_report.requested - total;
+    m_report.pages = m_report.documents;     // Une page par document
+    m_report.pagesPerSecond = m_report.renderMs > 0 ? m_report.pages * 1000.0 / m_report.renderMs : 0.0;
+
+    qInfo().noquote() << QString("Documents en lot (%1): %2 demandés, %3 produits, %4 en échec")
+                             .arg(m_config.kind == FACTURE ? "factures" : "étiquettes")
+                             .arg(m_report.requested).arg(m_report.documents).arg(m_report.failed);
+    qInfo().noquote() << QString("Lecture %1 ms, rendu %2 ms (%3 pages/s)")
+                             .arg(m_report.loadMs).arg(m_report.renderMs)
+                             .arg(m_report.pagesPerSecond, 0, 'f', 1);
+
+    return m_report.failed == 0;
+}
+
+bool BatchDocumentJob::loadDocuments(const QList<int>& idsCommande, QList<DocumentData>& documents)
+{
+    QHash<int, DocumentData> loaded;
+    loaded.reserve(idsCommande.size());
+
+    const bool success = Commande::forEachWithClient(idsCommande, R"(
+            c.ID_COMMANDE, c.NUMERO_COMMANDE, c.DATE_COMMANDE, c.DATE_LIVRAISON_PREVUE,
+            c.ADRESSE_LIVRAISON, c.CODE_POSTAL_LIVRAISON, c.VILLE_LIVRAISON, c.STATUT, c.PRIORITE,
+            c.POIDS_TOTAL, c.VOLUME_TOTAL, c.PRIX_TOTAL,
+            cl.PRENOM, cl.NOM, cl.ADRESSE, cl.CODE_POSTAL, cl.VILLE, cl.TELEPHONE, cl.EMAIL
+        )", [&loaded](const QSqlQuery& query) {
+        const int id = query.value(0).toInt();
+        loaded.insert(id, {id,
+                           query.value(1).toString(),
+                           query.value(2).toDate(),
+                           query.value(3).toDate(),
+                           query.value(4).toString(),
+                           query.value(5).toString(),
+                           query.value(6).toString(),
+                           query.value(7).toString(),
+                           query.value(8).toString(),
+                           query.value(9).toDouble(),
+                           query.value(10).toDouble(),
+                           query.value(11).toDouble(),
+                           query.value(12).toString(),
+                           query.value(13).toString(),
+                           query.value(14).toString(),
+                           query.value(15).toString(),
+                           query.value(16).toString(),
+                           query.value(17).toString(),
+                           query.value(18).toString()});
+    });
+
+    if (!success) {
+        m_report.errors << DatabaseManager::instance().lastError();
+        return false;
+    }
+
+    // Ordre de la demande conservé (ordre des pages du PDF unique)
+    documents.reserve(loaded.size());
+    for (int id : idsCommande) {
+        const auto it = loaded.constFind(id);
+        if (it == loaded.constEnd()) {
+            m_report.errors << QString("Commande introuvable: %1").arg(id);
+            continue;
+        }
+        documents.append(it.value());
+    }
+    return true;
+}
+
+void BatchDocumentJob::prepareResources()
+{
+    // Tailles en pixels du repère mis à l'échelle, soit en points
+    m_resources.title = QFont("Arial");
+    m_resources.title.setPixelSize(18);
+    m_resources.title.setBold(true);
+    m_resources.heading = QFont("Arial");
+    m_resources.heading.setPixelSize(11);
+    m_resources.heading.setBold(true);
+    m_resources.text = QFont("Arial");
+    m_resources.text.setPixelSize(9);
+    m_resources.small = QFont("Arial");
+    m_resources.small.setPixelSize(7);
+    m_resources.large = QFont("Arial");
+    m_resources.large.setPixelSize(14);
+    m_resources.large.setBold(true);
+
+    // Logo chargé et mis à la taille d'impression une seule fois (QImage : utilisable hors thread GUI)
+    m_resources.logo = QImage();
+    if (!m_config.logoPath.isEmpty()) {
+        QImage logo(m_config.logoPath);
+        if (logo.isNull()) {
+            qWarning() << "Documents en lot: logo illisible:" << m_config.logoPath;
+        } else {
+            const int height = qRound(LOGO_HEIGHT * m_config.resolution / 72.0);
+            m_resources.logo = logo.scaledToHeight(height, Qt::SmoothTransformation);
+        }
+    }
+}
+
+QPageLayout BatchDocumentJob::pageLayout() const
+{
+    if (m_config.kind == FACTURE) {
+        return QPageLayout(QPageSize(QPageSize::A4), QPageLayout::Portrait,
+                           QMarginsF(15, 15, 15, 15), QPageLayout::Millimeter);
+    }
+    // Format étiquette 100 x 150 mm
+    return QPageLayout(QPageSize(QSizeF(100, 150), QPageSize::Millimeter, "Etiquette"),
+                       QPageLayout::Portrait, QMarginsF(4, 4, 4, 4), QPageLayout::Millimeter);
+}
+
+void BatchDocumentJob::setupWriter(QPdfWriter& writer) const
+{
+    writer.setResolution(m_config.resolution);
+    writer.setCreator("LogisticsApp");
+    writer.setPageLayout(pageLayout());
+}
+
+QString BatchDocumentJob::fileNameFor(const DocumentData& document) const
+{
+    return QString("%1-%2.pdf").arg(m_config.kind == FACTURE ? "facture" : "etiquette",
+                                    document.numeroCommande);
+}
+
+void BatchDocumentJob::paintDocument(QPainter& painter, const QSizeF& page, const DocumentData& document) const
+{
+    if (m_config.kind == FACTURE) {
+        paintFacture(painter, page, document);
+    } else {
+        paintEtiquette(painter, page, document);
+    }
+}
+
+void BatchDocumentJob::paintFacture(QPainter& painter, const QSizeF& page, const DocumentData& document) const
+{
+    const double width = page.width();
+    double y = 0.0;
+
+    // En-tête de l'entreprise
+    double textX = 0.0;
+    if (!m_resources.logo.isNull()) {
+        const double logoWidth = LOGO_HEIGHT * m_resources.logo.width() / m_resources.logo.height();
+        painter.drawImage(QRectF(0, 0, logoWidth, LOGO_HEIGHT), m_resources.logo);
+        textX = logoWidth + 10;
+    }
+    painter.setPen(Qt::black);
+    painter.setFont(m_resources.heading);
+    painter.drawText(QRectF(textX, y, width - textX, 14), Qt::AlignLeft | Qt::AlignVCenter, m_config.companyName);
+    painter.setFont(m_resources.text);
+    painter.setPen(Qt::darkGray);
+    painter.drawText(QRectF(textX, y + 14, width - textX, 12), Qt::AlignLeft | Qt::AlignVCenter,
+                     m_config.companyAddress);
+    painter.drawText(QRectF(textX, y + 26, width - textX, 12), Qt::AlignLeft | Qt::AlignVCenter,
+                     QString("Tél: %1 | Email: %2").arg(m_config.companyPhone, m_config.companyEmail));
+    y += qMax(LOGO_HEIGHT, 38.0) + 20;
+
+    // Titre
+    painter.setPen(Qt::black);
+    painter.setFont(m_resources.title);
+    painter.drawText(QRectF(0, y, width, 24), Qt::AlignCenter, "FACTURE");
+    y += 24;
+    painter.setFont(m_resources.text);
+    painter.drawText(QRectF(0, y, width, LINE_HEIGHT), Qt::AlignCenter, "N° FAC-" + document.numeroCommande);
+    y += LINE_HEIGHT + 4;
+    const double barcodeWidth = Barcode::moduleCount(document.numeroCommande) * 1.0;
+    Barcode::drawCode128(painter, QRectF((width - barcodeWidth) / 2, y, barcodeWidth, 30), document.numeroCommande);
+    y += 30 + 12;
+
+    // Client facturé
+    painter.setFont(m_resources.heading);
+    painter.drawText(QRectF(0, y, width, LINE_HEIGHT), Qt::AlignLeft | Qt::AlignVCenter, "Facturation");
+    y += LINE_HEIGHT + 2;
+    painter.setFont(m_resources.text);
+    const QStringList client = {document.prenom + " " + document.nom,
+                                document.adresse,
+                                document.codePostal + " " + document.ville,
+                                "Tél: " + document.telephone,
+                                "Email: " + document.email};
+    for (const QString& line : client) {
+        painter.drawText(QRectF(0, y, width, LINE_HEIGHT), Qt::AlignLeft | Qt::AlignVCenter, line);
+        y += LINE_HEIGHT;
+    }
+    y += 12;
+
+    // Détails de la commande
+    painter.setFont(m_resources.heading);
+    painter.drawText(QRectF(0, y, width, LINE_HEIGHT), Qt::AlignLeft | Qt::AlignVCenter, "Détails de la Commande");
+    y += LINE_HEIGHT + 4;
+
+    const QList<QPair<QString, QString>> details = {
+        {"Date de commande", document.dateCommande.toString("dd/MM/yyyy")},
+        {"Date de livraison prévue", document.dateLivraisonPrevue.toString("dd/MM/yyyy")},
+        {"Adresse de livraison", QString("%1, %2 %3").arg(document.adresseLivraison,
+                                                          document.codePostalLivraison,
+                                                          document.villeLivraison)},
+        {"Priorité", prioriteLabel(document.priorite)},
+        {"Statut", statutLabel(document.statut)},
+        {"Poids total", QString::number(document.poidsTotal, 'f', 2) + " kg"},
+        {"Volume total", QString::number(document.volumeTotal, 'f', 2) + " m³"}};
+
+    const double labelWidth = width * 0.35;
+    painter.setFont(m_resources.text);
+    for (const auto& detail : details) {
+        painter.setPen(GRID_COLOR);
+        painter.drawLine(QPointF(0, y + LINE_HEIGHT + 2), QPointF(width, y + LINE_HEIGHT + 2));
+        painter.setPen(Qt::black);
+        painter.drawText(QRectF(4, y, labelWidth - 4, LINE_HEIGHT + 2), Qt::AlignLeft | Qt::AlignVCenter,
+                         detail.first);
+        painter.drawText(QRectF(labelWidth, y, width - labelWidth, LINE_HEIGHT + 2),
+                         Qt::AlignLeft | Qt::AlignVCenter, detail.second);
+        y += LINE_HEIGHT + 2;
+    }
+    y += 20;
+
+    // Totaux : le prix de la commande est TTC
+    const double sousTotal = document.prixTotal / 1.19;
+    const double tva = document.prixTotal - sousTotal;
+    const double totalsX = width * 0.55;
+    const QList<QPair<QString, QString>> totals = {{"Sous-total:", amount(sousTotal)},
+                                                   {"TVA (19%):", amount(tva)},
+                                                   {"TOTAL TTC:", amount(document.prixTotal)}};
+    for (int i = 0; i < totals.size(); ++i) {
+        const bool last = i == totals.size() - 1;
+        const QRectF row(totalsX, y, width - totalsX, LINE_HEIGHT + 4);
+        if (last) {
+            painter.fillRect(row, HEADER_BACKGROUND);
+            painter.setPen(Qt::white);
+        }
+        painter.setFont(m_resources.heading);
+        painter.drawText(row.adjusted(6, 0, -6, 0), Qt::AlignLeft | Qt::AlignVCenter, totals.at(i).first);
+        painter.drawText(row.adjusted(6, 0, -6, 0), Qt::AlignRight | Qt::AlignVCenter, totals.at(i).second);
+        painter.setPen(Qt::black);
+        y += LINE_HEIGHT + 4;
+    }
+
+    // Pied de page
+    painter.setFont(m_resources.small);
+    painter.setPen(Qt::darkGray);
+    painter.drawText(QRectF(0, page.height() - 24, width, 12), Qt::AlignCenter,
+                     "Document généré le " + QDateTime::currentDateTime().toString("dd/MM/yyyy hh:mm"));
+    painter.drawText(QRectF(0, page.height() - 12, width, 12), Qt::AlignCenter,
+                     "Conditions de paiement: 30 jours");
+}
+
+void BatchDocumentJob::paintEtiquette(QPainter& painter, const QSizeF& page, const DocumentData& document) const
+{
+    const double width = page.width();
+    const double padding = 8.0;
+    const double innerWidth = width - 2 * padding;
+
+    painter.setPen(QPen(Qt::black, 2));
+    painter.drawRect(QRectF(1, 1, width - 2, page.height() - 2));
+
+    double y = padding;
+    painter.setFont(m_resources.large);
+    painter.drawText(QRectF(padding, y, innerWidth, 20), Qt::AlignCenter, "ÉTIQUETTE DE LIVRAISON");
+    y += 28;
+
+    auto section = [&](const QString& label, const QStringList& lines) {
+        painter.setFont(m_resources.heading);
+        painter.drawText(QRectF(padding, y, innerWidth, LINE_HEIGHT), Qt::AlignLeft | Qt::AlignVCenter, label);
+        y += LINE_HEIGHT;
+        painter.setFont(m_resources.text);
+        for (const QString& line : lines) {
+            painter.drawText(QRectF(padding, y, innerWidth, LINE_HEIGHT), Qt::AlignLeft | Qt::AlignVCenter, line);
+            y += LINE_HEIGHT;
+        }
+        y += 8;
+    };
+
+    section("Commande N°:", {document.numeroCommande});
+    section("Destinataire:", {document.prenom + " " + document.nom,
+                              document.adresseLivraison,
+                              document.codePostalLivraison + " " + document.villeLivraison,
+                              "Tél: " + document.telephone});
+    section("Expéditeur:", {m_config.companyName, m_config.companyAddress});
+    section("Date de livraison prévue:", {document.dateLivraisonPrevue.toString("dd/MM/yyyy")});
+
+    // Code 128 en vectoriel, rendu net quelle que soit la résolution
+    const double barcodeHeight = qMin(70.0, page.height() - y - LINE_HEIGHT - padding);
+    Barcode::drawCode128(painter, QRectF(padding, y, innerWidth, barcodeHeight), document.numeroCommande);
+    y += barcodeHeight + 2;
+    painter.setFont(m_resources.text);
+    painter.drawText(QRectF(padding, y, innerWidth, LINE_HEIGHT), Qt::AlignCenter, document.numeroCommande);
+}
@@ -0,0 +1,150 @@
+#ifndef BATCHDOCUMENTJOB_H
+#define BATCHDOCUMENTJOB_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QDate>
+#include <QFont>
+#include <QImage>
+#include <QPageLayout>
+
+class QPainter;
+class QPdfWriter;
+
+/**
+ * @brief Génération en lot de factures ou d'étiquettes de livraison en PDF
+ *
+ * Les données de toutes les commandes, archivées comprises, sont lues par
+ * Commande::forEachWithClient() (thread appelant, seul à utiliser la base),
+ * puis les documents sont dessinés au QPainter sur un pool de threads, sans
+ * aucune boîte de dialogue. Deux sorties :
+ * - un PDF par commande : chaque tâche possède son propre QPdfWriter ;
+ * - un PDF unique : chaque document est enregistré en parallèle dans un
+ *   QPicture (vectoriel), puis les pages sont rejouées dans l'ordre sur un
+ *   seul QPdfWriter.
+ * Polices et logo sont préparés une fois et partagés (lecture seule) par
+ * toutes les tâches.
+ *
+ * Exécuté par `LogisticsApp --batch-pdf facture|etiquette` avec
+ * --batch-ids 1,2,3 ou --batch-date aaaa-mm-jj, --batch-output <dossier>,
+ * --batch-single <fichier.pdf>, --batch-threads <n>, --batch-logo <image>.
+ */
+class BatchDocumentJob : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum DocumentKind {
+        FACTURE,
+        ETIQUETTE_LIVRAISON
+    };
+
+    struct Config {
+        DocumentKind kind = ETIQUETTE_LIVRAISON;
+        QString outputDirectory = ".";
+        QString singleFile;             // Non vide : un seul PDF multipage
+        int threads = 0;                // 0 : QThread::idealThreadCount()
+        int resolution = 300;
+        QString logoPath;
+        QString companyName = "Société Logistique Tunisienne";
+        QString companyAddress = "123 Avenue Habib Bourguiba, 1000 Tunis, Tunisie";
+        QString companyPhone = "+216 71 123 456";
+        QString companyEmail = "contact@logistics.tn";
+    };
+
+    struct Report {
+        int requested = 0;
+        int documents = 0;
+        int pages = 0;
+        int failed = 0;
+        qint64 loadMs = 0;
+        qint64 renderMs = 0;
+        double pagesPerSecond = 0.0;
+        QStringList files;
+        QStringList errors;
+    };
+
+    /**
+     * @brief Construit la configuration à partir de la ligne de commande
+     */
+    static Config configFromArguments(const QStringList& arguments);
+
+    /**
+     * @brief Identifiants passés par --batch-ids ou sélectionnés par --batch-date
+     */
+    static QList<int> idsFromArguments(const QStringList& arguments);
+
+    /**
+     * @brief Commandes actives dont la livraison est prévue à une date (départs du jour)
+     */
+    static QList<int> idsForDelivery(const QDate& date);
+
+    explicit BatchDocumentJob(const Config& config, QObject *parent = nullptr);
+
+    /**
+     * @brief Génère les documents (bloquant ; progress() est émis pendant l'attente)
+     * @param idsCommande Commandes à traiter (doublons ignorés)
+     * @return true si tous les documents ont été produits
+     */
+    bool run(const QList<int>& idsCommande);
+
+    Report report() const { return m_report; }
+
+signals:
+    void progress(int done, int total);
+
+private:
+    struct DocumentData {
+        int idCommande;
+        QString numeroCommande;
+        QDate dateCommande;
+        QDate dateLivraisonPrevue;
+        QString adresseLivraison;
+        QString codePostalLivraison;
+        QString villeLivraison;
+        QString statut;
+        QString priorite;
+        double poidsTotal;
+        double volumeTotal;
+        double prixTotal;
+        QString prenom;
+        QString nom;
+        QString adresse;
+        QString codePostal;
+        QString ville;
+        QString telephone;
+        QString email;
+    };
+
+    /**
+     * @brief Ressources partagées, préparées avant le lancement des tâches
+     */
+    struct Resources {
+        QFont title;
+        QFont heading;
+        QFont text;
+        QFont small;
+        QFont large;
+        QImage logo;
+    };
+
+    bool loadDocuments(const QList<int>& idsCommande, QList<DocumentData>& documents);
+    void prepareResources();
+    QPageLayout pageLayout() const;
+    void setupWriter(QPdfWriter& writer) const;
+    QString fileNameFor(const DocumentData& document) const;
+
+    // Dessin d'une page dans un repère en points (zone imprimable)
+    void paintDocument(QPainter& painter, const QSizeF& page, const DocumentData& document) const;
+    void paintFacture(QPainter& painter, const QSizeF& page, const DocumentData& document) const;
+    void paintEtiquette(QPainter& painter, const QSizeF& page, const DocumentData& document) const;
+
+private:
+    Config m_config;
+    Resources m_resources;
+    Report m_report;
+};
+
+#endif // BATCHDOCUMENTJOB_H
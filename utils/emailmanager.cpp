@@ -1,19 +1,15 @@
 #include "emailmanager.h"
 #include "models/commande.h"
 #include "models/client.h"
-#include <QNetworkRequest>
-#include <QJsonDocument>
-#include <QJsonObject>
-#include <QRegularExpression>
+#include "emailoutbox.h"
+#include "texttemplate.h"
+#include "validator.h"
 #include <QDebug>
 #include <QDateTime>
 #include <QCoreApplication>
 
 EmailManager::EmailManager(QObject *parent)
     : QObject(parent)
-    , m_smtpPort(587)
-    , m_useSSL(true)
-    , m_networkManager(new QNetworkAccessManager(this))
 {
     // Configuration par défaut
     m_fromAddress = "noreply@logistics.tn";
@@ -28,11 +24,14 @@ EmailManager::~EmailManager()
 void EmailManager::configureSmtp(const QString& server, int port, const QString& username, 
                                 const QString& password, bool useSSL)
 {
-    m_smtpServer = server;
-    m_smtpPort = port;
-    m_username = username;
-    m_password = password;
-    m_useSSL = useSSL;
+    // Paramètres partagés par toutes les instances : la session est ouverte par la file
+    SmtpClient::Settings settings = EmailOutbox::instance().smtpSettings();
+    settings.host = server;
+    settings.port = port;
+    settings.username = username;
+    settings.password = password;
+    settings.useSsl = useSSL;
+    EmailOutbox::instance().setSmtpSettings(settings);
 }
 
 bool EmailManager::sendCommandeConfirmation(const Commande* commande, const Client* client)
@@ -45,7 +44,8 @@ bool EmailManager::sendCommandeConfirmation(const Commande* commande, const Clie
     QString subject = QString("Confirmation de commande #%1").arg(commande->numeroCommande());
     QString htmlBody = generateCommandeConfirmationHtml(commande, client);
     
-    return sendEmail(client->email(), subject, "", htmlBody);
+    return sendEmail(client->email(), subject, "", htmlBody,
+                     EmailOutbox::dedupKey(commande->id(), "CONFIRMATION"));
 }
 
 bool EmailManager::sendStatusUpdate(const Commande* commande, const Client* client, const QString& ancienStatut)
@@ -57,7 +57,8 @@ bool EmailManager::sendStatusUpdate(const Commande* commande, const Client* clie
     QString subject = QString("Mise à jour commande #%1").arg(commande->numeroCommande());
     QString htmlBody = generateStatusUpdateHtml(commande, client, ancienStatut);
     
-    return sendEmail(client->email(), subject, "", htmlBody);
+    return sendEmail(client->email(), subject, "", htmlBody,
+                     EmailOutbox::dedupKey(commande->id(), "STATUT:" + commande->statutToString()));
 }
 
 bool EmailManager::sendDeliveryNotification(const Commande* commande, const Client* client)
@@ -69,7 +70,8 @@ bool EmailManager::sendDeliveryNotification(const Commande* commande, const Clie
     QString subject = QString("Commande #%1 livrée").arg(commande->numeroCommande());
     QString htmlBody = generateDeliveryNotificationHtml(commande, client);
     
-    return sendEmail(client->email(), subject, "", htmlBody);
+    return sendEmail(client->email(), subject, "", htmlBody,
+                     EmailOutbox::dedupKey(commande->id(), "LIVREE"));
 }
 
 bool EmailManager::sendCancellationNotification(const Commande* commande, const Client* client, const QString& raison)
@@ -81,7 +83,8 @@ bool EmailManager::sendCancellationNotification(const Commande* commande, const
     QString subject = QString("Annulation commande #%1").arg(commande->numeroCommande());
     QString htmlBody = generateCancellationHtml(commande, client, raison);
     
-    return sendEmail(client->email(), subject, "", htmlBody);
+    return sendEmail(client->email(), subject, "", htmlBody,
+                     EmailOutbox::dedupKey(commande->id(), "ANNULEE"));
 }
 
 bool EmailManager::sendDeliveryReminder(const Commande* commande, const Client* client)
@@ -90,43 +93,45 @@ bool EmailManager::sendDeliveryReminder(const Commande* commande, const Client*
         return false;
     }
 
-    QString subject = QString("Rappel livraison commande #%1").arg(commande->numeroCommande());
+    QString subject = reminderSubject(commande->numeroCommande());
     QString htmlBody = generateReminderHtml(commande, client);
     
-    return sendEmail(client->email(), subject, "", htmlBody);
+    return sendEmail(client->email(), subject, "", htmlBody,
+                     reminderDedupKey(commande->id(), commande->dateLivraisonPrevue()));
 }
 
-bool EmailManager::sendEmail(const QString& to, const QString& subject, const QString& body, const QString& htmlBody)
+bool EmailManager::sendEmail(const QString& to, const QString& subject, const QString& body,
+                             const QString& htmlBody, const QString& dedupKey)
 {
     if (!isValidEmail(to)) {
         qWarning() << "EmailManager: Adresse email invalide:" << to;
         return false;
     }
 
-    // Pour cette implémentation simplifiée, nous utilisons une API REST
-    // En production, vous pourriez utiliser SMTP directement ou un service comme SendGrid
-    
-    QJsonObject emailData;
-    emailData["to"] = to;
-    emailData["from"] = m_fromAddress;
-    emailData["from_name"] = m_fromName;
-    emailData["reply_to"] = m_replyToAddress;
-    emailData["subject"] = subject;
-    emailData["body"] = body.isEmpty() ? htmlBody : body;
-    emailData["html_body"] = htmlBody;
-
-    QJsonDocument doc(emailData);
-    QByteArray data = doc.toJson();
-
-    // Simulation d'envoi - en production, remplacez par votre service SMTP
-    qInfo() << "EmailManager: Simulation d'envoi email";
-    qInfo() << "To:" << to;
-    qInfo() << "Subject:" << subject;
-    qInfo() << "Body preview:" << (htmlBody.isEmpty() ? body : htmlBody).left(100) + "...";
-
-    // Émettre le signal de succès
-    emit emailSent(to, subject);
-    return true;
+    // Une insertion en base : l'envoi SMTP est fait par le thread de la file
+    OutboxEmail email;
+    email.to = to;
+    email.subject = subject;
+    email.textBody = body;
+    email.htmlBody = htmlBody;
+    email.dedupKey = dedupKey;
+    email.from = m_fromAddress;
+    email.fromName = m_fromName;
+    email.replyTo = m_replyToAddress;
+
+    switch (EmailOutbox::instance().enqueue(email)) {
+        case EmailOutbox::QUEUED:
+            emit emailQueued(to, subject);
+            return true;
+        case EmailOutbox::DUPLICATE:
+            qInfo() << "EmailManager: Notification déjà en file:" << dedupKey;
+            return true;
+        case EmailOutbox::ERREUR:
+            break;
+    }
+
+    emit emailFailed(to, subject, EmailOutbox::instance().lastError());
+    return false;
 }
 
 void EmailManager::setFromAddress(const QString& fromAddress, const QString& fromName)
@@ -144,27 +149,28 @@ void EmailManager::setReplyToAddress(const QString& replyTo)
 
 bool EmailManager::isValidEmail(const QString& email)
 {
-    QRegularExpression regex(R"([a-zA-Z0-9._%+-]+@[a-zA-Z0-9.-]+\.[a-zA-Z]{2,})");
-    return regex.match(email).hasMatch();
+    return Validator::isValidEmail(email);
 }
 
-void EmailManager::onNetworkReply()
+QString EmailManager::renderHtml(EmailType type, const Commande* commande, const Client* client, const QString& extra)
 {
-    QNetworkReply* reply = qobject_cast<QNetworkReply*>(sender());
-    if (!reply) return;
-
-    if (reply->error() == QNetworkReply::NoError) {
-        qInfo() << "Email envoyé avec succès";
-    } else {
-        qWarning() << "Erreur envoi email:" << reply->errorString();
+    if (!commande || !client) {
+        return QString();
     }
 
-    reply->deleteLater();
+    switch (type) {
+        case CONFIRMATION_COMMANDE: return generateCommandeConfirmationHtml(commande, client);
+        case MISE_A_JOUR_STATUT: return generateStatusUpdateHtml(commande, client, extra);
+        case COMMANDE_LIVREE: return generateDeliveryNotificationHtml(commande, client);
+        case COMMANDE_ANNULEE: return generateCancellationHtml(commande, client, extra);
+        case RAPPEL_LIVRAISON: return generateReminderHtml(commande, client);
+    }
+    return QString();
 }
 
 QString EmailManager::generateCommandeConfirmationHtml(const Commande* commande, const Client* client)
 {
-    QString html = R"(
+    static const TextTemplate html(R"(
 <!DOCTYPE html>
 <html>
 <head>
@@ -200,17 +206,17 @@ QString EmailManager::generateCommandeConfirmationHtml(const Commande* commande,
     </div>
 </body>
 </html>
-    )";
+    )");
 
-    return html.arg(commande->numeroCommande())
-              .arg(client->prenom())
-              .arg(client->nom())
-              .arg(formatCommandeDetails(commande));
+    return html.render({commande->numeroCommande(),
+                        client->prenom(),
+                        client->nom(),
+                        formatCommandeDetails(commande)});
 }
 
 QString EmailManager::generateStatusUpdateHtml(const Commande* commande, const Client* client, const QString& ancienStatut)
 {
-    QString html = R"(
+    static const TextTemplate html(R"(
 <!DOCTYPE html>
 <html>
 <head>
@@ -246,27 +252,28 @@ QString EmailManager::generateStatusUpdateHtml(const Commande* commande, const C
     </div>
 </body>
 </html>
-    )";
+    )");
 
     QString nouveauStatut;
     switch (commande->statut()) {
         case Commande::EN_ATTENTE: nouveauStatut = "En attente"; break;
+        case Commande::CONFIRMEE: nouveauStatut = "Confirmée"; break;
         case Commande::EN_PREPARATION: nouveauStatut = "En préparation"; break;
-        case Commande::EXPEDIE: nouveauStatut = "Expédiée"; break;
+        case Commande::EN_TRANSIT: nouveauStatut = "En transit"; break;
         case Commande::LIVREE: nouveauStatut = "Livrée"; break;
         case Commande::ANNULEE: nouveauStatut = "Annulée"; break;
     }
 
-    return html.arg(commande->numeroCommande())
-              .arg(client->prenom())
-              .arg(client->nom())
-              .arg(ancienStatut)
-              .arg(nouveauStatut);
+    return html.render({commande->numeroCommande(),
+                        client->prenom(),
+                        client->nom(),
+                        ancienStatut,
+                        nouveauStatut});
 }
 
 QString EmailManager::generateDeliveryNotificationHtml(const Commande* commande, const Client* client)
 {
-    QString html = R"(
+    static const TextTemplate html(R"(
 <!DOCTYPE html>
 <html>
 <head>
@@ -302,17 +309,17 @@ QString EmailManager::generateDeliveryNotificationHtml(const Commande* commande,
     </div>
 </body>
 </html>
-    )";
+    )");
 
-    return html.arg(commande->numeroCommande())
-              .arg(client->prenom())
-              .arg(client->nom())
-              .arg(commande->dateLivraisonReelle().toString("dd/MM/yyyy"));
+    return html.render({commande->numeroCommande(),
+                        client->prenom(),
+                        client->nom(),
+                        commande->dateLivraisonReelle().toString("dd/MM/yyyy")});
 }
 
 QString EmailManager::generateCancellationHtml(const Commande* commande, const Client* client, const QString& raison)
 {
-    QString html = R"(
+    static const TextTemplate html(R"(
 <!DOCTYPE html>
 <html>
 <head>
@@ -348,19 +355,33 @@ QString EmailManager::generateCancellationHtml(const Commande* commande, const C
     </div>
 </body>
 </html>
-    )";
+    )");
 
     QString raisonHtml = raison.isEmpty() ? "" : QString("<p><strong>Raison :</strong> %1</p>").arg(raison);
 
-    return html.arg(commande->numeroCommande())
-              .arg(client->prenom())
-              .arg(client->nom())
-              .arg(raisonHtml);
+    return html.render({commande->numeroCommande(), client->prenom(), client->nom(), raisonHtml});
 }
 
 QString EmailManager::generateReminderHtml(const Commande* commande, const Client* client)
 {
-    QString html = R"(
+    return reminderHtml(commande->numeroCommande(), client->prenom(), client->nom(),
+                        commande->dateLivraisonPrevue());
+}
+
+QString EmailManager::reminderSubject(const QString& numeroCommande)
+{
+    return "Rappel livraison commande #" + numeroCommande;
+}
+
+QString EmailManager::reminderDedupKey(int idCommande, const QDate& dateLivraison)
+{
+    return EmailOutbox::dedupKey(idCommande, "RAPPEL:" + dateLivraison.toString(Qt::ISODate));
+}
+
+QString EmailManager::reminderHtml(const QString& numeroCommande, const QString& prenom,
+                                   const QString& nom, const QDate& dateLivraison)
+{
+    static const TextTemplate html(R"(
 <!DOCTYPE html>
 <html>
 <head>
@@ -395,17 +416,14 @@ QString EmailManager::generateReminderHtml(const Commande* commande, const Clien
     </div>
 </body>
 </html>
-    )";
+    )");
 
-    return html.arg(commande->numeroCommande())
-              .arg(client->prenom())
-              .arg(client->nom())
-              .arg(commande->dateLivraisonPrevue().toString("dd/MM/yyyy"));
+    return html.render({numeroCommande, prenom, nom, dateLivraison.toString("dd/MM/yyyy")});
 }
 
 QString EmailManager::formatCommandeDetails(const Commande* commande)
 {
-    QString details = R"(
+    static const TextTemplate details(R"(
         <table style="width: 100%; border-collapse: collapse;">
             <tr style="background-color: #f8f9fa;">
                 <td style="padding: 10px; border: 1px solid #dee2e6; font-weight: bold;">Numéro de commande</td>
@@ -432,7 +450,7 @@ QString EmailManager::formatCommandeDetails(const Commande* commande)
                 <td style="padding: 10px; border: 1px solid #dee2e6; color: #27ae60; font-weight: bold;">%8 TND</td>
             </tr>
         </table>
-    )";
+    )");
 
     QString priorite;
     switch (commande->priorite()) {
@@ -442,24 +460,20 @@ QString EmailManager::formatCommandeDetails(const Commande* commande)
         case Commande::URGENTE: priorite = "Urgente"; break;
     }
 
-    return details.arg(commande->numeroCommande())
-                  .arg(commande->dateCommande().toString("dd/MM/yyyy"))
-                  .arg(commande->dateLivraisonPrevue().toString("dd/MM/yyyy"))
-                  .arg(commande->adresseLivraison())
-                  .arg(commande->codePostalLivraison())
-                  .arg(commande->villeLivraison())
-                  .arg(priorite)
-                  .arg(QString::number(commande->prixTotal(), 'f', 3));
+    return details.render({commande->numeroCommande(),
+                           commande->dateCommande().toString("dd/MM/yyyy"),
+                           commande->dateLivraisonPrevue().toString("dd/MM/yyyy"),
+                           commande->adresseLivraison(),
+                           commande->codePostalLivraison(),
+                           commande->villeLivraison(),
+                           priorite,
+                           QString::number(commande->prixTotal(), 'f', 3)});
 }
 
 QString EmailManager::formatClientDetails(const Client* client)
 {
-    return QString("%1 %2\n%3\n%4 %5\nTél: %6\nEmail: %7")
-           .arg(client->prenom())
-           .arg(client->nom())
-           .arg(client->adresse())
-           .arg(client->codePostal())
-           .arg(client->ville())
-           .arg(client->telephone())
-           .arg(client->email());
+    static const TextTemplate details("%1 %2\n%3\n%4 %5\nTél: %6\nEmail: %7");
+
+    return details.render({client->prenom(), client->nom(), client->adresse(), client->codePostal(),
+                           client->ville(), client->telephone(), client->email()});
 }
@@ -4,9 +4,7 @@
 #include <QObject>
 #include <QString>
 #include <QStringList>
-#include <QNetworkAccessManager>
-#include <QNetworkReply>
-#include <QJsonObject>
+#include <QDate>
 
 class Commande;
 class Client;
@@ -15,7 +13,8 @@ class Client;
  * @brief Gestionnaire d'emails pour l'application logistique
  * 
  * Cette classe gère l'envoi d'emails pour les notifications de commandes,
- * confirmations, mises à jour de statut, etc.
+ * confirmations, mises à jour de statut, etc. Les emails sont placés dans la
+ * file d'envoi persistante (EmailOutbox) ; l'envoi SMTP est asynchrone.
  */
 class EmailManager : public QObject
 {
@@ -44,11 +43,32 @@ public:
     bool sendCancellationNotification(const Commande* commande, const Client* client, const QString& raison);
     bool sendDeliveryReminder(const Commande* commande, const Client* client);
 
-    // Envoi d'email générique
+    // Envoi d'email générique (mise en file ; dedupKey vide : pas de dédoublonnage)
     bool sendEmail(const QString& to, const QString& subject, const QString& body, 
-                  const QString& htmlBody = QString());
-
-    // Configuration
+                  const QString& htmlBody = QString(), const QString& dedupKey = QString());
+
+    /**
+     * @brief Produit le corps HTML d'une notification sans la mettre en file
+     * @param type Type de notification
+     * @param commande Commande concernée
+     * @param client Destinataire
+     * @param extra Ancien statut (MISE_A_JOUR_STATUT) ou raison (COMMANDE_ANNULEE)
+     * @return Corps HTML, vide si commande ou client est null
+     */
+    QString renderHtml(EmailType type, const Commande* commande, const Client* client,
+                       const QString& extra = QString());
+
+    /**
+     * @brief Rappel de livraison à partir des seuls champs affichés
+     *
+     * Sans état : utilisable depuis plusieurs threads (campagnes de rappels).
+     */
+    static QString reminderHtml(const QString& numeroCommande, const QString& prenom,
+                                const QString& nom, const QDate& dateLivraison);
+    static QString reminderSubject(const QString& numeroCommande);
+    static QString reminderDedupKey(int idCommande, const QDate& dateLivraison);
+
+    // Configuration de cette instance, enregistrée avec chaque message mis en file
     void setFromAddress(const QString& fromAddress, const QString& fromName = QString());
     void setReplyToAddress(const QString& replyTo);
 
@@ -56,12 +76,9 @@ public:
     static bool isValidEmail(const QString& email);
 
 signals:
-    void emailSent(const QString& to, const QString& subject);
+    void emailQueued(const QString& to, const QString& subject);
     void emailFailed(const QString& to, const QString& subject, const QString& error);
 
-private slots:
-    void onNetworkReply();
-
 private:
     QString generateCommandeConfirmationHtml(const Commande* commande, const Client* client);
     QString generateStatusUpdateHtml(const Commande* commande, const Client* client, const QString& ancienStatut);
@@ -72,20 +89,10 @@ private:
     QString formatCommandeDetails(const Commande* commande);
     QString formatClientDetails(const Client* client);
 
-    // Configuration SMTP
-    QString m_smtpServer;
-    int m_smtpPort;
-    QString m_username;
-    QString m_password;
-    bool m_useSSL;
-
     // Configuration email
     QString m_fromAddress;
     QString m_fromName;
     QString m_replyToAddress;
-
-    // Réseau
-    QNetworkAccessManager* m_networkManager;
 };
 
 #endif // EMAILMANAGER_H
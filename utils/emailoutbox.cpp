@@ -0,0 +1,611 @@
+#include "emailoutbox.h"
+#include "database/databasemanager.h"
+#include "database/queryprofiler.h"
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QDateTime>
+#include <QMutexLocker>
+#include <QElapsedTimer>
+#include <QDebug>
+#include <algorithm>
+
+namespace {
+const char* const MAIN_CONNECTION = "LogisticsConnection";
+const char* const OUTBOX_CONNECTION = "LogisticsOutboxConnection";
+const int WAKE_DELAY_MS = 200;      // Regroupe les mises en file rapprochées en un lot
+
+QVariant nullableText(const QString& text)
+{
+    return text.isEmpty() ? QVariant(QMetaType::fromType<QString>()) : QVariant(text);
+}
+}
+
+// ---------------------------------------------------------------------------
+// OutboxWorker
+// ---------------------------------------------------------------------------
+
+OutboxWorker::OutboxWorker()
+    : QObject(nullptr)
+    , m_timer(nullptr)
+    , m_connectionName(OUTBOX_CONNECTION)
+{
+}
+
+void OutboxWorker::setConfig(const Config& config)
+{
+    QMutexLocker locker(&m_configMutex);
+    m_config = config;
+}
+
+OutboxWorker::Config OutboxWorker::config() const
+{
+    QMutexLocker locker(&m_configMutex);
+    return m_config;
+}
+
+void OutboxWorker::start()
+{
+    // Le timer est créé dans le thread de la file
+    if (!m_timer) {
+        m_timer = new QTimer(this);
+        m_timer->setSingleShot(true);
+        connect(m_timer, &QTimer::timeout, this, &OutboxWorker::drain);
+    }
+    m_timer->start(0);
+}
+
+void OutboxWorker::stop()
+{
+    if (m_timer) {
+        m_timer->stop();
+    }
+
+    if (QSqlDatabase::contains(m_connectionName)) {
+        {
+            QSqlDatabase db = QSqlDatabase::database(m_connectionName, false);
+            db.close();
+        }
+        QSqlDatabase::removeDatabase(m_connectionName);
+    }
+}
+
+void OutboxWorker::wake()
+{
+    if (m_timer && (!m_timer->isActive() || m_timer->remainingTime() > WAKE_DELAY_MS)) {
+        m_timer->start(WAKE_DELAY_MS);
+    }
+}
+
+bool OutboxWorker::ensureConnection(QString& error)
+{
+    if (!QSqlDatabase::contains(m_connectionName)) {
+        // Clone des paramètres de la connexion principale (driver, hôte, identifiants)
+        QSqlDatabase clone = QSqlDatabase::cloneDatabase(MAIN_CONNECTION, m_connectionName);
+        if (clone.driverName() == "QSQLITE") {
+            // Écritures concurrentes avec la connexion principale
+            clone.setConnectOptions("QSQLITE_BUSY_TIMEOUT=5000");
+        }
+    }
+
+    QSqlDatabase db = QSqlDatabase::database(m_connectionName, false);
+    if (!db.isOpen() && !db.open()) {
+        error = db.lastError().text();
+        return false;
+    }
+
+    return true;
+}
+
+void OutboxWorker::drain()
+{
+    const Config current = config();
+    QString error;
+
+    if (!ensureConnection(error)) {
+        qWarning() << "File d'envoi: base indisponible:" << error;
+        m_timer->start(current.pollIntervalMs);
+        return;
+    }
+
+    const QList<Pending> batch = claimBatch(current, error);
+    if (!error.isEmpty()) {
+        qWarning() << "File d'envoi: réservation du lot impossible:" << error;
+        QSqlDatabase::database(m_connectionName, false).close();
+    }
+
+    if (!batch.isEmpty()) {
+        const QList<Outcome> outcomes = sendBatch(current, batch);
+        if (!recordOutcomes(current, batch, outcomes)) {
+            // Le bail expirera : les messages seront repris
+            qWarning() << "File d'envoi: enregistrement des résultats impossible";
+        }
+    }
+
+    // Lot complet : la file n'est probablement pas vide, on enchaîne
+    m_timer->start(batch.size() >= current.batchSize ? 0 : current.pollIntervalMs);
+}
+
+QList<OutboxWorker::Pending> OutboxWorker::claimBatch(const Config& config, QString& error)
+{
+    QList<Pending> batch;
+    QSqlDatabase db = QSqlDatabase::database(m_connectionName, false);
+    const QDateTime now = QDateTime::currentDateTime();
+
+    // Messages dus, y compris ceux dont le bail a expiré
+    QString sql = R"(
+        SELECT ID_EMAIL, DESTINATAIRE, SUJET, CORPS_TEXTE, CORPS_HTML, TENTATIVES,
+               EXPEDITEUR, NOM_EXPEDITEUR, REPONDRE_A
+        FROM EMAIL_OUTBOX
+        WHERE STATUT IN ('EN_ATTENTE', 'EN_COURS') AND PROCHAINE_TENTATIVE <= ?
+        ORDER BY ID_EMAIL
+    )";
+    sql += db.driverName() == "QOCI" ? QString(" FETCH FIRST %1 ROWS ONLY").arg(config.batchSize)
+                                     : QString(" LIMIT %1").arg(config.batchSize);
+
+    QSqlQuery select(db);
+    select.setForwardOnly(true);
+    select.prepare(sql);
+    select.addBindValue(now);
+    if (!select.exec()) {
+        error = select.lastError().text();
+        return batch;
+    }
+
+    while (select.next()) {
+        Pending pending;
+        pending.id = select.value(0).toInt();
+        pending.attempts = select.value(5).toInt();
+        // Expéditeur enregistré avec le message, sinon celui de la file
+        const QString from = select.value(6).toString();
+        pending.message.from = from.isEmpty() ? config.fromAddress : from;
+        const QString fromName = select.value(7).toString();
+        pending.message.fromName = fromName.isEmpty() ? config.fromName : fromName;
+        const QString replyTo = select.value(8).toString();
+        pending.message.replyTo = replyTo.isEmpty() ? config.replyTo : replyTo;
+        pending.message.to = select.value(1).toString();
+        pending.message.subject = select.value(2).toString();
+        pending.message.textBody = select.value(3).toString();
+        pending.message.htmlBody = select.value(4).toString();
+        batch.append(pending);
+    }
+    select.finish();
+
+    if (batch.isEmpty()) {
+        return batch;
+    }
+
+    // Réservation : seuls les messages encore dus passent EN_COURS
+    const QDateTime leaseEnd = now.addSecs(config.leaseSec);
+    QList<Pending> claimed;
+    db.transaction();
+
+    QSqlQuery claim(db);
+    claim.prepare(R"(
+        UPDATE EMAIL_OUTBOX SET STATUT = 'EN_COURS', PROCHAINE_TENTATIVE = ?
+        WHERE ID_EMAIL = ? AND STATUT IN ('EN_ATTENTE', 'EN_COURS') AND PROCHAINE_TENTATIVE <= ?
+    )");
+    for (const Pending& pending : batch) {
+        claim.addBindValue(leaseEnd);
+        claim.addBindValue(pending.id);
+        claim.addBindValue(now);
+        if (!claim.exec()) {
+            error = claim.lastError().text();
+            db.rollback();
+            return QList<Pending>();
+        }
+        if (claim.numRowsAffected() == 1) {
+            claimed.append(pending);
+        }
+    }
+
+    if (!db.commit()) {
+        error = db.lastError().text();
+        return QList<Pending>();
+    }
+    return claimed;
+}
+
+QList<OutboxWorker::Outcome> OutboxWorker::sendBatch(const Config& config, const QList<Pending>& batch)
+{
+    QList<Outcome> outcomes;
+    outcomes.reserve(batch.size());
+
+    // Une session pour tout le lot ; rouverte si le serveur la coupe
+    SmtpClient client(config.smtp);
+    bool sessionFailed = false;
+    QString sessionError;
+    QElapsedTimer pacing;
+    pacing.start();
+    int attempted = 0;
+
+    for (const Pending& pending : batch) {
+        // Limitation de débit : le n-ième message ne part pas avant n / débit secondes
+        if (config.maxPerSecond > 0 && !sessionFailed) {
+            const qint64 due = static_cast<qint64>(attempted) * 1000 / config.maxPerSecond;
+            if (due > pacing.elapsed()) {
+                QThread::msleep(static_cast<unsigned long>(due - pacing.elapsed()));
+            }
+        }
+        ++attempted;
+
+        if (!sessionFailed && !client.isOpen() && !client.open()) {
+            sessionFailed = true;
+            sessionError = client.lastError();
+            qWarning() << "File d'envoi: session SMTP impossible:" << sessionError;
+        }
+        if (sessionFailed) {
+            outcomes.append({false, false, sessionError});
+            continue;
+        }
+
+        if (client.send(pending.message)) {
+            outcomes.append({true, false, QString()});
+        } else {
+            outcomes.append({false, client.lastErrorIsPermanent(), client.lastError()});
+        }
+    }
+
+    client.close();
+    return outcomes;
+}
+
+bool OutboxWorker::recordOutcomes(const Config& config, const QList<Pending>& batch, const QList<Outcome>& outcomes)
+{
+    QSqlDatabase db = QSqlDatabase::database(m_connectionName, false);
+    const QDateTime now = QDateTime::currentDateTime();
+
+    QSqlQuery sentQuery(db);
+    sentQuery.prepare(R"(
+        UPDATE EMAIL_OUTBOX SET STATUT = 'ENVOYE', TENTATIVES = TENTATIVES + 1,
+               DATE_ENVOI = ?, DERNIERE_ERREUR = NULL
+        WHERE ID_EMAIL = ?
+    )");
+    QSqlQuery failedQuery(db);
+    failedQuery.prepare(R"(
+        UPDATE EMAIL_OUTBOX SET STATUT = ?, TENTATIVES = TENTATIVES + 1,
+               PROCHAINE_TENTATIVE = ?, DERNIERE_ERREUR = ?
+        WHERE ID_EMAIL = ?
+    )");
+
+    int sent = 0;
+    int retried = 0;
+    int failed = 0;
+    bool success = db.transaction();
+
+    for (int i = 0; success && i < batch.size(); ++i) {
+        const Pending& pending = batch.at(i);
+        const Outcome& outcome = outcomes.at(i);
+
+        if (outcome.sent) {
+            sentQuery.addBindValue(now);
+            sentQuery.addBindValue(pending.id);
+            success = sentQuery.exec();
+            ++sent;
+            continue;
+        }
+
+        const int attempts = pending.attempts + 1;
+        const bool definitive = outcome.permanent || attempts >= config.maxAttempts;
+
+        // Délai exponentiel : base, 2x, 4x ... plafonné
+        const int shift = std::min(attempts - 1, 16);
+        const qint64 delaySec = std::min<qint64>(static_cast<qint64>(config.baseBackoffSec) << shift,
+                                                 config.maxBackoffSec);
+
+        failedQuery.addBindValue(definitive ? "ECHEC" : "EN_ATTENTE");
+        failedQuery.addBindValue(now.addSecs(delaySec));
+        failedQuery.addBindValue(outcome.error.left(1000));
+        failedQuery.addBindValue(pending.id);
+        success = failedQuery.exec();
+
+        if (definitive) {
+            ++failed;
+            qWarning() << "File d'envoi: échec définitif pour" << pending.message.to << "-" << outcome.error;
+        } else {
+            ++retried;
+        }
+    }
+
+    if (!success || !db.commit()) {
+        qWarning() << "File d'envoi:" << (sentQuery.lastError().isValid() ? sentQuery.lastError().text()
+                                                                         : failedQuery.lastError().text());
+        db.rollback();
+        return false;
+    }
+
+    emit batchProcessed(sent, retried, failed);
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// EmailOutbox
+// ---------------------------------------------------------------------------
+
+EmailOutbox* EmailOutbox::m_instance = nullptr;
+
+EmailOutbox& EmailOutbox::instance()
+{
+    if (!m_instance) {
+        m_instance = new EmailOutbox();
+    }
+    return *m_instance;
+}
+
+EmailOutbox::EmailOutbox(QObject *parent)
+    : QObject(parent)
+    , m_worker(new OutboxWorker())
+{
+    // Le worker reste associé au thread : la file peut être redémarrée après stop()
+    m_thread.setObjectName("EmailOutbox");
+    m_worker->moveToThread(&m_thread);
+    m_worker->setConfig(m_config);
+
+    connect(m_worker, &OutboxWorker::batchProcessed, this, &EmailOutbox::batchProcessed);
+}
+
+void EmailOutbox::setSmtpSettings(const SmtpClient::Settings& settings)
+{
+    m_config.smtp = settings;
+    applyConfig();
+}
+
+SmtpClient::Settings EmailOutbox::smtpSettings() const
+{
+    return m_config.smtp;
+}
+
+void EmailOutbox::setSender(const QString& fromAddress, const QString& fromName, const QString& replyTo)
+{
+    m_config.fromAddress = fromAddress;
+    if (!fromName.isEmpty()) {
+        m_config.fromName = fromName;
+    }
+    if (!replyTo.isEmpty()) {
+        m_config.replyTo = replyTo;
+    }
+    applyConfig();
+}
+
+void EmailOutbox::setBatchSize(int batchSize)
+{
+    if (batchSize > 0) {
+        m_config.batchSize = batchSize;
+        applyConfig();
+    }
+}
+
+void EmailOutbox::setMaxAttempts(int maxAttempts)
+{
+    if (maxAttempts > 0) {
+        m_config.maxAttempts = maxAttempts;
+        applyConfig();
+    }
+}
+
+void EmailOutbox::setRateLimit(int messagesPerSecond)
+{
+    m_config.maxPerSecond = qMax(0, messagesPerSecond);
+    applyConfig();
+}
+
+void EmailOutbox::applyConfig()
+{
+    m_worker->setConfig(m_config);
+}
+
+EmailOutbox::EnqueueResult EmailOutbox::enqueue(const OutboxEmail& email)
+{
+    int duplicates = 0;
+    const int queued = enqueueBatch({email}, &duplicates);
+    if (queued < 0) {
+        return ERREUR;
+    }
+    return duplicates > 0 ? DUPLICATE : QUEUED;
+}
+
+int EmailOutbox::enqueueBatch(const QList<OutboxEmail>& emails, int* duplicates,
+                              QList<EnqueueResult>* results)
+{
+    if (duplicates) {
+        *duplicates = 0;
+    }
+    if (results) {
+        results->clear();
+    }
+    if (emails.isEmpty()) {
+        return 0;
+    }
+
+    DatabaseManager& db = DatabaseManager::instance();
+    const QDateTime now = QDateTime::currentDateTime();
+    int queued = 0;
+    int skipped = 0;
+    QList<EnqueueResult> outcomes;
+
+    // Rejouable : compteurs remis à zéro à chaque tentative
+    const bool success = db.runTransaction([&]() {
+        queued = 0;
+        skipped = 0;
+        outcomes.clear();
+        outcomes.reserve(emails.size());
+
+        QSqlQuery exists = db.prepareQuery("SELECT STATUT FROM EMAIL_OUTBOX WHERE CLE_DEDOUBLONNAGE = ?");
+        QSqlQuery requeue = db.prepareQuery(R"(
+            UPDATE EMAIL_OUTBOX
+            SET DESTINATAIRE = ?, SUJET = ?, CORPS_TEXTE = ?, CORPS_HTML = ?,
+                EXPEDITEUR = ?, NOM_EXPEDITEUR = ?, REPONDRE_A = ?,
+                STATUT = 'EN_ATTENTE', TENTATIVES = 0, PROCHAINE_TENTATIVE = ?, DERNIERE_ERREUR = NULL
+            WHERE CLE_DEDOUBLONNAGE = ? AND STATUT = 'ECHEC'
+        )");
+        QSqlQuery insert = db.prepareQuery(R"(
+            INSERT INTO EMAIL_OUTBOX (CLE_DEDOUBLONNAGE, DESTINATAIRE, SUJET, CORPS_TEXTE, CORPS_HTML,
+                                      EXPEDITEUR, NOM_EXPEDITEUR, REPONDRE_A,
+                                      STATUT, TENTATIVES, PROCHAINE_TENTATIVE, DATE_CREATION)
+            VALUES (?, ?, ?, ?, ?, ?, ?, ?, 'EN_ATTENTE', 0, ?, ?)
+        )");
+
+        for (const OutboxEmail& email : emails) {
+            if (!email.dedupKey.isEmpty()) {
+                if (!db.executeQuery(exists, {email.dedupKey})) {
+                    return false;
+                }
+                const bool known = exists.next();
+                const bool failed = known && exists.value(0).toString() == "ECHEC";
+                exists.finish();
+
+                // Échec définitif : la notification est remise en file
+                if (failed) {
+                    if (!db.executeQuery(requeue, {email.to, email.subject, nullableText(email.textBody),
+                                                   nullableText(email.htmlBody), nullableText(email.from),
+                                                   nullableText(email.fromName), nullableText(email.replyTo),
+                                                   now, email.dedupKey})) {
+                        return false;
+                    }
+                    ++queued;
+                    outcomes.append(QUEUED);
+                    continue;
+                }
+                if (known) {
+                    ++skipped;
+                    outcomes.append(DUPLICATE);
+                    continue;
+                }
+            }
+
+            if (!db.executeQuery(insert, {nullableText(email.dedupKey), email.to, email.subject,
+                                          nullableText(email.textBody), nullableText(email.htmlBody),
+                                          nullableText(email.from), nullableText(email.fromName),
+                                          nullableText(email.replyTo), now, now})) {
+                return false;
+            }
+            ++queued;
+            outcomes.append(QUEUED);
+        }
+        return true;
+    });
+
+    if (!success) {
+        m_lastError = db.lastError();
+        qWarning() << "File d'envoi: mise en file impossible:" << m_lastError;
+        if (results) {
+            *results = QList<EnqueueResult>(emails.size(), ERREUR);
+        }
+        return -1;
+    }
+
+    if (duplicates) {
+        *duplicates = skipped;
+    }
+    if (results) {
+        *results = outcomes;
+    }
+    if (queued > 0 && m_thread.isRunning()) {
+        QMetaObject::invokeMethod(m_worker, "wake", Qt::QueuedConnection);
+    }
+    return queued;
+}
+
+void EmailOutbox::start(int pollIntervalMs)
+{
+    if (m_thread.isRunning()) {
+        return;
+    }
+
+    if (pollIntervalMs > 0) {
+        m_config.pollIntervalMs = pollIntervalMs;
+        applyConfig();
+    }
+
+    m_thread.start(QThread::LowPriority);
+    QMetaObject::invokeMethod(m_worker, "start", Qt::QueuedConnection);
+}
+
+void EmailOutbox::stop()
+{
+    if (!m_thread.isRunning()) {
+        return;
+    }
+
+    // Un lot en cours d'envoi est terminé avant l'arrêt
+    QMetaObject::invokeMethod(m_worker, "stop", Qt::BlockingQueuedConnection);
+    m_thread.quit();
+    m_thread.wait();
+}
+
+bool EmailOutbox::isRunning() const
+{
+    return m_thread.isRunning();
+}
+
+EmailOutbox::Stats EmailOutbox::stats() const
+{
+    Stats stats;
+    DatabaseManager& db = DatabaseManager::instance();
+
+    QSqlQuery query = db.prepareQuery("SELECT STATUT, COUNT(*) FROM EMAIL_OUTBOX GROUP BY STATUT");
+    if (!db.executeQuery(query)) {
+        return stats;
+    }
+
+    int rows = 0;
+    while (query.next()) {
+        ++rows;
+        const QString statut = query.value(0).toString();
+        const int count = query.value(1).toInt();
+        if (statut == "EN_ATTENTE") {
+            stats.pending = count;
+        } else if (statut == "EN_COURS") {
+            stats.sending = count;
+        } else if (statut == "ENVOYE") {
+            stats.sent = count;
+        } else if (statut == "ECHEC") {
+            stats.failed = count;
+        }
+    }
+    QueryProfiler::instance().addRows(query.lastQuery(), rows);
+    return stats;
+}
+
+QHash<QString, QString> EmailOutbox::statusByDedupKey(const QStringList& dedupKeys) const
+{
+    QHash<QString, QString> statuses;
+    DatabaseManager& db = DatabaseManager::instance();
+
+    // Listes IN bornées, sous la limite Oracle de 1000 éléments
+    const int keysPerQuery = 500;
+    for (int begin = 0; begin < dedupKeys.size(); begin += keysPerQuery) {
+        const QStringList chunk = dedupKeys.mid(begin, keysPerQuery);
+
+        QStringList placeholders;
+        QVariantList values;
+        for (const QString& key : chunk) {
+            placeholders << "?";
+            values << key;
+        }
+
+        QSqlQuery query = db.prepareQuery("SELECT CLE_DEDOUBLONNAGE, STATUT FROM EMAIL_OUTBOX"
+                                          " WHERE CLE_DEDOUBLONNAGE IN (" + placeholders.join(", ") + ")");
+        if (!db.executeQuery(query, values)) {
+            return QHash<QString, QString>();
+        }
+
+        int rows = 0;
+        while (query.next()) {
+            ++rows;
+            statuses.insert(query.value(0).toString(), query.value(1).toString());
+        }
+        QueryProfiler::instance().addRows(query.lastQuery(), rows);
+    }
+    return statuses;
+}
+
+QString EmailOutbox::dedupKey(int idCommande, const QString& evenement)
+{
+    return QString("COMMANDE:%1:%2").arg(idCommande).arg(evenement);
+}
+
+QString EmailOutbox::lastError() const
+{
+    return m_lastError;
+}
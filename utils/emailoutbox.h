@@ -0,0 +1,237 @@
+#ifndef EMAILOUTBOX_H
+#define EMAILOUTBOX_H
+
+#include <QObject>
+#include <QString>
+#include <QList>
+#include <QHash>
+#include <QStringList>
+#include <QMutex>
+#include <QThread>
+#include <QTimer>
+#include "smtpclient.h"
+
+/**
+ * @brief Email à placer dans la file d'envoi
+ */
+struct OutboxEmail {
+    QString to;
+    QString subject;
+    QString textBody;
+    QString htmlBody;
+    QString dedupKey;       // Vide : pas de dédoublonnage
+    QString from;           // Expéditeur du message ; vides : expéditeur par défaut de la file
+    QString fromName;
+    QString replyTo;
+};
+
+/**
+ * @brief Vidage de la file d'envoi, exécuté dans le thread de la file
+ *
+ * Possède sa propre connexion à la base (clone de la connexion principale).
+ * Chaque lot est réservé par un bail (STATUT EN_COURS et échéance de
+ * PROCHAINE_TENTATIVE), envoyé sur une seule session SMTP puis soldé dans
+ * une transaction : envoyé, nouvelle tentative avec délai exponentiel
+ * (erreur temporaire) ou échec définitif (réponse 5xx, tentatives épuisées).
+ * Un bail expiré (arrêt brutal pendant l'envoi) remet le message en file.
+ */
+class OutboxWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Config {
+        SmtpClient::Settings smtp;
+        QString fromAddress = "noreply@logistics.tn";
+        QString fromName = "Système Logistique";
+        QString replyTo = "support@logistics.tn";
+        int batchSize = 100;
+        int maxAttempts = 5;
+        int pollIntervalMs = 5000;
+        int baseBackoffSec = 30;
+        int maxBackoffSec = 3600;
+        int leaseSec = 300;
+        int maxPerSecond = 0;           // Débit SMTP maximal, 0 : illimité
+    };
+
+    OutboxWorker();
+
+    /**
+     * @brief Remplace la configuration (appelable depuis un autre thread)
+     */
+    void setConfig(const Config& config);
+
+public slots:
+    void start();
+    void stop();
+
+    /**
+     * @brief Avance le prochain vidage (nouveaux messages en file)
+     */
+    void wake();
+
+signals:
+    /**
+     * @brief Bilan d'un lot
+     * @param sent Messages acceptés par le serveur
+     * @param retried Messages replanifiés (erreur temporaire)
+     * @param failed Messages en échec définitif
+     */
+    void batchProcessed(int sent, int retried, int failed);
+
+private slots:
+    void drain();
+
+private:
+    struct Pending {
+        int id;
+        int attempts;
+        SmtpClient::Message message;
+    };
+
+    struct Outcome {
+        bool sent;
+        bool permanent;
+        QString error;
+    };
+
+    Config config() const;
+    bool ensureConnection(QString& error);
+    QList<Pending> claimBatch(const Config& config, QString& error);
+    QList<Outcome> sendBatch(const Config& config, const QList<Pending>& batch);
+    bool recordOutcomes(const Config& config, const QList<Pending>& batch, const QList<Outcome>& outcomes);
+
+private:
+    QTimer *m_timer;
+    QString m_connectionName;
+    mutable QMutex m_configMutex;
+    Config m_config;
+};
+
+/**
+ * @brief File d'envoi persistante des emails (table EMAIL_OUTBOX)
+ *
+ * L'appelant ne fait qu'une insertion en base : l'envoi SMTP a lieu dans un
+ * thread dédié (OutboxWorker), par lots, une session étant réutilisée pour
+ * tout le lot. Une clé de dédoublonnage (ex. commande + statut) empêche
+ * qu'une même notification soit mise en file deux fois ; une notification
+ * en échec définitif (ECHEC) est en revanche remise en file.
+ */
+class EmailOutbox : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum EnqueueResult {
+        QUEUED,
+        DUPLICATE,
+        ERREUR
+    };
+
+    /**
+     * @brief Compteurs de la file par statut
+     */
+    struct Stats {
+        int pending = 0;
+        int sending = 0;
+        int sent = 0;
+        int failed = 0;
+    };
+
+    /**
+     * @brief Obtient l'instance unique de la file d'envoi
+     * @return Référence vers l'instance unique
+     */
+    static EmailOutbox& instance();
+
+    void setSmtpSettings(const SmtpClient::Settings& settings);
+    SmtpClient::Settings smtpSettings() const;
+    /**
+     * @brief Expéditeur par défaut, pour les messages mis en file sans expéditeur
+     */
+    void setSender(const QString& fromAddress, const QString& fromName, const QString& replyTo);
+
+    /**
+     * @brief Taille des lots et nombre maximal de tentatives
+     */
+    void setBatchSize(int batchSize);
+    void setMaxAttempts(int maxAttempts);
+
+    /**
+     * @brief Limite le débit d'envoi SMTP (campagnes volumineuses)
+     * @param messagesPerSecond Messages par seconde, 0 pour ne pas limiter
+     */
+    void setRateLimit(int messagesPerSecond);
+
+    /**
+     * @brief Met un email en file (une insertion, sans attente réseau)
+     * @param email Email à envoyer
+     * @return QUEUED (y compris remise en file d'un ECHEC), DUPLICATE si la
+     *         clé existe déjà, ERREUR sinon
+     */
+    EnqueueResult enqueue(const OutboxEmail& email);
+
+    /**
+     * @brief Met plusieurs emails en file dans une seule transaction
+     * @param emails Emails à envoyer
+     * @param duplicates Reçoit le nombre d'emails ignorés (clé existante hors ECHEC)
+     * @param results Reçoit le résultat de chaque email, dans l'ordre de la liste
+     * @return Nombre d'emails mis en file, -1 en cas d'erreur
+     */
+    int enqueueBatch(const QList<OutboxEmail>& emails, int* duplicates = nullptr,
+                     QList<EnqueueResult>* results = nullptr);
+
+    /**
+     * @brief Démarre le thread d'envoi
+     * @param pollIntervalMs Intervalle de scrutation de la file (défaut: 5000 ms)
+     */
+    void start(int pollIntervalMs = 5000);
+
+    /**
+     * @brief Arrête le thread d'envoi ; les messages restent en file
+     */
+    void stop();
+
+    bool isRunning() const;
+
+    Stats stats() const;
+
+    /**
+     * @brief Statut des messages identifiés par leur clé de dédoublonnage
+     * @param dedupKeys Clés recherchées
+     * @return Statut (EN_ATTENTE, EN_COURS, ENVOYE, ECHEC) par clé ; une clé
+     *         absente de la file n'apparaît pas. Vide en cas d'erreur
+     */
+    QHash<QString, QString> statusByDedupKey(const QStringList& dedupKeys) const;
+
+    /**
+     * @brief Clé de dédoublonnage d'une notification de commande
+     * @param idCommande Identifiant de la commande
+     * @param evenement Événement notifié (ex. "STATUT:LIVREE")
+     * @return Clé "COMMANDE:<id>:<evenement>"
+     */
+    static QString dedupKey(int idCommande, const QString& evenement);
+
+    QString lastError() const;
+
+signals:
+    void batchProcessed(int sent, int retried, int failed);
+
+private:
+    EmailOutbox(QObject *parent = nullptr);
+
+    // Empêche la copie et l'assignation
+    EmailOutbox(const EmailOutbox&) = delete;
+    EmailOutbox& operator=(const EmailOutbox&) = delete;
+
+    void applyConfig();
+
+private:
+    QThread m_thread;
+    OutboxWorker *m_worker;
+    OutboxWorker::Config m_config;
+    QString m_lastError;
+    static EmailOutbox* m_instance;
+};
+
+#endif // EMAILOUTBOX_H
@@ -0,0 +1,186 @@
+#include "labelengine.h"
+
+namespace {
+
+// Nom du format enregistré dans la mémoire vive de l'imprimante ZPL
+const QByteArray ZPL_FORMAT = "R:ETIQLIV.ZPL";
+
+// ESC/POS
+const char ESC = '\x1b';
+const char GS = '\x1d';
+
+QByteArray escPos(std::initializer_list<char> bytes)
+{
+    return QByteArray(bytes.begin(), static_cast<int>(bytes.size()));
+}
+
+} // namespace
+
+LabelEngine::LabelEngine(Language language, const QString& senderName, const QString& senderAddress)
+    : m_language(language)
+    , m_literalSize(0)
+{
+    if (m_language == ZPL) {
+        compileZpl(encode(senderName), encode(senderAddress));
+    } else {
+        compileEscPos(encode(senderName), encode(senderAddress));
+    }
+}
+
+LabelEngine::Language LabelEngine::languageFromString(const QString& name)
+{
+    const QString normalized = name.toLower().remove('/').remove('-');
+    return normalized == "escpos" ? ESC_POS : ZPL;
+}
+
+QByteArray LabelEngine::render(const Label& label) const
+{
+    QByteArray out;
+    renderTo(out, label);
+    return out;
+}
+
+void LabelEngine::renderTo(QByteArray& out, const Label& label) const
+{
+    // Chaque champ est encodé une fois, même s'il apparaît plusieurs fois
+    const QByteArray values[] = {
+        encode(label.numeroCommande),
+        encode(label.destinataire),
+        encode(label.adresse),
+        encode(label.codePostal + " " + label.ville),
+        encode(label.telephone),
+        encode(label.dateLivraisonPrevue.toString("dd/MM/yyyy"))
+    };
+
+    int valuesSize = 0;
+    for (const QByteArray& value : values) {
+        valuesSize += value.size();
+    }
+    // Le numéro est imprimé deux fois (texte et code-barres)
+    const int required = out.size() + m_literalSize + valuesSize + values[NUMERO].size() + 1;
+    if (out.capacity() < required) {
+        out.reserve(qMax(required, static_cast<int>(out.capacity()) * 2));
+    }
+
+    for (const Segment& segment : m_segments) {
+        if (segment.field == LITERAL) {
+            out.append(segment.literal);
+        } else if (segment.field == BARCODE) {
+            // GS k 73 : longueur, jeu de caractères Code 128 B puis données
+            const QByteArray& numero = values[NUMERO];
+            const int length = qMin(static_cast<int>(numero.size()), 253);
+            out.append(static_cast<char>(length + 2));
+            out.append("{B", 2);
+            out.append(numero.constData(), length);
+        } else {
+            out.append(values[segment.field]);
+        }
+    }
+}
+
+void LabelEngine::compileZpl(const QByteArray& sender, const QByteArray& senderAddress)
+{
+    // Format 100 x 150 mm à 203 dpi (799 x 1199 points), textes en UTF-8 (^CI28)
+    m_preamble = "^XA\n"
+                 "^DF" + ZPL_FORMAT + "^FS\n"
+                 "^CI28\n"
+                 "^PW799^LL1199\n"
+                 "^FO20,20^GB759,1159,4^FS\n"
+                 "^FO0,50^FB799,1,0,C^A0N,40,40^FDÉTIQUETTE DE LIVRAISON^FS\n"
+                 "^FO40,130^A0N,26,26^FDCommande N°:^FS\n"
+                 "^FO40,165^A0N,34,34^FN1^FS\n"
+                 "^FO40,240^A0N,26,26^FDDestinataire:^FS\n"
+                 "^FO40,275^A0N,32,32^FN2^FS\n"
+                 "^FO40,315^A0N,28,28^FN3^FS\n"
+                 "^FO40,350^A0N,28,28^FN4^FS\n"
+                 "^FO40,385^A0N,28,28^FDTél:^FS\n"
+                 "^FO110,385^A0N,28,28^FN5^FS\n"
+                 "^FO40,460^A0N,26,26^FDExpéditeur:^FS\n"
+                 "^FO40,495^A0N,28,28^FD" + sender + "^FS\n"
+                 "^FO40,530^A0N,24,24^FD" + senderAddress + "^FS\n"
+                 "^FO40,610^A0N,26,26^FDDate de livraison prévue:^FS\n"
+                 "^FO40,645^A0N,32,32^FN6^FS\n"
+                 "^FO80,760^BY3^BCN,220,Y,N,N^FN7^FS\n"
+                 "^XZ\n";
+
+    // Une étiquette : rappel du format et champs variables uniquement
+    addLiteral("^XA^CI28^XF" + ZPL_FORMAT + "^FS^FN1^FD");
+    addField(NUMERO);
+    addLiteral("^FS^FN2^FD");
+    addField(DESTINATAIRE);
+    addLiteral("^FS^FN3^FD");
+    addField(ADRESSE);
+    addLiteral("^FS^FN4^FD");
+    addField(CODE_POSTAL_VILLE);
+    addLiteral("^FS^FN5^FD");
+    addField(TELEPHONE);
+    addLiteral("^FS^FN6^FD");
+    addField(DATE_LIVRAISON);
+    addLiteral("^FS^FN7^FD");
+    addField(NUMERO);
+    addLiteral("^FS^XZ\n");
+}
+
+void LabelEngine::compileEscPos(const QByteArray& sender, const QByteArray& senderAddress)
+{
+    // Initialisation, page de codes Windows-1252
+    m_preamble = escPos({ESC, '@', ESC, 't', 16});
+
+    const QByteArray bold = escPos({ESC, 'E', 1});
+    const QByteArray normal = escPos({ESC, 'E', 0});
+    const QByteArray left = escPos({ESC, 'a', 0});
+    const QByteArray center = escPos({ESC, 'a', 1});
+
+    addLiteral(center + escPos({GS, '!', 0x11}) + QString("ÉTIQUETTE DE LIVRAISON\n").toLatin1()
+               + escPos({GS, '!', 0x00}) + left + "\n"
+               + bold + QString("Commande N°:\n").toLatin1() + normal);
+    addField(NUMERO);
+    addLiteral("\n\n" + bold + "Destinataire:\n" + normal);
+    addField(DESTINATAIRE);
+    addLiteral("\n");
+    addField(ADRESSE);
+    addLiteral("\n");
+    addField(CODE_POSTAL_VILLE);
+    addLiteral(QString("\nTél: ").toLatin1());
+    addField(TELEPHONE);
+    addLiteral("\n\n" + bold + QString("Expéditeur:\n").toLatin1() + normal
+               + sender + "\n" + senderAddress + "\n\n"
+               + bold + QString("Date de livraison prévue:\n").toLatin1() + normal);
+    addField(DATE_LIVRAISON);
+    // Code 128 : hauteur 100 points, module 2, texte lisible sous les barres
+    addLiteral("\n\n" + center + escPos({GS, 'h', 100, GS, 'w', 2, GS, 'H', 2, GS, 'k', 73}));
+    m_segments.append({QByteArray(), BARCODE});
+    m_literalSize += 3;
+    // Avance puis coupe partielle
+    addLiteral("\n" + left + escPos({ESC, 'd', 3, GS, 'V', 66, 0}));
+}
+
+void LabelEngine::addLiteral(const QByteArray& bytes)
+{
+    // Littéraux consécutifs fusionnés : un seul append par segment au rendu
+    if (!m_segments.isEmpty() && m_segments.last().field == LITERAL) {
+        m_segments.last().literal.append(bytes);
+    } else {
+        m_segments.append({bytes, LITERAL});
+    }
+    m_literalSize += bytes.size();
+}
+
+void LabelEngine::addField(Field field)
+{
+    m_segments.append({QByteArray(), field});
+}
+
+QByteArray LabelEngine::encode(const QString& text) const
+{
+    QByteArray bytes = m_language == ZPL ? text.toUtf8() : text.toLatin1();
+
+    // '^' et '~' introduisent des commandes ZPL ; les caractères de contrôle
+    // seraient interprétés par l'imprimante ESC/POS
+    for (char& c : bytes) {
+        if (c == '^' || c == '~' || (static_cast<unsigned char>(c) < 0x20)) {
+            c = ' ';
+        }
+    }
+    return bytes;
+}
@@ -0,0 +1,96 @@
+#ifndef LABELENGINE_H
+#define LABELENGINE_H
+
+#include <QString>
+#include <QByteArray>
+#include <QDate>
+#include <QVector>
+
+/**
+ * @brief Étiquettes de livraison pour imprimantes thermiques (ZPL, ESC/POS)
+ *
+ * La mise en page est compilée une seule fois en segments d'octets : le
+ * rendu d'une étiquette se réduit à concaténer ces segments et les champs
+ * de la commande, sans HTML ni QTextDocument. Le numéro de commande est
+ * imprimé en code-barres Code 128 par l'imprimante elle-même.
+ *
+ * En ZPL, la partie fixe (cadre, intitulés, expéditeur) est envoyée une fois
+ * par session sous forme de format enregistré dans l'imprimante (^DF) ;
+ * chaque étiquette ne transmet ensuite que ses champs variables (^XF/^FN).
+ * ESC/POS n'ayant pas de formats enregistrés, la partie fixe est
+ * précompilée dans les segments de chaque ticket.
+ */
+class LabelEngine
+{
+public:
+    enum Language {
+        ZPL,
+        ESC_POS
+    };
+
+    struct Label {
+        QString numeroCommande;
+        QString destinataire;           // Prénom et nom
+        QString adresse;                // Adresse de livraison
+        QString codePostal;
+        QString ville;
+        QString telephone;
+        QDate dateLivraisonPrevue;
+    };
+
+    LabelEngine(Language language, const QString& senderName, const QString& senderAddress);
+
+    /**
+     * @brief Octets à envoyer une fois à l'ouverture d'une session
+     *        (format enregistré en ZPL, initialisation en ESC/POS)
+     */
+    QByteArray preamble() const { return m_preamble; }
+
+    /**
+     * @brief Produit le flux d'une étiquette
+     */
+    QByteArray render(const Label& label) const;
+
+    /**
+     * @brief Ajoute le flux d'une étiquette à un tampon existant (impression en lot)
+     */
+    void renderTo(QByteArray& out, const Label& label) const;
+
+    Language language() const { return m_language; }
+
+    /**
+     * @brief "zpl" ou "escpos" (ZPL par défaut)
+     */
+    static Language languageFromString(const QString& name);
+
+private:
+    enum Field {
+        NUMERO,
+        DESTINATAIRE,
+        ADRESSE,
+        CODE_POSTAL_VILLE,
+        TELEPHONE,
+        DATE_LIVRAISON,
+        BARCODE,                        // Numéro préfixé de sa longueur (ESC/POS)
+        LITERAL = -1
+    };
+
+    struct Segment {
+        QByteArray literal;
+        int field;                      // Field, ou LITERAL
+    };
+
+    void compileZpl(const QByteArray& sender, const QByteArray& senderAddress);
+    void compileEscPos(const QByteArray& sender, const QByteArray& senderAddress);
+    void addLiteral(const QByteArray& bytes);
+    void addField(Field field);
+    QByteArray encode(const QString& text) const;
+
+private:
+    Language m_language;
+    QByteArray m_preamble;
+    QVector<Segment> m_segments;
+    int m_literalSize;
+};
+
+#endif // LABELENGINE_H
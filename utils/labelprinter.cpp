@@ -0,0 +1,207 @@
+#include "labelprinter.h"
+#include "batchdocumentjob.h"
+#include "database/databasemanager.h"
+#include "models/commande.h"
+#include <QSqlQuery>
+#include <QTcpSocket>
+#include <QFile>
+#include <QHash>
+#include <QRegularExpression>
+#include <QElapsedTimer>
+#include <QDebug>
+
+namespace {
+
+const int CONNECT_TIMEOUT_MS = 5000;
+const int WRITE_TIMEOUT_MS = 10000;
+
+} // namespace
+
+LabelPrinter::LabelPrinter(const LabelEngine& engine)
+    : m_engine(engine)
+{
+}
+
+LabelPrinter::~LabelPrinter()
+{
+    close();
+}
+
+bool LabelPrinter::open(const QString& target)
+{
+    close();
+    m_lastError.clear();
+
+    static const QRegularExpression hostPort("^([A-Za-z0-9.\\-]+):(\\d{1,5})$");
+    const QRegularExpressionMatch match = hostPort.match(target);
+
+    if (match.hasMatch()) {
+        auto socket = std::make_unique<QTcpSocket>();
+        socket->connectToHost(match.captured(1), match.captured(2).toUShort());
+        if (!socket->waitForConnected(CONNECT_TIMEOUT_MS)) {
+            m_lastError = QString("Connexion à %1 impossible: %2").arg(target, socket->errorString());
+            return false;
+        }
+        m_device = std::move(socket);
+    } else {
+        auto file = std::make_unique<QFile>(target);
+        if (!file->open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            m_lastError = QString("Ouverture de %1 impossible: %2").arg(target, file->errorString());
+            return false;
+        }
+        m_device = std::move(file);
+    }
+
+    return write(m_engine.preamble());
+}
+
+void LabelPrinter::close()
+{
+    if (!m_device) {
+        return;
+    }
+    if (auto* socket = qobject_cast<QTcpSocket*>(m_device.get())) {
+        socket->disconnectFromHost();
+        if (socket->state() != QAbstractSocket::UnconnectedState) {
+            socket->waitForDisconnected(WRITE_TIMEOUT_MS);
+        }
+    } else {
+        m_device->close();
+    }
+    m_device.reset();
+}
+
+bool LabelPrinter::print(const LabelEngine::Label& label)
+{
+    m_buffer.clear();
+    m_engine.renderTo(m_buffer, label);
+    return write(m_buffer);
+}
+
+bool LabelPrinter::print(const QList<LabelEngine::Label>& labels)
+{
+    m_buffer.clear();
+    for (const LabelEngine::Label& label : labels) {
+        m_engine.renderTo(m_buffer, label);
+    }
+    return write(m_buffer);
+}
+
+bool LabelPrinter::write(const QByteArray& bytes)
+{
+    if (!m_device) {
+        m_lastError = "Aucune cible d'impression ouverte";
+        return false;
+    }
+
+    if (m_device->write(bytes) != bytes.size()) {
+        m_lastError = "Écriture impossible: " + m_device->errorString();
+        return false;
+    }
+
+    // Socket : écriture synchrone, l'appelant n'a pas de boucle d'événements
+    if (auto* socket = qobject_cast<QTcpSocket*>(m_device.get())) {
+        while (socket->bytesToWrite() > 0) {
+            if (!socket->waitForBytesWritten(WRITE_TIMEOUT_MS)) {
+                m_lastError = "Envoi à l'imprimante interrompu: " + socket->errorString();
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool LabelPrinter::loadLabels(const QList<int>& idsCommande, QList<LabelEngine::Label>& labels,
+                              int* missing)
+{
+    QHash<int, LabelEngine::Label> loaded;
+    loaded.reserve(idsCommande.size());
+
+    const bool success = Commande::forEachWithClient(idsCommande, R"(
+            c.ID_COMMANDE, c.NUMERO_COMMANDE, cl.PRENOM, cl.NOM, c.ADRESSE_LIVRAISON,
+            c.CODE_POSTAL_LIVRAISON, c.VILLE_LIVRAISON, cl.TELEPHONE, c.DATE_LIVRAISON_PREVUE
+        )", [&loaded](const QSqlQuery& query) {
+        loaded.insert(query.value(0).toInt(),
+                      {query.value(1).toString(),
+                       query.value(2).toString() + " " + query.value(3).toString(),
+                       query.value(4).toString(),
+                       query.value(5).toString(),
+                       query.value(6).toString(),
+                       query.value(7).toString(),
+                       query.value(8).toDate()});
+    });
+
+    if (!success) {
+        qWarning() << "Étiquettes: lecture impossible:" << DatabaseManager::instance().lastError();
+        return false;
+    }
+
+    int notFound = 0;
+    labels.reserve(labels.size() + loaded.size());
+    for (int id : idsCommande) {
+        const auto it = loaded.constFind(id);
+        if (it == loaded.constEnd()) {
+            qWarning() << "Étiquettes: commande introuvable:" << id;
+            ++notFound;
+            continue;
+        }
+        labels.append(it.value());
+    }
+    if (missing) {
+        *missing = notFound;
+    }
+    return true;
+}
+
+int LabelPrinter::runFromArguments(const QStringList& arguments)
+{
+    const int index = arguments.indexOf("--labels");
+    const LabelEngine::Language language = LabelEngine::languageFromString(
+        index >= 0 && index + 1 < arguments.size() ? arguments.at(index + 1) : QString());
+
+    QString target = language == LabelEngine::ZPL ? "etiquettes.zpl" : "etiquettes.bin";
+    const int outputIndex = arguments.indexOf("--labels-output");
+    if (outputIndex >= 0 && outputIndex + 1 < arguments.size()) {
+        target = arguments.at(outputIndex + 1);
+    }
+
+    QList<LabelEngine::Label> labels;
+    int missing = 0;
+    if (!loadLabels(BatchDocumentJob::idsFromArguments(arguments), labels, &missing)) {
+        return -1;
+    }
+
+    const LabelEngine engine(language, "Société Logistique Tunisienne",
+                             "123 Avenue Habib Bourguiba, 1000 Tunis, Tunisie");
+
+    // Génération seule, mesurée hors écriture
+    QElapsedTimer timer;
+    timer.start();
+    QByteArray stream;
+    for (const LabelEngine::Label& label : labels) {
+        engine.renderTo(stream, label);
+    }
+    const qint64 renderNs = timer.nsecsElapsed();
+
+    LabelPrinter printer(engine);
+    timer.restart();
+    if (!printer.open(target) || !printer.write(stream)) {
+        qWarning().noquote() << "Étiquettes:" << printer.lastError();
+        return -1;
+    }
+    printer.close();
+    const qint64 writeMs = timer.elapsed();
+
+    qInfo().noquote() << QString("Étiquettes %1: %2 envoyées vers %3 (%4 octets)")
+                             .arg(language == LabelEngine::ZPL ? "ZPL" : "ESC/POS")
+                             .arg(labels.size()).arg(target).arg(stream.size());
+    qInfo().noquote() << QString("Génération %1 µs/étiquette, écriture %2 ms")
+                             .arg(labels.isEmpty() ? 0.0 : renderNs / 1000.0 / labels.size(), 0, 'f', 2)
+                             .arg(writeMs);
+
+    if (missing > 0) {
+        qWarning().noquote() << QString("Étiquettes: %1 commande(s) introuvable(s)").arg(missing);
+        return 2;
+    }
+    return 0;
+}
@@ -0,0 +1,81 @@
+#ifndef LABELPRINTER_H
+#define LABELPRINTER_H
+
+#include "labelengine.h"
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <memory>
+
+class QIODevice;
+
+/**
+ * @brief Envoi des étiquettes thermiques vers un fichier ou une imprimante réseau
+ *
+ * La cible est soit "hôte:port" (socket brute, port 9100 des imprimantes
+ * d'étiquettes), soit un chemin de fichier : un fichier ou un écouteur local
+ * (ex. `nc -l 9100`) peut ainsi capturer le flux exact envoyé à l'imprimante.
+ * Le préambule du moteur (format enregistré ZPL, initialisation ESC/POS) est
+ * envoyé une fois à l'ouverture.
+ *
+ * Mode ligne de commande : `LogisticsApp --labels zpl|escpos` avec
+ * --labels-output <cible> (etiquettes.zpl ou etiquettes.bin par défaut) et
+ * la sélection des commandes de --batch-pdf (--batch-ids ou --batch-date).
+ */
+class LabelPrinter
+{
+public:
+    explicit LabelPrinter(const LabelEngine& engine);
+    ~LabelPrinter();
+
+    /**
+     * @brief Ouvre la cible et envoie le préambule
+     * @param target "hôte:port" ou chemin de fichier
+     * @return true si la cible est prête
+     */
+    bool open(const QString& target);
+    void close();
+    bool isOpen() const { return m_device != nullptr; }
+
+    /**
+     * @brief Imprime une étiquette
+     */
+    bool print(const LabelEngine::Label& label);
+
+    /**
+     * @brief Imprime un lot d'étiquettes en une seule écriture
+     */
+    bool print(const QList<LabelEngine::Label>& labels);
+
+    QString lastError() const { return m_lastError; }
+
+    /**
+     * @brief Étiquettes des commandes, archivées comprises (Commande::forEachWithClient())
+     * @param idsCommande Commandes à étiqueter (ordre conservé)
+     * @param labels Reçoit les étiquettes
+     * @param missing Reçoit le nombre de commandes introuvables
+     * @return false en cas d'erreur de base de données
+     */
+    static bool loadLabels(const QList<int>& idsCommande, QList<LabelEngine::Label>& labels,
+                           int* missing = nullptr);
+
+    /**
+     * @brief Mode ligne de commande
+     * @param arguments Arguments de l'application
+     * @return Code de sortie : 0 si toutes les étiquettes ont été envoyées,
+     *         2 si des commandes sont introuvables (les autres sont envoyées),
+     *         -1 en cas d'erreur
+     */
+    static int runFromArguments(const QStringList& arguments);
+
+private:
+    bool write(const QByteArray& bytes);
+
+private:
+    const LabelEngine& m_engine;
+    std::unique_ptr<QIODevice> m_device;
+    QByteArray m_buffer;                // Réutilisé d'une étiquette à l'autre
+    QString m_lastError;
+};
+
+#endif // LABELPRINTER_H
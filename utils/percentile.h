@@ -0,0 +1,30 @@
+#ifndef PERCENTILE_H
+#define PERCENTILE_H
+
+#include <QList>
+#include <algorithm>
+
+/**
+ * @brief Percentile d'une série de mesures (rang le plus proche)
+ *
+ * Sélection partielle par std::nth_element, en O(n) : la série est reçue
+ * par copie et réordonnée sans toucher à celle de l'appelant.
+ *
+ * @param samples Mesures (latences, durées, allocations)
+ * @param percentile Valeur entre 0 et 100 (ex. 50, 95, 99)
+ * @return Valeur au percentile demandé, T() si la série est vide
+ */
+template <typename T>
+T percentileOf(QList<T> samples, double percentile)
+{
+    if (samples.isEmpty()) {
+        return T();
+    }
+
+    const int rank = std::clamp(static_cast<int>(percentile / 100.0 * (samples.size() - 1) + 0.5),
+                                0, static_cast<int>(samples.size()) - 1);
+    std::nth_element(samples.begin(), samples.begin() + rank, samples.end());
+    return samples.at(rank);
+}
+
+#endif // PERCENTILE_H
@@ -1,14 +1,23 @@
 #include "printmanager.h"
 #include "models/commande.h"
 #include "models/client.h"
+#include "texttemplate.h"
+#include "labelprinter.h"
+#include "barcode.h"
+#include "database/databasemanager.h"
+#include "database/archivemanager.h"
 #include <QApplication>
 #include <QTextDocument>
 #include <QPrinter>
 #include <QPrintDialog>
 #include <QPrintPreviewDialog>
 #include <QFileDialog>
+#include <QPdfWriter>
+#include <QSqlQuery>
 #include <QMessageBox>
 #include <QDateTime>
+#include <QElapsedTimer>
+#include <QUrl>
 #include <QDebug>
 
 PrintManager::PrintManager(QObject *parent)
@@ -16,6 +25,8 @@ PrintManager::PrintManager(QObject *parent)
     , m_printer(new QPrinter(QPrinter::HighResolution))
     , m_document(new QTextDocument(this))
     , m_currentDocumentType(BON_COMMANDE)
+    , m_lastReportRows(0)
+    , m_lastReportPages(0)
 {
     setupPrinter();
     
@@ -51,6 +62,8 @@ void PrintManager::setCompanyInfo(const QString& name, const QString& address,
     m_companyAddress = address;
     m_companyPhone = phone;
     m_companyEmail = email;
+    m_labelPrinter.reset();
+    m_labelEngine.reset();
 }
 
 bool PrintManager::printBonCommande(const Commande* commande, const Client* client, bool showPreview)
@@ -87,18 +100,130 @@ bool PrintManager::printEtiquetteLivraison(const Commande* commande, const Clien
     return printDocument(html, showPreview);
 }
 
+bool PrintManager::printEtiquetteThermique(const Commande* commande, const Client* client,
+                                           const QString& target, LabelEngine::Language language)
+{
+    if (!commande || !client) {
+        return false;
+    }
+
+    // L'expéditeur fait partie de la mise en page compilée ; la session
+    // référence le moteur et le précède donc dans la destruction
+    if (!m_labelEngine || m_labelEngine->language() != language) {
+        m_labelPrinter.reset();
+        m_labelEngine = std::make_unique<LabelEngine>(language, m_companyName, m_companyAddress);
+    }
+    if (!m_labelPrinter || m_labelTarget != target) {
+        m_labelPrinter = std::make_unique<LabelPrinter>(*m_labelEngine);
+        m_labelTarget = target;
+    }
+
+    emit printStarted(ETIQUETTE_LIVRAISON);
+
+    LabelEngine::Label label;
+    label.numeroCommande = commande->numeroCommande();
+    label.destinataire = client->prenom() + " " + client->nom();
+    label.adresse = commande->adresseLivraison();
+    label.codePostal = commande->codePostalLivraison();
+    label.ville = commande->villeLivraison();
+    label.telephone = client->telephone();
+    label.dateLivraisonPrevue = commande->dateLivraisonPrevue();
+
+    const bool reused = m_labelPrinter->isOpen();
+    bool success = (reused || m_labelPrinter->open(target)) && m_labelPrinter->print(label);
+
+    // Session rompue (imprimante redémarrée, socket fermée) : une seule réouverture
+    if (!success && reused) {
+        success = m_labelPrinter->open(target) && m_labelPrinter->print(label);
+    }
+    if (!success) {
+        qWarning() << "PrintManager:" << m_labelPrinter->lastError();
+        m_labelPrinter->close();
+    }
+
+    emit printCompleted(ETIQUETTE_LIVRAISON, success);
+    return success;
+}
+
 bool PrintManager::printRapportCommandes(const QList<Commande*>& commandes, bool showPreview)
 {
     m_currentDocumentType = RAPPORT_COMMANDES;
-    QString html = generateRapportCommandesHtml(commandes);
-    return printDocument(html, showPreview);
+    return printReport([this, commandes](QPagedPaintDevice* device) {
+        return renderRapportCommandes(device, commandes);
+    }, showPreview);
+}
+
+bool PrintManager::printRapportCommandes(const QDate& debut, const QDate& fin, bool showPreview)
+{
+    m_currentDocumentType = RAPPORT_COMMANDES;
+    return printReport([this, debut, fin](QPagedPaintDevice* device) {
+        return renderRapportCommandes(device, debut, fin);
+    }, showPreview);
 }
 
 bool PrintManager::printListeClients(const QList<Client*>& clients, bool showPreview)
 {
     m_currentDocumentType = LISTE_CLIENTS;
-    QString html = generateListeClientsHtml(clients);
-    return printDocument(html, showPreview);
+    return printReport([this, clients](QPagedPaintDevice* device) {
+        return renderListeClients(device, clients);
+    }, showPreview);
+}
+
+bool PrintManager::printListeClients(bool showPreview)
+{
+    m_currentDocumentType = LISTE_CLIENTS;
+    return printReport([this](QPagedPaintDevice* device) {
+        return renderListeClients(device);
+    }, showPreview);
+}
+
+bool PrintManager::saveRapportCommandesPdf(const QString& fileName, const QDate& debut, const QDate& fin)
+{
+    QPdfWriter writer(fileName);
+    setupPdfWriter(writer);
+    return renderRapportCommandes(&writer, debut, fin);
+}
+
+bool PrintManager::saveListeClientsPdf(const QString& fileName)
+{
+    QPdfWriter writer(fileName);
+    setupPdfWriter(writer);
+    return renderListeClients(&writer);
+}
+
+int PrintManager::runReportFromArguments(const QStringList& arguments)
+{
+    const auto option = [&arguments](const QString& name) {
+        const int index = arguments.indexOf(name);
+        return index >= 0 && index + 1 < arguments.size() ? arguments.at(index + 1) : QString();
+    };
+
+    const QString kind = option("--report");
+    if (kind != "commandes" && kind != "clients") {
+        qWarning() << "Rapport: type attendu commandes ou clients, reçu" << kind;
+        return -1;
+    }
+    QString fileName = option("--report-output");
+    if (fileName.isEmpty()) {
+        fileName = QString("rapport-%1.pdf").arg(kind);
+    }
+
+    PrintManager printManager;
+    QElapsedTimer timer;
+    timer.start();
+    const bool success = kind == "commandes"
+        ? printManager.saveRapportCommandesPdf(fileName,
+                                               QDate::fromString(option("--report-from"), Qt::ISODate),
+                                               QDate::fromString(option("--report-to"), Qt::ISODate))
+        : printManager.saveListeClientsPdf(fileName);
+    if (!success) {
+        return -1;
+    }
+
+    qInfo().noquote() << QString("Rapport %1: %2 lignes, %3 pages vers %4 en %5 ms")
+                             .arg(kind).arg(printManager.lastReportRows()).arg(printManager.lastReportPages())
+                             .arg(fileName).arg(timer.elapsed());
+    return 0;
 }
 
 bool PrintManager::saveToPdf(const QString& fileName, DocumentType type, const QVariant& data)
@@ -119,14 +244,14 @@ bool PrintManager::saveToPdf(const QString& fileName, DocumentType type, const Q
             break;
         }
         case RAPPORT_COMMANDES: {
-            QList<Commande*> commandes = data.value<QList<Commande*>>();
-            html = generateRapportCommandesHtml(commandes);
-            break;
+            QPdfWriter writer(fileName);
+            setupPdfWriter(writer);
+            return renderRapportCommandes(&writer, data.value<QList<Commande*>>());
         }
         case LISTE_CLIENTS: {
-            QList<Client*> clients = data.value<QList<Client*>>();
-            html = generateListeClientsHtml(clients);
-            break;
+            QPdfWriter writer(fileName);
+            setupPdfWriter(writer);
+            return renderListeClients(&writer, data.value<QList<Client*>>());
         }
         default:
             return false;
@@ -139,7 +264,7 @@ bool PrintManager::saveToPdf(const QString& fileName, DocumentType type, const Q
     m_printer->setOutputFormat(QPrinter::PdfFormat);
     m_printer->setOutputFileName(fileName);
     
-    m_document->setHtml(html);
+    setDocumentHtml(html);
     m_document->print(m_printer);
 
     return true;
@@ -152,6 +277,7 @@ bool PrintManager::printDocument(const QString& html, bool showPreview)
     }
 
     m_currentHtml = html;
+    m_currentReport = nullptr;
     emit printStarted(m_currentDocumentType);
 
     if (showPreview) {
@@ -180,21 +306,260 @@ bool PrintManager::printDocument(const QString& html, bool showPreview)
     }
 }
 
+bool PrintManager::printReport(const std::function<bool(QPagedPaintDevice*)>& render, bool showPreview)
+{
+    m_currentHtml.clear();
+    m_currentReport = render;
+    emit printStarted(m_currentDocumentType);
+
+    if (showPreview) {
+        QPrintPreviewDialog preview(m_printer);
+        connect(&preview, &QPrintPreviewDialog::paintRequested,
+                this, &PrintManager::onPreviewPaintRequested);
+
+        if (preview.exec() == QDialog::Accepted) {
+            emit printCompleted(m_currentDocumentType, true);
+            return true;
+        }
+        emit printCancelled(m_currentDocumentType);
+        return false;
+    }
+
+    QPrintDialog printDialog(m_printer);
+    if (printDialog.exec() != QDialog::Accepted) {
+        emit printCancelled(m_currentDocumentType);
+        return false;
+    }
+
+    const bool success = render(m_printer);
+    emit printCompleted(m_currentDocumentType, success);
+    return success;
+}
+
+void PrintManager::setDocumentHtml(const QString& html)
+{
+    m_document->setHtml(html);
+
+    // Les codes-barres référencés par <img src="barcode:..."> sont fournis comme ressources
+    static const QString scheme = "barcode:";
+    int from = 0;
+    while ((from = html.indexOf(scheme, from)) >= 0) {
+        from += scheme.size();
+        const int end = html.indexOf('"', from);
+        if (end < 0) {
+            break;
+        }
+        const QString data = html.mid(from, end - from);
+        m_document->addResource(QTextDocument::ImageResource, QUrl(scheme + data), Barcode::code128Image(data));
+        from = end;
+    }
+}
+
 void PrintManager::onPrintRequested(QPrinter* printer)
 {
-    m_document->setHtml(m_currentHtml);
+    if (m_currentReport) {
+        m_currentReport(printer);
+        return;
+    }
+    setDocumentHtml(m_currentHtml);
     m_document->print(printer);
 }
 
 void PrintManager::onPreviewPaintRequested(QPrinter* printer)
 {
-    m_document->setHtml(m_currentHtml);
-    m_document->print(printer);
+    onPrintRequested(printer);
+}
+
+void PrintManager::setupPdfWriter(QPdfWriter& writer)
+{
+    writer.setPageLayout(m_printer->pageLayout());
+    writer.setResolution(300);
+    writer.setCreator(m_companyName);
+}
+
+void PrintManager::setupReport(ReportRenderer& renderer, const QString& title, const QStringList& summary,
+                               const QList<ReportRenderer::Column>& columns)
+{
+    renderer.setCompanyInfo(m_companyName, m_companyAddress, m_companyPhone, m_companyEmail);
+    renderer.setTitle(title);
+    renderer.setSummary(summary);
+    renderer.setColumns(columns);
+}
+
+QList<ReportRenderer::Column> PrintManager::commandeColumns()
+{
+    return {{"N° Commande", 3, Qt::AlignLeft},
+            {"Date", 2, Qt::AlignLeft},
+            {"Client", 4, Qt::AlignLeft},
+            {"Statut", 3, Qt::AlignLeft},
+            {"Montant (TND)", 2, Qt::AlignRight}};
+}
+
+QList<ReportRenderer::Column> PrintManager::clientColumns()
+{
+    return {{"ID", 1, Qt::AlignRight},
+            {"Nom", 3, Qt::AlignLeft},
+            {"Prénom", 3, Qt::AlignLeft},
+            {"Ville", 3, Qt::AlignLeft},
+            {"Téléphone", 3, Qt::AlignLeft},
+            {"Email", 5, Qt::AlignLeft}};
+}
+
+QString PrintManager::statutLabel(int statut)
+{
+    switch (statut) {
+        case Commande::EN_ATTENTE: return "En attente";
+        case Commande::CONFIRMEE: return "Confirmée";
+        case Commande::EN_PREPARATION: return "En préparation";
+        case Commande::EN_TRANSIT: return "En transit";
+        case Commande::LIVREE: return "Livrée";
+        case Commande::ANNULEE: return "Annulée";
+    }
+    return QString();
+}
+
+bool PrintManager::renderRapportCommandes(QPagedPaintDevice* device, const QList<Commande*>& commandes)
+{
+    double totalCA = 0;
+    for (const Commande* commande : commandes) {
+        totalCA += commande->prixTotal();
+    }
+
+    ReportRenderer renderer;
+    setupReport(renderer, "RAPPORT DES COMMANDES",
+                {QString("Nombre total de commandes: %1").arg(commandes.size()),
+                 QString("Chiffre d'affaires total: %1 TND").arg(QString::number(totalCA, 'f', 3))},
+                commandeColumns());
+
+    int index = 0;
+    return renderer.render(device, [&commandes, &index](QStringList& cells) {
+        if (index >= commandes.size()) {
+            return false;
+        }
+        const Commande* commande = commandes.at(index++);
+        cells << commande->numeroCommande()
+              << commande->dateCommande().toString("dd/MM/yyyy")
+              << QString("Client %1").arg(commande->idClient())
+              << statutLabel(commande->statut())
+              << QString::number(commande->prixTotal(), 'f', 3);
+        return true;
+    });
+}
+
+bool PrintManager::renderRapportCommandes(QPagedPaintDevice* device, const QDate& debut, const QDate& fin)
+{
+    DatabaseManager& db = DatabaseManager::instance();
+
+    // Période optionnelle, liée en paramètres comme dans Commande::search
+    QString where;
+    QVariantList params;
+    if (debut.isValid()) {
+        where = "c.DATE_COMMANDE >= ?";
+        params << debut;
+    }
+    if (fin.isValid()) {
+        where += QString(where.isEmpty() ? "" : " AND ") + "c.DATE_COMMANDE < ?";
+        params << fin.addDays(1);
+    }
+    const bool withArchive = ArchiveManager::includesArchive(debut);
+
+    // Résumé calculé en base : une ligne par table interrogée
+    int total = 0;
+    double totalCA = 0;
+    QStringList tables = {"COMMANDES"};
+    if (withArchive) {
+        tables.prepend("COMMANDES_ARCHIVE");
+    }
+    for (const QString& table : tables) {
+        QSqlQuery summary = db.prepareQuery(QString("SELECT COUNT(*), SUM(c.PRIX_TOTAL) FROM %1 c%2")
+                                                .arg(table, where.isEmpty() ? QString() : " WHERE " + where));
+        if (!db.executeQuery(summary, params) || !summary.next()) {
+            qWarning() << "PrintManager: résumé du rapport impossible:" << db.lastError();
+            return false;
+        }
+        total += summary.value(0).toInt();
+        totalCA += summary.value(1).toDouble();
+    }
+
+    ReportRenderer renderer;
+    QStringList lines;
+    if (debut.isValid() || fin.isValid()) {
+        lines << QString("Période: %1 - %2").arg(debut.isValid() ? debut.toString("dd/MM/yyyy") : "...",
+                                                 fin.isValid() ? fin.toString("dd/MM/yyyy") : "...");
+    }
+    lines << QString("Nombre total de commandes: %1").arg(total)
+          << QString("Chiffre d'affaires total: %1 TND").arg(QString::number(totalCA, 'f', 3));
+    setupReport(renderer, "RAPPORT DES COMMANDES", lines, commandeColumns());
+
+    const ReportRenderer::RowFormatter format = [](const QSqlQuery& query, QStringList& cells) {
+        cells << query.value(1).toString()
+              << query.value(2).toDate().toString("dd/MM/yyyy")
+              << query.value(3).toString() + ' ' + query.value(4).toString()
+              << statutLabel(Commande::stringToStatut(query.value(5).toString()))
+              << QString::number(query.value(6).toDouble(), 'f', 3);
+    };
+
+    QString error;
+    QList<ReportRenderer::RowSource> sources;
+    for (const QString& table : tables) {
+        const QString select = QString(R"(
+            SELECT c.ID_COMMANDE, c.NUMERO_COMMANDE, c.DATE_COMMANDE, cl.NOM, cl.PRENOM, c.STATUT, c.PRIX_TOTAL
+            FROM %1 c LEFT JOIN CLIENTS cl ON cl.ID_CLIENT = c.ID_CLIENT
+        )").arg(table);
+        sources << ReportRenderer::chunkedQuery(select, where, params, "c.ID_COMMANDE", format, 500, &error);
+    }
+
+    const bool success = renderer.render(device, ReportRenderer::concat(sources)) && error.isEmpty();
+    m_lastReportRows = renderer.rowCount();
+    m_lastReportPages = renderer.pageCount();
+    if (!success) {
+        qWarning() << "PrintManager: rendu du rapport impossible:" << (error.isEmpty() ? renderer.lastError() : error);
+    }
+    return success;
+}
+
+bool PrintManager::renderListeClients(QPagedPaintDevice* device, const QList<Client*>& clients)
+{
+    ReportRenderer renderer;
+    setupReport(renderer, "LISTE DES CLIENTS", {QString("Total: %1 clients").arg(clients.size())}, clientColumns());
+
+    int index = 0;
+    return renderer.render(device, [&clients, &index](QStringList& cells) {
+        if (index >= clients.size()) {
+            return false;
+        }
+        const Client* client = clients.at(index++);
+        cells << QString::number(client->id()) << client->nom() << client->prenom()
+              << client->ville() << client->telephone() << client->email();
+        return true;
+    });
+}
+
+bool PrintManager::renderListeClients(QPagedPaintDevice* device)
+{
+    ReportRenderer renderer;
+    setupReport(renderer, "LISTE DES CLIENTS", {QString("Total: %1 clients").arg(Client::count())}, clientColumns());
+
+    QString error;
+    const ReportRenderer::RowSource source = ReportRenderer::chunkedQuery(
+        "SELECT ID_CLIENT, NOM, PRENOM, VILLE, TELEPHONE, EMAIL FROM CLIENTS", QString(), QVariantList(),
+        "ID_CLIENT", [](const QSqlQuery& query, QStringList& cells) {
+            cells << query.value(0).toString() << query.value(1).toString() << query.value(2).toString()
+                  << query.value(3).toString() << query.value(4).toString() << query.value(5).toString();
+        }, 500, &error);
+
+    const bool success = renderer.render(device, source) && error.isEmpty();
+    m_lastReportRows = renderer.rowCount();
+    m_lastReportPages = renderer.pageCount();
+    if (!success) {
+        qWarning() << "PrintManager: rendu de la liste impossible:" << (error.isEmpty() ? renderer.lastError() : error);
+    }
+    return success;
 }
 
 QString PrintManager::generateBonCommandeHtml(const Commande* commande, const Client* client)
 {
-    QString html = R"(
+    static const TextTemplate html(R"(
 <!DOCTYPE html>
 <html>
 <head>
@@ -206,6 +571,7 @@ QString PrintManager::generateBonCommandeHtml(const Commande* commande, const Cl
     <div class="document-title">
         <h1>BON DE COMMANDE</h1>
         <p>N° %3</p>
+        <p><img src="barcode:%3" height="50"></p>
     </div>
 
     <div class="client-info">
@@ -224,19 +590,19 @@ QString PrintManager::generateBonCommandeHtml(const Commande* commande, const Cl
     </div>
 </body>
 </html>
-    )";
-
-    return html.arg(getDocumentStyles())
-              .arg(formatCompanyHeader())
-              .arg(commande->numeroCommande())
-              .arg(formatClientInfo(client))
-              .arg(formatCommandeTable(commande))
-              .arg(QDateTime::currentDateTime().toString("dd/MM/yyyy hh:mm"));
+    )");
+
+    return html.render({getDocumentStyles(),
+                        formatCompanyHeader(),
+                        commande->numeroCommande(),
+                        formatClientInfo(client),
+                        formatCommandeTable(commande),
+                        QDateTime::currentDateTime().toString("dd/MM/yyyy hh:mm")});
 }
 
 QString PrintManager::generateFactureHtml(const Commande* commande, const Client* client)
 {
-    QString html = R"(
+    static const TextTemplate html(R"(
 <!DOCTYPE html>
 <html>
 <head>
@@ -248,6 +614,7 @@ QString PrintManager::generateFactureHtml(const Commande* commande, const Client
     <div class="document-title">
         <h1>FACTURE</h1>
         <p>N° FAC-%3</p>
+        <p><img src="barcode:%3" height="50"></p>
     </div>
 
     <div class="client-info">
@@ -283,25 +650,25 @@ QString PrintManager::generateFactureHtml(const Commande* commande, const Client
     </div>
 </body>
 </html>
-    )";
+    )");
 
     double sousTotal = commande->prixTotal() / 1.19; // Prix HT
     double tva = commande->prixTotal() - sousTotal;
 
-    return html.arg(getDocumentStyles())
-              .arg(formatCompanyHeader())
-              .arg(commande->numeroCommande())
-              .arg(formatClientInfo(client))
-              .arg(formatCommandeTable(commande))
-              .arg(QString::number(sousTotal, 'f', 3))
-              .arg(QString::number(tva, 'f', 3))
-              .arg(QString::number(commande->prixTotal(), 'f', 3))
-              .arg(QDateTime::currentDateTime().toString("dd/MM/yyyy hh:mm"));
+    return html.render({getDocumentStyles(),
+                        formatCompanyHeader(),
+                        commande->numeroCommande(),
+                        formatClientInfo(client),
+                        formatCommandeTable(commande),
+                        QString::number(sousTotal, 'f', 3),
+                        QString::number(tva, 'f', 3),
+                        QString::number(commande->prixTotal(), 'f', 3),
+                        QDateTime::currentDateTime().toString("dd/MM/yyyy hh:mm")});
 }
 
 QString PrintManager::generateEtiquetteLivraisonHtml(const Commande* commande, const Client* client)
 {
-    QString html = R"(
+    static const TextTemplate html(R"(
 <!DOCTYPE html>
 <html>
 <head>
@@ -344,178 +711,24 @@ QString PrintManager::generateEtiquetteLivraisonHtml(const Commande* commande, c
         </div>
 
         <div class="barcode">
-            |||| | || ||| | || ||||
+            <img src="barcode:%1" height="60"><br>
             %1
         </div>
     </div>
 </body>
 </html>
-    )";
-
-    return html.arg(commande->numeroCommande())
-              .arg(client->prenom())
-              .arg(client->nom())
-              .arg(commande->adresseLivraison())
-              .arg(commande->codePostalLivraison())
-              .arg(commande->villeLivraison())
-              .arg(client->telephone())
-              .arg(m_companyName)
-              .arg(m_companyAddress)
-              .arg(commande->dateLivraisonPrevue().toString("dd/MM/yyyy"));
-}
-
-QString PrintManager::generateRapportCommandesHtml(const QList<Commande*>& commandes)
-{
-    QString html = R"(
-<!DOCTYPE html>
-<html>
-<head>
-    <meta charset="UTF-8">
-    %1
-</head>
-<body>
-    %2
-    <div class="document-title">
-        <h1>RAPPORT DES COMMANDES</h1>
-        <p>Période: %3</p>
-    </div>
-
-    <div class="summary">
-        <h3>Résumé</h3>
-        <p>Nombre total de commandes: <strong>%4</strong></p>
-        <p>Chiffre d'affaires total: <strong>%5 TND</strong></p>
-    </div>
-
-    <div class="commandes-list">
-        <h3>Liste des Commandes</h3>
-        <table class="data-table">
-            <thead>
-                <tr>
-                    <th>N° Commande</th>
-                    <th>Date</th>
-                    <th>Client</th>
-                    <th>Statut</th>
-                    <th>Montant (TND)</th>
-                </tr>
-            </thead>
-            <tbody>
-                %6
-            </tbody>
-        </table>
-    </div>
-
-    <div class="footer">
-        <p>Rapport généré le %7</p>
-    </div>
-</body>
-</html>
-    )";
-
-    // Calcul du résumé
-    double totalCA = 0;
-    QString commandesRows;
-
-    for (const Commande* commande : commandes) {
-        totalCA += commande->prixTotal();
-
-        QString statutText;
-        switch (commande->statut()) {
-            case Commande::EN_ATTENTE: statutText = "En attente"; break;
-            case Commande::EN_PREPARATION: statutText = "En préparation"; break;
-            case Commande::EXPEDIE: statutText = "Expédiée"; break;
-            case Commande::LIVREE: statutText = "Livrée"; break;
-            case Commande::ANNULEE: statutText = "Annulée"; break;
-        }
-
-        commandesRows += QString(R"(
-            <tr>
-                <td>%1</td>
-                <td>%2</td>
-                <td>Client %3</td>
-                <td>%4</td>
-                <td>%5</td>
-            </tr>
-        )").arg(commande->numeroCommande())
-           .arg(commande->dateCommande().toString("dd/MM/yyyy"))
-           .arg(commande->idClient())
-           .arg(statutText)
-           .arg(QString::number(commande->prixTotal(), 'f', 3));
-    }
-
-    return html.arg(getDocumentStyles())
-              .arg(formatCompanyHeader())
-              .arg(QDate::currentDate().toString("dd/MM/yyyy"))
-              .arg(commandes.size())
-              .arg(QString::number(totalCA, 'f', 3))
-              .arg(commandesRows)
-              .arg(QDateTime::currentDateTime().toString("dd/MM/yyyy hh:mm"));
-}
-
-QString PrintManager::generateListeClientsHtml(const QList<Client*>& clients)
-{
-    QString html = R"(
-<!DOCTYPE html>
-<html>
-<head>
-    <meta charset="UTF-8">
-    %1
-</head>
-<body>
-    %2
-    <div class="document-title">
-        <h1>LISTE DES CLIENTS</h1>
-        <p>Total: %3 clients</p>
-    </div>
-
-    <div class="clients-list">
-        <table class="data-table">
-            <thead>
-                <tr>
-                    <th>ID</th>
-                    <th>Nom</th>
-                    <th>Prénom</th>
-                    <th>Ville</th>
-                    <th>Téléphone</th>
-                    <th>Email</th>
-                </tr>
-            </thead>
-            <tbody>
-                %4
-            </tbody>
-        </table>
-    </div>
-
-    <div class="footer">
-        <p>Liste générée le %5</p>
-    </div>
-</body>
-</html>
-    )";
-
-    QString clientsRows;
-    for (const Client* client : clients) {
-        clientsRows += QString(R"(
-            <tr>
-                <td>%1</td>
-                <td>%2</td>
-                <td>%3</td>
-                <td>%4</td>
-                <td>%5</td>
-                <td>%6</td>
-            </tr>
-        )").arg(client->id())
-           .arg(client->nom())
-           .arg(client->prenom())
-           .arg(client->ville())
-           .arg(client->telephone())
-           .arg(client->email());
-    }
-
-    return html.arg(getDocumentStyles())
-              .arg(formatCompanyHeader())
-              .arg(clients.size())
-              .arg(clientsRows)
-              .arg(QDateTime::currentDateTime().toString("dd/MM/yyyy hh:mm"));
+    )");
+
+    return html.render({commande->numeroCommande(),
+                        client->prenom(),
+                        client->nom(),
+                        commande->adresseLivraison(),
+                        commande->codePostalLivraison(),
+                        commande->villeLivraison(),
+                        client->telephone(),
+                        m_companyName,
+                        m_companyAddress,
+                        commande->dateLivraisonPrevue().toString("dd/MM/yyyy")});
 }
 
 QString PrintManager::formatCommandeTable(const Commande* commande)
@@ -531,13 +744,14 @@ QString PrintManager::formatCommandeTable(const Commande* commande)
     QString statut;
     switch (commande->statut()) {
         case Commande::EN_ATTENTE: statut = "En attente"; break;
+        case Commande::CONFIRMEE: statut = "Confirmée"; break;
         case Commande::EN_PREPARATION: statut = "En préparation"; break;
-        case Commande::EXPEDIE: statut = "Expédiée"; break;
+        case Commande::EN_TRANSIT: statut = "En transit"; break;
         case Commande::LIVREE: statut = "Livrée"; break;
         case Commande::ANNULEE: statut = "Annulée"; break;
     }
 
-    return QString(R"(
+    static const TextTemplate table(R"(
         <table class="info-table">
             <tr>
                 <td><strong>Date de commande:</strong></td>
@@ -572,21 +786,23 @@ QString PrintManager::formatCommandeTable(const Commande* commande)
                 <td><strong>%10 TND</strong></td>
             </tr>
         </table>
-    )").arg(commande->dateCommande().toString("dd/MM/yyyy"))
-       .arg(commande->dateLivraisonPrevue().toString("dd/MM/yyyy"))
-       .arg(commande->adresseLivraison())
-       .arg(commande->codePostalLivraison())
-       .arg(commande->villeLivraison())
-       .arg(priorite)
-       .arg(statut)
-       .arg(QString::number(commande->poidsTotal(), 'f', 2))
-       .arg(QString::number(commande->volumeTotal(), 'f', 2))
-       .arg(QString::number(commande->prixTotal(), 'f', 3));
+    )");
+
+    return table.render({commande->dateCommande().toString("dd/MM/yyyy"),
+                         commande->dateLivraisonPrevue().toString("dd/MM/yyyy"),
+                         commande->adresseLivraison(),
+                         commande->codePostalLivraison(),
+                         commande->villeLivraison(),
+                         priorite,
+                         statut,
+                         QString::number(commande->poidsTotal(), 'f', 2),
+                         QString::number(commande->volumeTotal(), 'f', 2),
+                         QString::number(commande->prixTotal(), 'f', 3)});
 }
 
 QString PrintManager::formatClientInfo(const Client* client)
 {
-    return QString(R"(
+    static const TextTemplate info(R"(
         <div class="client-details">
             <p><strong>%1 %2</strong></p>
             <p>%3</p>
@@ -594,27 +810,31 @@ QString PrintManager::formatClientInfo(const Client* client)
             <p>Tél: %6</p>
             <p>Email: %7</p>
         </div>
-    )").arg(client->prenom())
-       .arg(client->nom())
-       .arg(client->adresse())
-       .arg(client->codePostal())
-       .arg(client->ville())
-       .arg(client->telephone())
-       .arg(client->email());
+    )");
+
+    return info.render({client->prenom(),
+                        client->nom(),
+                        client->adresse(),
+                        client->codePostal(),
+                        client->ville(),
+                        client->telephone(),
+                        client->email()});
 }
 
 QString PrintManager::formatCompanyHeader()
 {
-    return QString(R"(
+    static const TextTemplate header(R"(
         <div class="company-header">
             <h2>%1</h2>
             <p>%2</p>
             <p>Tél: %3 | Email: %4</p>
         </div>
-    )").arg(m_companyName)
-       .arg(m_companyAddress)
-       .arg(m_companyPhone)
-       .arg(m_companyEmail);
+    )");
+
+    return header.render({m_companyName,
+                          m_companyAddress,
+                          m_companyPhone,
+                          m_companyEmail});
 }
 
 QString PrintManager::getDocumentStyles()
@@ -8,6 +8,14 @@
 #include <QPrintDialog>
 #include <QPrintPreviewDialog>
 #include <QPagedPaintDevice>
+#include <QDate>
+#include <functional>
+#include <memory>
+#include "reportrenderer.h"
+#include "labelengine.h"
+
+class QPdfWriter;
+class LabelPrinter;
 
 class Commande;
 class Client;
@@ -39,12 +47,49 @@ public:
     bool printFacture(const Commande* commande, const Client* client, bool showPreview = true);
     bool printEtiquetteLivraison(const Commande* commande, const Client* client, bool showPreview = true);
 
-    // Impression de rapports
+    /**
+     * @brief Étiquette de livraison envoyée directement à une imprimante thermique
+     *
+     * La session (socket ou fichier, préambule envoyé) reste ouverte d'une
+     * étiquette à l'autre pour une même cible ; elle n'est rouverte qu'après
+     * une erreur.
+     * @param target "hôte:port" de l'imprimante, ou fichier de capture
+     * @param language Langage de l'imprimante
+     */
+    bool printEtiquetteThermique(const Commande* commande, const Client* client, const QString& target,
+                                 LabelEngine::Language language = LabelEngine::ZPL);
+
+    // Impression de rapports (rendu paginé au QPainter)
     bool printRapportCommandes(const QList<Commande*>& commandes, bool showPreview = true);
     bool printListeClients(const QList<Client*>& clients, bool showPreview = true);
 
+    /**
+     * @brief Rapport des commandes lu en base par tranches (volumes importants)
+     * @param debut Début de période sur la date de commande (invalide : pas de borne)
+     * @param fin Fin de période incluse (invalide : pas de borne)
+     */
+    bool printRapportCommandes(const QDate& debut, const QDate& fin, bool showPreview = true);
+    bool printListeClients(bool showPreview);
+
     // Sauvegarde en PDF
     bool saveToPdf(const QString& fileName, DocumentType type, const QVariant& data);
+    bool saveRapportCommandesPdf(const QString& fileName, const QDate& debut = QDate(), const QDate& fin = QDate());
+    bool saveListeClientsPdf(const QString& fileName);
+
+    /**
+     * @brief Lignes et pages du dernier rapport lu en base
+     */
+    int lastReportRows() const { return m_lastReportRows; }
+    int lastReportPages() const { return m_lastReportPages; }
+
+    /**
+     * @brief Mode ligne de commande : `LogisticsApp --report commandes|clients`
+     *        avec --report-output <fichier.pdf>, --report-from et --report-to
+     *        (aaaa-mm-jj, rapport des commandes uniquement)
+     * @param arguments Arguments de l'application
+     * @return Code de sortie
+     */
+    static int runReportFromArguments(const QStringList& arguments);
 
     // Configuration d'impression
     void configurePrinter(QPrinter::PageSize pageSize = QPrinter::A4, 
@@ -66,8 +111,17 @@ private:
     QString generateBonCommandeHtml(const Commande* commande, const Client* client);
     QString generateFactureHtml(const Commande* commande, const Client* client);
     QString generateEtiquetteLivraisonHtml(const Commande* commande, const Client* client);
-    QString generateRapportCommandesHtml(const QList<Commande*>& commandes);
-    QString generateListeClientsHtml(const QList<Client*>& clients);
+
+    // Rapports tabulaires : liste en mémoire ou lecture en base par tranches
+    bool renderRapportCommandes(QPagedPaintDevice* device, const QList<Commande*>& commandes);
+    bool renderRapportCommandes(QPagedPaintDevice* device, const QDate& debut, const QDate& fin);
+    bool renderListeClients(QPagedPaintDevice* device, const QList<Client*>& clients);
+    bool renderListeClients(QPagedPaintDevice* device);
+    void setupReport(ReportRenderer& renderer, const QString& title, const QStringList& summary,
+                     const QList<ReportRenderer::Column>& columns);
+    static QList<ReportRenderer::Column> commandeColumns();
+    static QList<ReportRenderer::Column> clientColumns();
+    static QString statutLabel(int statut);
 
     // Utilitaires de formatage
     QString formatCommandeTable(const Commande* commande);
@@ -77,13 +131,22 @@ private:
 
     // Impression
     bool printDocument(const QString& html, bool showPreview = true);
+    void setDocumentHtml(const QString& html);
+    bool printReport(const std::function<bool(QPagedPaintDevice*)>& render, bool showPreview = true);
     void setupPrinter();
+    void setupPdfWriter(QPdfWriter& writer);
 
     // Configuration
     QPrinter* m_printer;
     QTextDocument* m_document;
     DocumentType m_currentDocumentType;
     QString m_currentHtml;
+    std::function<bool(QPagedPaintDevice*)> m_currentReport;
+    std::unique_ptr<LabelEngine> m_labelEngine;     // Compilé au premier usage
+    std::unique_ptr<LabelPrinter> m_labelPrinter;   // Session ouverte vers m_labelTarget
+    QString m_labelTarget;
+    int m_lastReportRows;
+    int m_lastReportPages;
 
     // Informations de l'entreprise
     QString m_companyName;
@@ -0,0 +1,300 @@
+#include "reportrenderer.h"
+#include "database/databasemanager.h"
+#include <QPagedPaintDevice>
+#include <QPainter>
+#include <QFontMetricsF>
+#include <QSqlQuery>
+#include <QSqlDatabase>
+#include <QDateTime>
+#include <QDebug>
+#include <memory>
+
+namespace {
+// Dimensions en points (1/72 pouce)
+const double ROW_HEIGHT = 14.0;
+const double HEADER_HEIGHT = 18.0;
+const double FOOTER_HEIGHT = 20.0;
+const double CELL_PADDING = 4.0;
+const QColor HEADER_BACKGROUND(52, 73, 94);
+const QColor ALTERNATE_BACKGROUND(245, 247, 249);
+const QColor GRID_COLOR(222, 226, 230);
+}
+
+ReportRenderer::ReportRenderer()
+    : m_pageWidth(0.0)
+    , m_pageHeight(0.0)
+    , m_pageCount(0)
+    , m_rowCount(0)
+{
+    // Tailles en pixels du repère mis à l'échelle, soit en points
+    m_titleFont = QFont("Arial");
+    m_titleFont.setPixelSize(16);
+    m_titleFont.setBold(true);
+    m_textFont = QFont("Arial");
+    m_textFont.setPixelSize(8);
+    m_headerFont = m_textFont;
+    m_headerFont.setBold(true);
+}
+
+void ReportRenderer::setCompanyInfo(const QString& name, const QString& address,
+                                    const QString& phone, const QString& email)
+{
+    m_companyName = name;
+    m_companyAddress = address;
+    m_companyPhone = phone;
+    m_companyEmail = email;
+}
+
+void ReportRenderer::setTitle(const QString& title)
+{
+    m_title = title;
+}
+
+void ReportRenderer::setSummary(const QStringList& lines)
+{
+    m_summary = lines;
+}
+
+void ReportRenderer::setColumns(const QList<Column>& columns)
+{
+    m_columns = columns;
+}
+
+bool ReportRenderer::render(QPagedPaintDevice* device, const RowSource& source)
+{
+    m_pageCount = 0;
+    m_rowCount = 0;
+    m_lastError.clear();
+
+    if (!device || m_columns.isEmpty()) {
+        m_lastError = "Périphérique ou colonnes manquants";
+        return false;
+    }
+
+    QPainter painter;
+    if (!painter.begin(device)) {
+        m_lastError = "Impossible d'ouvrir le périphérique d'impression";
+        return false;
+    }
+
+    // Repère en points, quelle que soit la résolution du périphérique
+    const double scaleX = device->logicalDpiX() / 72.0;
+    const double scaleY = device->logicalDpiY() / 72.0;
+    painter.scale(scaleX, scaleY);
+    m_pageWidth = device->width() / scaleX;
+    m_pageHeight = device->height() / scaleY;
+
+    int totalStretch = 0;
+    for (const Column& column : m_columns) {
+        totalStretch += qMax(1, column.stretch);
+    }
+    m_columnX.clear();
+    double x = 0.0;
+    for (const Column& column : m_columns) {
+        m_columnX.append(x);
+        x += m_pageWidth * qMax(1, column.stretch) / totalStretch;
+    }
+    m_columnX.append(m_pageWidth);
+
+    double y = beginPage(painter, true);
+    QStringList cells;
+    cells.reserve(m_columns.size());
+
+    // Une ligne lue, une ligne peinte : rien n'est conservé d'une ligne à l'autre
+    while (true) {
+        cells.clear();
+        if (!source(cells)) {
+            break;
+        }
+
+        if (y + ROW_HEIGHT > m_pageHeight - FOOTER_HEIGHT) {
+            drawFooter(painter);
+            device->newPage();
+            y = beginPage(painter, false);
+        }
+
+        drawRow(painter, y, cells, m_rowCount % 2 == 1);
+        y += ROW_HEIGHT;
+        ++m_rowCount;
+    }
+
+    if (m_rowCount == 0) {
+        painter.setFont(m_textFont);
+        painter.setPen(Qt::darkGray);
+        painter.drawText(QRectF(0, y, m_pageWidth, ROW_HEIGHT), Qt::AlignCenter, "Aucune donnée");
+    }
+
+    drawFooter(painter);
+    painter.end();
+    return true;
+}
+
+double ReportRenderer::beginPage(QPainter& painter, bool first)
+{
+    ++m_pageCount;
+    double y = 0.0;
+
+    painter.setPen(Qt::black);
+    if (first) {
+        // En-tête complet sur la première page uniquement
+        QFont companyFont = m_headerFont;
+        companyFont.setPixelSize(11);
+        painter.setFont(companyFont);
+        painter.drawText(QRectF(0, y, m_pageWidth, 14), Qt::AlignLeft | Qt::AlignVCenter, m_companyName);
+        y += 14;
+
+        painter.setFont(m_textFont);
+        painter.setPen(Qt::darkGray);
+        painter.drawText(QRectF(0, y, m_pageWidth, 11), Qt::AlignLeft | Qt::AlignVCenter, m_companyAddress);
+        y += 11;
+        painter.drawText(QRectF(0, y, m_pageWidth, 11), Qt::AlignLeft | Qt::AlignVCenter,
+                         QString("Tél: %1 | Email: %2").arg(m_companyPhone, m_companyEmail));
+        y += 20;
+
+        painter.setPen(Qt::black);
+        painter.setFont(m_titleFont);
+        painter.drawText(QRectF(0, y, m_pageWidth, 22), Qt::AlignCenter, m_title);
+        y += 30;
+
+        painter.setFont(m_textFont);
+        for (const QString& line : m_summary) {
+            painter.drawText(QRectF(0, y, m_pageWidth, 12), Qt::AlignLeft | Qt::AlignVCenter, line);
+            y += 12;
+        }
+        y += 8;
+    } else {
+        painter.setFont(m_headerFont);
+        painter.drawText(QRectF(0, y, m_pageWidth, 14), Qt::AlignLeft | Qt::AlignVCenter,
+                         m_title + " (suite)");
+        y += 20;
+    }
+
+    drawColumnHeader(painter, y);
+    return y + HEADER_HEIGHT;
+}
+
+void ReportRenderer::drawColumnHeader(QPainter& painter, double y)
+{
+    painter.fillRect(QRectF(0, y, m_pageWidth, HEADER_HEIGHT), HEADER_BACKGROUND);
+    painter.setFont(m_headerFont);
+    painter.setPen(Qt::white);
+
+    for (int i = 0; i < m_columns.size(); ++i) {
+        const QRectF cell(m_columnX.at(i) + CELL_PADDING, y,
+                          m_columnX.at(i + 1) - m_columnX.at(i) - 2 * CELL_PADDING, HEADER_HEIGHT);
+        painter.drawText(cell, m_columns.at(i).alignment | Qt::AlignVCenter, m_columns.at(i).title);
+    }
+}
+
+void ReportRenderer::drawRow(QPainter& painter, double y, const QStringList& cells, bool alternate)
+{
+    if (alternate) {
+        painter.fillRect(QRectF(0, y, m_pageWidth, ROW_HEIGHT), ALTERNATE_BACKGROUND);
+    }
+
+    painter.setPen(GRID_COLOR);
+    painter.drawLine(QPointF(0, y + ROW_HEIGHT), QPointF(m_pageWidth, y + ROW_HEIGHT));
+
+    painter.setFont(m_textFont);
+    painter.setPen(Qt::black);
+    const QFontMetricsF metrics(m_textFont, painter.device());
+
+    for (int i = 0; i < m_columns.size() && i < cells.size(); ++i) {
+        const double width = m_columnX.at(i + 1) - m_columnX.at(i) - 2 * CELL_PADDING;
+        const QRectF cell(m_columnX.at(i) + CELL_PADDING, y, width, ROW_HEIGHT);
+        // Hauteur fixe : le texte trop long est tronqué plutôt que replié
+        painter.drawText(cell, m_columns.at(i).alignment | Qt::AlignVCenter,
+                         metrics.elidedText(cells.at(i), Qt::ElideRight, width));
+    }
+}
+
+void ReportRenderer::drawFooter(QPainter& painter)
+{
+    painter.setFont(m_textFont);
+    painter.setPen(Qt::darkGray);
+    const QRectF footer(0, m_pageHeight - FOOTER_HEIGHT + 6, m_pageWidth, FOOTER_HEIGHT - 6);
+    painter.drawText(footer, Qt::AlignLeft | Qt::AlignVCenter,
+                     "Généré le " + QDateTime::currentDateTime().toString("dd/MM/yyyy hh:mm"));
+    painter.drawText(footer, Qt::AlignRight | Qt::AlignVCenter, QString("Page %1").arg(m_pageCount));
+}
+
+ReportRenderer::RowSource ReportRenderer::chunkedQuery(const QString& select, const QString& where,
+                                                       const QVariantList& params, const QString& keyColumn,
+                                                       const RowFormatter& formatter, int chunkSize,
+                                                       QString* error)
+{
+    struct State {
+        QSqlQuery query;
+        QVariant lastKey;
+        int rowsInChunk = 0;
+        bool open = false;
+        bool finished = false;
+    };
+    auto state = std::make_shared<State>();
+    chunkSize = qMax(1, chunkSize);
+
+    return [=](QStringList& cells) -> bool {
+        DatabaseManager& db = DatabaseManager::instance();
+
+        while (!state->finished) {
+            if (!state->open) {
+                // Pagination par clé : chaque tranche reprend après la dernière clé lue
+                QStringList predicates;
+                QVariantList values = params;
+                if (!where.isEmpty()) {
+                    predicates << "(" + where + ")";
+                }
+                if (state->lastKey.isValid()) {
+                    predicates << keyColumn + " > ?";
+                    values << state->lastKey;
+                }
+
+                QString sql = select;
+                if (!predicates.isEmpty()) {
+                    sql += " WHERE " + predicates.join(" AND ");
+                }
+                sql += " ORDER BY " + keyColumn;
+                sql += db.database().driverName() == "QOCI" ? QString(" FETCH FIRST %1 ROWS ONLY").arg(chunkSize)
+                                                            : QString(" LIMIT %1").arg(chunkSize);
+
+                state->query = db.prepareQuery(sql);
+                if (!db.executeQuery(state->query, values)) {
+                    if (error) {
+                        *error = db.lastError();
+                    }
+                    state->finished = true;
+                    return false;
+                }
+                state->rowsInChunk = 0;
+                state->open = true;
+            }
+
+            if (state->query.next()) {
+                state->lastKey = state->query.value(0);
+                ++state->rowsInChunk;
+                formatter(state->query, cells);
+                return true;
+            }
+
+            // Tranche incomplète : plus rien à lire
+            state->query.finish();
+            state->open = false;
+            state->finished = state->rowsInChunk < chunkSize;
+        }
+        return false;
+    };
+}
+
+ReportRenderer::RowSource ReportRenderer::concat(const QList<RowSource>& sources)
+{
+    auto index = std::make_shared<int>(0);
+    return [sources, index](QStringList& cells) -> bool {
+        while (*index < sources.size()) {
+            if (sources.at(*index)(cells)) {
+                return true;
+            }
+            ++*index;
+        }
+        return false;
+    };
+}
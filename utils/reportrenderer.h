@@ -0,0 +1,117 @@
+#ifndef REPORTRENDERER_H
+#define REPORTRENDERER_H
+
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QVariantList>
+#include <QFont>
+#include <functional>
+
+class QPagedPaintDevice;
+class QPainter;
+class QSqlQuery;
+
+/**
+ * @brief Rendu paginé en flux des rapports tabulaires (commandes, clients)
+ *
+ * Les pages sont dessinées directement au QPainter sur un QPrinter ou un
+ * QPdfWriter, sans passer par un document HTML : chaque ligne est peinte dès
+ * qu'elle est lue puis oubliée. Les lignes ont une hauteur fixe, l'en-tête
+ * des colonnes est répété sur chaque page et un pied de page numérote les
+ * pages. Avec chunkedQuery(), les lignes sont lues par tranches (pagination
+ * par clé, requêtes en lecture seule vers l'avant) : la mémoire ne dépend pas
+ * du nombre de lignes du rapport.
+ */
+class ReportRenderer
+{
+public:
+    struct Column {
+        QString title;
+        int stretch = 1;                // Largeur relative
+        Qt::Alignment alignment = Qt::AlignLeft;
+    };
+
+    /**
+     * @brief Fournit la ligne suivante
+     * @param cells Reçoit les cellules de la ligne (une par colonne)
+     * @return false quand il n'y a plus de ligne
+     */
+    using RowSource = std::function<bool(QStringList& cells)>;
+
+    /**
+     * @brief Mise en forme d'une ligne de résultat en cellules
+     */
+    using RowFormatter = std::function<void(const QSqlQuery& query, QStringList& cells)>;
+
+    ReportRenderer();
+
+    void setCompanyInfo(const QString& name, const QString& address,
+                        const QString& phone, const QString& email);
+    void setTitle(const QString& title);
+    void setSummary(const QStringList& lines);
+    void setColumns(const QList<Column>& columns);
+
+    /**
+     * @brief Dessine le rapport complet
+     * @param device QPrinter ou QPdfWriter (taille et marges déjà configurées)
+     * @param source Lignes du rapport, consommées une à une
+     * @return true si le rendu a réussi
+     */
+    bool render(QPagedPaintDevice* device, const RowSource& source);
+
+    int pageCount() const { return m_pageCount; }
+    int rowCount() const { return m_rowCount; }
+    QString lastError() const { return m_lastError; }
+
+    /**
+     * @brief Source lisant une requête par tranches, triée par clé
+     *
+     * Chaque tranche est une requête "select WHERE [where AND] clé > ?
+     * ORDER BY clé" limitée à chunkSize lignes ; la clé doit être la
+     * première colonne sélectionnée.
+     *
+     * @param select Début de la requête (SELECT ... FROM ... [JOIN ...])
+     * @param where Prédicat additionnel, vide si aucun
+     * @param params Valeurs des paramètres du prédicat
+     * @param keyColumn Colonne de pagination (unique, indexée)
+     * @param formatter Mise en forme d'une ligne
+     * @param chunkSize Lignes par tranche
+     * @param error Reçoit l'erreur éventuelle de la base
+     */
+    static RowSource chunkedQuery(const QString& select, const QString& where, const QVariantList& params,
+                                  const QString& keyColumn, const RowFormatter& formatter,
+                                  int chunkSize = 500, QString* error = nullptr);
+
+    /**
+     * @brief Enchaîne plusieurs sources (ex. archive puis commandes courantes)
+     */
+    static RowSource concat(const QList<RowSource>& sources);
+
+private:
+    double beginPage(QPainter& painter, bool first);
+    void drawColumnHeader(QPainter& painter, double y);
+    void drawRow(QPainter& painter, double y, const QStringList& cells, bool alternate);
+    void drawFooter(QPainter& painter);
+
+private:
+    QString m_companyName;
+    QString m_companyAddress;
+    QString m_companyPhone;
+    QString m_companyEmail;
+    QString m_title;
+    QStringList m_summary;
+    QList<Column> m_columns;
+    QList<double> m_columnX;            // Abscisse de chaque colonne (points)
+
+    QFont m_titleFont;
+    QFont m_textFont;
+    QFont m_headerFont;
+    double m_pageWidth;                 // Zone imprimable, en points
+    double m_pageHeight;
+    int m_pageCount;
+    int m_rowCount;
+    QString m_lastError;
+};
+
+#endif // REPORTRENDERER_H
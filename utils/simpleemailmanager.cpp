@@ -1,9 +1,12 @@
 #include "simpleemailmanager.h"
 #include "models/commande.h"
 #include "models/client.h"
+#include "emailoutbox.h"
+#include "emailmanager.h"
+#include "texttemplate.h"
+#include "validator.h"
 #include <QMessageBox>
 #include <QAbstractButton>
-#include <QRegularExpression>
 #include <QDebug>
 #include <QDateTime>
 
@@ -35,8 +38,7 @@ void SimpleEmailManager::setReplyToAddress(const QString& replyTo)
 
 bool SimpleEmailManager::isValidEmail(const QString& email)
 {
-    QRegularExpression regex(R"([a-zA-Z0-9._%+-]+@[a-zA-Z0-9.-]+\.[a-zA-Z]{2,})");
-    return regex.match(email).hasMatch();
+    return Validator::isValidEmail(email);
 }
 
 bool SimpleEmailManager::sendCommandeConfirmation(const Commande* commande, const Client* client)
@@ -49,7 +51,8 @@ bool SimpleEmailManager::sendCommandeConfirmation(const Commande* commande, cons
     QString subject = QString("Confirmation de commande #%1").arg(commande->numeroCommande());
     QString content = generateEmailPreview(commande, client, CONFIRMATION_COMMANDE);
     
-    return showEmailPreview(client->email(), subject, content);
+    return showEmailPreview(client->email(), subject, content,
+                            EmailOutbox::dedupKey(commande->id(), "CONFIRMATION"));
 }
 
 bool SimpleEmailManager::sendStatusUpdate(const Commande* commande, const Client* client, const QString& ancienStatut)
@@ -61,7 +64,8 @@ bool SimpleEmailManager::sendStatusUpdate(const Commande* commande, const Client
     QString subject = QString("Mise à jour commande #%1").arg(commande->numeroCommande());
     QString content = generateEmailPreview(commande, client, MISE_A_JOUR_STATUT, ancienStatut);
     
-    return showEmailPreview(client->email(), subject, content);
+    return showEmailPreview(client->email(), subject, content,
+                            EmailOutbox::dedupKey(commande->id(), "STATUT:" + commande->statutToString()));
 }
 
 bool SimpleEmailManager::sendDeliveryNotification(const Commande* commande, const Client* client)
@@ -73,7 +77,8 @@ bool SimpleEmailManager::sendDeliveryNotification(const Commande* commande, cons
     QString subject = QString("Commande #%1 livrée").arg(commande->numeroCommande());
     QString content = generateEmailPreview(commande, client, COMMANDE_LIVREE);
     
-    return showEmailPreview(client->email(), subject, content);
+    return showEmailPreview(client->email(), subject, content,
+                            EmailOutbox::dedupKey(commande->id(), "LIVREE"));
 }
 
 bool SimpleEmailManager::sendCancellationNotification(const Commande* commande, const Client* client, const QString& raison)
@@ -85,7 +90,8 @@ bool SimpleEmailManager::sendCancellationNotification(const Commande* commande,
     QString subject = QString("Annulation commande #%1").arg(commande->numeroCommande());
     QString content = generateEmailPreview(commande, client, COMMANDE_ANNULEE, raison);
     
-    return showEmailPreview(client->email(), subject, content);
+    return showEmailPreview(client->email(), subject, content,
+                            EmailOutbox::dedupKey(commande->id(), "ANNULEE"));
 }
 
 bool SimpleEmailManager::sendDeliveryReminder(const Commande* commande, const Client* client)
@@ -94,41 +100,62 @@ bool SimpleEmailManager::sendDeliveryReminder(const Commande* commande, const Cl
         return false;
     }
 
-    QString subject = QString("Rappel livraison commande #%1").arg(commande->numeroCommande());
+    // Même sujet et même clé que la campagne de rappels : pas de double envoi
+    QString subject = EmailManager::reminderSubject(commande->numeroCommande());
     QString content = generateEmailPreview(commande, client, RAPPEL_LIVRAISON);
     
-    return showEmailPreview(client->email(), subject, content);
+    return showEmailPreview(client->email(), subject, content,
+                            EmailManager::reminderDedupKey(commande->id(), commande->dateLivraisonPrevue()));
 }
 
 QString SimpleEmailManager::generateEmailPreview(const Commande* commande, const Client* client, EmailType type, const QString& extra)
 {
+    // Gabarits compilés une fois ; le rendu remplit un seul tampon
+    static const TextTemplate header("De: %1 <%2>\nÀ: %3 %4 <%5>\nDate: %6\n\nCher(e) %3 %4,\n\n");
+    static const TextTemplate confirmation(
+        "Nous vous confirmons la réception de votre commande.\n\n"
+        "Numéro de commande: %1\n"
+        "Date de commande: %2\n"
+        "Date de livraison prévue: %3\n"
+        "Prix total: %4 TND\n"
+        "Adresse de livraison: %5, %6 %7\n");
+    static const TextTemplate statusUpdate("Le statut de votre commande #%1 a été mis à jour.\n\n%2Nouveau statut: %3\n");
+    static const TextTemplate delivered(
+        "Bonne nouvelle ! Votre commande #%1 a été livrée avec succès.\n\n"
+        "Date de livraison: %2\n"
+        "Nous espérons que vous êtes satisfait(e) de nos services.\n");
+    static const TextTemplate cancelled(
+        "Nous regrettons de vous informer que votre commande #%1 a été annulée.\n\n"
+        "%2Pour toute question, n'hésitez pas à nous contacter.\n");
+    static const TextTemplate reminder(
+        "Rappel: Votre commande #%1 est prévue pour être livrée le %2.\n\n"
+        "Merci de vous assurer d'être disponible à l'adresse de livraison.\n");
+    static const TextTemplate footer(
+        "\nCordialement,\nL'équipe Logistique\n\n"
+        "---\n"
+        "Cet email a été généré automatiquement par le système de gestion logistique.\n"
+        "Pour nous contacter: %1");
+
     QString content;
-    
+    content.reserve(1024);
+
     // En-tête commun
-    content += QString("De: %1 <%2>\n").arg(m_fromName).arg(m_fromAddress);
-    content += QString("À: %1 %2 <%3>\n").arg(client->prenom()).arg(client->nom()).arg(client->email());
-    content += QString("Date: %1\n\n").arg(QDateTime::currentDateTime().toString("dd/MM/yyyy hh:mm"));
+    header.renderTo(content, {m_fromName, m_fromAddress, client->prenom(), client->nom(), client->email(),
+                              QDateTime::currentDateTime().toString("dd/MM/yyyy hh:mm")});
     
     // Corps selon le type
     switch (type) {
-        case CONFIRMATION_COMMANDE: {
-            content += QString("Cher(e) %1 %2,\n\n").arg(client->prenom()).arg(client->nom());
-            content += "Nous vous confirmons la réception de votre commande.\n\n";
-            content += QString("Numéro de commande: %1\n").arg(commande->numeroCommande());
-            content += QString("Date de commande: %1\n").arg(commande->dateCommande().toString("dd/MM/yyyy"));
-            content += QString("Date de livraison prévue: %1\n").arg(commande->dateLivraisonPrevue().toString("dd/MM/yyyy"));
-            content += QString("Prix total: %1 TND\n").arg(QString::number(commande->prixTotal(), 'f', 3));
-            content += QString("Adresse de livraison: %1, %2 %3\n").arg(commande->adresseLivraison()).arg(commande->codePostalLivraison()).arg(commande->villeLivraison());
+        case CONFIRMATION_COMMANDE:
+            confirmation.renderTo(content, {commande->numeroCommande(),
+                                            commande->dateCommande().toString("dd/MM/yyyy"),
+                                            commande->dateLivraisonPrevue().toString("dd/MM/yyyy"),
+                                            QString::number(commande->prixTotal(), 'f', 3),
+                                            commande->adresseLivraison(),
+                                            commande->codePostalLivraison(),
+                                            commande->villeLivraison()});
             break;
-        }
             
         case MISE_A_JOUR_STATUT: {
-            content += QString("Cher(e) %1 %2,\n\n").arg(client->prenom()).arg(client->nom());
-            content += QString("Le statut de votre commande #%1 a été mis à jour.\n\n").arg(commande->numeroCommande());
-            if (!extra.isEmpty()) {
-                content += QString("Ancien statut: %1\n").arg(extra);
-            }
-
             QString nouveauStatut;
             switch (commande->statut()) {
                 case Commande::EN_ATTENTE: nouveauStatut = "En attente"; break;
@@ -138,46 +165,36 @@ QString SimpleEmailManager::generateEmailPreview(const Commande* commande, const
                 case Commande::LIVREE: nouveauStatut = "Livrée"; break;
                 case Commande::ANNULEE: nouveauStatut = "Annulée"; break;
             }
-            content += QString("Nouveau statut: %1\n").arg(nouveauStatut);
+            statusUpdate.renderTo(content, {commande->numeroCommande(),
+                                            extra.isEmpty() ? QString() : "Ancien statut: " + extra + "\n",
+                                            nouveauStatut});
             break;
         }
             
-        case COMMANDE_LIVREE: {
-            content += QString("Cher(e) %1 %2,\n\n").arg(client->prenom()).arg(client->nom());
-            content += QString("Bonne nouvelle ! Votre commande #%1 a été livrée avec succès.\n\n").arg(commande->numeroCommande());
-            content += QString("Date de livraison: %1\n").arg(commande->dateLivraisonReelle().toString("dd/MM/yyyy"));
-            content += "Nous espérons que vous êtes satisfait(e) de nos services.\n";
+        case COMMANDE_LIVREE:
+            delivered.renderTo(content, {commande->numeroCommande(),
+                                         commande->dateLivraisonReelle().toString("dd/MM/yyyy")});
             break;
-        }
             
-        case COMMANDE_ANNULEE: {
-            content += QString("Cher(e) %1 %2,\n\n").arg(client->prenom()).arg(client->nom());
-            content += QString("Nous regrettons de vous informer que votre commande #%1 a été annulée.\n\n").arg(commande->numeroCommande());
-            if (!extra.isEmpty()) {
-                content += QString("Raison: %1\n\n").arg(extra);
-            }
-            content += "Pour toute question, n'hésitez pas à nous contacter.\n";
+        case COMMANDE_ANNULEE:
+            cancelled.renderTo(content, {commande->numeroCommande(),
+                                         extra.isEmpty() ? QString() : "Raison: " + extra + "\n\n"});
             break;
-        }
             
-        case RAPPEL_LIVRAISON: {
-            content += QString("Cher(e) %1 %2,\n\n").arg(client->prenom()).arg(client->nom());
-            content += QString("Rappel: Votre commande #%1 est prévue pour être livrée le %2.\n\n").arg(commande->numeroCommande()).arg(commande->dateLivraisonPrevue().toString("dd/MM/yyyy"));
-            content += "Merci de vous assurer d'être disponible à l'adresse de livraison.\n";
+        case RAPPEL_LIVRAISON:
+            reminder.renderTo(content, {commande->numeroCommande(),
+                                        commande->dateLivraisonPrevue().toString("dd/MM/yyyy")});
             break;
-        }
     }
     
     // Pied de page commun
-    content += "\nCordialement,\nL'équipe Logistique\n\n";
-    content += "---\n";
-    content += "Cet email a été généré automatiquement par le système de gestion logistique.\n";
-    content += QString("Pour nous contacter: %1").arg(m_replyToAddress);
+    footer.renderTo(content, {m_replyToAddress});
     
     return content;
 }
 
-bool SimpleEmailManager::showEmailPreview(const QString& to, const QString& subject, const QString& content)
+bool SimpleEmailManager::showEmailPreview(const QString& to, const QString& subject, const QString& content,
+                                          const QString& dedupKey)
 {
     // Vérifier l'email
     if (!isValidEmail(to)) {
@@ -200,10 +217,33 @@ bool SimpleEmailManager::showEmailPreview(const QString& to, const QString& subj
     int result = msgBox.exec();
     
     if (result == QMessageBox::Ok) {
-        // Simuler l'envoi
-        qInfo() << "Email simulé envoyé à:" << to << "Sujet:" << subject;
-        emit emailSent(to, subject);
-        return true;
+        // Mise en file : l'envoi SMTP est fait par le thread de la file d'envoi
+        OutboxEmail email;
+        email.to = to;
+        email.subject = subject;
+        email.textBody = content;
+        email.dedupKey = dedupKey;
+        email.from = m_fromAddress;
+        email.fromName = m_fromName;
+        email.replyTo = m_replyToAddress;
+
+        switch (EmailOutbox::instance().enqueue(email)) {
+            case EmailOutbox::QUEUED:
+                qInfo() << "Email mis en file pour:" << to << "Sujet:" << subject;
+                emit emailSent(to, subject);
+                return true;
+            case EmailOutbox::DUPLICATE:
+                QMessageBox::information(nullptr, "Email déjà envoyé",
+                    "Cette notification a déjà été placée dans la file d'envoi.");
+                return false;
+            case EmailOutbox::ERREUR:
+                break;
+        }
+
+        const QString error = EmailOutbox::instance().lastError();
+        QMessageBox::warning(nullptr, "Erreur", "Impossible de placer l'email en file d'envoi:\n" + error);
+        emit emailFailed(to, subject, error);
+        return false;
     } else {
         qInfo() << "Envoi d'email annulé par l'utilisateur";
         return false;
@@ -11,8 +11,8 @@ class Client;
 /**
  * @brief Gestionnaire d'emails simplifié pour l'application logistique
  * 
- * Version simplifiée qui génère des aperçus d'emails et simule l'envoi
- * sans dépendances réseau complexes.
+ * Version simplifiée qui affiche un aperçu texte de l'email puis, après
+ * confirmation, le place dans la file d'envoi persistante (EmailOutbox).
  */
 class SimpleEmailManager : public QObject
 {
@@ -30,7 +30,7 @@ public:
     explicit SimpleEmailManager(QObject *parent = nullptr);
     ~SimpleEmailManager();
 
-    // Envoi d'emails (simulation avec aperçu)
+    // Envoi d'emails (aperçu puis mise en file)
     bool sendCommandeConfirmation(const Commande* commande, const Client* client);
     bool sendStatusUpdate(const Commande* commande, const Client* client, const QString& ancienStatut);
     bool sendDeliveryNotification(const Commande* commande, const Client* client);
@@ -50,7 +50,8 @@ signals:
 
 private:
     QString generateEmailPreview(const Commande* commande, const Client* client, EmailType type, const QString& extra = QString());
-    bool showEmailPreview(const QString& to, const QString& subject, const QString& content);
+    bool showEmailPreview(const QString& to, const QString& subject, const QString& content,
+                          const QString& dedupKey = QString());
 
     // Configuration email
     QString m_fromAddress;
@@ -1,6 +1,8 @@
 #include "simpleprintmanager.h"
 #include "models/commande.h"
 #include "models/client.h"
+#include "texttemplate.h"
+#include "barcode.h"
 #include <QMessageBox>
 #include <QAbstractButton>
 #include <QDateTime>
@@ -175,8 +177,8 @@ QString SimplePrintManager::generateEtiquetteLivraisonText(const Commande* comma
     
     content += QString("Date de livraison prévue: %1\n\n").arg(commande->dateLivraisonPrevue().toString("dd/MM/yyyy"));
     
-    content += "Code-barres (simulé):\n";
-    content += "|||| | || ||| | || ||||\n";
+    content += "Code-barres (Code 128):\n";
+    content += Barcode::code128Text(commande->numeroCommande()) + "\n";
     content += QString("     %1\n").arg(commande->numeroCommande());
     content += "\n" + QString("*").repeated(40) + "\n";
     
@@ -216,15 +218,12 @@ QString SimplePrintManager::generateListeClientsText(const QList<Client*>& clien
     content += QString("                   LISTE DES CLIENTS\n");
     content += QString("=").repeated(60) + "\n\n";
 
+    // Une ligne compilée une fois, rendue dans le tampon du document
+    static const TextTemplate row("ID: %1 - %2 %3\nVille: %4 | Tél: %5\nEmail: %6\n\n");
+    content.reserve(content.size() + clients.size() * (row.literalSize() + 80));
     for (const Client* client : clients) {
-        content += QString("ID: %1 - %2 %3\n")
-                   .arg(client->id())
-                   .arg(client->prenom())
-                   .arg(client->nom());
-        content += QString("Ville: %1 | Tél: %2\n")
-                   .arg(client->ville())
-                   .arg(client->telephone());
-        content += QString("Email: %1\n\n").arg(client->email());
+        row.renderTo(content, {QString::number(client->id()), client->prenom(), client->nom(),
+                               client->ville(), client->telephone(), client->email()});
     }
 
     content += QString("Liste générée le %1\n").arg(QDateTime::currentDateTime().toString("dd/MM/yyyy hh:mm"));
@@ -0,0 +1,331 @@
+#include "smtpclient.h"
+#include <QDateTime>
+#include <QUuid>
+#include <QDebug>
+
+namespace {
+const int BASE64_LINE_LENGTH = 76;
+}
+
+SmtpClient::SmtpClient(const Settings& settings)
+    : m_settings(settings)
+    , m_replyCode(0)
+{
+}
+
+SmtpClient::~SmtpClient()
+{
+    close();
+}
+
+bool SmtpClient::open()
+{
+    if (isOpen()) {
+        return true;
+    }
+
+    m_extensions.clear();
+    const bool implicitTls = m_settings.useSsl && m_settings.port == 465;
+
+    if (implicitTls) {
+        m_socket.connectToHostEncrypted(m_settings.host, static_cast<quint16>(m_settings.port));
+        if (!m_socket.waitForEncrypted(m_settings.timeoutMs)) {
+            return fail("Connexion TLS impossible: " + m_socket.errorString());
+        }
+    } else {
+        m_socket.connectToHost(m_settings.host, static_cast<quint16>(m_settings.port));
+        if (!m_socket.waitForConnected(m_settings.timeoutMs)) {
+            return fail("Connexion impossible: " + m_socket.errorString());
+        }
+    }
+
+    if (!readReply() || !expect(220) || !ehlo()) {
+        close();
+        return false;
+    }
+
+    // STARTTLS : la session est renégociée puis EHLO est répété
+    if (m_settings.useSsl && !m_socket.isEncrypted()) {
+        if (!m_extensions.contains("STARTTLS")) {
+            close();
+            return fail("Le serveur SMTP ne propose pas STARTTLS");
+        }
+        if (!command("STARTTLS", 220)) {
+            close();
+            return false;
+        }
+        m_socket.startClientEncryption();
+        if (!m_socket.waitForEncrypted(m_settings.timeoutMs) || !ehlo()) {
+            close();
+            return fail("Négociation STARTTLS impossible: " + m_socket.errorString());
+        }
+    }
+
+    if (!m_settings.username.isEmpty() && !authenticate()) {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+bool SmtpClient::send(const Message& message)
+{
+    if (!isOpen()) {
+        return fail("Session SMTP fermée");
+    }
+
+    static const char* const steps[] = {"MAIL FROM", "RCPT TO", "DATA"};
+    const QByteArray commands[] = {
+        "MAIL FROM:<" + message.from.toUtf8() + ">\r\n",
+        "RCPT TO:<" + message.to.toUtf8() + ">\r\n",
+        "DATA\r\n"
+    };
+
+    // PIPELINING : enveloppe et DATA en une seule écriture ; les trois réponses
+    // sont lues dans l'ordre, même après un refus, pour garder le flux synchronisé
+    const bool pipelined = supportsPipelining();
+    if (pipelined) {
+        m_socket.write(commands[0] + commands[1] + commands[2]);
+    }
+
+    int codes[3] = {0, 0, 0};
+    QString texts[3];
+    int failed = -1;
+    for (int i = 0; i < 3; ++i) {
+        if (!pipelined) {
+            if (failed >= 0) {
+                break;
+            }
+            m_socket.write(commands[i]);
+        }
+        if (!readReply()) {
+            return false;
+        }
+        codes[i] = m_replyCode;
+        texts[i] = m_replyText.trimmed();
+
+        const bool accepted = i == 2 ? codes[i] == 354
+                                     : codes[i] == 250 || (i == 1 && codes[i] == 251);
+        if (!accepted && failed < 0) {
+            failed = i;
+        }
+    }
+
+    if (failed >= 0) {
+        if (codes[2] == 354) {
+            // DATA accepté malgré un refus de l'enveloppe : transaction vide abandonnée
+            m_socket.write(".\r\n");
+            if (!readReply()) {
+                return false;
+            }
+        }
+        resetTransaction();
+        m_replyCode = codes[failed];
+        return fail(QString("%1 refusé (%2): %3").arg(steps[failed]).arg(codes[failed]).arg(texts[failed]));
+    }
+
+    // Corps : transparence des points (RFC 5321, 4.5.2) puis terminaison
+    QByteArray data = buildMime(message);
+    data.replace("\r\n.", "\r\n..");
+    if (data.startsWith('.')) {
+        data.prepend('.');
+    }
+    m_socket.write(data + "\r\n.\r\n");
+
+    if (!readReply()) {
+        return false;
+    }
+    if (m_replyCode != 250) {
+        return fail(QString("Message refusé (%1): %2").arg(m_replyCode).arg(m_replyText.trimmed()));
+    }
+    return true;
+}
+
+void SmtpClient::close()
+{
+    if (m_socket.state() == QAbstractSocket::ConnectedState) {
+        m_socket.write("QUIT\r\n");
+        m_socket.waitForBytesWritten(1000);
+        m_socket.waitForReadyRead(1000);
+    }
+    m_socket.abort();
+}
+
+bool SmtpClient::isOpen() const
+{
+    return m_socket.state() == QAbstractSocket::ConnectedState;
+}
+
+bool SmtpClient::supportsPipelining() const
+{
+    return m_extensions.contains("PIPELINING");
+}
+
+bool SmtpClient::readReply()
+{
+    m_replyText.clear();
+
+    // Réponse multiligne : "250-..." jusqu'à "250 ..."
+    while (true) {
+        while (!m_socket.canReadLine()) {
+            if (!m_socket.waitForReadyRead(m_settings.timeoutMs)) {
+                m_replyCode = 0;
+                const QString error = "Pas de réponse du serveur SMTP: " + m_socket.errorString();
+                m_socket.abort();
+                return fail(error);
+            }
+        }
+
+        const QByteArray line = m_socket.readLine().trimmed();
+        if (line.size() < 3) {
+            m_replyCode = 0;
+            m_socket.abort();
+            return fail("Réponse SMTP invalide: " + QString::fromUtf8(line));
+        }
+
+        m_replyCode = line.left(3).toInt();
+        m_replyText += QString::fromUtf8(line.mid(4)) + '\n';
+        if (line.size() == 3 || line.at(3) == ' ') {
+            return true;
+        }
+    }
+}
+
+bool SmtpClient::expect(int expectedCode)
+{
+    if (m_replyCode != expectedCode) {
+        return fail(QString("Réponse SMTP inattendue (%1, attendu %2): %3")
+                        .arg(m_replyCode).arg(expectedCode).arg(m_replyText.trimmed()));
+    }
+    return true;
+}
+
+bool SmtpClient::command(const QByteArray& line, int expectedCode)
+{
+    m_socket.write(line + "\r\n");
+    return readReply() && expect(expectedCode);
+}
+
+bool SmtpClient::ehlo()
+{
+    if (!command("EHLO " + m_settings.heloName.toUtf8(), 250)) {
+        return false;
+    }
+
+    // Première ligne : nom du serveur ; suivantes : extensions
+    m_extensions.clear();
+    const QStringList lines = m_replyText.split('\n', Qt::SkipEmptyParts);
+    for (int i = 1; i < lines.size(); ++i) {
+        const QStringList words = lines.at(i).toUpper().split(' ', Qt::SkipEmptyParts);
+        if (words.isEmpty()) {
+            continue;
+        }
+        m_extensions << words.first();
+        if (words.first() == "AUTH") {
+            for (int j = 1; j < words.size(); ++j) {
+                m_extensions << "AUTH=" + words.at(j);
+            }
+        }
+    }
+    return true;
+}
+
+bool SmtpClient::authenticate()
+{
+    const QByteArray user = m_settings.username.toUtf8();
+    const QByteArray password = m_settings.password.toUtf8();
+
+    if (m_extensions.contains("AUTH=PLAIN") || !m_extensions.contains("AUTH=LOGIN")) {
+        const QByteArray token = QByteArray(1, '\0') + user + QByteArray(1, '\0') + password;
+        return command("AUTH PLAIN " + token.toBase64(), 235);
+    }
+
+    return command("AUTH LOGIN", 334)
+           && command(user.toBase64(), 334)
+           && command(password.toBase64(), 235);
+}
+
+bool SmtpClient::resetTransaction()
+{
+    if (!isOpen()) {
+        return false;
+    }
+    return command("RSET", 250);
+}
+
+bool SmtpClient::fail(const QString& error)
+{
+    m_lastError = error;
+    return false;
+}
+
+QByteArray SmtpClient::buildMime(const Message& message)
+{
+    const QString domain = message.from.section('@', 1);
+    QByteArray mime;
+    mime.reserve(message.textBody.size() * 2 + message.htmlBody.size() * 2 + 1024);
+
+    mime += "From: ";
+    if (!message.fromName.isEmpty()) {
+        mime += encodeHeader(message.fromName) + ' ';
+    }
+    mime += "<" + message.from.toUtf8() + ">\r\n";
+    mime += "To: <" + message.to.toUtf8() + ">\r\n";
+    if (!message.replyTo.isEmpty()) {
+        mime += "Reply-To: <" + message.replyTo.toUtf8() + ">\r\n";
+    }
+    mime += "Subject: " + encodeHeader(message.subject) + "\r\n";
+    mime += "Date: " + QDateTime::currentDateTime().toString(Qt::RFC2822Date).toUtf8() + "\r\n";
+    mime += "Message-ID: <" + QUuid::createUuid().toByteArray(QUuid::WithoutBraces)
+            + "@" + domain.toUtf8() + ">\r\n";
+    mime += "MIME-Version: 1.0\r\n";
+
+    const bool hasText = !message.textBody.isEmpty();
+    const bool hasHtml = !message.htmlBody.isEmpty();
+
+    if (hasText && hasHtml) {
+        const QByteArray boundary = "=_" + QUuid::createUuid().toByteArray(QUuid::Id128);
+        mime += "Content-Type: multipart/alternative; boundary=\"" + boundary + "\"\r\n\r\n";
+        mime += "--" + boundary + "\r\n";
+        mime += "Content-Type: text/plain; charset=UTF-8\r\nContent-Transfer-Encoding: base64\r\n\r\n";
+        mime += wrapBase64(message.textBody.toUtf8());
+        mime += "--" + boundary + "\r\n";
+        mime += "Content-Type: text/html; charset=UTF-8\r\nContent-Transfer-Encoding: base64\r\n\r\n";
+        mime += wrapBase64(message.htmlBody.toUtf8());
+        mime += "--" + boundary + "--";
+    } else {
+        mime += hasHtml ? "Content-Type: text/html; charset=UTF-8\r\n"
+                        : "Content-Type: text/plain; charset=UTF-8\r\n";
+        mime += "Content-Transfer-Encoding: base64\r\n\r\n";
+        mime += wrapBase64((hasHtml ? message.htmlBody : message.textBody).toUtf8());
+        mime.chop(2);
+    }
+
+    return mime;
+}
+
+QByteArray SmtpClient::encodeHeader(const QString& text)
+{
+    // En-tête ASCII laissé tel quel, sinon mot encodé RFC 2047
+    for (const QChar c : text) {
+        if (c.unicode() > 127) {
+            return "=?UTF-8?B?" + text.toUtf8().toBase64() + "?=";
+        }
+    }
+    return text.toUtf8();
+}
+
+QByteArray SmtpClient::wrapBase64(const QByteArray& data)
+{
+    const QByteArray encoded = data.toBase64();
+    QByteArray wrapped;
+    wrapped.reserve(encoded.size() + encoded.size() / BASE64_LINE_LENGTH * 2 + 2);
+    for (int i = 0; i < encoded.size(); i += BASE64_LINE_LENGTH) {
+        wrapped += encoded.mid(i, BASE64_LINE_LENGTH) + "\r\n";
+    }
+    if (wrapped.isEmpty()) {
+        wrapped = "\r\n";
+    }
+    return wrapped;
+}
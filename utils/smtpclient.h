@@ -0,0 +1,102 @@
+#ifndef SMTPCLIENT_H
+#define SMTPCLIENT_H
+
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QSslSocket>
+
+/**
+ * @brief Client SMTP bloquant destiné à un thread de travail
+ *
+ * Une session (connexion, EHLO, STARTTLS/TLS, authentification) est ouverte
+ * une fois puis réutilisée pour plusieurs messages. Si le serveur annonce
+ * PIPELINING, MAIL FROM, RCPT TO et DATA partent en une seule écriture.
+ * Après un refus, la transaction est réinitialisée (RSET) et la session
+ * reste utilisable pour le message suivant.
+ */
+class SmtpClient
+{
+public:
+    struct Settings {
+        QString host = "localhost";
+        int port = 25;
+        QString username;
+        QString password;
+        bool useSsl = false;            // TLS implicite sur le port 465, STARTTLS sinon
+        QString heloName = "logistics.local";
+        int timeoutMs = 15000;
+    };
+
+    struct Message {
+        QString from;
+        QString fromName;
+        QString replyTo;
+        QString to;
+        QString subject;
+        QString textBody;
+        QString htmlBody;
+    };
+
+    explicit SmtpClient(const Settings& settings);
+    ~SmtpClient();
+
+    /**
+     * @brief Ouvre la session (accueil, EHLO, chiffrement, authentification)
+     * @return true si la session est prête à envoyer
+     */
+    bool open();
+
+    /**
+     * @brief Envoie un message sur la session ouverte
+     * @return true si le serveur a accepté le message
+     */
+    bool send(const Message& message);
+
+    /**
+     * @brief Termine la session (QUIT) et ferme la connexion
+     */
+    void close();
+
+    bool isOpen() const;
+    bool supportsPipelining() const;
+
+    /**
+     * @brief Dernier code de réponse du serveur (0 si erreur réseau)
+     */
+    int lastReplyCode() const { return m_replyCode; }
+
+    /**
+     * @brief Indique si le dernier échec est définitif (réponse 5xx)
+     */
+    bool lastErrorIsPermanent() const { return m_replyCode >= 500; }
+
+    QString lastError() const { return m_lastError; }
+
+    /**
+     * @brief Construit le message MIME (en-têtes et corps en base64)
+     */
+    static QByteArray buildMime(const Message& message);
+
+private:
+    bool readReply();
+    bool expect(int expectedCode);
+    bool command(const QByteArray& line, int expectedCode);
+    bool ehlo();
+    bool authenticate();
+    bool resetTransaction();
+    bool fail(const QString& error);
+
+    static QByteArray encodeHeader(const QString& text);
+    static QByteArray wrapBase64(const QByteArray& data);
+
+private:
+    Settings m_settings;
+    QSslSocket m_socket;
+    QStringList m_extensions;
+    int m_replyCode;
+    QString m_replyText;
+    QString m_lastError;
+};
+
+#endif // SMTPCLIENT_H
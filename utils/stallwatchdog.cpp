@@ -0,0 +1,253 @@
+#include "stallwatchdog.h"
+#include "tracer.h"
+#include "database/databasemanager.h"
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QDebug>
+#include <algorithm>
+#include <chrono>
+
+namespace {
+const int CHECK_INTERVAL_MS = 25;
+}
+
+// ---------------------------------------------------------------------------
+// StallSampler
+// ---------------------------------------------------------------------------
+
+StallSampler::StallSampler(QThread* guiThread, const std::atomic<qint64>* lastBeatMs)
+    : QObject(nullptr)
+    , m_timer(nullptr)
+    , m_guiThread(guiThread)
+    , m_lastBeatMs(lastBeatMs)
+    , m_thresholdMs(200)
+    , m_inStall(false)
+    , m_stallStartMs(0)
+{
+}
+
+void StallSampler::start(int thresholdMs)
+{
+    m_thresholdMs = qMax(CHECK_INTERVAL_MS, thresholdMs);
+
+    // Le timer est créé dans le thread du chien de garde
+    if (!m_timer) {
+        m_timer = new QTimer(this);
+        m_timer->setTimerType(Qt::PreciseTimer);
+        connect(m_timer, &QTimer::timeout, this, &StallSampler::check);
+    }
+    m_timer->start(CHECK_INTERVAL_MS);
+}
+
+void StallSampler::stop()
+{
+    if (m_timer) {
+        m_timer->stop();
+    }
+    m_inStall = false;
+}
+
+void StallSampler::check()
+{
+    const qint64 now = StallWatchdog::nowMs();
+    const qint64 lastBeat = m_lastBeatMs->load(std::memory_order_acquire);
+
+    if (m_inStall && lastBeat > m_stallStartMs) {
+        finishStall(lastBeat);
+    }
+
+    if (now - lastBeat < m_thresholdMs) {
+        return;
+    }
+
+    if (!m_inStall) {
+        m_inStall = true;
+        m_stallStartMs = lastBeat;
+        m_current = StallEvent();
+        m_current.timestamp = QDateTime::currentDateTime().addMSecs(lastBeat - now);
+        m_stackSamples.clear();
+    }
+
+    const QString stack = sample();
+
+    // Signalé dès la détection : le thread graphique peut ne jamais reprendre
+    if (m_current.samples == 1) {
+        qWarning().noquote() << QString("Interface bloquée depuis %1 ms").arg(now - lastBeat)
+                             << "- portées:" << stack
+                             << "- SQL:" << (m_current.sql.isEmpty() ? QString("aucune") : m_current.sql.simplified());
+    }
+}
+
+QString StallSampler::sample()
+{
+    ++m_current.samples;
+
+    const QStringList spans = Tracer::activeSpans(m_guiThread);
+    const QString stack = spans.isEmpty() ? QString("(hors portée tracée)") : spans.join(" > ");
+    ++m_stackSamples[stack];
+
+    qint64 sqlElapsedMs = 0;
+    const QString sql = DatabaseManager::instance().currentStatement(&sqlElapsedMs);
+    if (!sql.isEmpty() && sqlElapsedMs >= m_current.sqlElapsedMs) {
+        m_current.sql = sql.simplified();
+        m_current.sqlElapsedMs = sqlElapsedMs;
+    }
+    return stack;
+}
+
+void StallSampler::finishStall(qint64 resumedAtMs)
+{
+    m_inStall = false;
+    m_current.durationMs = static_cast<double>(resumedAtMs - m_stallStartMs);
+
+    // Piles classées par nombre d'échantillons
+    QList<QPair<int, QString>> ranked;
+    for (auto it = m_stackSamples.constBegin(); it != m_stackSamples.constEnd(); ++it) {
+        ranked.append(qMakePair(it.value(), it.key()));
+    }
+    std::sort(ranked.begin(), ranked.end(), [](const QPair<int, QString>& a, const QPair<int, QString>& b) {
+        return a.first > b.first;
+    });
+    for (const QPair<int, QString>& entry : ranked) {
+        m_current.stacks << QString("%1x %2").arg(entry.first).arg(entry.second);
+    }
+
+    emit stallFinished(m_current);
+}
+
+// ---------------------------------------------------------------------------
+// StallWatchdog
+// ---------------------------------------------------------------------------
+
+StallWatchdog::StallWatchdog(QObject *parent)
+    : QObject(parent)
+    , m_sampler(nullptr)
+    , m_lastBeatMs(nowMs())
+{
+    qRegisterMetaType<StallEvent>("StallEvent");
+
+    m_sampler = new StallSampler(thread(), &m_lastBeatMs);
+    m_thread.setObjectName("StallWatchdog");
+    m_sampler->moveToThread(&m_thread);
+
+    connect(&m_thread, &QThread::finished, m_sampler, &QObject::deleteLater);
+    connect(m_sampler, &StallSampler::stallFinished, this, &StallWatchdog::onStallFinished);
+
+    m_heartbeat.setInterval(HEARTBEAT_MS);
+    connect(&m_heartbeat, &QTimer::timeout, this, [this]() {
+        m_lastBeatMs.store(nowMs(), std::memory_order_release);
+    });
+}
+
+StallWatchdog::~StallWatchdog()
+{
+    stop();
+
+    // Échantillonneur jamais démarré : deleteLater() n'a pas été déclenché par le thread
+    if (!m_thread.isFinished()) {
+        delete m_sampler;
+    }
+}
+
+void StallWatchdog::start(int thresholdMs)
+{
+    if (m_thread.isRunning()) {
+        return;
+    }
+
+    m_lastBeatMs.store(nowMs(), std::memory_order_release);
+    m_heartbeat.start();
+    Tracer::setPublishingActiveSpans(true);
+
+    // Priorité haute : l'échantillonneur doit tourner même sous charge
+    m_thread.start(QThread::HighPriority);
+    QMetaObject::invokeMethod(m_sampler, "start", Qt::QueuedConnection, Q_ARG(int, thresholdMs));
+}
+
+void StallWatchdog::stop()
+{
+    m_heartbeat.stop();
+    Tracer::setPublishingActiveSpans(false);
+
+    if (!m_thread.isRunning()) {
+        return;
+    }
+
+    QMetaObject::invokeMethod(m_sampler, "stop", Qt::BlockingQueuedConnection);
+    m_thread.quit();
+    m_thread.wait();
+}
+
+QList<StallEvent> StallWatchdog::events() const
+{
+    return m_events;
+}
+
+QString StallWatchdog::report() const
+{
+    if (m_events.isEmpty()) {
+        return "Aucun blocage de l'interface détecté";
+    }
+
+    QString text;
+    for (const StallEvent& event : m_events) {
+        text += QString("[%1] %2 ms (%3 échantillons)\n")
+                    .arg(event.timestamp.toString("hh:mm:ss.zzz"))
+                    .arg(event.durationMs, 0, 'f', 0)
+                    .arg(event.samples);
+        for (const QString& stack : event.stacks) {
+            text += "    " + stack + "\n";
+        }
+        if (!event.sql.isEmpty()) {
+            text += QString("    SQL (%1 ms): %2\n").arg(event.sqlElapsedMs).arg(event.sql);
+        }
+    }
+    return text;
+}
+
+bool StallWatchdog::exportJson(const QString& filePath) const
+{
+    QJsonArray events;
+    for (const StallEvent& event : m_events) {
+        QJsonObject entry;
+        entry["timestamp"] = event.timestamp.toString(Qt::ISODateWithMs);
+        entry["durationMs"] = event.durationMs;
+        entry["samples"] = event.samples;
+        entry["stacks"] = QJsonArray::fromStringList(event.stacks);
+        entry["sql"] = event.sql;
+        entry["sqlElapsedMs"] = event.sqlElapsedMs;
+        events.append(entry);
+    }
+
+    QJsonObject root;
+    root["exportedAt"] = QDateTime::currentDateTime().toString(Qt::ISODate);
+    root["stalls"] = events;
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "Impossible d'exporter les blocages:" << filePath << file.errorString();
+        return false;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Indented));
+    return true;
+}
+
+qint64 StallWatchdog::nowMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void StallWatchdog::onStallFinished(const StallEvent& event)
+{
+    m_events.append(event);
+    if (m_events.size() > EVENT_CAPACITY) {
+        m_events.removeFirst();
+    }
+
+    qWarning().noquote() << QString("Blocage de l'interface: %1 ms").arg(event.durationMs, 0, 'f', 0)
+                         << "-" << event.stacks.value(0);
+    emit stallDetected(event);
+}
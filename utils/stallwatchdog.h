@@ -0,0 +1,141 @@
+#ifndef STALLWATCHDOG_H
+#define STALLWATCHDOG_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QMap>
+#include <QThread>
+#include <QTimer>
+#include <QDateTime>
+#include <QMetaType>
+#include <atomic>
+
+/**
+ * @brief Blocage de la boucle d'événements du thread graphique
+ */
+struct StallEvent {
+    QDateTime timestamp;        // Début estimé du blocage
+    double durationMs = 0.0;
+    int samples = 0;            // Nombre d'échantillons pris pendant le blocage
+    QStringList stacks;         // Piles de portées échantillonnées, les plus fréquentes d'abord
+    QString sql;                // Plus longue requête observée pendant le blocage
+    qint64 sqlElapsedMs = 0;
+};
+Q_DECLARE_METATYPE(StallEvent)
+
+/**
+ * @brief Échantillonneur exécuté dans le thread du chien de garde
+ *
+ * Compare régulièrement l'horloge au dernier battement du thread graphique.
+ * Pendant un blocage, il relève les portées ouvertes du thread graphique
+ * (Tracer::activeSpans, publiées pendant que le chien de garde tourne) et la
+ * requête SQL en cours (DatabaseManager).
+ */
+class StallSampler : public QObject
+{
+    Q_OBJECT
+
+public:
+    StallSampler(QThread* guiThread, const std::atomic<qint64>* lastBeatMs);
+
+public slots:
+    void start(int thresholdMs);
+    void stop();
+
+signals:
+    /**
+     * @brief Émis à la fin d'un blocage (le thread graphique a repris)
+     */
+    void stallFinished(const StallEvent& event);
+
+private slots:
+    void check();
+
+private:
+    /**
+     * @brief Relève les portées ouvertes et la requête en cours
+     * @return Pile échantillonnée ("catégorie/nom > ...")
+     */
+    QString sample();
+    void finishStall(qint64 resumedAtMs);
+
+private:
+    QTimer *m_timer;
+    QThread *m_guiThread;
+    const std::atomic<qint64> *m_lastBeatMs;
+    int m_thresholdMs;
+    bool m_inStall;
+    qint64 m_stallStartMs;
+    StallEvent m_current;
+    QMap<QString, int> m_stackSamples;
+};
+
+/**
+ * @brief Chien de garde du thread graphique
+ *
+ * Un battement (QTimer du thread graphique) horodate la boucle d'événements ;
+ * un thread dédié détecte les blocages supérieurs au seuil et les conserve
+ * dans un tampon circulaire exportable à la demande.
+ */
+class StallWatchdog : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit StallWatchdog(QObject *parent = nullptr);
+    ~StallWatchdog();
+
+    /**
+     * @brief Démarre la surveillance (à appeler depuis le thread graphique)
+     * @param thresholdMs Durée minimale d'un blocage signalé (défaut: 200 ms)
+     */
+    void start(int thresholdMs = 200);
+
+    /**
+     * @brief Arrête la surveillance
+     */
+    void stop();
+
+    /**
+     * @brief Derniers blocages détectés, du plus ancien au plus récent
+     */
+    QList<StallEvent> events() const;
+
+    /**
+     * @brief Rapport texte des blocages
+     */
+    QString report() const;
+
+    /**
+     * @brief Exporte les blocages au format JSON
+     * @param filePath Fichier de sortie
+     * @return true si l'export a réussi
+     */
+    bool exportJson(const QString& filePath) const;
+
+    /**
+     * @brief Horloge monotone partagée par le battement et l'échantillonneur
+     * @return Millisecondes depuis une origine arbitraire
+     */
+    static qint64 nowMs();
+
+signals:
+    void stallDetected(const StallEvent& event);
+
+private slots:
+    void onStallFinished(const StallEvent& event);
+
+private:
+    static const int EVENT_CAPACITY = 200;
+    static const int HEARTBEAT_MS = 50;
+
+    QThread m_thread;
+    StallSampler *m_sampler;
+    QTimer m_heartbeat;
+    std::atomic<qint64> m_lastBeatMs;
+    QList<StallEvent> m_events;
+};
+
+#endif // STALLWATCHDOG_H
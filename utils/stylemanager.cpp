@@ -1,8 +1,10 @@
 #include "stylemanager.h"
 #include <QFont>
 #include <QFontDatabase>
+#include <QStyle>
 
 StyleManager* StyleManager::m_instance = nullptr;
+const char* const StyleManager::STYLE_CLASS = "styleClass";
 
 // Color definitions
 const QString StyleManager::Colors::PRIMARY = "#2563eb";
@@ -42,7 +44,80 @@ StyleManager& StyleManager::instance()
 void StyleManager::applyApplicationStyle()
 {
     QApplication::setStyle("Fusion");
-    qApp->setStyleSheet(getApplicationStyleSheet());
+    // A single stylesheet for the whole application: widgets opt in through the
+    // styleClass property instead of receiving their own stylesheet, which would
+    // make Qt parse it and re-polish the widget and its children every time
+    qApp->setStyleSheet(applicationStyleSheet());
+}
+
+const QString& StyleManager::applicationStyleSheet()
+{
+    if (m_applicationStyleSheet.isEmpty()) {
+        m_applicationStyleSheet = composeApplicationStyleSheet();
+    }
+    return m_applicationStyleSheet;
+}
+
+void StyleManager::setStyleClass(QWidget* widget, const QString& styleClass)
+{
+    setStyleState(widget, STYLE_CLASS, styleClass);
+}
+
+void StyleManager::setStyleState(QWidget* widget, const char* property, const QString& value)
+{
+    if (!widget || widget->property(property).toString() == value) {
+        return;
+    }
+    widget->setProperty(property, value);
+
+    // Not yet polished: the rules are resolved when the widget is first shown
+    if (widget->testAttribute(Qt::WA_WState_Polished)) {
+        widget->style()->unpolish(widget);
+        widget->style()->polish(widget);
+    }
+}
+
+QString StyleManager::scoped(QString styleSheet, const QStringList& types, const QString& styleClass,
+                             const QStringList& descendants)
+{
+    // Rules written for a single widget become rules for its style class:
+    // "QPushButton" -> "QPushButton[styleClass="primary"]", and descendant
+    // types (header, scroll bars) are nested under the first scoped type
+    const QString property = QString("[%1=\"%2\"]").arg(STYLE_CLASS, styleClass);
+    for (const QString& type : types) {
+        styleSheet.replace(type, type + property);
+    }
+    for (const QString& descendant : descendants) {
+        styleSheet.replace(descendant, types.first() + property + " " + descendant);
+    }
+    return styleSheet;
+}
+
+QString StyleManager::composeApplicationStyleSheet()
+{
+    QString styleSheet;
+    styleSheet += getApplicationStyleSheet();
+    styleSheet += scoped(getMainWindowStyleSheet(), {"QMainWindow"}, "main");
+    styleSheet += scoped(getTabWidgetStyleSheet(), {"QTabWidget"}, "main", {"QTabBar"});
+    styleSheet += scoped(getTableStyleSheet(), {"QTableWidget"}, "table", {"QHeaderView", "QScrollBar"});
+
+    for (const QString& type : {"primary", "success", "warning", "danger", "secondary"}) {
+        styleSheet += scoped(getButtonStyleSheet(type), {"QPushButton"}, type);
+    }
+
+    styleSheet += scoped(getGroupBoxStyleSheet(), {"QGroupBox"}, "section");
+    styleSheet += scoped(getInputStyleSheet(), {"QLineEdit", "QTextEdit", "QPlainTextEdit"}, "input");
+    styleSheet += scoped(getComboBoxStyleSheet(), {"QComboBox"}, "input");
+
+    for (const QString& type : {"normal", "title", "subtitle", "caption", "success", "warning", "danger"}) {
+        styleSheet += scoped(getLabelStyleSheet(type), {"QLabel"}, type);
+    }
+
+    styleSheet += scoped(getCardStyleSheet(), {"QWidget"}, "card");
+    styleSheet += scoped(getToolbarStyleSheet(), {"QWidget"}, "toolbar");
+    styleSheet += scoped(getFormStyleSheet(), {"QWidget"}, "form");
+    styleSheet += getViewStyleSheet();
+    return styleSheet;
 }
 
 QString StyleManager::getApplicationStyleSheet()
@@ -481,21 +556,21 @@ QString StyleManager::getLabelStyleSheet(const QString& type)
 void StyleManager::applyMainWindowStyle(QWidget* mainWindow)
 {
     if (mainWindow) {
-        mainWindow->setStyleSheet(getMainWindowStyleSheet());
+        setStyleClass(mainWindow, "main");
     }
 }
 
 void StyleManager::applyTabWidgetStyle(QTabWidget* tabWidget)
 {
     if (tabWidget) {
-        tabWidget->setStyleSheet(getTabWidgetStyleSheet());
+        setStyleClass(tabWidget, "main");
     }
 }
 
 void StyleManager::applyTableStyle(QTableWidget* table)
 {
     if (table) {
-        table->setStyleSheet(getTableStyleSheet());
+        setStyleClass(table, "table");
         table->setAlternatingRowColors(true);
         table->setSelectionBehavior(QAbstractItemView::SelectRows);
         table->setSelectionMode(QAbstractItemView::SingleSelection);
@@ -507,7 +582,7 @@ void StyleManager::applyTableStyle(QTableWidget* table)
 void StyleManager::applyButtonStyle(QPushButton* button, const QString& type)
 {
     if (button) {
-        button->setStyleSheet(getButtonStyleSheet(type));
+        setStyleClass(button, type);
         button->setCursor(Qt::PointingHandCursor);
     }
 }
@@ -515,28 +590,26 @@ void StyleManager::applyButtonStyle(QPushButton* button, const QString& type)
 void StyleManager::applyGroupBoxStyle(QGroupBox* groupBox)
 {
     if (groupBox) {
-        groupBox->setStyleSheet(getGroupBoxStyleSheet());
+        setStyleClass(groupBox, "section");
     }
 }
 
-void StyleManager::applyInputStyle(QLineEdit* input)
+void StyleManager::applyInputStyle(QWidget* input)
 {
-    if (input) {
-        input->setStyleSheet(getInputStyleSheet());
-    }
+    setStyleClass(input, "input");
 }
 
 void StyleManager::applyComboBoxStyle(QComboBox* combo)
 {
     if (combo) {
-        combo->setStyleSheet(getComboBoxStyleSheet());
+        setStyleClass(combo, "input");
     }
 }
 
 void StyleManager::applyLabelStyle(QLabel* label, const QString& type)
 {
     if (label) {
-        label->setStyleSheet(getLabelStyleSheet(type));
+        setStyleClass(label, type);
     }
 }
 
@@ -575,14 +648,14 @@ QString StyleManager::getToolbarStyleSheet()
 void StyleManager::applyCardStyle(QWidget* card)
 {
     if (card) {
-        card->setStyleSheet(getCardStyleSheet());
+        setStyleClass(card, "card");
     }
 }
 
 void StyleManager::applyToolbarStyle(QWidget* toolbar)
 {
     if (toolbar) {
-        toolbar->setStyleSheet(getToolbarStyleSheet());
+        setStyleClass(toolbar, "toolbar");
     }
 }
 
@@ -599,6 +672,84 @@ QString StyleManager::getFormStyleSheet()
 void StyleManager::applyFormStyle(QWidget* form)
 {
     if (form) {
-        form->setStyleSheet(getFormStyleSheet());
+        setStyleClass(form, "form");
     }
 }
+
+QString StyleManager::getViewStyleSheet()
+{
+    // Rules for the view-specific widgets (client form, statistics cards, status bar)
+    return QString(R"(
+        QLabel[styleClass="formTitle"] {
+            font-size: 16pt;
+            font-weight: bold;
+            color: #1f2937;
+            margin-bottom: 10px;
+        }
+
+        QLabel[styleClass="formLabel"] {
+            font-weight: 600;
+            color: #374151;
+        }
+
+        QLabel[styleClass="note"] {
+            color: #6b7280;
+            font-style: italic;
+            font-size: 9pt;
+            margin-top: 10px;
+        }
+
+        QDateEdit[styleClass="readonly"] {
+            background-color: #f3f4f6;
+            color: #6b7280;
+        }
+
+        QFrame[styleClass="separator"] {
+            color: #e5e7eb;
+        }
+
+        QGroupBox[styleClass="statCard"] {
+            font-weight: bold;
+            color: #1f2937;
+            background-color: #ffffff;
+            border: 1px solid #e5e7eb;
+            border-radius: 8px;
+            padding: 16px;
+        }
+
+        QLabel[styleClass="statCaption"] {
+            font-size: 12px;
+            color: #6b7280;
+        }
+
+        QProgressBar[styleClass="statProgress"] {
+            border: 2px solid #e5e7eb;
+            border-radius: 5px;
+            background-color: #f3f4f6;
+        }
+
+        QProgressBar[styleClass="statProgress"]::chunk {
+            background-color: #8b5cf6;
+            border-radius: 3px;
+        }
+
+        QWidget[styleClass="chart"] {
+            background-color: white;
+            border: 1px solid #e5e7eb;
+            border-radius: 8px;
+        }
+
+        QLabel[styleClass="clock"] {
+            color: blue;
+        }
+
+        QLabel[connection="unknown"] { color: gray; font-weight: bold; }
+        QLabel[connection="connected"] { color: green; font-weight: bold; }
+        QLabel[connection="degraded"] { color: orange; font-weight: bold; }
+        QLabel[connection="disconnected"] { color: red; font-weight: bold; }
+
+        QLabel[sla="ok"] { color: green; }
+        QLabel[sla="risk"] { color: orange; font-weight: bold; }
+        QLabel[sla="late"] { color: red; font-weight: bold; }
+    )");
+}
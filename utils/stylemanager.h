@@ -20,8 +20,12 @@ class StyleManager : public QObject
 
 public:
     static StyleManager& instance();
-    
-    // Apply styles to different components
+
+    // Dynamic property matched by the application stylesheet selectors
+    static const char* const STYLE_CLASS;
+
+    // Apply styles to different components (sets the style class; the rules
+    // themselves live in the application stylesheet)
     void applyApplicationStyle();
     void applyMainWindowStyle(QWidget* mainWindow);
     void applyTabWidgetStyle(QTabWidget* tabWidget);
@@ -31,10 +35,18 @@ public:
     void applyFormStyle(QWidget* form);
     void applyToolbarStyle(QWidget* toolbar);
     void applyCardStyle(QWidget* card);
-    void applyInputStyle(QLineEdit* input);
+    void applyInputStyle(QWidget* input);
     void applyComboBoxStyle(QComboBox* combo);
     void applyLabelStyle(QLabel* label, const QString& type = "normal");
     
+    // Opt a widget into a stylesheet rule, e.g. QLabel[styleClass="note"]
+    static void setStyleClass(QWidget* widget, const QString& styleClass);
+    // Change a state property (e.g. connection="disconnected") and re-polish the widget
+    static void setStyleState(QWidget* widget, const char* property, const QString& value);
+
+    // Complete application stylesheet, composed on first use and cached
+    const QString& applicationStyleSheet();
+
     // Get style strings
     QString getApplicationStyleSheet();
     QString getMainWindowStyleSheet();
@@ -76,7 +88,13 @@ public:
 
 private:
     StyleManager(QObject *parent = nullptr);
+    QString composeApplicationStyleSheet();
+    QString getViewStyleSheet();
+    static QString scoped(QString styleSheet, const QStringList& types, const QString& styleClass,
+                          const QStringList& descendants = QStringList());
+
     static StyleManager* m_instance;
+    QString m_applicationStyleSheet;
 };
 
 #endif // STYLEMANAGER_H
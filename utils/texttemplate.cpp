@@ -0,0 +1,84 @@
+#include "texttemplate.h"
+
+TextTemplate::TextTemplate(const QString& source)
+    : m_source(source)
+    , m_placeholderCount(0)
+    , m_literalSize(0)
+{
+    const int size = m_source.size();
+    int literalStart = 0;
+    int i = 0;
+
+    while (i < size) {
+        // Marqueur : '%' suivi d'un ou deux chiffres, %1 à %99
+        if (m_source.at(i) != '%' || i + 1 >= size || !m_source.at(i + 1).isDigit()) {
+            ++i;
+            continue;
+        }
+
+        int number = m_source.at(i + 1).digitValue();
+        int markerLength = 2;
+        if (i + 2 < size && m_source.at(i + 2).isDigit()) {
+            number = number * 10 + m_source.at(i + 2).digitValue();
+            markerLength = 3;
+        }
+        if (number == 0) {
+            ++i;
+            continue;
+        }
+
+        if (i > literalStart) {
+            m_segments.append({literalStart, i - literalStart, -1});
+            m_literalSize += i - literalStart;
+        }
+        m_segments.append({0, 0, number - 1});
+        m_placeholderCount = qMax(m_placeholderCount, number);
+
+        i += markerLength;
+        literalStart = i;
+    }
+
+    if (literalStart < size) {
+        m_segments.append({literalStart, size - literalStart, -1});
+        m_literalSize += size - literalStart;
+    }
+}
+
+QString TextTemplate::render(std::initializer_list<QString> values) const
+{
+    QString out;
+    out.reserve(m_literalSize + valuesSize(values));
+    renderTo(out, values);
+    return out;
+}
+
+void TextTemplate::renderTo(QString& out, std::initializer_list<QString> values) const
+{
+    const int count = static_cast<int>(values.size());
+    const QString* first = values.begin();
+
+    // Le tampon d'un appelant qui enchaîne les rendus ne grandit qu'une fois par ligne
+    const int required = out.size() + m_literalSize + valuesSize(values);
+    if (out.capacity() < required) {
+        out.reserve(qMax(required, out.capacity() * 2));
+    }
+
+    for (const Segment& segment : m_segments) {
+        if (segment.placeholder < 0) {
+            out.append(QStringView(m_source).mid(segment.offset, segment.length));
+        } else if (segment.placeholder < count) {
+            out.append(first[segment.placeholder]);
+        }
+    }
+}
+
+int TextTemplate::valuesSize(std::initializer_list<QString> values) const
+{
+    int total = 0;
+    for (const Segment& segment : m_segments) {
+        if (segment.placeholder >= 0 && segment.placeholder < static_cast<int>(values.size())) {
+            total += values.begin()[segment.placeholder].size();
+        }
+    }
+    return total;
+}
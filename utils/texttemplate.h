@@ -0,0 +1,69 @@
+#ifndef TEXTTEMPLATE_H
+#define TEXTTEMPLATE_H
+
+#include <QString>
+#include <QVector>
+#include <initializer_list>
+
+/**
+ * @brief Gabarit de texte compilé (emails, documents HTML)
+ *
+ * Le texte source utilise les marqueurs positionnels de QString::arg (%1 à
+ * %99). Il est découpé une seule fois en segments littéraux et marqueurs ;
+ * le rendu ajoute ensuite chaque segment dans un tampon réservé à la bonne
+ * taille, là où une chaîne de arg() recopie tout le texte à chaque appel.
+ * Contrairement à arg(), une valeur contenant "%2" n'est jamais réinterprétée.
+ *
+ * Utilisation : un gabarit statique par générateur, compilé au premier appel.
+ * @code
+ * static const TextTemplate tpl(R"(<p>Commande %1 pour %2</p>)");
+ * return tpl.render({commande->numeroCommande(), client->nom()});
+ * @endcode
+ */
+class TextTemplate
+{
+public:
+    explicit TextTemplate(const QString& source);
+
+    /**
+     * @brief Produit le texte final
+     * @param values Valeurs des marqueurs (%1 = première valeur) ; une valeur
+     *        absente est remplacée par une chaîne vide
+     * @return Texte rendu
+     */
+    QString render(std::initializer_list<QString> values) const;
+
+    /**
+     * @brief Ajoute le texte rendu à un tampon existant (lignes de tableau)
+     * @param out Tampon de destination
+     * @param values Valeurs des marqueurs
+     */
+    void renderTo(QString& out, std::initializer_list<QString> values) const;
+
+    /**
+     * @brief Nombre de marqueurs distincts attendus (plus grand numéro)
+     */
+    int placeholderCount() const { return m_placeholderCount; }
+
+    /**
+     * @brief Taille cumulée des segments littéraux
+     */
+    int literalSize() const { return m_literalSize; }
+
+private:
+    struct Segment {
+        int offset;             // Début dans m_source (littéral)
+        int length;             // Longueur du littéral
+        int placeholder;        // Index de la valeur, -1 pour un littéral
+    };
+
+    int valuesSize(std::initializer_list<QString> values) const;
+
+private:
+    QString m_source;
+    QVector<Segment> m_segments;
+    int m_placeholderCount;
+    int m_literalSize;
+};
+
+#endif // TEXTTEMPLATE_H
@@ -0,0 +1,213 @@
+#include "tracer.h"
+#include <QCoreApplication>
+#include <QThread>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QFile>
+#include <QTextStream>
+#include <QDebug>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace {
+
+struct TraceEvent {
+    const char* category;
+    const char* name;
+    qint64 startUs;
+    qint64 durationUs;
+};
+
+// Profondeur publiée des portées ouvertes (les plus profondes sont ignorées)
+const int MAX_ACTIVE_DEPTH = 32;
+
+struct ThreadBuffer {
+    QMutex mutex;
+    std::vector<TraceEvent> events;
+    int tid = 0;
+    QString threadName;
+    quint64 dropped = 0;
+
+    // Pile des portées ouvertes, lue sans verrou par les autres threads
+    QThread* thread = nullptr;
+    std::atomic<int> depth{0};
+    std::atomic<const char*> activeCategories[MAX_ACTIVE_DEPTH] = {};
+    std::atomic<const char*> activeNames[MAX_ACTIVE_DEPTH] = {};
+};
+
+// Borne mémoire : ~32 Mo par thread au maximum
+const size_t MAX_EVENTS_PER_THREAD = 1u << 20;
+
+const std::chrono::steady_clock::time_point g_origin = std::chrono::steady_clock::now();
+
+QMutex g_registryMutex;
+std::vector<std::shared_ptr<ThreadBuffer>> g_registry;
+
+thread_local std::shared_ptr<ThreadBuffer> t_buffer;
+
+ThreadBuffer* currentBuffer()
+{
+    if (!t_buffer) {
+        t_buffer = std::make_shared<ThreadBuffer>();
+        t_buffer->events.reserve(4096);
+
+        QThread* thread = QThread::currentThread();
+        t_buffer->thread = thread;
+        const bool isMain = QCoreApplication::instance()
+                            && thread == QCoreApplication::instance()->thread();
+        t_buffer->threadName = isMain ? QString("Main") : thread->objectName();
+
+        QMutexLocker locker(&g_registryMutex);
+        g_registry.push_back(t_buffer);
+        t_buffer->tid = static_cast<int>(g_registry.size());
+        if (t_buffer->threadName.isEmpty()) {
+            t_buffer->threadName = QString("Thread %1").arg(t_buffer->tid);
+        }
+    }
+    return t_buffer.get();
+}
+
+QString jsonEscape(const QString& text)
+{
+    QString escaped;
+    escaped.reserve(text.size() + 8);
+    for (const QChar c : text) {
+        switch (c.unicode()) {
+            case '"': escaped += "\\\""; break;
+            case '\\': escaped += "\\\\"; break;
+            case '\n': escaped += "\\n"; break;
+            case '\t': escaped += "\\t"; break;
+            default:
+                if (c.unicode() < 0x20) {
+                    escaped += QString("\\u%1").arg(c.unicode(), 4, 16, QChar('0'));
+                } else {
+                    escaped += c;
+                }
+        }
+    }
+    return escaped;
+}
+
+} // namespace
+
+qint64 Tracer::nowUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - g_origin).count();
+}
+
+void Tracer::record(const char* category, const char* name, qint64 startUs, qint64 durationUs)
+{
+    ThreadBuffer* buffer = currentBuffer();
+
+    // Verrou propre au thread : jamais disputé hors export
+    QMutexLocker locker(&buffer->mutex);
+    if (buffer->events.size() >= MAX_EVENTS_PER_THREAD) {
+        ++buffer->dropped;
+        return;
+    }
+    buffer->events.push_back({category, name, startUs, durationUs});
+}
+
+void Tracer::enterSpan(const char* category, const char* name)
+{
+    ThreadBuffer* buffer = currentBuffer();
+    const int depth = buffer->depth.load(std::memory_order_relaxed);
+    if (depth < MAX_ACTIVE_DEPTH) {
+        buffer->activeCategories[depth].store(category, std::memory_order_relaxed);
+        buffer->activeNames[depth].store(name, std::memory_order_relaxed);
+    }
+    buffer->depth.store(depth + 1, std::memory_order_release);
+}
+
+void Tracer::leaveSpan()
+{
+    ThreadBuffer* buffer = currentBuffer();
+    buffer->depth.store(qMax(0, buffer->depth.load(std::memory_order_relaxed) - 1),
+                        std::memory_order_release);
+}
+
+QStringList Tracer::activeSpans(QThread* thread)
+{
+    QStringList spans;
+
+    // Parcours inverse : une adresse de thread terminé peut être réutilisée
+    QMutexLocker registryLocker(&g_registryMutex);
+    for (auto it = g_registry.crbegin(); it != g_registry.crend(); ++it) {
+        const std::shared_ptr<ThreadBuffer>& buffer = *it;
+        if (buffer->thread != thread) {
+            continue;
+        }
+
+        // Lecture concurrente : la pile peut évoluer, les noms restent valides (littéraux)
+        const int depth = qMin(buffer->depth.load(std::memory_order_acquire), MAX_ACTIVE_DEPTH);
+        for (int i = 0; i < depth; ++i) {
+            const char* category = buffer->activeCategories[i].load(std::memory_order_relaxed);
+            const char* name = buffer->activeNames[i].load(std::memory_order_relaxed);
+            if (category && name) {
+                spans << QString::fromUtf8(category) + '/' + QString::fromUtf8(name);
+            }
+        }
+        break;
+    }
+    return spans;
+}
+
+bool Tracer::exportChromeTrace(const QString& filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate)) {
+        qWarning() << "Impossible d'écrire la trace:" << filePath << file.errorString();
+        return false;
+    }
+
+    QTextStream out(&file);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+    const qint64 pid = QCoreApplication::applicationPid();
+    bool first = true;
+    quint64 total = 0;
+
+    QMutexLocker registryLocker(&g_registryMutex);
+    for (const std::shared_ptr<ThreadBuffer>& buffer : g_registry) {
+        QMutexLocker locker(&buffer->mutex);
+
+        // Métadonnée : nom du thread dans la visionneuse
+        out << (first ? "" : ",\n")
+            << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid
+            << ",\"tid\":" << buffer->tid
+            << ",\"args\":{\"name\":\"" << jsonEscape(buffer->threadName) << "\"}}";
+        first = false;
+
+        for (const TraceEvent& event : buffer->events) {
+            out << ",\n{\"name\":\"" << jsonEscape(QString::fromUtf8(event.name))
+                << "\",\"cat\":\"" << jsonEscape(QString::fromUtf8(event.category))
+                << "\",\"ph\":\"X\",\"ts\":" << event.startUs
+                << ",\"dur\":" << event.durationUs
+                << ",\"pid\":" << pid << ",\"tid\":" << buffer->tid << "}";
+        }
+        total += buffer->events.size();
+
+        if (buffer->dropped > 0) {
+            qWarning() << "Trace:" << buffer->dropped << "portées perdues sur" << buffer->threadName;
+        }
+    }
+
+    out << "\n]}\n";
+    out.flush();
+
+    qInfo() << "Trace exportée:" << filePath << "(" << total << "portées)";
+    return file.error() == QFile::NoError;
+}
+
+void Tracer::clear()
+{
+    QMutexLocker registryLocker(&g_registryMutex);
+    for (const std::shared_ptr<ThreadBuffer>& buffer : g_registry) {
+        QMutexLocker locker(&buffer->mutex);
+        buffer->events.clear();
+        buffer->dropped = 0;
+    }
+}
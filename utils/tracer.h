@@ -0,0 +1,149 @@
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <QString>
+#include <QStringList>
+#include <QtGlobal>
+#include <atomic>
+
+QT_BEGIN_NAMESPACE
+class QThread;
+QT_END_NAMESPACE
+
+/**
+ * @brief Traçage léger par portées (spans) exportable au format Chrome trace
+ *
+ * Chaque thread écrit dans son propre tampon ; l'enregistrement d'une portée
+ * ne coûte qu'une lecture d'horloge à l'entrée et à la sortie. Les noms et
+ * catégories sont des littéraux (aucune allocation). Le fichier produit par
+ * exportChromeTrace() s'ouvre dans chrome://tracing ou Perfetto.
+ *
+ * Indépendamment de l'enregistrement, et tant que la publication est active
+ * (chien de garde démarré), chaque thread publie la pile de ses portées
+ * ouvertes : activeSpans() permet à un autre thread de savoir ce que fait
+ * un thread bloqué. Les deux drapeaux sont lus en ligne par TraceSpan : une
+ * portée sans enregistrement ni publication ne fait aucun appel.
+ *
+ * Utilisation : TRACE_SPAN("db", "executeQuery");
+ */
+namespace TracerFlags {
+inline std::atomic<bool> recording{false};
+inline std::atomic<bool> publishing{false};
+}
+
+class Tracer
+{
+public:
+    /**
+     * @brief Active ou désactive l'enregistrement (désactivé par défaut)
+     */
+    static void setEnabled(bool enabled)
+    {
+        TracerFlags::recording.store(enabled, std::memory_order_relaxed);
+    }
+
+    static bool isEnabled()
+    {
+        return TracerFlags::recording.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Active ou désactive la publication des portées ouvertes
+     *        (activée par le chien de garde, désactivée par défaut)
+     */
+    static void setPublishingActiveSpans(bool publishing)
+    {
+        TracerFlags::publishing.store(publishing, std::memory_order_relaxed);
+    }
+
+    static bool isPublishingActiveSpans()
+    {
+        return TracerFlags::publishing.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Enregistre une portée terminée
+     * @param category Catégorie (littéral : "view", "controller", "model", "db")
+     * @param name Nom de la portée (littéral)
+     * @param startUs Début en microsecondes depuis le démarrage du traceur
+     * @param durationUs Durée en microsecondes
+     */
+    static void record(const char* category, const char* name, qint64 startUs, qint64 durationUs);
+
+    /**
+     * @brief Horloge monotone du traceur
+     * @return Microsecondes depuis le démarrage du traceur
+     */
+    static qint64 nowUs();
+
+    /**
+     * @brief Empile / dépile une portée ouverte du thread courant (voir TraceSpan)
+     */
+    static void enterSpan(const char* category, const char* name);
+    static void leaveSpan();
+
+    /**
+     * @brief Portées ouvertes d'un thread, de la plus externe à la plus interne
+     * @param thread Thread observé (peut être bloqué)
+     * @return Liste "catégorie/nom", vide si le thread n'a jamais tracé
+     */
+    static QStringList activeSpans(QThread* thread);
+
+    /**
+     * @brief Exporte toutes les portées au format Chrome trace-event JSON
+     * @param filePath Chemin du fichier JSON
+     * @return true si l'export a réussi
+     */
+    static bool exportChromeTrace(const QString& filePath);
+
+    /**
+     * @brief Vide les tampons de tous les threads
+     */
+    static void clear();
+};
+
+/**
+ * @brief Portée RAII : publiée comme portée ouverte pendant sa durée de vie
+ *        si la publication est active, enregistrée à la destruction si le
+ *        traçage est actif
+ */
+class TraceSpan
+{
+public:
+    TraceSpan(const char* category, const char* name)
+        : m_category(category)
+        , m_name(name)
+        , m_startUs(Tracer::isEnabled() ? Tracer::nowUs() : -1)
+        , m_published(Tracer::isPublishingActiveSpans())
+    {
+        if (m_published) {
+            Tracer::enterSpan(category, name);
+        }
+    }
+
+    ~TraceSpan()
+    {
+        // Dépile même si la publication a été coupée entre-temps
+        if (m_published) {
+            Tracer::leaveSpan();
+        }
+        if (m_startUs >= 0) {
+            Tracer::record(m_category, m_name, m_startUs, Tracer::nowUs() - m_startUs);
+        }
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+private:
+    const char* m_category;
+    const char* m_name;
+    qint64 m_startUs;
+    bool m_published;
+};
+
+#define TRACE_SPAN_CONCAT_INNER(a, b) a##b
+#define TRACE_SPAN_CONCAT(a, b) TRACE_SPAN_CONCAT_INNER(a, b)
+#define TRACE_SPAN(category, name) TraceSpan TRACE_SPAN_CONCAT(traceSpan_, __LINE__)(category, name)
+
+#endif // TRACER_H
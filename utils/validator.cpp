@@ -1,5 +1,6 @@
 #include "validator.h"
 #include <QDebug>
+#include <array>
 
 // Définition des expressions régulières statiques
 const QRegularExpression Validator::s_emailRegex(R"(^[A-Za-z0-9._%+-]+@[A-Za-z0-9.-]+\.[A-Za-z]{2,}$)");
@@ -7,46 +8,160 @@ const QRegularExpression Validator::s_telephoneRegex(R"(^[0-9+\-\s\(\)]{8,20}$)"
 const QRegularExpression Validator::s_codePostalRegex(R"(^[0-9A-Za-z\-\s]{4,10}$)");
 const QRegularExpression Validator::s_nameRegex(R"(^[A-Za-zÀ-ÿ\s\-']{2,100}$)");
 
+namespace {
+
+// Classes de caractères des expressions régulières, pour les caractères ASCII
+enum CharClass : quint8 {
+    EMAIL_LOCAL = 1 << 0,       // [A-Za-z0-9._%+-]
+    EMAIL_DOMAIN = 1 << 1,      // [A-Za-z0-9.-]
+    ALPHA = 1 << 2,             // [A-Za-z]
+    PHONE = 1 << 3,             // [0-9+\-\s()]
+    POSTAL = 1 << 4,            // [0-9A-Za-z\-\s]
+    NAME = 1 << 5               // [A-Za-z\s\-'] (lettres accentuées : voie lente)
+};
+
+constexpr std::array<quint8, 128> buildClassTable()
+{
+    std::array<quint8, 128> table{};
+    for (int c = 0; c < 128; ++c) {
+        const bool alpha = (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
+        const bool digit = c >= '0' && c <= '9';
+        const bool space = c == ' ' || (c >= '\t' && c <= '\r');    // \s ASCII
+        quint8 bits = 0;
+        if (alpha || digit || c == '.' || c == '_' || c == '%' || c == '+' || c == '-') bits |= EMAIL_LOCAL;
+        if (alpha || digit || c == '.' || c == '-') bits |= EMAIL_DOMAIN;
+        if (alpha) bits |= ALPHA;
+        if (digit || space || c == '+' || c == '-' || c == '(' || c == ')') bits |= PHONE;
+        if (alpha || digit || space || c == '-') bits |= POSTAL;
+        if (alpha || space || c == '-' || c == '\'') bits |= NAME;
+        table[c] = bits;
+    }
+    return table;
+}
+
+constexpr std::array<quint8, 128> CLASS_TABLE = buildClassTable();
+
+bool isAscii(QStringView text)
+{
+    // Accumulation sans branchement : boucle vectorisable par le compilateur
+    char16_t high = 0;
+    for (const QChar c : text) {
+        high |= c.unicode();
+    }
+    return (high & 0xff80) == 0;
+}
+
+bool allInClass(QStringView text, quint8 charClass)
+{
+    // Texte ASCII uniquement (vérifié par l'appelant)
+    quint8 accumulated = charClass;
+    for (const QChar c : text) {
+        accumulated &= CLASS_TABLE[c.unicode() & 0x7f];
+    }
+    return accumulated == charClass;
+}
+
+} // namespace
+
 bool Validator::isValidName(const QString& nom, int minLength, int maxLength)
 {
-    QString cleanNom = cleanText(nom);
+    const QStringView cleanNom = QStringView(nom).trimmed();
     if (cleanNom.length() < minLength || cleanNom.length() > maxLength) {
         return false;
     }
-    return s_nameRegex.match(cleanNom).hasMatch();
+    return matchesName(cleanNom);
 }
 
 bool Validator::isValidEmail(const QString& email)
 {
-    QString cleanMail = cleanEmail(email);
+    const QStringView cleanMail = QStringView(email).trimmed();
     if (cleanMail.isEmpty() || cleanMail.length() > 150) {
         return false;
     }
-    return s_emailRegex.match(cleanMail).hasMatch();
+    // La mise en minuscules (cleanEmail) ne change rien à un email ASCII
+    if (!isAscii(cleanMail)) {
+        return s_emailRegex.match(cleanEmail(email)).hasMatch();
+    }
+    return matchesEmail(cleanMail);
 }
 
 bool Validator::isValidTelephone(const QString& telephone)
 {
-    QString cleanPhone = cleanTelephone(telephone);
+    const QStringView cleanPhone = QStringView(telephone).trimmed();
     if (cleanPhone.length() < 8 || cleanPhone.length() > 20) {
         return false;
     }
-    return s_telephoneRegex.match(cleanPhone).hasMatch();
+    return matchesTelephone(cleanPhone);
 }
 
 bool Validator::isValidAdresse(const QString& adresse, int minLength, int maxLength)
 {
-    QString cleanAddr = cleanText(adresse);
+    const QStringView cleanAddr = QStringView(adresse).trimmed();
     return !cleanAddr.isEmpty() && cleanAddr.length() >= minLength && cleanAddr.length() <= maxLength;
 }
 
 bool Validator::isValidCodePostal(const QString& codePostal)
 {
-    QString cleanCP = cleanText(codePostal);
+    const QStringView cleanCP = QStringView(codePostal).trimmed();
     if (cleanCP.length() < 4 || cleanCP.length() > 10) {
         return false;
     }
-    return s_codePostalRegex.match(cleanCP).hasMatch();
+    return matchesCodePostal(cleanCP);
+}
+
+bool Validator::matchesEmail(QStringView email)
+{
+    if (!isAscii(email)) {
+        return s_emailRegex.match(email.toString()).hasMatch();
+    }
+
+    // ^local+@domaine+\.[A-Za-z]{2,}$ : un seul '@', le domaine n'en contient pas
+    const qsizetype at = email.indexOf(u'@');
+    if (at <= 0 || !allInClass(email.left(at), EMAIL_LOCAL)) {
+        return false;
+    }
+    const QStringView domain = email.mid(at + 1);
+    if (!allInClass(domain, EMAIL_DOMAIN)) {
+        return false;
+    }
+    // Seul le dernier point peut précéder une extension entièrement alphabétique
+    const qsizetype dot = domain.lastIndexOf(u'.');
+    return dot >= 1 && domain.size() - dot - 1 >= 2 && allInClass(domain.mid(dot + 1), ALPHA);
+}
+
+bool Validator::matchesTelephone(QStringView telephone)
+{
+    if (telephone.size() < 8 || telephone.size() > 20) {
+        return false;
+    }
+    if (!isAscii(telephone)) {
+        // \s reconnaît aussi les espaces Unicode (espace insécable...)
+        return s_telephoneRegex.match(telephone.toString()).hasMatch();
+    }
+    return allInClass(telephone, PHONE);
+}
+
+bool Validator::matchesCodePostal(QStringView codePostal)
+{
+    if (codePostal.size() < 4 || codePostal.size() > 10) {
+        return false;
+    }
+    if (!isAscii(codePostal)) {
+        return s_codePostalRegex.match(codePostal.toString()).hasMatch();
+    }
+    return allInClass(codePostal, POSTAL);
+}
+
+bool Validator::matchesName(QStringView nom)
+{
+    if (nom.size() < 2 || nom.size() > 100) {
+        return false;
+    }
+    if (!isAscii(nom)) {
+        // Lettres accentuées (À-ÿ) et espaces Unicode
+        return s_nameRegex.match(nom.toString()).hasMatch();
+    }
+    return allInClass(nom, NAME);
 }
 
 bool Validator::isValidVille(const QString& ville, int minLength, int maxLength)
@@ -202,3 +317,68 @@ QStringList Validator::validateCommande(int idClient, const QDate& dateCommande,
     
     return errors;
 }
+
+Validator::BulkResult Validator::validateClients(const ClientRecord* records, qsizetype count)
+{
+    BulkResult result;
+    result.failures.fill(0, (count + 63) / 64);
+    result.errors.fill(0, count);
+
+    quint64* failures = result.failures.data();
+    quint8* errors = result.errors.data();
+
+    for (qsizetype i = 0; i < count; ++i) {
+        const ClientRecord& record = records[i];
+        quint8 mask = 0;
+
+        if (!isValidName(record.nom)) mask |= NOM_INVALIDE;
+        if (!isValidName(record.prenom)) mask |= PRENOM_INVALIDE;
+        if (!isValidEmail(record.email)) mask |= EMAIL_INVALIDE;
+        if (!isValidTelephone(record.telephone)) mask |= TELEPHONE_INVALIDE;
+        if (!isValidAdresse(record.adresse)) mask |= ADRESSE_INVALIDE;
+        if (!isValidVille(record.ville)) mask |= VILLE_INVALIDE;
+        if (!isValidCodePostal(record.codePostal)) mask |= CODE_POSTAL_INVALIDE;
+
+        errors[i] = mask;
+        if (mask) {
+            failures[i / 64] |= quint64(1) << (i % 64);
+            ++result.invalidCount;
+        }
+    }
+
+    return result;
+}
+
+Validator::BulkResult Validator::validateClients(const QList<ClientRecord>& records)
+{
+    return validateClients(records.constData(), records.size());
+}
+
+QStringList Validator::errorMessages(quint8 errors)
+{
+    QStringList messages;
+
+    if (errors & NOM_INVALIDE) {
+        messages << "Le nom doit contenir entre 2 et 100 caractères alphabétiques";
+    }
+    if (errors & PRENOM_INVALIDE) {
+        messages << "Le prénom doit contenir entre 2 et 100 caractères alphabétiques";
+    }
+    if (errors & EMAIL_INVALIDE) {
+        messages << "Format d'email invalide";
+    }
+    if (errors & TELEPHONE_INVALIDE) {
+        messages << "Le téléphone doit contenir entre 8 et 20 caractères numériques";
+    }
+    if (errors & ADRESSE_INVALIDE) {
+        messages << "L'adresse doit contenir entre 10 et 500 caractères";
+    }
+    if (errors & VILLE_INVALIDE) {
+        messages << "La ville doit contenir entre 2 et 100 caractères alphabétiques";
+    }
+    if (errors & CODE_POSTAL_INVALIDE) {
+        messages << "Le code postal doit contenir entre 4 et 10 caractères alphanumériques";
+    }
+
+    return messages;
+}
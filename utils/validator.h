@@ -4,6 +4,9 @@
 #include <QString>
 #include <QStringList>
 #include <QRegularExpression>
+#include <QStringView>
+#include <QVector>
+#include <QList>
 #include <QDate>
 
 /**
@@ -15,6 +18,43 @@
 class Validator
 {
 public:
+    /**
+     * @brief Codes d'erreur de la validation en masse (combinables)
+     */
+    enum ClientError : quint8 {
+        NOM_INVALIDE = 1 << 0,
+        PRENOM_INVALIDE = 1 << 1,
+        EMAIL_INVALIDE = 1 << 2,
+        TELEPHONE_INVALIDE = 1 << 3,
+        ADRESSE_INVALIDE = 1 << 4,
+        VILLE_INVALIDE = 1 << 5,
+        CODE_POSTAL_INVALIDE = 1 << 6
+    };
+
+    /**
+     * @brief Ligne client à valider (import en masse)
+     */
+    struct ClientRecord {
+        QString nom;
+        QString prenom;
+        QString email;
+        QString telephone;
+        QString adresse;
+        QString ville;
+        QString codePostal;
+    };
+
+    /**
+     * @brief Résultat d'une validation en masse
+     */
+    struct BulkResult {
+        QVector<quint64> failures;      // Bit i : ligne i invalide
+        QVector<quint8> errors;         // Combinaison de ClientError par ligne
+        qsizetype invalidCount = 0;
+
+        bool isValid(qsizetype row) const { return !(failures.at(row / 64) >> (row % 64) & 1); }
+    };
+
     /**
      * @brief Valide un nom ou prénom
      * @param nom Le nom à valider
@@ -170,6 +210,32 @@ public:
                                        const QString& villeLivraison, const QString& codePostalLivraison,
                                        double poidsTotal, double volumeTotal, double prixTotal);
 
+    /**
+     * @brief Valide des clients en masse, sans allocation par ligne
+     *
+     * Mêmes règles que validateClient(), sans produire de messages : les
+     * champs sont contrôlés par des parcours de classes de caractères ASCII,
+     * l'expression régulière n'étant utilisée que pour les caractères non ASCII.
+     *
+     * @param records Première ligne
+     * @param count Nombre de lignes
+     * @return Lignes invalides (bitmap) et codes d'erreur par ligne
+     */
+    static BulkResult validateClients(const ClientRecord* records, qsizetype count);
+    static BulkResult validateClients(const QList<ClientRecord>& records);
+
+    /**
+     * @brief Messages d'erreur correspondant à des codes de validateClients()
+     */
+    static QStringList errorMessages(quint8 errors);
+
+    // Contrôles de format sur une valeur déjà nettoyée (parcours ASCII, expression
+    // régulière en repli pour les caractères non ASCII)
+    static bool matchesEmail(QStringView email);
+    static bool matchesTelephone(QStringView telephone);
+    static bool matchesCodePostal(QStringView codePostal);
+    static bool matchesName(QStringView nom);
+
 private:
     // Expressions régulières statiques
     static const QRegularExpression s_emailRegex;
@@ -1,5 +1,6 @@
 #include "clientview.h"
 #include "utils/stylemanager.h"
+#include "utils/tracer.h"
 #include <QMessageBox>
 #include <QHeaderView>
 #include <QSplitter>
@@ -16,7 +17,7 @@ ClientView::ClientView(ClientController* controller, QWidget *parent)
     setupUI();
     applyStyles();
     connectSignals();
-    refreshData();
+    // Données chargées par refreshData() une fois la vue affichée (MainWindow)
 }
 
 ClientView::~ClientView()
@@ -127,7 +128,7 @@ void ClientView::applyStyles()
         styleManager.applyButtonStyle(m_cancelButton, "secondary");
 
         // Style the text area
-        m_formAdresse->setStyleSheet(styleManager.getInputStyleSheet());
+        styleManager.applyInputStyle(m_formAdresse);
     }
 }
 
@@ -139,6 +140,7 @@ void ClientView::createSearchSection()
     // Champs de recherche
     m_searchLayout->addWidget(new QLabel("Nom:"), 0, 0);
     m_searchNom = new QLineEdit();
+    m_searchNom->setObjectName("clientSearchNom");
     m_searchNom->setPlaceholderText("Rechercher par nom...");
     m_searchLayout->addWidget(m_searchNom, 0, 1);
     
@@ -149,6 +151,7 @@ void ClientView::createSearchSection()
     
     m_searchLayout->addWidget(new QLabel("Ville:"), 1, 0);
     m_searchVille = new QLineEdit();
+    m_searchVille->setObjectName("clientSearchVille");
     m_searchVille->setPlaceholderText("Rechercher par ville...");
     m_searchLayout->addWidget(m_searchVille, 1, 1);
     
@@ -169,6 +172,7 @@ void ClientView::createSearchSection()
     // Section de tri
     m_sortLabel = new QLabel("Trier par:");
     m_sortCombo = new QComboBox();
+    m_sortCombo->setObjectName("clientSortCombo");
     m_sortCombo->addItem("Nom", "nom");
     m_sortCombo->addItem("Prénom", "prenom");
     m_sortCombo->addItem("Email", "email");
@@ -189,6 +193,7 @@ void ClientView::createSearchSection()
 void ClientView::createClientTable()
 {
     m_clientTable = new QTableWidget(this);
+    m_clientTable->setObjectName("clientTable");
     m_clientTable->setColumnCount(8);
     
     QStringList headers;
@@ -225,7 +230,7 @@ void ClientView::createEditForm()
 
     // Form title
     QLabel* titleLabel = new QLabel("📝 Informations Client");
-    titleLabel->setStyleSheet("font-size: 16pt; font-weight: bold; color: #1f2937; margin-bottom: 10px;");
+    StyleManager::setStyleClass(titleLabel, "formTitle");
     m_formLayout->addRow(titleLabel);
 
     // Champs du formulaire avec placeholders
@@ -233,49 +238,49 @@ void ClientView::createEditForm()
     m_formNom->setMaxLength(100);
     m_formNom->setPlaceholderText("Entrez le nom du client");
     QLabel* nomLabel = new QLabel("👤 Nom *:");
-    nomLabel->setStyleSheet("font-weight: 600; color: #374151;");
+    StyleManager::setStyleClass(nomLabel, "formLabel");
     m_formLayout->addRow(nomLabel, m_formNom);
 
     m_formPrenom = new QLineEdit();
     m_formPrenom->setMaxLength(100);
     m_formPrenom->setPlaceholderText("Entrez le prénom du client");
     QLabel* prenomLabel = new QLabel("👤 Prénom *:");
-    prenomLabel->setStyleSheet("font-weight: 600; color: #374151;");
+    StyleManager::setStyleClass(prenomLabel, "formLabel");
     m_formLayout->addRow(prenomLabel, m_formPrenom);
 
     m_formEmail = new QLineEdit();
     m_formEmail->setMaxLength(150);
     m_formEmail->setPlaceholderText("exemple@email.com");
     QLabel* emailLabel = new QLabel("📧 Email *:");
-    emailLabel->setStyleSheet("font-weight: 600; color: #374151;");
+    StyleManager::setStyleClass(emailLabel, "formLabel");
     m_formLayout->addRow(emailLabel, m_formEmail);
 
     m_formTelephone = new QLineEdit();
     m_formTelephone->setMaxLength(20);
     m_formTelephone->setPlaceholderText("0123456789");
     QLabel* telLabel = new QLabel("📞 Téléphone *:");
-    telLabel->setStyleSheet("font-weight: 600; color: #374151;");
+    StyleManager::setStyleClass(telLabel, "formLabel");
     m_formLayout->addRow(telLabel, m_formTelephone);
 
     m_formAdresse = new QTextEdit();
     m_formAdresse->setMaximumHeight(80);
     m_formAdresse->setPlaceholderText("Adresse complète du client");
     QLabel* adresseLabel = new QLabel("🏠 Adresse *:");
-    adresseLabel->setStyleSheet("font-weight: 600; color: #374151;");
+    StyleManager::setStyleClass(adresseLabel, "formLabel");
     m_formLayout->addRow(adresseLabel, m_formAdresse);
 
     m_formVille = new QLineEdit();
     m_formVille->setMaxLength(100);
     m_formVille->setPlaceholderText("Ville");
     QLabel* villeLabel = new QLabel("🏙️ Ville *:");
-    villeLabel->setStyleSheet("font-weight: 600; color: #374151;");
+    StyleManager::setStyleClass(villeLabel, "formLabel");
     m_formLayout->addRow(villeLabel, m_formVille);
 
     m_formCodePostal = new QLineEdit();
     m_formCodePostal->setMaxLength(10);
     m_formCodePostal->setPlaceholderText("Code postal");
     QLabel* cpLabel = new QLabel("📮 Code postal *:");
-    cpLabel->setStyleSheet("font-weight: 600; color: #374151;");
+    StyleManager::setStyleClass(cpLabel, "formLabel");
     m_formLayout->addRow(cpLabel, m_formCodePostal);
 
     m_formStatut = new QComboBox();
@@ -283,20 +288,20 @@ void ClientView::createEditForm()
     m_formStatut->addItem("❌ Inactif", static_cast<int>(Client::INACTIF));
     m_formStatut->addItem("⏸️ Suspendu", static_cast<int>(Client::SUSPENDU));
     QLabel* statutLabel = new QLabel("📊 Statut:");
-    statutLabel->setStyleSheet("font-weight: 600; color: #374151;");
+    StyleManager::setStyleClass(statutLabel, "formLabel");
     m_formLayout->addRow(statutLabel, m_formStatut);
 
     m_formDateCreation = new QDateEdit(QDate::currentDate());
     m_formDateCreation->setEnabled(false);
-    m_formDateCreation->setStyleSheet("background-color: #f3f4f6; color: #6b7280;");
+    StyleManager::setStyleClass(m_formDateCreation, "readonly");
     QLabel* dateLabel = new QLabel("📅 Date de création:");
-    dateLabel->setStyleSheet("font-weight: 600; color: #374151;");
+    StyleManager::setStyleClass(dateLabel, "formLabel");
     m_formLayout->addRow(dateLabel, m_formDateCreation);
 
     // Separator
     QFrame* separator = new QFrame();
     separator->setFrameShape(QFrame::HLine);
-    separator->setStyleSheet("color: #e5e7eb;");
+    StyleManager::setStyleClass(separator, "separator");
     m_formLayout->addRow(separator);
 
     // Boutons du formulaire
@@ -312,7 +317,7 @@ void ClientView::createEditForm()
 
     // Note sur les champs obligatoires
     QLabel* noteLabel = new QLabel("* Champs obligatoires");
-    noteLabel->setStyleSheet("color: #6b7280; font-style: italic; font-size: 9pt; margin-top: 10px;");
+    StyleManager::setStyleClass(noteLabel, "note");
     m_formLayout->addRow(noteLabel);
 }
 
@@ -365,6 +370,7 @@ void ClientView::connectSignals()
 // Slots publics
 void ClientView::refreshData()
 {
+    TRACE_SPAN("view", "ClientView::refreshData");
     // Nettoyage des anciens clients
     for (Client* client : m_currentClients) {
         delete client;
@@ -489,6 +495,7 @@ void ClientView::onCancelEdit()
 // Recherche et tri
 void ClientView::onSearchClients()
 {
+    TRACE_SPAN("view", "ClientView::onSearchClients");
     ClientController::SearchCriteria criteria;
     criteria.nom = m_searchNom->text().trimmed();
     criteria.prenom = m_searchPrenom->text().trimmed();
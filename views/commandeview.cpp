@@ -6,6 +6,7 @@
 #include "utils/stylemanager.h"
 #include "utils/simpleemailmanager.h"
 #include "utils/simpleprintmanager.h"
+#include "utils/tracer.h"
 #include <QApplication>
 #include <QDebug>
 #include <QMessageBox>
@@ -22,7 +23,7 @@ CommandeView::CommandeView(CommandeController *controller, QWidget *parent)
 
     setupUI();
     applyStyles();
-    refreshData();
+    // Données chargées par refreshData() une fois la vue affichée (MainWindow)
 }
 
 void CommandeView::setupUI()
@@ -143,11 +144,14 @@ void CommandeView::setupFilters()
     // Search
     QLabel *searchLabel = new QLabel("Rechercher:", this);
     m_searchEdit = new QLineEdit(this);
+    m_searchEdit->setObjectName("commandeSearchEdit");
     m_searchButton = new QPushButton("Chercher", this);
+    m_searchButton->setObjectName("commandeSearchButton");
 
     // Status filter
     QLabel *statusLabel = new QLabel("Statut:", this);
     m_statusFilter = new QComboBox(this);
+    m_statusFilter->setObjectName("commandeStatusFilter");
     m_statusFilter->addItem("Tous", "");
     m_statusFilter->addItem("En Attente", "EN_ATTENTE");
     m_statusFilter->addItem("Confirmée", "CONFIRMEE");
@@ -187,6 +191,7 @@ void CommandeView::setupFilters()
 void CommandeView::setupTable()
 {
     m_tableWidget = new QTableWidget(this);
+    m_tableWidget->setObjectName("commandeTable");
 
     // Setup columns
     QStringList headers;
@@ -216,12 +221,14 @@ void CommandeView::setupTable()
 
 void CommandeView::refreshData()
 {
+    TRACE_SPAN("view", "CommandeView::refreshData");
     loadCommandes();
     updateTable();
 }
 
 void CommandeView::loadCommandes()
 {
+    TRACE_SPAN("view", "CommandeView::loadCommandes");
     if (m_controller) {
         // Clear old cache
         qDeleteAll(m_commandesCache);
@@ -240,6 +247,7 @@ void CommandeView::loadCommandes()
 
 void CommandeView::updateTable()
 {
+    TRACE_SPAN("view", "CommandeView::updateTable");
     m_tableWidget->setRowCount(m_commandes.size());
 
     for (int i = 0; i < m_commandes.size(); ++i) {
@@ -266,6 +274,9 @@ void CommandeView::updateTable()
             case Commande::LIVREE: statutText = "Livrée"; break;
             case Commande::ANNULEE: statutText = "Annulée"; break;
         }
+        if (commande->estArchivee()) {
+            statutText += " (archivée)";
+        }
         m_tableWidget->setItem(i, 4, new QTableWidgetItem(statutText));
 
         QString prioriteText;
@@ -307,9 +318,13 @@ void CommandeView::updateStatistics()
 // Slot implementations
 void CommandeView::onTableSelectionChanged()
 {
-    bool hasSelection = m_tableWidget->currentRow() >= 0;
-    m_editButton->setEnabled(hasSelection);
-    m_deleteButton->setEnabled(hasSelection);
+    const int currentRow = m_tableWidget->currentRow();
+    bool hasSelection = currentRow >= 0;
+    // Les commandes archivées sont en lecture seule
+    bool modifiable = hasSelection && currentRow < m_commandes.size()
+                      && !m_commandes[currentRow]->estArchivee();
+    m_editButton->setEnabled(modifiable);
+    m_deleteButton->setEnabled(modifiable);
     m_viewButton->setEnabled(hasSelection);
     m_printButton->setEnabled(hasSelection);
     m_emailButton->setEnabled(hasSelection);
@@ -396,6 +411,12 @@ void CommandeView::onEditCommande()
             return;
         }
 
+        if (commande->estArchivee()) {
+            QMessageBox::information(this, "Commande archivée",
+                "Cette commande est archivée et ne peut plus être modifiée.");
+            return;
+        }
+
         CommandeDialog dialog(commande, this);
         if (dialog.exec() == QDialog::Accepted) {
             // Validate before updating
@@ -445,6 +466,12 @@ void CommandeView::onDeleteCommande()
             return;
         }
 
+        if (commande->estArchivee()) {
+            QMessageBox::information(this, "Commande archivée",
+                "Cette commande est archivée et ne peut pas être supprimée.");
+            return;
+        }
+
         QMessageBox::StandardButton reply = QMessageBox::question(this,
             "Confirmer la suppression",
             QString("Êtes-vous sûr de vouloir supprimer la commande %1 ?")
@@ -484,6 +511,7 @@ void CommandeView::onViewCommande()
 
 void CommandeView::onSearchCommandes()
 {
+    TRACE_SPAN("view", "CommandeView::onSearchCommandes");
     try {
         QString searchText = m_searchEdit->text().trimmed();
 
@@ -898,7 +926,7 @@ void CommandeView::onEmailCommande()
         }
 
         if (success) {
-            QMessageBox::information(this, "Succès", "Email envoyé avec succès!");
+            QMessageBox::information(this, "Succès", "Email placé dans la file d'envoi.");
         }
 
         delete client;
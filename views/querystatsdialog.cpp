@@ -0,0 +1,125 @@
+#include "querystatsdialog.h"
+#include "database/queryprofiler.h"
+#include "database/databasemanager.h"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QTableWidget>
+#include <QHeaderView>
+#include <QPlainTextEdit>
+#include <QPushButton>
+#include <QLabel>
+#include <QStringList>
+
+namespace {
+const int TOP_QUERIES = 50;
+}
+
+QueryStatsDialog::QueryStatsDialog(QWidget *parent)
+    : QDialog(parent)
+    , m_statsTable(nullptr)
+    , m_slowQueriesText(nullptr)
+{
+    setWindowTitle("Statistiques des requêtes SQL");
+    resize(1100, 650);
+
+    setupUI();
+    refresh();
+}
+
+void QueryStatsDialog::setupUI()
+{
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+
+    mainLayout->addWidget(new QLabel("Requêtes classées par temps cumulé :"));
+
+    m_statsTable = new QTableWidget(0, 8, this);
+    m_statsTable->setHorizontalHeaderLabels({"Appels", "Total (ms)", "p50 (ms)", "p95 (ms)",
+                                             "p99 (ms)", "Max (ms)", "Lignes", "Requête"});
+    m_statsTable->horizontalHeader()->setStretchLastSection(true);
+    m_statsTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_statsTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+    m_statsTable->verticalHeader()->setVisible(false);
+    mainLayout->addWidget(m_statsTable, 3);
+
+    mainLayout->addWidget(new QLabel("Requêtes lentes récentes :"));
+
+    m_slowQueriesText = new QPlainTextEdit(this);
+    m_slowQueriesText->setReadOnly(true);
+    m_slowQueriesText->setLineWrapMode(QPlainTextEdit::NoWrap);
+    mainLayout->addWidget(m_slowQueriesText, 2);
+
+    QHBoxLayout *buttonLayout = new QHBoxLayout();
+    QPushButton *refreshButton = new QPushButton("Actualiser", this);
+    QPushButton *resetButton = new QPushButton("Réinitialiser", this);
+    QPushButton *closeButton = new QPushButton("Fermer", this);
+    buttonLayout->addWidget(refreshButton);
+    buttonLayout->addWidget(resetButton);
+    buttonLayout->addStretch();
+    buttonLayout->addWidget(closeButton);
+    mainLayout->addLayout(buttonLayout);
+
+    connect(refreshButton, &QPushButton::clicked, this, &QueryStatsDialog::refresh);
+    connect(resetButton, &QPushButton::clicked, this, &QueryStatsDialog::resetStats);
+    connect(closeButton, &QPushButton::clicked, this, &QDialog::accept);
+}
+
+void QueryStatsDialog::refresh()
+{
+    const QList<QueryProfiler::QueryStat> stats = QueryProfiler::instance().snapshot(TOP_QUERIES);
+
+    m_statsTable->setUpdatesEnabled(false);
+    m_statsTable->setRowCount(stats.size());
+
+    for (int row = 0; row < stats.size(); ++row) {
+        const QueryProfiler::QueryStat& stat = stats.at(row);
+        const QStringList cells = {
+            QString::number(stat.count),
+            QString::number(stat.totalMs, 'f', 1),
+            QString::number(stat.p50Ms, 'f', 2),
+            QString::number(stat.p95Ms, 'f', 2),
+            QString::number(stat.p99Ms, 'f', 2),
+            QString::number(stat.maxMs, 'f', 2),
+            QString::number(stat.rows),
+            stat.sql
+        };
+
+        for (int column = 0; column < cells.size(); ++column) {
+            QTableWidgetItem *item = new QTableWidgetItem(cells.at(column));
+            if (column < cells.size() - 1) {
+                item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+            } else {
+                item->setToolTip(stat.sql);
+            }
+            m_statsTable->setItem(row, column, item);
+        }
+    }
+
+    m_statsTable->resizeColumnsToContents();
+    m_statsTable->setUpdatesEnabled(true);
+
+    QStringList lines;
+    for (const QueryProfiler::SlowQuery& slow : QueryProfiler::instance().slowQueries()) {
+        QStringList params;
+        for (const QVariant& value : slow.params) {
+            params << value.toString();
+        }
+        lines << QString("[%1] %2 ms  %3  -- (%4)")
+                     .arg(slow.timestamp.toString("hh:mm:ss"))
+                     .arg(slow.elapsedMs, 0, 'f', 1)
+                     .arg(slow.sql, params.join(", "));
+    }
+
+    const DatabaseManager::RetryStats retry = DatabaseManager::instance().retryStats();
+    lines << QString()
+          << QString("Erreurs transitoires: %1 | rejeux requêtes: %2 | rejeux transactions: %3 | reconnexions: %4")
+                 .arg(retry.transientErrors).arg(retry.statementRetries)
+                 .arg(retry.transactionReplays).arg(retry.reconnects);
+
+    m_slowQueriesText->setPlainText(lines.join('\n'));
+}
+
+void QueryStatsDialog::resetStats()
+{
+    QueryProfiler::instance().reset();
+    refresh();
+}
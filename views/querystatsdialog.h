@@ -0,0 +1,41 @@
+#ifndef QUERYSTATSDIALOG_H
+#define QUERYSTATSDIALOG_H
+
+#include <QDialog>
+
+QT_BEGIN_NAMESPACE
+class QTableWidget;
+class QPlainTextEdit;
+QT_END_NAMESPACE
+
+/**
+ * @brief Panneau de diagnostic des requêtes SQL
+ *
+ * Affiche l'instantané de QueryProfiler (requêtes les plus coûteuses en
+ * temps cumulé) et le journal des requêtes lentes avec leurs paramètres.
+ */
+class QueryStatsDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit QueryStatsDialog(QWidget *parent = nullptr);
+
+public slots:
+    /**
+     * @brief Recharge l'instantané des statistiques
+     */
+    void refresh();
+
+private slots:
+    void resetStats();
+
+private:
+    void setupUI();
+
+private:
+    QTableWidget *m_statsTable;
+    QPlainTextEdit *m_slowQueriesText;
+};
+
+#endif // QUERYSTATSDIALOG_H
@@ -4,22 +4,28 @@
 #include "models/client.h"
 #include "models/commande.h"
 #include "utils/stylemanager.h"
+#include "utils/printmanager.h"
+#include "utils/tracer.h"
 #include <QApplication>
 #include <QDebug>
 #include <QHeaderView>
 #include <QFileDialog>
 #include <QMessageBox>
+#include <QMenu>
+#include <QCursor>
 #include <QDate>
 
-StatisticsView::StatisticsView(QWidget *parent)
+StatisticsView::StatisticsView(ClientController *clientController, CommandeController *commandeController,
+                               QWidget *parent)
     : QWidget(parent)
+    , m_clientController(clientController)
+    , m_commandeController(commandeController)
 {
-    m_clientController = new ClientController(this);
-    m_commandeController = new CommandeController(this);
+    m_printManager = new PrintManager(this);
 
     setupUI();
     applyStyles();
-    refreshData();
+    // Données chargées par refreshData() une fois la vue affichée (MainWindow)
 }
 
 void StatisticsView::setupUI()
@@ -58,6 +64,7 @@ void StatisticsView::applyStyles()
     // Apply button styling
     styleManager.applyButtonStyle(m_refreshButton, "primary");
     styleManager.applyButtonStyle(m_exportButton, "secondary");
+    styleManager.applyButtonStyle(m_printReportButton, "secondary");
 
     // Apply group box styling
     styleManager.applyGroupBoxStyle(m_overviewGroup);
@@ -104,6 +111,7 @@ void StatisticsView::setupToolbar()
     // Action buttons
     m_refreshButton = new QPushButton("Actualiser", this);
     m_exportButton = new QPushButton("Exporter Rapport", this);
+    m_printReportButton = new QPushButton("Imprimer", this);
 
     m_toolbarLayout->addWidget(periodLabel);
     m_toolbarLayout->addWidget(m_periodCombo);
@@ -114,6 +122,7 @@ void StatisticsView::setupToolbar()
     m_toolbarLayout->addStretch();
     m_toolbarLayout->addWidget(m_refreshButton);
     m_toolbarLayout->addWidget(m_exportButton);
+    m_toolbarLayout->addWidget(m_printReportButton);
 
     m_mainLayout->addLayout(m_toolbarLayout);
 
@@ -122,6 +131,7 @@ void StatisticsView::setupToolbar()
             this, &StatisticsView::onPeriodChanged);
     connect(m_refreshButton, &QPushButton::clicked, this, &StatisticsView::onRefreshCharts);
     connect(m_exportButton, &QPushButton::clicked, this, &StatisticsView::onExportReport);
+    connect(m_printReportButton, &QPushButton::clicked, this, &StatisticsView::onPrintReport);
 }
 
 void StatisticsView::setupOverviewCards()
@@ -131,62 +141,57 @@ void StatisticsView::setupOverviewCards()
 
     // Create cards with improved styling
     QGroupBox *clientsCard = new QGroupBox("👥 Clients", this);
-    clientsCard->setStyleSheet("QGroupBox { font-weight: bold; color: #1f2937; background-color: #ffffff; border: 1px solid #e5e7eb; border-radius: 8px; padding: 16px; }");
+    StyleManager::setStyleClass(clientsCard, "statCard");
     QVBoxLayout *clientsLayout = new QVBoxLayout(clientsCard);
     m_totalClientsLabel = new QLabel("0", this);
-    m_totalClientsLabel->setStyleSheet("font-size: 32px; font-weight: bold; color: #3b82f6; margin: 8px 0;");
     m_totalClientsLabel->setAlignment(Qt::AlignCenter);
     QLabel *clientsSubLabel = new QLabel("Total Clients", this);
-    clientsSubLabel->setStyleSheet("font-size: 12px; color: #6b7280; text-align: center;");
+    StyleManager::setStyleClass(clientsSubLabel, "statCaption");
     clientsSubLabel->setAlignment(Qt::AlignCenter);
     clientsLayout->addWidget(m_totalClientsLabel);
     clientsLayout->addWidget(clientsSubLabel);
 
     QGroupBox *commandesCard = new QGroupBox("📦 Commandes", this);
-    commandesCard->setStyleSheet("QGroupBox { font-weight: bold; color: #1f2937; background-color: #ffffff; border: 1px solid #e5e7eb; border-radius: 8px; padding: 16px; }");
+    StyleManager::setStyleClass(commandesCard, "statCard");
     QVBoxLayout *commandesLayout = new QVBoxLayout(commandesCard);
     m_totalCommandesLabel = new QLabel("0", this);
-    m_totalCommandesLabel->setStyleSheet("font-size: 32px; font-weight: bold; color: #10b981; margin: 8px 0;");
     m_totalCommandesLabel->setAlignment(Qt::AlignCenter);
     QLabel *commandesSubLabel = new QLabel("Total Commandes", this);
-    commandesSubLabel->setStyleSheet("font-size: 12px; color: #6b7280; text-align: center;");
+    StyleManager::setStyleClass(commandesSubLabel, "statCaption");
     commandesSubLabel->setAlignment(Qt::AlignCenter);
     commandesLayout->addWidget(m_totalCommandesLabel);
     commandesLayout->addWidget(commandesSubLabel);
 
     QGroupBox *caCard = new QGroupBox("💰 Chiffre d'Affaires", this);
-    caCard->setStyleSheet("QGroupBox { font-weight: bold; color: #1f2937; background-color: #ffffff; border: 1px solid #e5e7eb; border-radius: 8px; padding: 16px; }");
+    StyleManager::setStyleClass(caCard, "statCard");
     QVBoxLayout *caLayout = new QVBoxLayout(caCard);
     m_chiffresAffairesLabel = new QLabel("0 TND", this);
-    m_chiffresAffairesLabel->setStyleSheet("font-size: 32px; font-weight: bold; color: #f59e0b; margin: 8px 0;");
     m_chiffresAffairesLabel->setAlignment(Qt::AlignCenter);
     QLabel *caSubLabel = new QLabel("Chiffre d'Affaires", this);
-    caSubLabel->setStyleSheet("font-size: 12px; color: #6b7280; text-align: center;");
+    StyleManager::setStyleClass(caSubLabel, "statCaption");
     caSubLabel->setAlignment(Qt::AlignCenter);
     caLayout->addWidget(m_chiffresAffairesLabel);
     caLayout->addWidget(caSubLabel);
 
     QGroupBox *enCoursCard = new QGroupBox("⏳ En Cours", this);
-    enCoursCard->setStyleSheet("QGroupBox { font-weight: bold; color: #1f2937; background-color: #ffffff; border: 1px solid #e5e7eb; border-radius: 8px; padding: 16px; }");
+    StyleManager::setStyleClass(enCoursCard, "statCard");
     QVBoxLayout *enCoursLayout = new QVBoxLayout(enCoursCard);
     m_commandesEnCoursLabel = new QLabel("0", this);
-    m_commandesEnCoursLabel->setStyleSheet("font-size: 32px; font-weight: bold; color: #ef4444; margin: 8px 0;");
     m_commandesEnCoursLabel->setAlignment(Qt::AlignCenter);
     QLabel *enCoursSubLabel = new QLabel("Commandes en Cours", this);
-    enCoursSubLabel->setStyleSheet("font-size: 12px; color: #6b7280; text-align: center;");
+    StyleManager::setStyleClass(enCoursSubLabel, "statCaption");
     enCoursSubLabel->setAlignment(Qt::AlignCenter);
     enCoursLayout->addWidget(m_commandesEnCoursLabel);
     enCoursLayout->addWidget(enCoursSubLabel);
 
     QGroupBox *tauxCard = new QGroupBox("📈 Taux de Livraison", this);
-    tauxCard->setStyleSheet("QGroupBox { font-weight: bold; color: #1f2937; background-color: #ffffff; border: 1px solid #e5e7eb; border-radius: 8px; padding: 16px; }");
+    StyleManager::setStyleClass(tauxCard, "statCard");
     QVBoxLayout *tauxLayout = new QVBoxLayout(tauxCard);
     m_tauxLivraisonLabel = new QLabel("0%", this);
-    m_tauxLivraisonLabel->setStyleSheet("font-size: 28px; font-weight: bold; color: #8b5cf6; margin: 8px 0;");
     m_tauxLivraisonLabel->setAlignment(Qt::AlignCenter);
     m_tauxLivraisonBar = new QProgressBar(this);
     m_tauxLivraisonBar->setRange(0, 100);
-    m_tauxLivraisonBar->setStyleSheet("QProgressBar { border: 2px solid #e5e7eb; border-radius: 5px; background-color: #f3f4f6; } QProgressBar::chunk { background-color: #8b5cf6; border-radius: 3px; }");
+    StyleManager::setStyleClass(m_tauxLivraisonBar, "statProgress");
     tauxLayout->addWidget(m_tauxLivraisonLabel);
     tauxLayout->addWidget(m_tauxLivraisonBar);
 
@@ -207,48 +212,57 @@ void StatisticsView::setupCharts()
     m_statusPieChart = new PieChart(this);
     m_statusPieChart->setTitle("Répartition des Commandes par Statut");
     m_statusPieChart->setMinimumHeight(300);
-    m_statusPieChart->setStyleSheet("background-color: white; border: 1px solid #e5e7eb; border-radius: 8px;");
+    StyleManager::setStyleClass(m_statusPieChart, "chart");
 
     // Add sample data for status chart
-    m_statusPieChart->addSlice("En Attente", 25, QColor("#fbbf24"));    // Yellow
-    m_statusPieChart->addSlice("En Cours", 35, QColor("#3b82f6"));      // Blue
-    m_statusPieChart->addSlice("Expédiée", 30, QColor("#8b5cf6"));      // Purple
-    m_statusPieChart->addSlice("Livrée", 45, QColor("#10b981"));        // Green
-    m_statusPieChart->addSlice("Annulée", 5, QColor("#ef4444"));        // Red
+    m_statusPieChart->setData({
+        PieSlice("En Attente", 25, QColor("#fbbf24")),    // Yellow
+        PieSlice("En Cours", 35, QColor("#3b82f6")),      // Blue
+        PieSlice("Expédiée", 30, QColor("#8b5cf6")),      // Purple
+        PieSlice("Livrée", 45, QColor("#10b981")),        // Green
+        PieSlice("Annulée", 5, QColor("#ef4444"))         // Red
+    });
 
     // Create Priority distribution pie chart
     m_priorityPieChart = new PieChart(this);
     m_priorityPieChart->setTitle("Distribution des Commandes par Priorité");
     m_priorityPieChart->setMinimumHeight(300);
-    m_priorityPieChart->setStyleSheet("background-color: white; border: 1px solid #e5e7eb; border-radius: 8px;");
+    StyleManager::setStyleClass(m_priorityPieChart, "chart");
 
     // Add sample data for priority chart
-    m_priorityPieChart->addSlice("Faible", 15, QColor("#94a3b8"));       // Light Gray
-    m_priorityPieChart->addSlice("Normale", 25, QColor("#3b82f6"));      // Blue
-    m_priorityPieChart->addSlice("Élevée", 35, QColor("#f59e0b"));       // Orange
-    m_priorityPieChart->addSlice("Urgente", 20, QColor("#ef4444"));      // Red
-
-    // Enhanced Monthly evolution chart (keep as placeholder for now)
-    m_monthlyChartPlaceholder = new QLabel(this);
-    m_monthlyChartPlaceholder->setAlignment(Qt::AlignCenter);
-    m_monthlyChartPlaceholder->setMinimumHeight(350);
-    m_monthlyChartPlaceholder->setStyleSheet(R"(
-        QLabel {
-            background: qlineargradient(x1:0, y1:0, x2:1, y2:0,
-                stop:0 #10b981, stop:0.3 #06b6d4, stop:0.6 #3b82f6, stop:1 #8b5cf6);
-            border-radius: 12px;
-            color: white;
-            font-size: 14px;
-            font-weight: bold;
-            padding: 20px;
-        }
-    )");
-    m_monthlyChartPlaceholder->setText("📈 Évolution Mensuelle des Commandes\n\n📅 Tendance sur 12 mois\n📊 Moyenne: 32 commandes/mois\n📈 Croissance: +15% vs année précédente\n🎯 Pic: Décembre (48 commandes)");
+    m_priorityPieChart->setData({
+        PieSlice("Faible", 15, QColor("#94a3b8")),       // Light Gray
+        PieSlice("Normale", 25, QColor("#3b82f6")),      // Blue
+        PieSlice("Élevée", 35, QColor("#f59e0b")),       // Orange
+        PieSlice("Urgente", 20, QColor("#ef4444"))       // Red
+    });
+
+    // Order volume time series (daily or monthly)
+    QWidget *volumeContainer = new QWidget(this);
+    QVBoxLayout *volumeLayout = new QVBoxLayout(volumeContainer);
+    volumeLayout->setContentsMargins(0, 0, 0, 0);
+
+    QHBoxLayout *volumeToolbar = new QHBoxLayout();
+    volumeToolbar->addStretch();
+    volumeToolbar->addWidget(new QLabel("Granularité:", this));
+    m_volumeGranularityCombo = new QComboBox(this);
+    m_volumeGranularityCombo->addItems({"Par mois", "Par jour"});
+    connect(m_volumeGranularityCombo, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &StatisticsView::onVolumeGranularityChanged);
+    volumeToolbar->addWidget(m_volumeGranularityCombo);
+
+    m_volumeChart = new TimeSeriesChart(this);
+    m_volumeChart->setTitle("Évolution du Volume de Commandes");
+    m_volumeChart->setMinimumHeight(350);
+    m_volumeChart->setToolTip("Molette : zoom, glisser : déplacement, double-clic : vue complète");
+
+    volumeLayout->addLayout(volumeToolbar);
+    volumeLayout->addWidget(m_volumeChart);
 
     // Add charts to layout
     chartsLayout->addWidget(m_statusPieChart, 0, 0);
     chartsLayout->addWidget(m_priorityPieChart, 0, 1);
-    chartsLayout->addWidget(m_monthlyChartPlaceholder, 1, 0, 1, 2);
+    chartsLayout->addWidget(volumeContainer, 1, 0, 1, 2);
 }
 
 
@@ -295,10 +309,11 @@ void StatisticsView::setupTables()
 
 void StatisticsView::refreshData()
 {
+    TRACE_SPAN("view", "StatisticsView::refreshData");
     updateOverviewCards();
     updateStatusChart();
     updatePriorityChart();
-    updateMonthlyChart();
+    updateVolumeChart();
     updateTopClientsTable();
     updateRecentOrdersTable();
 }
@@ -342,9 +357,6 @@ void StatisticsView::updateStatusChart()
 {
     QList<Commande*> commandes = m_commandeController->getAllCommandes();
 
-    // Clear existing slices
-    m_statusPieChart->clearSlices();
-
     // Count by status
     QMap<Commande::Statut, int> statusCounts;
     for (Commande* commande : commandes) {
@@ -368,21 +380,20 @@ void StatisticsView::updateStatusChart()
     statusColors[Commande::LIVREE] = QColor("#10b981");          // Green
     statusColors[Commande::ANNULEE] = QColor("#ef4444");         // Red
 
-    // Add slices to pie chart
+    // Replace the pie chart data in one pass (only the differences are animated)
+    QVector<PieSlice> slices;
     for (auto it = statusCounts.begin(); it != statusCounts.end(); ++it) {
         if (it.value() > 0) {
-            m_statusPieChart->addSlice(statusNames[it.key()], it.value(), statusColors[it.key()]);
+            slices.append(PieSlice(statusNames[it.key()], it.value(), statusColors[it.key()]));
         }
     }
+    m_statusPieChart->setData(slices);
 }
 
 void StatisticsView::updatePriorityChart()
 {
     QList<Commande*> commandes = m_commandeController->getAllCommandes();
 
-    // Clear existing slices
-    m_priorityPieChart->clearSlices();
-
     // Count by priority
     QMap<Commande::Priorite, int> priorityCounts;
     for (Commande* commande : commandes) {
@@ -402,47 +413,55 @@ void StatisticsView::updatePriorityChart()
     priorityColors[Commande::HAUTE] = QColor("#f59e0b");     // Orange
     priorityColors[Commande::URGENTE] = QColor("#ef4444");   // Red
 
-    // Add slices to pie chart
+    // Replace the pie chart data in one pass (only the differences are animated)
+    QVector<PieSlice> slices;
     for (auto it = priorityCounts.begin(); it != priorityCounts.end(); ++it) {
         if (it.value() > 0) {
-            m_priorityPieChart->addSlice(priorityNames[it.key()], it.value(), priorityColors[it.key()]);
+            slices.append(PieSlice(priorityNames[it.key()], it.value(), priorityColors[it.key()]));
         }
     }
+    m_priorityPieChart->setData(slices);
 }
 
-void StatisticsView::updateMonthlyChart()
+void StatisticsView::updateVolumeChart()
 {
-    QList<Commande*> commandes = m_commandeController->getAllCommandes();
-
-    // Group by month
-    QMap<QString, int> monthlyData;
-    QDate currentDate = QDate::currentDate();
+    // Orders per day over the whole history, archived orders included
+    m_dailyVolume = m_commandeController->getVolumeParJour();
 
-    // Initialize last 6 months for display
-    for (int i = 5; i >= 0; --i) {
-        QDate monthDate = currentDate.addMonths(-i);
-        QString monthKey = monthDate.toString("yyyy-MM");
-        monthlyData[monthKey] = 0;
-    }
+    applyVolumeSeries();
+}
 
-    // Count orders by month
-    for (Commande* commande : commandes) {
-        QString monthKey = commande->dateCommande().toString("yyyy-MM");
-        if (monthlyData.contains(monthKey)) {
-            monthlyData[monthKey]++;
+void StatisticsView::applyVolumeSeries()
+{
+    QVector<qint64> timestamps;
+    QVector<double> values;
+
+    if (!m_dailyVolume.isEmpty()) {
+        const QDate first = m_dailyVolume.firstKey();
+        const QDate last = m_dailyVolume.lastKey();
+
+        if (m_volumeGranularityCombo->currentIndex() == 0) {
+            // Monthly totals, empty months included
+            QMap<QDate, int> monthly;
+            for (auto it = m_dailyVolume.constBegin(); it != m_dailyVolume.constEnd(); ++it) {
+                monthly[QDate(it.key().year(), it.key().month(), 1)] += it.value();
+            }
+            for (QDate month(first.year(), first.month(), 1); month <= last; month = month.addMonths(1)) {
+                timestamps.append(month.startOfDay().toMSecsSinceEpoch());
+                values.append(monthly.value(month, 0));
+            }
+        } else {
+            // Daily totals, days without orders included
+            timestamps.reserve(first.daysTo(last) + 1);
+            values.reserve(first.daysTo(last) + 1);
+            for (QDate day = first; day <= last; day = day.addDays(1)) {
+                timestamps.append(day.startOfDay().toMSecsSinceEpoch());
+                values.append(m_dailyVolume.value(day, 0));
+            }
         }
     }
 
-    // Update placeholder with monthly data
-    QString monthlyText = "Évolution Mensuelle:\n\n";
-    for (auto it = monthlyData.begin(); it != monthlyData.end(); ++it) {
-        QDate monthDate = QDate::fromString(it.key() + "-01", "yyyy-MM-dd");
-        monthlyText += QString("%1: %2 commandes\n")
-            .arg(monthDate.toString("MMM yyyy"))
-            .arg(it.value());
-    }
-
-    m_monthlyChartPlaceholder->setText(monthlyText);
+    m_volumeChart->setData(timestamps, values);
 }
 
 void StatisticsView::updateTopClientsTable()
@@ -557,6 +576,13 @@ void StatisticsView::onPeriodChanged()
     }
 }
 
+void StatisticsView::onVolumeGranularityChanged()
+{
+    // Daily counts are kept: switching granularity does not reload the orders
+    applyVolumeSeries();
+    m_volumeChart->resetZoom();
+}
+
 void StatisticsView::onRefreshCharts()
 {
     refreshData();
@@ -606,4 +632,38 @@ void StatisticsView::onExportReport()
     }
 }
 
+void StatisticsView::onPrintReport()
+{
+    // Rapports paginés lus en base par tranches, sur la période affichée
+    QMenu printMenu;
+    QAction* commandesAction = printMenu.addAction("Rapport des commandes de la période");
+    QAction* commandesPdfAction = printMenu.addAction("Rapport des commandes en PDF...");
+    QAction* clientsAction = printMenu.addAction("Liste des clients");
+
+    QAction* selectedAction = printMenu.exec(QCursor::pos());
+    const QDate debut = m_startDateEdit->date();
+    const QDate fin = m_endDateEdit->date();
+
+    if (selectedAction == commandesAction) {
+        m_printManager->printRapportCommandes(debut, fin);
+    } else if (selectedAction == clientsAction) {
+        m_printManager->printListeClients(true);
+    } else if (selectedAction == commandesPdfAction) {
+        const QString fileName = QFileDialog::getSaveFileName(this,
+            "Enregistrer le rapport des commandes",
+            QString("rapport_commandes_%1.pdf").arg(QDate::currentDate().toString("yyyy-MM-dd")),
+            "Documents PDF (*.pdf)");
+        if (fileName.isEmpty()) {
+            return;
+        }
+        if (m_printManager->saveRapportCommandesPdf(fileName, debut, fin)) {
+            QMessageBox::information(this, "Export réussi",
+                QString("Rapport de %1 commandes (%2 pages) enregistré vers:\n%3")
+                    .arg(m_printManager->lastReportRows()).arg(m_printManager->lastReportPages()).arg(fileName));
+        } else {
+            QMessageBox::warning(this, "Erreur d'export", "Impossible de générer le rapport PDF.");
+        }
+    }
+}
+
 // MOC include removed for compilation
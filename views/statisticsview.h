@@ -13,25 +13,38 @@
 #include <QDateEdit>
 #include <QProgressBar>
 #include <QScrollArea>
+#include <QMap>
+#include <QDate>
 #include "../widgets/piechart.h"
+#include "../widgets/timeserieschart.h"
 
 class ClientController;
 class CommandeController;
+class PrintManager;
 
 class StatisticsView : public QWidget
 {
     Q_OBJECT
 
 public:
-    explicit StatisticsView(QWidget *parent = nullptr);
+    /**
+     * @brief Construit la vue sur les contrôleurs partagés de la fenêtre principale
+     *
+     * Le contrôleur de commandes est celui suivi par SlaEngine : un changement
+     * de statut fait depuis cette vue met à jour les échéances et l'indicateur SLA.
+     */
+    StatisticsView(ClientController *clientController, CommandeController *commandeController,
+                   QWidget *parent = nullptr);
 
 public slots:
     void refreshData();
 
 private slots:
     void onExportReport();
+    void onPrintReport();
     void onRefreshCharts();
     void onPeriodChanged();
+    void onVolumeGranularityChanged();
 
 private:
     void setupUI();
@@ -44,7 +57,8 @@ private:
     void updateOverviewCards();
     void updateStatusChart();
     void updatePriorityChart();
-    void updateMonthlyChart();
+    void updateVolumeChart();
+    void applyVolumeSeries();
     void updateTopClientsTable();
     void updateRecentOrdersTable();
 
@@ -56,6 +70,7 @@ private:
     // Toolbar
     QHBoxLayout *m_toolbarLayout;
     QPushButton *m_exportButton;
+    QPushButton *m_printReportButton;
     QPushButton *m_refreshButton;
     QComboBox *m_periodCombo;
     QDateEdit *m_startDateEdit;
@@ -74,7 +89,9 @@ private:
     QGroupBox *m_chartsGroup;
     PieChart *m_statusPieChart;
     PieChart *m_priorityPieChart;
-    QLabel *m_monthlyChartPlaceholder;
+    TimeSeriesChart *m_volumeChart;
+    QComboBox *m_volumeGranularityCombo;
+    QMap<QDate, int> m_dailyVolume;     // Nombre de commandes par jour
 
     // Tables
     QGroupBox *m_tablesGroup;
@@ -84,6 +101,7 @@ private:
     // Controllers
     ClientController *m_clientController;
     CommandeController *m_commandeController;
+    PrintManager *m_printManager;
 };
 
 #endif // STATISTICSVIEW_H
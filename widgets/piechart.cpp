@@ -1,11 +1,24 @@
 #include "piechart.h"
 #include <QPaintEvent>
 #include <QResizeEvent>
+#include <QShowEvent>
+#include <QHideEvent>
 #include <QtMath>
 #include <QDebug>
+#include <QHash>
+
+namespace {
+const int INITIAL_ANIMATION_MS = 1500;
+const int DIFF_ANIMATION_MS = 400;
+}
 
 PieChart::PieChart(QWidget *parent)
     : QWidget(parent)
+    , m_diffAnimation(false)
+    , m_geometryDirty(true)
+    , m_cacheDirty(true)
+    , m_cacheComplete(false)
+    , m_animationPending(false)
     , m_showPercentages(true)
     , m_showLegend(true)
     , m_animated(true)
@@ -18,14 +31,16 @@ PieChart::PieChart(QWidget *parent)
     m_titleFont = QFont("Arial", 14, QFont::Bold);
     m_labelFont = QFont("Arial", 9, QFont::Normal);
     m_legendFont = QFont("Arial", 9, QFont::Normal);
-    
+
     // Setup animation
     m_animation = new QPropertyAnimation(this, "animationProgress");
-    m_animation->setDuration(1500);
+    m_animation->setDuration(INITIAL_ANIMATION_MS);
     m_animation->setStartValue(0.0);
     m_animation->setEndValue(1.0);
     m_animation->setEasingCurve(QEasingCurve::OutCubic);
-    
+
+    // Le widget peint toute sa surface (fond opaque)
+    setAttribute(Qt::WA_OpaquePaintEvent);
     setMinimumSize(300, 250);
 }
 
@@ -33,9 +48,11 @@ void PieChart::addSlice(const QString& label, double value, const QColor& color)
 {
     m_slices.append(PieSlice(label, value, color));
     calculateAngles();
-    
+    animateFromZero();
+    invalidateCache();
+
     if (m_animated) {
-        m_animation->start();
+        startAnimation();
     } else {
         m_animationProgress = 1.0;
         update();
@@ -44,26 +61,95 @@ void PieChart::addSlice(const QString& label, double value, const QColor& color)
 
 void PieChart::clearSlices()
 {
+    m_animation->stop();
+    m_animationPending = false;
     m_slices.clear();
+    m_fromAngles.clear();
     m_animationProgress = 0.0;
+    invalidateCache();
     update();
 }
 
+void PieChart::setData(const QVector<PieSlice>& slices)
+{
+    // Données inchangées : ni calcul ni repeint
+    if (slices.size() == m_slices.size()) {
+        bool identical = true;
+        for (int i = 0; i < slices.size() && identical; ++i) {
+            identical = slices.at(i).label == m_slices.at(i).label
+                        && slices.at(i).value == m_slices.at(i).value
+                        && slices.at(i).color == m_slices.at(i).color;
+        }
+        if (identical) {
+            return;
+        }
+    }
+
+    if (slices.isEmpty()) {
+        clearSlices();
+        return;
+    }
+
+    // Angles actuellement affichés (interpolés si une animation est en cours), par libellé
+    QHash<QString, QPair<int, int>> previous;
+    for (int i = 0; i < m_slices.size(); ++i) {
+        previous.insert(m_slices.at(i).label, displayedAngles(i, m_animationProgress));
+    }
+    const bool hadData = !m_slices.isEmpty() && m_animationProgress > 0.0;
+
+    m_animation->stop();
+    m_slices = QList<PieSlice>(slices.cbegin(), slices.cend());
+    calculateAngles();
+    invalidateCache();
+
+    if (!hadData) {
+        // Premier affichage : animation complète depuis zéro
+        animateFromZero();
+        if (m_animated) {
+            m_animation->setDuration(INITIAL_ANIMATION_MS);
+            startAnimation();
+        } else {
+            m_animationProgress = 1.0;
+            update();
+        }
+        return;
+    }
+
+    // Nouvelles parts : départ d'une étendue nulle à leur position finale
+    m_fromAngles.clear();
+    for (const PieSlice& slice : std::as_const(m_slices)) {
+        m_fromAngles.append(previous.value(slice.label, qMakePair(slice.startAngle, 0)));
+    }
+    m_diffAnimation = true;
+
+    if (m_animated && isVisible()) {
+        m_animationPending = false;
+        m_animation->setDuration(DIFF_ANIMATION_MS);
+        m_animation->start();
+    } else {
+        m_animationProgress = 1.0;
+        update();
+    }
+}
+
 void PieChart::setTitle(const QString& title)
 {
     m_title = title;
+    invalidateCache();
     update();
 }
 
 void PieChart::setShowPercentages(bool show)
 {
     m_showPercentages = show;
+    invalidateCache();
     update();
 }
 
 void PieChart::setShowLegend(bool show)
 {
     m_showLegend = show;
+    invalidateCache();
     update();
 }
 
@@ -85,29 +171,49 @@ QSize PieChart::minimumSizeHint() const
 void PieChart::paintEvent(QPaintEvent *event)
 {
     Q_UNUSED(event)
-    
-    QPainter painter(this);
-    painter.setRenderHint(QPainter::Antialiasing);
-    
-    // Clear background
-    painter.fillRect(rect(), QColor(255, 255, 255));
-    
-    if (m_slices.isEmpty()) {
-        return;
+
+    // Cache invalide ou écran de densité différente : nouveau rendu
+    if (m_cacheDirty || m_cache.devicePixelRatio() != devicePixelRatioF()
+        || m_cacheComplete != (m_animationProgress >= 1.0)) {
+        renderCache();
     }
-    
-    drawTitle(painter);
-    drawPieChart(painter);
-    
-    if (m_showLegend) {
-        drawLegend(painter);
+
+    QPainter painter(this);
+    painter.drawPixmap(0, 0, m_cache);
+
+    // Pendant l'animation, seules les parts sont redessinées
+    if (!m_cacheComplete && !m_slices.isEmpty() && m_animationProgress > 0.0) {
+        painter.setRenderHint(QPainter::Antialiasing);
+        drawPieChart(painter, m_animationProgress);
     }
 }
 
 void PieChart::resizeEvent(QResizeEvent *event)
 {
     Q_UNUSED(event)
-    calculateAngles();
+    invalidateCache();
+}
+
+void PieChart::showEvent(QShowEvent *event)
+{
+    QWidget::showEvent(event);
+
+    // Reprise de l'animation suspendue ou différée pendant que le widget était masqué
+    if (m_animationPending) {
+        m_animationPending = false;
+        m_animation->start();
+    } else if (m_animation->state() == QAbstractAnimation::Paused) {
+        m_animation->resume();
+    }
+}
+
+void PieChart::hideEvent(QHideEvent *event)
+{
+    QWidget::hideEvent(event);
+
+    if (m_animation->state() == QAbstractAnimation::Running) {
+        m_animation->pause();
+    }
 }
 
 void PieChart::updateAnimation()
@@ -120,17 +226,17 @@ void PieChart::calculateAngles()
     if (m_slices.isEmpty()) {
         return;
     }
-    
+
     // Calculate total value
     double total = 0.0;
     for (const auto& slice : m_slices) {
         total += slice.value;
     }
-    
+
     if (total <= 0) {
         return;
     }
-    
+
     // Calculate angles and percentages
     int currentAngle = 0; // Start from top (12 o'clock)
     for (auto& slice : m_slices) {
@@ -141,96 +247,183 @@ void PieChart::calculateAngles()
     }
 }
 
-void PieChart::drawPieChart(QPainter& painter)
+void PieChart::animateFromZero()
+{
+    m_fromAngles.clear();
+    for (const auto& slice : m_slices) {
+        m_fromAngles.append(qMakePair(slice.startAngle, 0));
+    }
+    m_diffAnimation = false;
+    m_animation->setDuration(INITIAL_ANIMATION_MS);
+}
+
+void PieChart::invalidateCache()
+{
+    m_geometryDirty = true;
+    m_cacheDirty = true;
+}
+
+void PieChart::startAnimation()
+{
+    // Widget masqué (onglet inactif) : l'animation démarrera à l'affichage
+    if (!isVisible()) {
+        m_animation->stop();
+        m_animationProgress = 0.0;
+        m_animationPending = true;
+        return;
+    }
+    m_animation->start();
+}
+
+void PieChart::updateGeometryCache()
+{
+    if (!m_geometryDirty) {
+        return;
+    }
+
+    ChartGeometry geometry;
+    geometry.titleRect = QRect(m_margin, m_margin, width() - 2 * m_margin, m_titleHeight);
+    geometry.pieRect = getPieRect();
+    geometry.legendRect = getLegendRect();
+
+    // Textes et métriques des pourcentages
+    const QFontMetrics labelMetrics(m_labelFont);
+    for (const auto& slice : m_slices) {
+        const QString percentText = QString("%1%").arg(slice.percentage, 0, 'f', 1);
+        geometry.percentTexts.append(percentText);
+        geometry.percentSizes.append(labelMetrics.boundingRect(percentText).size());
+    }
+
+    // Disposition de la légende
+    if (m_showLegend && geometry.legendRect.width() > 0 && geometry.legendRect.height() > 0) {
+        const QFontMetrics legendMetrics(m_legendFont);
+        const int lineHeight = legendMetrics.height() + 4;
+        const int colorBoxSize = 12;
+        int y = geometry.legendRect.top();
+
+        for (const auto& slice : m_slices) {
+            if (y + lineHeight > geometry.legendRect.bottom()) {
+                break; // Not enough space
+            }
+
+            geometry.legendColorRects.append(QRect(geometry.legendRect.left(), y + 2, colorBoxSize, colorBoxSize));
+            geometry.legendTextRects.append(QRect(geometry.legendRect.left() + colorBoxSize + 8, y,
+                                                  geometry.legendRect.width() - colorBoxSize - 8, lineHeight));
+            geometry.legendTexts.append(QString("%1 (%2%)").arg(slice.label).arg(slice.percentage, 0, 'f', 1));
+            y += lineHeight;
+        }
+    }
+
+    m_geometry = geometry;
+    m_geometryDirty = false;
+}
+
+void PieChart::renderCache()
+{
+    updateGeometryCache();
+
+    const qreal ratio = devicePixelRatioF();
+    m_cache = QPixmap(size() * ratio);
+    m_cache.setDevicePixelRatio(ratio);
+    m_cache.fill(QColor(255, 255, 255));
+
+    m_cacheComplete = m_animationProgress >= 1.0;
+    m_cacheDirty = false;
+
+    if (m_slices.isEmpty()) {
+        return;
+    }
+
+    QPainter painter(&m_cache);
+    painter.setRenderHint(QPainter::Antialiasing);
+
+    drawTitle(painter);
+    if (m_cacheComplete) {
+        drawPieChart(painter, 1.0);
+    }
+    if (m_showLegend) {
+        drawLegend(painter);
+    }
+}
+
+void PieChart::drawPieChart(QPainter& painter, double progress)
 {
-    QRect pieRect = getPieRect();
-    
+    const QRect& pieRect = m_geometry.pieRect;
+
     if (pieRect.width() <= 0 || pieRect.height() <= 0) {
         return;
     }
-    
+
+    const int radius = qMin(pieRect.width(), pieRect.height()) / 2;
+    const int labelRadius = radius * 0.7; // Position labels at 70% of radius
+    const QPoint center = pieRect.center();
+
     // Draw pie slices
-    for (const auto& slice : m_slices) {
-        // Apply animation progress
-        int animatedSpan = static_cast<int>(slice.spanAngle * m_animationProgress);
-        
+    for (int i = 0; i < m_slices.size(); ++i) {
+        const PieSlice& slice = m_slices.at(i);
+
+        const QPair<int, int> angles = displayedAngles(i, progress);
+        const int animatedStart = angles.first;
+        const int animatedSpan = angles.second;
+
         if (animatedSpan > 0) {
             painter.setBrush(slice.color);
             painter.setPen(QPen(Qt::white, 2));
-            painter.drawPie(pieRect, slice.startAngle, animatedSpan);
-            
+            painter.drawPie(pieRect, animatedStart, animatedSpan);
+
             // Draw percentage labels if enabled
-            if (m_showPercentages && m_animationProgress > 0.7) {
-                double midAngle = (slice.startAngle + animatedSpan / 2.0) / 16.0; // Convert to degrees
+            if (m_showPercentages && (progress > 0.7 || m_diffAnimation) && i < m_geometry.percentTexts.size()) {
+                double midAngle = (animatedStart + animatedSpan / 2.0) / 16.0; // Convert to degrees
                 double radians = qDegreesToRadians(midAngle);
-                
+
                 // Calculate label position
-                int radius = qMin(pieRect.width(), pieRect.height()) / 2;
-                int labelRadius = radius * 0.7; // Position labels at 70% of radius
-                
-                QPoint center = pieRect.center();
                 int x = center.x() + static_cast<int>(labelRadius * qSin(radians));
                 int y = center.y() - static_cast<int>(labelRadius * qCos(radians));
-                
-                // Draw percentage text
-                painter.setFont(m_labelFont);
-                painter.setPen(Qt::white);
-                
-                QString percentText = QString("%1%").arg(slice.percentage, 0, 'f', 1);
-                QFontMetrics fm(m_labelFont);
-                QRect textRect = fm.boundingRect(percentText);
+
+                QRect textRect(QPoint(0, 0), m_geometry.percentSizes.at(i));
                 textRect.moveCenter(QPoint(x, y));
-                
+
                 // Draw background for better readability
                 painter.setBrush(QColor(0, 0, 0, 100));
                 painter.setPen(Qt::NoPen);
                 painter.drawRoundedRect(textRect.adjusted(-4, -2, 4, 2), 3, 3);
-                
+
                 // Draw text
+                painter.setFont(m_labelFont);
                 painter.setPen(Qt::white);
                 painter.setBrush(Qt::NoBrush);
-                painter.drawText(textRect, Qt::AlignCenter, percentText);
+                painter.drawText(textRect, Qt::AlignCenter, m_geometry.percentTexts.at(i));
             }
         }
     }
 }
 
-void PieChart::drawLegend(QPainter& painter)
+QPair<int, int> PieChart::displayedAngles(int index, double progress) const
 {
-    QRect legendRect = getLegendRect();
+    const PieSlice& slice = m_slices.at(index);
 
-    if (legendRect.width() <= 0 || legendRect.height() <= 0) {
-        return;
-    }
+    // Interpolation entre les angles de départ et les angles finaux
+    const QPair<int, int> from = index < m_fromAngles.size()
+                                     ? m_fromAngles.at(index) : qMakePair(slice.startAngle, 0);
+    return qMakePair(from.first + static_cast<int>((slice.startAngle - from.first) * progress),
+                     from.second + static_cast<int>((slice.spanAngle - from.second) * progress));
+}
 
+void PieChart::drawLegend(QPainter& painter)
+{
     painter.setFont(m_legendFont);
-    QFontMetrics fm(m_legendFont);
-
-    int y = legendRect.top();
-    int lineHeight = fm.height() + 4;
-    int colorBoxSize = 12;
-
-    for (const auto& slice : m_slices) {
-        if (y + lineHeight > legendRect.bottom()) {
-            break; // Not enough space
-        }
 
+    for (int i = 0; i < m_geometry.legendTexts.size(); ++i) {
         // Draw color box
-        QRect colorRect(legendRect.left(), y + 2, colorBoxSize, colorBoxSize);
-        painter.setBrush(slice.color);
+        painter.setBrush(m_slices.at(i).color);
         painter.setPen(QPen(Qt::gray, 1));
-        painter.drawRoundedRect(colorRect, 2, 2);
+        painter.drawRoundedRect(m_geometry.legendColorRects.at(i), 2, 2);
 
         // Draw label and percentage
-        QString text = QString("%1 (%2%)").arg(slice.label).arg(slice.percentage, 0, 'f', 1);
-        QRect textRect(legendRect.left() + colorBoxSize + 8, y,
-                      legendRect.width() - colorBoxSize - 8, lineHeight);
-
         painter.setPen(QColor(60, 60, 60));
         painter.setBrush(Qt::NoBrush);
-        painter.drawText(textRect, Qt::AlignLeft | Qt::AlignVCenter, text);
-
-        y += lineHeight;
+        painter.drawText(m_geometry.legendTextRects.at(i), Qt::AlignLeft | Qt::AlignVCenter,
+                         m_geometry.legendTexts.at(i));
     }
 }
 
@@ -242,9 +435,7 @@ void PieChart::drawTitle(QPainter& painter)
 
     painter.setFont(m_titleFont);
     painter.setPen(QColor(40, 40, 40));
-
-    QRect titleRect(m_margin, m_margin, width() - 2 * m_margin, m_titleHeight);
-    painter.drawText(titleRect, Qt::AlignCenter, m_title);
+    painter.drawText(m_geometry.titleRect, Qt::AlignCenter, m_title);
 }
 
 QRect PieChart::getPieRect() const
@@ -283,5 +474,9 @@ QRect PieChart::getLegendRect() const
 void PieChart::setAnimationProgress(double progress)
 {
     m_animationProgress = qBound(0.0, progress, 1.0);
-    update();
+
+    // Seule la zone du graphique change pendant l'animation
+    if (isVisible()) {
+        update(m_geometry.pieRect.isValid() ? m_geometry.pieRect.adjusted(-2, -2, 2, 2) : rect());
+    }
 }
@@ -13,6 +13,8 @@
 #include <QString>
 #include <QTimer>
 #include <QPropertyAnimation>
+#include <QPixmap>
+#include <QVector>
 
 struct PieSlice {
     QString label;
@@ -36,6 +38,16 @@ public:
     
     void addSlice(const QString& label, double value, const QColor& color);
     void clearSlices();
+
+    /**
+     * @brief Remplace toutes les parts en une seule opération
+     *
+     * Les angles ne sont recalculés qu'une fois. Si des données étaient déjà
+     * affichées, seule la différence est animée (parts associées par libellé) ;
+     * des données identiques ne provoquent aucun repeint.
+     * @param slices Nouvelles parts (pourcentages et angles recalculés)
+     */
+    void setData(const QVector<PieSlice>& slices);
     void setTitle(const QString& title);
     void setShowPercentages(bool show);
     void setShowLegend(bool show);
@@ -47,13 +59,42 @@ public:
 protected:
     void paintEvent(QPaintEvent *event) override;
     void resizeEvent(QResizeEvent *event) override;
+    void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
 
 private slots:
     void updateAnimation();
 
 private:
+    /**
+     * @brief Géométrie précalculée (recalculée seulement si les données,
+     *        la taille ou les options d'affichage changent)
+     */
+    struct ChartGeometry {
+        QRect titleRect;
+        QRect pieRect;
+        QRect legendRect;
+        QVector<QString> percentTexts;
+        QVector<QSize> percentSizes;
+        QVector<QRect> legendColorRects;
+        QVector<QRect> legendTextRects;
+        QVector<QString> legendTexts;
+    };
+
     void calculateAngles();
-    void drawPieChart(QPainter& painter);
+    void animateFromZero();
+    void updateGeometryCache();
+    void invalidateCache();
+    void startAnimation();
+    void renderCache();
+    void drawPieChart(QPainter& painter, double progress);
+
+    /**
+     * @brief Angles (début, étendue) d'une part à un instant de l'animation
+     * @param index Indice de la part
+     * @param progress Avancement de l'animation (0 : départ, 1 : angles finaux)
+     */
+    QPair<int, int> displayedAngles(int index, double progress) const;
     void drawLegend(QPainter& painter);
     void drawTitle(QPainter& painter);
     QRect getPieRect() const;
@@ -64,6 +105,17 @@ private:
 
 private:
     QList<PieSlice> m_slices;
+    QVector<QPair<int, int>> m_fromAngles;  // Angles de départ (début, étendue) de l'animation
+    bool m_diffAnimation;
+    ChartGeometry m_geometry;
+    bool m_geometryDirty;
+
+    // Rendu mis en cache : fond, titre et légende pendant l'animation,
+    // graphique complet une fois l'animation terminée
+    QPixmap m_cache;
+    bool m_cacheDirty;
+    bool m_cacheComplete;
+    bool m_animationPending;
     QString m_title;
     bool m_showPercentages;
     bool m_showLegend;
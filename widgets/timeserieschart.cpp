@@ -0,0 +1,616 @@
+#include "timeserieschart.h"
+#include <QPainter>
+#include <QPaintEvent>
+#include <QResizeEvent>
+#include <QWheelEvent>
+#include <QMouseEvent>
+#include <QDateTime>
+#include <QPolygonF>
+#include <QtMath>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace {
+const qint64 MIN_SPAN_MS = 60 * 1000;   // Zoom maximal : une minute
+const double WHEEL_ZOOM_FACTOR = 0.85;  // Par cran de molette
+const int VALUE_TICKS = 5;
+const int TIME_TICKS = 6;
+}
+
+TimeSeriesChart::TimeSeriesChart(QWidget *parent)
+    : QWidget(parent)
+    , m_visibleFrom(0)
+    , m_visibleTo(0)
+    , m_autoRange(true)
+    , m_plotMin(0.0)
+    , m_plotMax(1.0)
+    , m_plotDirty(true)
+    , m_dragging(false)
+    , m_dragFrom(0)
+    , m_dragTo(0)
+    , m_seriesColor("#3b82f6")
+    , m_includeZero(true)
+    , m_margin(20)
+    , m_titleHeight(40)
+    , m_axisWidth(50)
+    , m_axisHeight(24)
+{
+    m_titleFont = QFont("Arial", 14, QFont::Bold);
+    m_axisFont = QFont("Arial", 8, QFont::Normal);
+
+    // Le widget peint toute sa surface (fond opaque)
+    setAttribute(Qt::WA_OpaquePaintEvent);
+    setMinimumSize(400, 250);
+}
+
+void TimeSeriesChart::setData(const QVector<qint64>& timestamps, const QVector<double>& values)
+{
+    if (timestamps.size() != values.size()) {
+        qWarning() << "TimeSeriesChart::setData: tailles différentes" << timestamps.size() << values.size();
+        return;
+    }
+
+    if (std::is_sorted(timestamps.cbegin(), timestamps.cend())) {
+        m_timestamps = timestamps;
+        m_values = values;
+    } else {
+        QVector<int> order(timestamps.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&timestamps](int a, int b) {
+            return timestamps.at(a) < timestamps.at(b);
+        });
+
+        m_timestamps.resize(order.size());
+        m_values.resize(order.size());
+        for (int i = 0; i < order.size(); ++i) {
+            m_timestamps[i] = timestamps.at(order.at(i));
+            m_values[i] = values.at(order.at(i));
+        }
+    }
+
+    rebuildPyramid();
+
+    // Le zoom de l'utilisateur est conservé (et borné aux nouvelles données)
+    applyRange(m_visibleFrom, m_visibleTo, m_autoRange);
+    invalidatePlot();
+}
+
+void TimeSeriesChart::append(qint64 timestamp, double value)
+{
+    const qint64 previousLast = m_timestamps.isEmpty() ? timestamp : m_timestamps.last();
+    if (appendPoint(timestamp, value)) {
+        followAppend(previousLast);
+    }
+}
+
+void TimeSeriesChart::append(const QVector<qint64>& timestamps, const QVector<double>& values)
+{
+    if (timestamps.size() != values.size()) {
+        qWarning() << "TimeSeriesChart::append: tailles différentes" << timestamps.size() << values.size();
+        return;
+    }
+    if (timestamps.isEmpty()) {
+        return;
+    }
+
+    const qint64 previousLast = m_timestamps.isEmpty() ? timestamps.first() : m_timestamps.last();
+    m_timestamps.reserve(m_timestamps.size() + timestamps.size());
+    m_values.reserve(m_values.size() + values.size());
+
+    bool appended = false;
+    for (int i = 0; i < timestamps.size(); ++i) {
+        appended |= appendPoint(timestamps.at(i), values.at(i));
+    }
+    if (appended) {
+        followAppend(previousLast);
+    }
+}
+
+void TimeSeriesChart::clear()
+{
+    m_timestamps.clear();
+    m_values.clear();
+    m_levels.clear();
+    m_autoRange = true;
+    m_visibleFrom = 0;
+    m_visibleTo = 0;
+    invalidatePlot();
+}
+
+void TimeSeriesChart::setVisibleRange(qint64 from, qint64 to)
+{
+    applyRange(from, to, false);
+}
+
+void TimeSeriesChart::resetZoom()
+{
+    applyRange(0, 0, true);
+}
+
+void TimeSeriesChart::setTitle(const QString& title)
+{
+    m_title = title;
+    update();
+}
+
+void TimeSeriesChart::setSeriesColor(const QColor& color)
+{
+    m_seriesColor = color;
+    update();
+}
+
+void TimeSeriesChart::setIncludeZero(bool includeZero)
+{
+    m_includeZero = includeZero;
+    invalidatePlot();
+}
+
+QSize TimeSeriesChart::sizeHint() const
+{
+    return QSize(800, 350);
+}
+
+QSize TimeSeriesChart::minimumSizeHint() const
+{
+    return QSize(400, 250);
+}
+
+bool TimeSeriesChart::appendPoint(qint64 timestamp, double value)
+{
+    if (!m_timestamps.isEmpty() && timestamp < m_timestamps.last()) {
+        qWarning() << "TimeSeriesChart: point antérieur à la fin de la série ignoré" << timestamp;
+        return false;
+    }
+
+    m_timestamps.append(timestamp);
+    m_values.append(value);
+    appendToPyramid(value);
+    return true;
+}
+
+void TimeSeriesChart::followAppend(qint64 previousLast)
+{
+    // Vue zoomée sur la fin de la série : la fenêtre glisse avec les nouveaux points
+    if (!m_autoRange && m_visibleTo >= previousLast) {
+        const qint64 delta = m_timestamps.last() - previousLast;
+        applyRange(m_visibleFrom + delta, m_visibleTo + delta, false);
+    } else {
+        applyRange(m_visibleFrom, m_visibleTo, m_autoRange);
+    }
+    invalidatePlot();
+}
+
+void TimeSeriesChart::rebuildPyramid()
+{
+    m_levels.clear();
+
+    // Un niveau de plus tant que le plus grossier compte plus d'un paquet
+    while ((m_levels.isEmpty() ? m_values.size() : m_levels.last().size()) > LEVEL_FACTOR) {
+        addLevel();
+    }
+}
+
+void TimeSeriesChart::appendToPyramid(double value)
+{
+    const int index = m_values.size() - 1;
+
+    for (int k = 0; k < m_levels.size(); ++k) {
+        QVector<Bucket>& level = m_levels[k];
+        const int bucket = index >> (LEVEL_SHIFT * (k + 1));
+
+        if (bucket == level.size()) {
+            level.append({value, value});
+        } else {
+            Bucket& current = level[bucket];
+            current.minValue = qMin(current.minValue, value);
+            current.maxValue = qMax(current.maxValue, value);
+        }
+    }
+
+    if ((m_levels.isEmpty() ? m_values.size() : m_levels.last().size()) > LEVEL_FACTOR) {
+        addLevel();
+    }
+}
+
+void TimeSeriesChart::addLevel()
+{
+    QVector<Bucket> level;
+
+    if (m_levels.isEmpty()) {
+        level.reserve(m_values.size() / LEVEL_FACTOR + 1);
+        for (int i = 0; i < m_values.size(); ++i) {
+            const double value = m_values.at(i);
+            if (i % LEVEL_FACTOR == 0) {
+                level.append({value, value});
+            } else {
+                Bucket& current = level.last();
+                current.minValue = qMin(current.minValue, value);
+                current.maxValue = qMax(current.maxValue, value);
+            }
+        }
+    } else {
+        const QVector<Bucket>& below = m_levels.last();
+        level.reserve(below.size() / LEVEL_FACTOR + 1);
+        for (int i = 0; i < below.size(); ++i) {
+            const Bucket& source = below.at(i);
+            if (i % LEVEL_FACTOR == 0) {
+                level.append(source);
+            } else {
+                Bucket& current = level.last();
+                current.minValue = qMin(current.minValue, source.minValue);
+                current.maxValue = qMax(current.maxValue, source.maxValue);
+            }
+        }
+    }
+
+    m_levels.append(level);
+}
+
+void TimeSeriesChart::applyRange(qint64 from, qint64 to, bool autoRange)
+{
+    const qint64 oldFrom = m_visibleFrom;
+    const qint64 oldTo = m_visibleTo;
+
+    if (m_timestamps.isEmpty()) {
+        m_autoRange = true;
+    } else {
+        qint64 dataFrom = m_timestamps.first();
+        qint64 dataTo = m_timestamps.last();
+        if (dataTo - dataFrom < MIN_SPAN_MS) {
+            dataFrom -= MIN_SPAN_MS / 2;
+            dataTo = dataFrom + MIN_SPAN_MS;
+        }
+
+        const qint64 span = qMax(to - from, MIN_SPAN_MS);
+        if (autoRange || span >= dataTo - dataFrom) {
+            m_visibleFrom = dataFrom;
+            m_visibleTo = dataTo;
+            m_autoRange = true;
+        } else {
+            // La fenêtre reste dans l'étendue des données
+            from = qBound(dataFrom, from, dataTo - span);
+            m_visibleFrom = from;
+            m_visibleTo = from + span;
+            m_autoRange = false;
+        }
+    }
+
+    if (m_visibleFrom != oldFrom || m_visibleTo != oldTo) {
+        invalidatePlot();
+        emit visibleRangeChanged(m_visibleFrom, m_visibleTo);
+    }
+}
+
+void TimeSeriesChart::invalidatePlot()
+{
+    m_plotDirty = true;
+    update();
+}
+
+void TimeSeriesChart::updatePlot()
+{
+    if (!m_plotDirty) {
+        return;
+    }
+    m_plotDirty = false;
+    m_plot.clear();
+
+    const QRect rect = plotRect();
+    if (m_timestamps.isEmpty() || rect.width() <= 0 || rect.height() <= 0
+        || m_visibleTo <= m_visibleFrom) {
+        return;
+    }
+
+    // Indices des points visibles
+    const auto begin = m_timestamps.cbegin();
+    const int first = std::lower_bound(begin, m_timestamps.cend(), m_visibleFrom) - begin;
+    const int last = std::upper_bound(begin, m_timestamps.cend(), m_visibleTo) - begin - 1;
+    const int columns = rect.width();
+    const double span = static_cast<double>(m_visibleTo - m_visibleFrom);
+
+    // m_plot reçoit d'abord (abscisse écran, valeur)
+    if (last - first + 1 <= 2 * columns) {
+        // Peu de points : tracé exact, prolongé d'un point de chaque côté jusqu'aux bords
+        const int from = qMax(0, first - 1);
+        const int to = qMin(m_timestamps.size() - 1, last + 1);
+        m_plot.reserve(to - from + 1);
+        for (int i = from; i <= to; ++i) {
+            m_plot.append(QPointF(rect.left() + (m_timestamps.at(i) - m_visibleFrom) * columns / span,
+                                  m_values.at(i)));
+        }
+    } else {
+        decimate(first, last, columns);
+        for (QPointF& point : m_plot) {
+            point.rx() += rect.left();
+        }
+    }
+
+    if (m_plot.isEmpty()) {
+        return;
+    }
+
+    // Échelle des valeurs sur la partie visible
+    double minValue = m_plot.first().y();
+    double maxValue = minValue;
+    for (const QPointF& point : std::as_const(m_plot)) {
+        minValue = qMin(minValue, point.y());
+        maxValue = qMax(maxValue, point.y());
+    }
+    if (m_includeZero) {
+        minValue = qMin(minValue, 0.0);
+        maxValue = qMax(maxValue, 0.0);
+    }
+    if (qFuzzyCompare(minValue, maxValue)) {
+        maxValue = minValue + 1.0;
+    }
+
+    const double step = niceStep(maxValue - minValue, VALUE_TICKS);
+    m_plotMin = qFloor(minValue / step) * step;
+    m_plotMax = qCeil(maxValue / step) * step;
+
+    const double scale = rect.height() / (m_plotMax - m_plotMin);
+    for (QPointF& point : m_plot) {
+        point.setY(rect.bottom() - (point.y() - m_plotMin) * scale);
+    }
+}
+
+void TimeSeriesChart::decimate(int first, int last, int columns)
+{
+    // Niveau le plus grossier offrant encore au moins deux paquets par colonne
+    const int count = last - first + 1;
+    int level = -1;
+    while (level + 1 < m_levels.size()
+           && (count >> (LEVEL_SHIFT * (level + 2))) >= 2 * columns) {
+        ++level;
+    }
+
+    QVector<double> columnMin(columns);
+    QVector<double> columnMax(columns);
+    QVector<bool> used(columns, false);
+    const double span = static_cast<double>(m_visibleTo - m_visibleFrom);
+
+    auto accumulate = [&](qint64 timestamp, double minValue, double maxValue) {
+        const int column = qBound(0, static_cast<int>((timestamp - m_visibleFrom) * columns / span), columns - 1);
+        if (!used.at(column)) {
+            used[column] = true;
+            columnMin[column] = minValue;
+            columnMax[column] = maxValue;
+        } else {
+            columnMin[column] = qMin(columnMin.at(column), minValue);
+            columnMax[column] = qMax(columnMax.at(column), maxValue);
+        }
+    };
+
+    if (level < 0) {
+        for (int i = first; i <= last; ++i) {
+            accumulate(m_timestamps.at(i), m_values.at(i), m_values.at(i));
+        }
+    } else {
+        // Un paquet couvre moins d'une demi-colonne : il est placé sur son premier point
+        const int shift = LEVEL_SHIFT * (level + 1);
+        const QVector<Bucket>& buckets = m_levels.at(level);
+        for (int b = first >> shift; b <= (last >> shift); ++b) {
+            const Bucket& bucket = buckets.at(b);
+            accumulate(m_timestamps.at(qMax(first, b << shift)), bucket.minValue, bucket.maxValue);
+        }
+    }
+
+    // Un segment vertical minimum-maximum par colonne
+    m_plot.reserve(2 * columns);
+    for (int column = 0; column < columns; ++column) {
+        if (used.at(column)) {
+            m_plot.append(QPointF(column + 0.5, columnMin.at(column)));
+            m_plot.append(QPointF(column + 0.5, columnMax.at(column)));
+        }
+    }
+}
+
+QRect TimeSeriesChart::plotRect() const
+{
+    const int top = m_margin + m_titleHeight;
+    const int left = m_margin + m_axisWidth;
+    return QRect(left, top,
+                 width() - left - m_margin,
+                 height() - top - m_margin - m_axisHeight);
+}
+
+void TimeSeriesChart::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event)
+
+    QPainter painter(this);
+    painter.fillRect(rect(), QColor(255, 255, 255));
+
+    if (!m_title.isEmpty()) {
+        painter.setFont(m_titleFont);
+        painter.setPen(QColor(50, 50, 50));
+        painter.drawText(QRect(m_margin, m_margin, width() - 2 * m_margin, m_titleHeight),
+                         Qt::AlignCenter, m_title);
+    }
+
+    const QRect plot = plotRect();
+    if (plot.width() <= 0 || plot.height() <= 0) {
+        return;
+    }
+
+    if (m_timestamps.isEmpty()) {
+        painter.setFont(m_axisFont);
+        painter.setPen(QColor(120, 120, 120));
+        painter.drawText(plot, Qt::AlignCenter, "Aucune donnée");
+        return;
+    }
+
+    updatePlot();
+    drawAxes(painter, plot);
+
+    if (m_plot.isEmpty()) {
+        return;
+    }
+
+    painter.setClipRect(plot.adjusted(0, 0, 1, 1));
+    painter.setRenderHint(QPainter::Antialiasing);
+
+    // Aire sous la courbe
+    QPolygonF area(m_plot);
+    area.prepend(QPointF(m_plot.first().x(), plot.bottom()));
+    area.append(QPointF(m_plot.last().x(), plot.bottom()));
+    QColor fill = m_seriesColor;
+    fill.setAlpha(40);
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(fill);
+    painter.drawPolygon(area);
+
+    painter.setPen(QPen(m_seriesColor, 1.5));
+    painter.setBrush(Qt::NoBrush);
+    painter.drawPolyline(m_plot.constData(), m_plot.size());
+}
+
+void TimeSeriesChart::drawAxes(QPainter& painter, const QRect& rect)
+{
+    painter.setFont(m_axisFont);
+    const QFontMetrics metrics(m_axisFont);
+
+    // Axe des valeurs et quadrillage horizontal
+    const double step = niceStep(m_plotMax - m_plotMin, VALUE_TICKS);
+    const double scale = rect.height() / (m_plotMax - m_plotMin);
+    for (double value = m_plotMin; value <= m_plotMax + step / 2; value += step) {
+        const int y = rect.bottom() - qRound((value - m_plotMin) * scale);
+        painter.setPen(QColor(229, 231, 235));
+        painter.drawLine(rect.left(), y, rect.right(), y);
+
+        const QString label = step >= 1.0 ? QString::number(value, 'f', 0) : QString::number(value, 'g', 4);
+        painter.setPen(QColor(100, 100, 100));
+        painter.drawText(QRect(m_margin, y - metrics.height() / 2, m_axisWidth - 6, metrics.height()),
+                         Qt::AlignRight | Qt::AlignVCenter, label);
+    }
+
+    // Axe du temps
+    const qint64 span = m_visibleTo - m_visibleFrom;
+    for (int i = 0; i <= TIME_TICKS; ++i) {
+        const int x = rect.left() + rect.width() * i / TIME_TICKS;
+        const qint64 timestamp = m_visibleFrom + span * i / TIME_TICKS;
+        painter.setPen(QColor(180, 180, 180));
+        painter.drawLine(x, rect.bottom(), x, rect.bottom() + 4);
+
+        const QString label = formatTimestamp(timestamp, span);
+        const int labelWidth = metrics.horizontalAdvance(label);
+        const int labelX = qBound(0, x - labelWidth / 2, width() - labelWidth);
+        painter.setPen(QColor(100, 100, 100));
+        painter.drawText(QRect(labelX, rect.bottom() + 6, labelWidth, metrics.height()),
+                         Qt::AlignCenter, label);
+    }
+
+    painter.setPen(QColor(180, 180, 180));
+    painter.drawLine(rect.bottomLeft(), rect.bottomRight());
+}
+
+QString TimeSeriesChart::formatTimestamp(qint64 timestamp, qint64 span) const
+{
+    const qint64 day = 24LL * 3600 * 1000;
+    const QDateTime dateTime = QDateTime::fromMSecsSinceEpoch(timestamp);
+
+    if (span > 3 * 365 * day) {
+        return dateTime.toString("yyyy");
+    }
+    if (span > 90 * day) {
+        return dateTime.toString("MMM yyyy");
+    }
+    if (span > 2 * day) {
+        return dateTime.toString("dd/MM/yyyy");
+    }
+    return dateTime.toString("dd/MM hh:mm");
+}
+
+double TimeSeriesChart::niceStep(double range, int ticks)
+{
+    const double raw = range / qMax(1, ticks);
+    const double magnitude = qPow(10.0, qFloor(std::log10(raw)));
+    const double normalized = raw / magnitude;
+
+    if (normalized <= 1.0) {
+        return magnitude;
+    }
+    if (normalized <= 2.0) {
+        return 2.0 * magnitude;
+    }
+    if (normalized <= 5.0) {
+        return 5.0 * magnitude;
+    }
+    return 10.0 * magnitude;
+}
+
+void TimeSeriesChart::resizeEvent(QResizeEvent *event)
+{
+    Q_UNUSED(event)
+    invalidatePlot();
+}
+
+void TimeSeriesChart::wheelEvent(QWheelEvent *event)
+{
+    const QRect plot = plotRect();
+    if (m_timestamps.isEmpty() || plot.width() <= 0) {
+        event->ignore();
+        return;
+    }
+
+    // Zoom centré sur l'instant sous le curseur
+    const double factor = qPow(WHEEL_ZOOM_FACTOR, event->angleDelta().y() / 120.0);
+    const double ratio = qBound(0.0, (event->position().x() - plot.left()) / plot.width(), 1.0);
+    const double span = static_cast<double>(m_visibleTo - m_visibleFrom);
+    const qint64 anchor = m_visibleFrom + static_cast<qint64>(span * ratio);
+    const qint64 newSpan = static_cast<qint64>(span * factor);
+    const qint64 from = anchor - static_cast<qint64>(newSpan * ratio);
+
+    applyRange(from, from + newSpan, false);
+    event->accept();
+}
+
+void TimeSeriesChart::mousePressEvent(QMouseEvent *event)
+{
+    if (event->button() == Qt::LeftButton && plotRect().contains(event->pos())) {
+        m_dragging = true;
+        m_dragOrigin = event->pos();
+        m_dragFrom = m_visibleFrom;
+        m_dragTo = m_visibleTo;
+        setCursor(Qt::ClosedHandCursor);
+        event->accept();
+        return;
+    }
+    QWidget::mousePressEvent(event);
+}
+
+void TimeSeriesChart::mouseMoveEvent(QMouseEvent *event)
+{
+    if (!m_dragging) {
+        QWidget::mouseMoveEvent(event);
+        return;
+    }
+
+    const int plotWidth = qMax(1, plotRect().width());
+    const qint64 shift = static_cast<qint64>(
+        -static_cast<double>(event->pos().x() - m_dragOrigin.x()) * (m_dragTo - m_dragFrom) / plotWidth);
+    applyRange(m_dragFrom + shift, m_dragTo + shift, false);
+}
+
+void TimeSeriesChart::mouseReleaseEvent(QMouseEvent *event)
+{
+    if (m_dragging && event->button() == Qt::LeftButton) {
+        m_dragging = false;
+        unsetCursor();
+        event->accept();
+        return;
+    }
+    QWidget::mouseReleaseEvent(event);
+}
+
+void TimeSeriesChart::mouseDoubleClickEvent(QMouseEvent *event)
+{
+    if (event->button() == Qt::LeftButton) {
+        resetZoom();
+        event->accept();
+        return;
+    }
+    QWidget::mouseDoubleClickEvent(event);
+}
@@ -0,0 +1,139 @@
+#ifndef TIMESERIESCHART_H
+#define TIMESERIESCHART_H
+
+#include <QWidget>
+#include <QColor>
+#include <QFont>
+#include <QPoint>
+#include <QPointF>
+#include <QRect>
+#include <QString>
+#include <QVector>
+
+/**
+ * @brief Graphique de série temporelle pour de grands volumes de points
+ *
+ * Les points (horodatage en millisecondes depuis l'époque, valeur) sont
+ * résumés dans une pyramide de niveaux de détail : chaque niveau regroupe
+ * les points par paquets de 4, 16, 64... en conservant minimum et maximum.
+ * Au rendu, le niveau le plus grossier offrant encore au moins deux paquets
+ * par colonne de pixels est parcouru et réduit à un minimum et un maximum
+ * par colonne : le coût d'un repeint dépend de la largeur du widget, pas du
+ * nombre de points. Les ajouts en fin de série mettent la pyramide à jour
+ * de manière incrémentale.
+ *
+ * Molette : zoom autour du curseur ; glisser : déplacement ;
+ * double-clic : vue complète.
+ */
+class TimeSeriesChart : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit TimeSeriesChart(QWidget *parent = nullptr);
+
+    /**
+     * @brief Remplace la série (triée par horodatage si nécessaire)
+     * @param timestamps Horodatages en millisecondes depuis l'époque
+     * @param values Valeurs, de même taille que timestamps
+     */
+    void setData(const QVector<qint64>& timestamps, const QVector<double>& values);
+
+    /**
+     * @brief Ajoute un point en fin de série
+     *
+     * Les points antérieurs au dernier point de la série sont ignorés.
+     */
+    void append(qint64 timestamp, double value);
+    void append(const QVector<qint64>& timestamps, const QVector<double>& values);
+    void clear();
+
+    int pointCount() const { return m_timestamps.size(); }
+
+    /**
+     * @brief Restreint l'affichage à une plage de temps
+     */
+    void setVisibleRange(qint64 from, qint64 to);
+    void resetZoom();
+    qint64 visibleFrom() const { return m_visibleFrom; }
+    qint64 visibleTo() const { return m_visibleTo; }
+
+    void setTitle(const QString& title);
+    void setSeriesColor(const QColor& color);
+    void setIncludeZero(bool includeZero);
+
+    QSize sizeHint() const override;
+    QSize minimumSizeHint() const override;
+
+signals:
+    void visibleRangeChanged(qint64 from, qint64 to);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+    void wheelEvent(QWheelEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void mouseReleaseEvent(QMouseEvent *event) override;
+    void mouseDoubleClickEvent(QMouseEvent *event) override;
+
+private:
+    struct Bucket {
+        double minValue;
+        double maxValue;
+    };
+
+    static const int LEVEL_SHIFT = 2;          // Paquets de 4 entre deux niveaux
+    static const int LEVEL_FACTOR = 1 << LEVEL_SHIFT;
+
+    bool appendPoint(qint64 timestamp, double value);
+    void followAppend(qint64 previousLast);
+    void rebuildPyramid();
+    void appendToPyramid(double value);
+    void addLevel();
+    void applyRange(qint64 from, qint64 to, bool autoRange);
+    void invalidatePlot();
+    void updatePlot();
+    void decimate(int first, int last, int columns);
+    QRect plotRect() const;
+    void drawAxes(QPainter& painter, const QRect& rect);
+    QString formatTimestamp(qint64 timestamp, qint64 span) const;
+    static double niceStep(double range, int ticks);
+
+private:
+    // Série brute (niveau 0) et pyramide : m_levels[k] regroupe 4^(k+1) points
+    QVector<qint64> m_timestamps;
+    QVector<double> m_values;
+    QVector<QVector<Bucket>> m_levels;
+
+    // Plage affichée ; m_autoRange : suit l'étendue complète de la série
+    qint64 m_visibleFrom;
+    qint64 m_visibleTo;
+    bool m_autoRange;
+
+    // Tracé décimé en coordonnées écran, recalculé si données, plage ou taille changent
+    QVector<QPointF> m_plot;
+    double m_plotMin;
+    double m_plotMax;
+    bool m_plotDirty;
+
+    // Déplacement à la souris
+    bool m_dragging;
+    QPoint m_dragOrigin;
+    qint64 m_dragFrom;
+    qint64 m_dragTo;
+
+    QString m_title;
+    QColor m_seriesColor;
+    bool m_includeZero;
+
+    // Styling
+    QFont m_titleFont;
+    QFont m_axisFont;
+    int m_margin;
+    int m_titleHeight;
+    int m_axisWidth;
+    int m_axisHeight;
+};
+
+#endif // TIMESERIESCHART_H